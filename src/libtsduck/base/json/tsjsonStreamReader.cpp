@@ -0,0 +1,394 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsjsonStreamReader.h"
+#include "tsjsonNull.h"
+#include "tsjsonTrue.h"
+#include "tsjsonFalse.h"
+#include "tsjsonNumber.h"
+#include "tsjsonString.h"
+#include "tsjsonObject.h"
+#include "tsjsonArray.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::json::StreamReader::StreamReader(Report& report) :
+    _report(report),
+    _error(false),
+    _done(false),
+    _file(),
+    _input(nullptr),
+    _text(),
+    _textNext(_text.end()),
+    _line(),
+    _lineNumber(0),
+    _index(0),
+    _levels(),
+    _name(),
+    _value()
+{
+}
+
+ts::json::StreamReader::~StreamReader()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Open or close the input document.
+//----------------------------------------------------------------------------
+
+bool ts::json::StreamReader::open(const UString& fileName)
+{
+    close();
+    _file.open(fileName.toUTF8().c_str());
+    if (!_file) {
+        _report.error(u"error reading file %s", {fileName});
+        _error = true;
+        return false;
+    }
+    _input = &_file;
+    return true;
+}
+
+bool ts::json::StreamReader::open(std::istream& strm)
+{
+    close();
+    _input = &strm;
+    return true;
+}
+
+bool ts::json::StreamReader::openText(const UString& text)
+{
+    close();
+    text.toSubstituted(u"\r", UString()).split(_text, u'\n', false);
+    _textNext = _text.begin();
+    return true;
+}
+
+void ts::json::StreamReader::close()
+{
+    if (_file.is_open()) {
+        _file.close();
+    }
+    _file.clear();
+    _input = nullptr;
+    _text.clear();
+    _textNext = _text.end();
+    _error = false;
+    _done = false;
+    _line.clear();
+    _lineNumber = 0;
+    _index = 0;
+    _levels.clear();
+    _name.clear();
+    _value.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Read the next line in the input document.
+//----------------------------------------------------------------------------
+
+bool ts::json::StreamReader::nextLine()
+{
+    _index = 0;
+    if (_input != nullptr) {
+        if (!_line.getLine(*_input)) {
+            if (!_input->eof()) {
+                _report.error(u"error reading input document");
+                _error = true;
+            }
+            return false;
+        }
+    }
+    else if (_textNext != _text.end()) {
+        _line = *_textNext++;
+    }
+    else {
+        _line.clear();
+        return false;
+    }
+    _lineNumber++;
+    return true;
+}
+
+bool ts::json::StreamReader::skipWhiteSpace()
+{
+    for (;;) {
+        while (_index < _line.length() && IsSpace(_line[_index])) {
+            _index++;
+        }
+        if (_index < _line.length()) {
+            return true;
+        }
+        if (!nextLine()) {
+            return false;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Report an error.
+//----------------------------------------------------------------------------
+
+ts::json::StreamReader::Event ts::json::StreamReader::error(const UString& message)
+{
+    _report.error(u"line %d: %s", {_lineNumber, message});
+    _error = true;
+    _value.clear();
+    return EventError;
+}
+
+
+//----------------------------------------------------------------------------
+// Parse a string literal at current position.
+//----------------------------------------------------------------------------
+
+bool ts::json::StreamReader::parseString(UString& str)
+{
+    // JSON strings always start with a double quote and never span several lines.
+    if (_index >= _line.length() || _line[_index] != u'"') {
+        return false;
+    }
+    for (size_t end = _index + 1; end < _line.length(); ++end) {
+        if (_line[end] == u'\\') {
+            // Skip escaped character.
+            ++end;
+        }
+        else if (_line[end] == u'"') {
+            str = _line.substr(_index + 1, end - _index - 1);
+            str.convertFromJSON();
+            _index = end + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Read the next event in the document.
+//----------------------------------------------------------------------------
+
+ts::json::StreamReader::Event ts::json::StreamReader::next()
+{
+    if (_error) {
+        return EventError;
+    }
+
+    // Leading spaces are ignored.
+    if (!skipWhiteSpace()) {
+        if (_error) {
+            return EventError;
+        }
+        else if (_levels.empty() && _done) {
+            return EventEnd;
+        }
+        else if (_levels.empty()) {
+            return error(u"not a valid JSON value");
+        }
+        else {
+            return error(u"unexpected end of JSON document");
+        }
+    }
+
+    // At top level, one single value is allowed.
+    if (_levels.empty()) {
+        if (_done) {
+            return error(u"extraneous text after JSON value");
+        }
+        _name.clear();
+        return parseValue();
+    }
+
+    // In an object or array, check end of object or array.
+    Level& level(_levels.back());
+    const bool isObject = level.isObject;
+    if (_line[_index] == (isObject ? u'}' : u']')) {
+        _index++;
+        _levels.pop_back();
+        _done = _levels.empty();
+        _name.clear();
+        _value.clear();
+        return isObject ? EventEndObject : EventEndArray;
+    }
+
+    // Expect a comma before next field or element.
+    if (level.count++ > 0) {
+        if (_line[_index] != u',') {
+            return error(isObject ? u"syntax error in JSON object, missing ','" : u"syntax error in JSON array, missing ','");
+        }
+        _index++;
+        if (!skipWhiteSpace()) {
+            return error(u"unexpected end of JSON document");
+        }
+    }
+
+    // In an object, get the field name.
+    if (isObject) {
+        if (!parseString(_name)) {
+            return error(u"syntax error in JSON object, missing field name");
+        }
+        if (!skipWhiteSpace() || _line[_index] != u':') {
+            return error(u"syntax error in JSON object, missing ':'");
+        }
+        _index++;
+        if (!skipWhiteSpace()) {
+            return error(u"unexpected end of JSON document");
+        }
+    }
+    else {
+        _name.clear();
+    }
+    return parseValue();
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the start of a value at current position.
+//----------------------------------------------------------------------------
+
+ts::json::StreamReader::Event ts::json::StreamReader::parseValue()
+{
+    _value.clear();
+    const UChar c = _line[_index];
+    UString str;
+
+    if (c == u'{') {
+        _index++;
+        _levels.push_back({true, 0});
+        return EventBeginObject;
+    }
+    else if (c == u'[') {
+        _index++;
+        _levels.push_back({false, 0});
+        return EventBeginArray;
+    }
+    else if (c == u'"') {
+        if (!parseString(str)) {
+            return error(u"unterminated JSON string literal");
+        }
+        _value = new String(str);
+    }
+    else if (_line.compare(_index, 4, u"null") == 0) {
+        _index += 4;
+        _value = new Null;
+    }
+    else if (_line.compare(_index, 4, u"true") == 0) {
+        _index += 4;
+        _value = new True;
+    }
+    else if (_line.compare(_index, 5, u"false") == 0) {
+        _index += 5;
+        _value = new False;
+    }
+    else if (c == u'-' || IsDigit(c)) {
+        // Numeric literal: [-]digits[.digits][e|E[+|-]digits]
+        const size_t start = _index;
+        size_t end = start + 1;
+        while (end < _line.length() && (IsDigit(_line[end]) || _line[end] == u'.' || _line[end] == u'e' || _line[end] == u'E' ||
+                                        ((_line[end] == u'+' || _line[end] == u'-') && (_line[end - 1] == u'e' || _line[end - 1] == u'E'))))
+        {
+            end++;
+        }
+        _index = end;
+        int64_t intVal = 0;
+        if (_line.substr(start, end - start).toInteger(intVal)) {
+            _value = new Number(intVal);
+        }
+        else {
+            // Invalid integer.
+            _report.error(u"line %d: JSON floating-point numbers not yet supported, using \"null\" instead", {_lineNumber});
+            _value = new Null;
+        }
+    }
+    else {
+        return error(u"not a valid JSON value");
+    }
+
+    // A scalar value at top level is the complete document.
+    _done = _levels.empty();
+    return EventValue;
+}
+
+
+//----------------------------------------------------------------------------
+// Read the next complete value in the document.
+//----------------------------------------------------------------------------
+
+ts::json::StreamReader::Event ts::json::StreamReader::readValue(ValuePtr& value)
+{
+    value.clear();
+
+    const Event event = next();
+    const UString name(_name);
+
+    if (event == EventValue) {
+        value = _value;
+    }
+    else if (event == EventBeginObject || event == EventBeginArray) {
+        // Read all fields or elements, recursively.
+        const bool isObject = event == EventBeginObject;
+        value = isObject ? ValuePtr(new Object) : ValuePtr(new Array);
+        for (;;) {
+            ValuePtr element;
+            const Event sub = readValue(element);
+            if (sub == EventValue) {
+                if (isObject) {
+                    value->add(_name, element);
+                }
+                else {
+                    value->set(element);
+                }
+            }
+            else if (sub == (isObject ? EventEndObject : EventEndArray)) {
+                break;
+            }
+            else {
+                value.clear();
+                return EventError;
+            }
+        }
+    }
+    else {
+        return event;
+    }
+
+    // The name of the value is the one before reading the content of an object or array.
+    _name = name;
+    _value.clear();
+    return EventValue;
+}
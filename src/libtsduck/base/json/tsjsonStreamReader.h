@@ -0,0 +1,187 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Incremental pull parser of JSON documents.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsjsonValue.h"
+
+namespace ts {
+    namespace json {
+        //!
+        //! Incremental pull parser of JSON documents.
+        //! @ingroup json
+        //!
+        //! The document is read sequentially, one line at a time, and returned as a
+        //! sequence of events: start and end of objects and arrays, scalar values.
+        //! Only the current line and the stack of open objects and arrays are kept
+        //! in memory. At any point, the application may build the complete tree of
+        //! the next value using readValue(). This is typically used to process a
+        //! huge array of objects, one object at a time.
+        //!
+        //! The syntax of the document and the error messages are the same as json::Parse().
+        //!
+        class TSDUCKDLL StreamReader
+        {
+            TS_NOCOPY(StreamReader);
+        public:
+            //!
+            //! Events which are returned by the parser.
+            //!
+            enum Event {
+                EventEnd,          //!< End of document, after the top-level value.
+                EventError,        //!< Syntax or input error, already reported.
+                EventBeginObject,  //!< Start of an object.
+                EventEndObject,    //!< End of an object.
+                EventBeginArray,   //!< Start of an array.
+                EventEndArray,     //!< End of an array.
+                EventValue,        //!< A value (a scalar value with next(), any value with readValue()).
+            };
+
+            //!
+            //! Constructor.
+            //! @param [in,out] report Where to report errors.
+            //!
+            explicit StreamReader(Report& report = NULLREP);
+
+            //!
+            //! Destructor.
+            //!
+            ~StreamReader();
+
+            //!
+            //! Start reading a JSON document from a text file.
+            //! @param [in] fileName Name of the file to read.
+            //! @return True on success, false on error.
+            //!
+            bool open(const UString& fileName);
+
+            //!
+            //! Start reading a JSON document from a text stream.
+            //! @param [in,out] strm A standard text stream in input mode. The lifetime of the stream
+            //! must equal or exceed the time the document is read.
+            //! @return True on success, false on error.
+            //!
+            bool open(std::istream& strm);
+
+            //!
+            //! Start reading a JSON document from a string.
+            //! @param [in] text The JSON document.
+            //! @return True on success, false on error.
+            //!
+            bool openText(const UString& text);
+
+            //!
+            //! Close the document and release all resources.
+            //!
+            void close();
+
+            //!
+            //! Read the next event in the document.
+            //! @return The next event.
+            //!
+            Event next();
+
+            //!
+            //! Read the next complete value in the document.
+            //! When the next event is the start of an object or array, the complete
+            //! object or array is read and returned as one value.
+            //! @param [out] value The returned value when the return value is EventValue, null otherwise.
+            //! @return EventValue when a value was read. Otherwise, this is the end of the
+            //! enclosing object or array, the end of the document or an error.
+            //!
+            Event readValue(ValuePtr& value);
+
+            //!
+            //! Get the name of the last object field.
+            //! @return The name of the field in the innermost object for the last start of object,
+            //! start of array or scalar value event. Empty if the value is not in an object.
+            //!
+            const UString& name() const { return _name; }
+
+            //!
+            //! Get the last scalar value.
+            //! @return The scalar value of the last EventValue which was returned by next().
+            //!
+            const ValuePtr& value() const { return _value; }
+
+            //!
+            //! Get the number of open objects and arrays.
+            //! @return The number of open objects and arrays.
+            //!
+            size_t depth() const { return _levels.size(); }
+
+            //!
+            //! Get the current line number.
+            //! @return The current line number in the document.
+            //!
+            size_t lineNumber() const { return _lineNumber; }
+
+        private:
+            // Description of an open object or array.
+            struct Level
+            {
+                bool   isObject;  // An object, not an array.
+                size_t count;     // Number of fields or elements already read.
+            };
+
+            Report&                     _report;      // Where to report errors.
+            bool                        _error;       // An error was found.
+            bool                        _done;        // The top-level value was completely read.
+            std::ifstream               _file;        // Input file, when the document is read from a file.
+            std::istream*               _input;       // Input stream, null when the document is read from a string.
+            UStringList                 _text;        // All text lines, when the document is read from a string.
+            UStringList::const_iterator _textNext;    // Next line in _text.
+            UString                     _line;        // Current input line.
+            size_t                      _lineNumber;  // Line number of _line, zero before first line.
+            size_t                      _index;       // Index of next character to analyze in _line.
+            std::vector<Level>          _levels;      // Stack of open objects and arrays.
+            UString                     _name;        // Name of last field.
+            ValuePtr                    _value;       // Last scalar value.
+
+            // Read the next line in the input document. Return false at end of document.
+            bool nextLine();
+
+            // Skip white spaces, including end of lines. Return false at end of document.
+            bool skipWhiteSpace();
+
+            // Parse a string literal at current position. Return false if there is none.
+            bool parseString(UString& str);
+
+            // Parse the start of a value at current position.
+            Event parseValue();
+
+            // Report an error and return EventError.
+            Event error(const UString& message);
+        };
+    }
+}
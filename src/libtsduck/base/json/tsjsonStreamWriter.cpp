@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsjsonStreamWriter.h"
+#include "tsjsonNumber.h"
+#include "tsjsonString.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::json::StreamWriter::StreamWriter(TextFormatter& output) :
+    _output(output),
+    _levels()
+{
+}
+
+ts::json::StreamWriter::~StreamWriter()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Open and close objects and arrays.
+//----------------------------------------------------------------------------
+
+void ts::json::StreamWriter::beginObject(const UString& name)
+{
+    prefix(name);
+    _output << "{" << ts::indent;
+    _levels.push_back({true, 0});
+}
+
+void ts::json::StreamWriter::beginArray(const UString& name)
+{
+    prefix(name);
+    _output << "[" << ts::indent;
+    _levels.push_back({false, 0});
+}
+
+void ts::json::StreamWriter::end()
+{
+    if (!_levels.empty()) {
+        _output << std::endl << ts::unindent << ts::margin << (_levels.back().isObject ? "}" : "]");
+        _levels.pop_back();
+    }
+}
+
+void ts::json::StreamWriter::close()
+{
+    while (!_levels.empty()) {
+        end();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Add fields or elements.
+//----------------------------------------------------------------------------
+
+void ts::json::StreamWriter::prefix(const UString& name)
+{
+    // Same formatting as json::Object and json::Array.
+    if (!_levels.empty()) {
+        Level& level(_levels.back());
+        if (level.count++ > 0) {
+            _output << ",";
+        }
+        _output << std::endl << ts::margin;
+        if (level.isObject) {
+            _output << '"' << name.toJSON() << "\": ";
+        }
+    }
+}
+
+void ts::json::StreamWriter::add(const UString& name, const Value& value)
+{
+    prefix(name);
+    value.print(_output);
+}
+
+void ts::json::StreamWriter::add(const UString& name, const ValuePtr& value)
+{
+    if (!value.isNull()) {
+        add(name, *value);
+    }
+}
+
+void ts::json::StreamWriter::add(const UString& name, int64_t value)
+{
+    add(name, Number(value));
+}
+
+void ts::json::StreamWriter::add(const UString& name, const UString& value)
+{
+    add(name, String(value));
+}
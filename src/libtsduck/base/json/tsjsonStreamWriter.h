@@ -0,0 +1,165 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  JSON document which is formatted and printed on the fly.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsjsonValue.h"
+
+namespace ts {
+    namespace json {
+        //!
+        //! JSON document which is formatted and printed on the fly.
+        //! @ingroup json
+        //!
+        //! Instead of building the complete tree of values before printing it, the
+        //! objects and arrays are opened, filled and closed by the application and
+        //! immediately printed. Only the stack of open objects and arrays is kept
+        //! in memory. The formatting is identical to ts::json::Value::print().
+        //!
+        //! When a field or element is added, the name is used only when the innermost
+        //! open value is an object. It is ignored when the innermost open value is an
+        //! array or at top level.
+        //!
+        class TSDUCKDLL StreamWriter
+        {
+            TS_NOBUILD_NOCOPY(StreamWriter);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in,out] output The text formatter to print the document.
+            //! The formatter must remain valid during the lifetime of this object.
+            //!
+            explicit StreamWriter(TextFormatter& output);
+
+            //!
+            //! Destructor.
+            //! All open objects and arrays are closed.
+            //!
+            ~StreamWriter();
+
+            //!
+            //! Open a new object.
+            //! @param [in] name Name of the field when the innermost open value is an object.
+            //!
+            void beginObject(const UString& name = UString());
+
+            //!
+            //! Open a new array.
+            //! @param [in] name Name of the field when the innermost open value is an object.
+            //!
+            void beginArray(const UString& name = UString());
+
+            //!
+            //! Close the innermost open object or array.
+            //!
+            void end();
+
+            //!
+            //! Close all open objects and arrays.
+            //!
+            void close();
+
+            //!
+            //! Get the number of open objects and arrays.
+            //! @return The number of open objects and arrays.
+            //!
+            size_t depth() const { return _levels.size(); }
+
+            //!
+            //! Add a field into the innermost open object.
+            //! @param [in] name Name of the field.
+            //! @param [in] value Value of the field. The value is immediately printed.
+            //!
+            void add(const UString& name, const Value& value);
+
+            //!
+            //! Add a field into the innermost open object.
+            //! @param [in] name Name of the field.
+            //! @param [in] value Value of the field. The value is immediately printed.
+            //!
+            void add(const UString& name, const ValuePtr& value);
+
+            //!
+            //! Add an integer field into the innermost open object.
+            //! @param [in] name Name of the field.
+            //! @param [in] value Value of the field.
+            //!
+            void add(const UString& name, int64_t value);
+
+            //!
+            //! Add a string field into the innermost open object.
+            //! @param [in] name Name of the field.
+            //! @param [in] value Value of the field.
+            //!
+            void add(const UString& name, const UString& value);
+
+            //!
+            //! Add an element into the innermost open array.
+            //! @param [in] value Value of the element. The value is immediately printed.
+            //!
+            void set(const Value& value) { add(UString(), value); }
+
+            //!
+            //! Add an element into the innermost open array.
+            //! @param [in] value Value of the element. The value is immediately printed.
+            //!
+            void set(const ValuePtr& value) { add(UString(), value); }
+
+            //!
+            //! Add an integer element into the innermost open array.
+            //! @param [in] value Value of the element.
+            //!
+            void set(int64_t value) { add(UString(), value); }
+
+            //!
+            //! Add a string element into the innermost open array.
+            //! @param [in] value Value of the element.
+            //!
+            void set(const UString& value) { add(UString(), value); }
+
+        private:
+            // Description of an open object or array.
+            struct Level
+            {
+                bool   isObject;  // An object, not an array.
+                size_t count;     // Number of fields or elements already printed.
+            };
+
+            TextFormatter&     _output;
+            std::vector<Level> _levels;
+
+            // Print the separator and the name of a new field or element.
+            void prefix(const UString& name);
+        };
+    }
+}
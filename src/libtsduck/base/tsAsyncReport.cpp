@@ -28,8 +28,16 @@
 //----------------------------------------------------------------------------
 
 #include "tsAsyncReport.h"
+#include "tsGuardCondition.h"
+#include "tsTime.h"
 TSDUCK_SOURCE;
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::AsyncReport::RATE_COUNT;
+constexpr ts::MilliSecond ts::AsyncReport::MAX_WAKEUP_DELAY;
+constexpr size_t ts::AsyncReport::RECORD_PREALLOC;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Default constructor
@@ -38,13 +46,32 @@ TSDUCK_SOURCE;
 ts::AsyncReport::AsyncReport(int max_severity, const AsyncReportArgs& args) :
     Report(max_severity),
     Thread(ThreadAttributes().setPriority(ThreadAttributes::GetMinimumPriority())),
-    _log_queue(args.log_msg_count),
+    _ring(std::max<size_t>(args.log_msg_count, 1)),
+    _write_pos(0),
+    _read_pos(0),
+    _mutex(),
+    _wakeup(),
+    _space(),
+    _sleeping(false),
+    _waiting(0),
+    _terminate(false),
+    _dropped(0),
+    _dropped_total(0),
+    _max_rate(args.log_msg_rate),
+    _origin(true),
+    _rates(),
     _default_handler(*this),
     _handler(&_default_handler),
     _time_stamp(args.timed_log),
     _synchronous(args.sync_log),
     _terminated(false)
 {
+    // Preallocate the records so that the application threads do not allocate memory.
+    for (size_t i = 0; i < _ring.size(); ++i) {
+        _ring[i].sequence = i;
+        _ring[i].message.reserve(RECORD_PREALLOC);
+    }
+
     // Start the logging thread
     start();
 }
@@ -67,9 +94,17 @@ ts::AsyncReport::~AsyncReport()
 void ts::AsyncReport::terminate()
 {
     if (!_terminated) {
-        // Insert an "end of report" message in the queue.
-        // This message will tell the logging thread to terminate.
-        _log_queue.forceEnqueue(new LogMessage(true, 0, UString()));
+        // Tell the logging thread to terminate after delivering all pending messages.
+        {
+            GuardCondition lock(_mutex, _wakeup);
+            _terminate = true;
+            lock.signal();
+        }
+        // Producers which wait for a free record will drop their message.
+        {
+            GuardCondition lock(_mutex, _space);
+            lock.signal();
+        }
 
         // Wait for termination of the logging thread
         waitForTermination();
@@ -93,30 +128,158 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
     ::OutputDebugStringA(msgNewLine.toUTF8().c_str());
 #endif
 
-    if (!_terminated) {
-        // Enqueue the message immediately (timeout = 0), drop message on overflow.
-        // On the contrary, in synchronous mode, wait infinitely until the message is queued.
-        _log_queue.enqueue(new LogMessage(false, severity, msg), _synchronous ? Infinite : 0);
+    if (!_terminated && allowedRate(severity)) {
+        // Enqueue the message immediately, drop message on overflow. On the contrary,
+        // in synchronous mode, wait until the logging thread frees some space.
+        while (!enqueue(severity, msg)) {
+            if (!_synchronous || _terminate) {
+                _dropped++;
+                _dropped_total++;
+                break;
+            }
+            GuardCondition lock(_mutex, _space);
+            _waiting++;
+            // Check again, a record may have been freed before _waiting was set.
+            // The timeout covers a missed signal and the termination of the logging thread.
+            const bool done = enqueue(severity, msg);
+            if (!done) {
+                lock.waitCondition(MAX_WAKEUP_DELAY);
+            }
+            _waiting--;
+            if (done) {
+                break;
+            }
+        }
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Check if a message is allowed by the rate limitation of its severity.
+//----------------------------------------------------------------------------
+
+bool ts::AsyncReport::allowedRate(int severity)
+{
+    // Fatal errors are never dropped. Synchronous mode does not drop messages.
+    if (_max_rate == 0 || severity <= Severity::Fatal || _synchronous) {
+        return true;
+    }
+
+    RateLimit& rate(_rates[std::min<int>(severity, Severity::Debug) - Severity::Fatal]);
+    const int64_t second = (Monotonic(true) - _origin) / NanoSecPerSec;
+
+    // Start a new window when the second changed. Concurrent threads may reset the
+    // counter more than once at the beginning of a window, this is an approximation.
+    int64_t previous = rate.second;
+    if (previous != second && rate.second.compare_exchange_strong(previous, second)) {
+        rate.count = 0;
+    }
+    if (++rate.count <= _max_rate) {
+        return true;
+    }
+    else {
+        _dropped++;
+        _dropped_total++;
+        return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Try to insert a message in the ring, return false if full.
+//----------------------------------------------------------------------------
+
+bool ts::AsyncReport::enqueue(int severity, const UString& msg)
+{
+    // Reserve a record: the record at the write position must have been released by the consumer.
+    size_t pos = _write_pos.load(std::memory_order_relaxed);
+    LogRecord* rec = nullptr;
+    for (;;) {
+        rec = &_ring[pos % _ring.size()];
+        const size_t seq = rec->sequence.load(std::memory_order_acquire);
+        if (seq == pos) {
+            if (_write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+            // pos was reloaded by compare_exchange_weak, retry.
+        }
+        else if (seq < pos) {
+            // The record is still used by the consumer, the ring is full.
+            return false;
+        }
+        else {
+            // Another producer got this position, retry with the next one.
+            pos = _write_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Fill the record (reuse the preallocated string buffer) and publish it.
+    rec->severity = severity;
+    rec->message = msg;
+    rec->sequence.store(pos + 1, std::memory_order_release);
+
+    // Wake up the logging thread if it is waiting. Never block: if the mutex is
+    // busy, the logging thread will notice the message after a short timeout.
+    if (_sleeping.load() && _mutex.acquire(0)) {
+        _wakeup.signal();
+        _mutex.release();
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // This hook is invoked in the context of the logging thread.
 //----------------------------------------------------------------------------
 
 void ts::AsyncReport::main()
 {
-    LogMessagePtr msg;
+    UString msg;
+    msg.reserve(RECORD_PREALLOC);
 
-    while (_log_queue.dequeue(msg) && !msg->terminate) {
+    for (;;) {
+        // Deliver the number of dropped messages, if any.
+        const uint64_t dropped = _dropped.exchange(0);
+        if (dropped > 0) {
+            _handler->handleMessage(Severity::Warning, UString::Format(u"%'d log messages dropped", {dropped}));
+        }
+
+        // Get next record, if any.
+        const size_t pos = _read_pos.load(std::memory_order_relaxed);
+        LogRecord& rec(_ring[pos % _ring.size()]);
+        if (rec.sequence.load(std::memory_order_acquire) == pos + 1) {
+            // Copy the message and release the record as soon as possible.
+            const int severity = rec.severity;
+            msg = rec.message;
+            _read_pos.store(pos + 1, std::memory_order_relaxed);
+            rec.sequence.store(pos + _ring.size(), std::memory_order_release);
 
-        // Invoke the report handler
-        _handler->handleMessage(msg->severity, msg->message);
+            // In synchronous mode, wake up a producer which waits for a free record.
+            if (_waiting.load() > 0) {
+                GuardCondition lock(_mutex, _space);
+                lock.signal();
+            }
 
-        // Abort application on fatal error
-        if (msg->severity == Severity::Fatal) {
-            ::exit(EXIT_FAILURE);
+            // Invoke the report handler
+            _handler->handleMessage(severity, msg);
+
+            // Abort application on fatal error
+            if (severity == Severity::Fatal) {
+                ::exit(EXIT_FAILURE);
+            }
+        }
+        else {
+            // The ring is empty, wait for a new message or termination.
+            GuardCondition lock(_mutex, _wakeup);
+            if (_terminate) {
+                break;
+            }
+            _sleeping = true;
+            // Check again, a message may have been published before _sleeping was set.
+            if (rec.sequence.load(std::memory_order_acquire) != pos + 1) {
+                lock.waitCondition(MAX_WAKEUP_DELAY);
+            }
+            _sleeping = false;
         }
     }
 
@@ -36,9 +36,11 @@
 #include "tsReport.h"
 #include "tsReportHandler.h"
 #include "tsAsyncReportArgs.h"
-#include "tsMessageQueue.h"
-#include "tsNullMutex.h"
 #include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsMonotonic.h"
+#include <atomic>
 
 namespace ts {
     //!
@@ -56,6 +58,14 @@ namespace ts {
     //! to never block, slow down or crash the application. Messages are dropped when
     //! necessary to avoid that kind of problem.
     //!
+    //! The messages are stored in a fixed-size ring of preallocated records. The ring
+    //! has multiple lock-free producers (the application threads) and one consumer
+    //! (the logging thread). The application threads never wait for a mutex, except in
+    //! synchronous mode when the ring is full, and, in the general case, never allocate
+    //! memory. Dropped messages are counted and the number of dropped messages is
+    //! periodically reported by the logging thread.
+    //! Optionally, the number of messages per second can be limited for each severity.
+    //!
     //! Messages are displayed on the standard error device by default.
     //!
     class TSDUCKDLL AsyncReport : public Report, private Thread
@@ -108,6 +118,13 @@ namespace ts {
         //!
         bool getSynchronous() const { return _synchronous; }
 
+        //!
+        //! Get the total number of dropped messages since the creation of the report.
+        //! @return The total number of dropped messages, because the ring was full
+        //! or because the maximum message rate of a severity was reached.
+        //!
+        uint64_t droppedMessages() const { return _dropped_total; }
+
         //!
         //! Synchronously terminate the report thread.
         //! Automatically performed in destructor.
@@ -122,17 +139,42 @@ namespace ts {
         // This hook is invoked in the context of the logging thread.
         virtual void main() override;
 
-        // The application threads send that type of message to the logging thread
-        struct LogMessage
+        // One record in the ring of messages. A record is ready to be filled by a producer
+        // when its sequence number is equal to the write position. It is ready to be read by
+        // the consumer when its sequence number is equal to the read position plus one.
+        struct LogRecord
         {
-            LogMessage(bool t, int s, const UString& m) : terminate(t), severity(s), message(m) {}
+            LogRecord() : sequence(0), severity(0), message() {}
 
-            bool    terminate;  // ask the logging thread to terminate
-            int     severity;
-            UString message;
+            std::atomic<size_t> sequence;
+            int                 severity;
+            UString             message;
         };
-        typedef SafePtr <LogMessage, NullMutex> LogMessagePtr;
-        typedef MessageQueue <LogMessage, NullMutex> LogMessageQueue;
+
+        // Rate limitation for one severity, using one-second windows.
+        struct RateLimit
+        {
+            RateLimit() : second(0), count(0) {}
+
+            std::atomic<int64_t> second;  // current one-second window
+            std::atomic<size_t>  count;   // number of messages in current window
+        };
+
+        // Number of severities with distinct rate limitations, from Fatal to Debug.
+        // All debug levels share the last one.
+        static constexpr size_t RATE_COUNT = Severity::Debug - Severity::Fatal + 1;
+
+        // Maximum number of milliseconds the logging thread may miss a wake up signal.
+        static constexpr MilliSecond MAX_WAKEUP_DELAY = 20;
+
+        // Preallocated size of message records.
+        static constexpr size_t RECORD_PREALLOC = 256;
+
+        // Try to insert a message in the ring, return false if full.
+        bool enqueue(int severity, const UString& msg);
+
+        // Check if a message is allowed by the rate limitation of its severity.
+        bool allowedRate(int severity);
 
         // Default report handler:
         class DefaultHandler : public ReportHandler
@@ -146,7 +188,20 @@ namespace ts {
         };
 
         // Private members:
-        LogMessageQueue         _log_queue;
+        std::vector<LogRecord>  _ring;             // fixed-size ring of messages
+        std::atomic<size_t>     _write_pos;        // next position to write, by producers
+        std::atomic<size_t>     _read_pos;         // next position to read, by the logging thread
+        Mutex                   _mutex;            // only used to wake up the logging thread or waiting producers
+        Condition               _wakeup;           // signaled when a message is available
+        Condition               _space;            // signaled when a record is freed, in synchronous mode
+        std::atomic<bool>       _sleeping;         // the logging thread waits for messages
+        std::atomic<size_t>     _waiting;          // number of producers waiting for a free record
+        std::atomic<bool>       _terminate;        // the logging thread shall terminate
+        std::atomic<uint64_t>   _dropped;          // dropped messages, not yet reported
+        std::atomic<uint64_t>   _dropped_total;    // total number of dropped messages
+        const size_t            _max_rate;         // max messages per second per severity, zero means unlimited
+        const Monotonic         _origin;           // time origin for rate limitation
+        RateLimit               _rates[RATE_COUNT];
         DefaultHandler          _default_handler;
         ReportHandler* volatile _handler;
         volatile bool           _time_stamp;
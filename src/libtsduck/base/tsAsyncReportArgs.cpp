@@ -43,7 +43,8 @@ const size_t ts::AsyncReportArgs::MAX_LOG_MESSAGES;
 ts::AsyncReportArgs::AsyncReportArgs() :
     sync_log(false),
     timed_log(false),
-    log_msg_count(MAX_LOG_MESSAGES)
+    log_msg_count(MAX_LOG_MESSAGES),
+    log_msg_rate(0)
 {
 }
 
@@ -64,6 +65,13 @@ void ts::AsyncReportArgs::defineArgs(Args& args) const
               u"this value if you think that too many messages are dropped. The default "
               u"is " + UString::Decimal(MAX_LOG_MESSAGES) + u" messages.");
 
+    args.option(u"log-message-rate", 0, Args::POSITIVE);
+    args.help(u"log-message-rate",
+              u"Specify the maximum number of log messages per second for each severity "
+              u"(error, warning, info, etc.) Fatal errors are never limited. Extra messages "
+              u"are dropped and the number of dropped messages is periodically reported. "
+              u"This option is ignored with --synchronous-log. By default, there is no limit.");
+
     args.option(u"synchronous-log", 's');
     args.help(u"synchronous-log",
               u"Each logged message is guaranteed to be displayed, synchronously, without "
@@ -86,6 +94,7 @@ void ts::AsyncReportArgs::defineArgs(Args& args) const
 bool ts::AsyncReportArgs::loadArgs(DuckContext& duck, Args& args)
 {
     log_msg_count = args.intValue<size_t>(u"log-message-count", MAX_LOG_MESSAGES);
+    log_msg_rate = args.intValue<size_t>(u"log-message-rate", 0);
     sync_log = args.present(u"synchronous-log");
     timed_log = args.present(u"timed-log");
     return true;
@@ -47,6 +47,7 @@ namespace ts {
         bool   sync_log;       //!< Synchronous log.
         bool   timed_log;      //!< Add time stamps in log messages.
         size_t log_msg_count;  //!< Maximum buffered log messages.
+        size_t log_msg_rate;   //!< Maximum number of messages per second for each severity, zero means unlimited.
 
         //!
         //! Default maximum number of messages in the queue.
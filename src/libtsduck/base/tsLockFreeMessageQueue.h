@@ -0,0 +1,206 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Bounded lock-free message queue for inter-thread communication.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+#include "tsSafePtr.h"
+#include "tsAtomicRefCount.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsGuardCondition.h"
+
+namespace ts {
+    //!
+    //! Bounded lock-free message queue for inter-thread communication.
+    //! @ingroup thread
+    //!
+    //! This class has the same interface as ts::MessageQueue but the messages are stored
+    //! in a fixed-size ring. Inserting and removing messages is lock-free: there is no
+    //! mutex and no memory allocation when the queue is neither full nor empty. A mutex
+    //! and conditions are used only when a thread needs to wait, for a message in an
+    //! empty queue or for free space in a full queue.
+    //!
+    //! Unlike ts::MessageQueue, the queue is always bounded and the messages are
+    //! always dequeued in order of insertion.
+    //!
+    //! @tparam MSG The type of the messages to exchange.
+    //! @tparam MUTEX The type of mutex for synchronization of message pointers
+    //! (lock-free ts::AtomicRefCount by default).
+    //!
+    template <typename MSG, class MUTEX = AtomicRefCount>
+    class LockFreeMessageQueue
+    {
+        TS_NOCOPY(LockFreeMessageQueue);
+    public:
+        //!
+        //! Safe pointer to messages.
+        //!
+        typedef SafePtr<MSG, MUTEX> MessagePtr;
+
+        //!
+        //! Default maximum number of messages in the queue.
+        //!
+        static constexpr size_t DEFAULT_MAX_MESSAGES = 256;
+
+        //!
+        //! Constructor.
+        //! @param [in] maxMessages Maximum number of messages in the queue.
+        //! When a thread attempts to enqueue a message and the queue is full,
+        //! the thread waits until at least one message is dequeued.
+        //! If @a maxMessages is 0, DEFAULT_MAX_MESSAGES is used.
+        //!
+        LockFreeMessageQueue(size_t maxMessages = DEFAULT_MAX_MESSAGES);
+
+        //!
+        //! Destructor
+        //!
+        virtual ~LockFreeMessageQueue();
+
+        //!
+        //! Get the maximum allowed messages in the queue.
+        //! @return The maximum allowed messages in the queue.
+        //!
+        size_t getMaxMessages() const { return _maxMessages; }
+
+        //!
+        //! Insert a message in the queue.
+        //! If the queue is full, the calling thread waits until some space becomes
+        //! available in the queue or the timeout expires.
+        //! @param [in,out] msg The message to enqueue. The ownership of the pointed object
+        //! is transfered to the message queue. Upon return, the @a msg safe pointer becomes
+        //! a null pointer if the message was successfully enqueued (no timeout).
+        //! @param [in] timeout Maximum time to wait in milliseconds.
+        //! @return True on success, false on error (queue still full after timeout).
+        //!
+        bool enqueue(MessagePtr& msg, MilliSecond timeout = Infinite);
+
+        //!
+        //! Insert a message in the queue.
+        //! If the queue is full, the calling thread waits until some space becomes
+        //! available in the queue or the timeout expires.
+        //! @param [in] msg A pointer to the message to enqueue. This pointer shall not
+        //! be owned by a safe pointer. When the message is successfully enqueued, the
+        //! pointer becomes owned by a safe pointer and will be deallocated when no
+        //! longer used. In case of timeout, the object is not equeued and immediately
+        //! deallocated.
+        //! @param [in] timeout Maximum time to wait in milliseconds.
+        //! @return True on success, false on error (queue still full after timeout).
+        //!
+        bool enqueue(MSG* msg, MilliSecond timeout = Infinite);
+
+        //!
+        //! Insert a message in the queue, even if the queue is full.
+        //! The ring has a few extra slots beyond the maximum number of messages for that
+        //! purpose, typically to enqueue a message to instruct the consumer thread to terminate.
+        //! The calling thread waits only when all extra slots are also used.
+        //! @param [in,out] msg The message to enqueue. The ownership of the pointed object
+        //! is transfered to the message queue. Upon return, the @a msg safe pointer becomes
+        //! a null pointer.
+        //!
+        void forceEnqueue(MessagePtr& msg);
+
+        //!
+        //! Insert a message in the queue, even if the queue is full.
+        //! @param [in] msg A pointer to the message to enqueue. This pointer shall not
+        //! be owned by a safe pointer. When the message is enqueued, the pointer becomes
+        //! owned by a safe pointer and will be deallocated when no longer used.
+        //! @see forceEnqueue(MessagePtr&)
+        //!
+        void forceEnqueue(MSG* msg);
+
+        //!
+        //! Remove a message from the queue.
+        //! Wait until a message is received or the timeout expires.
+        //! @param [out] msg Received message.
+        //! @param [in] timeout Maximum time to wait in milliseconds.
+        //! If @a timeout is zero and the queue is empty, return immediately.
+        //! @return True on success, false on error (queue still empty after timeout).
+        //!
+        bool dequeue(MessagePtr& msg, MilliSecond timeout = Infinite);
+
+        //!
+        //! Peek the next message from the queue, without dequeueing it.
+        //! While the message is copied, the other consumers may briefly see the queue empty.
+        //! @return A safe pointer to the first message in the queue or a null pointer
+        //! if the queue is empty.
+        //!
+        MessagePtr peek();
+
+        //!
+        //! Clear the content of the queue.
+        //! This method shall not be called while other threads dequeue messages.
+        //!
+        void clear();
+
+    private:
+        // Number of extra slots in the ring for forced messages.
+        static constexpr size_t FORCE_SLOTS = 8;
+
+        // One slot in the ring. A slot is free for the producer at position p when its sequence
+        // number is p. It contains a message for the consumer at position p when its sequence
+        // number is p + 1. The message pointer is moved in and out of the slot, there is no
+        // allocation for a null safe pointer in a free slot.
+        struct Slot
+        {
+            Slot() : sequence(0), msg() {}
+            std::atomic<size_t> sequence;
+            MessagePtr          msg;
+        };
+
+        const size_t        _maxMessages;       // Max number of messages in the queue, without forced ones.
+        std::vector<Slot>   _ring;              // Ring of messages.
+        std::atomic<size_t> _writePos;          // Next position to write.
+        std::atomic<size_t> _readPos;           // Next position to read.
+        std::atomic<size_t> _count;             // Number of reserved or filled slots.
+        std::atomic<int>    _waitingConsumers;  // Number of threads waiting for messages.
+        std::atomic<int>    _waitingProducers;  // Number of threads waiting for free space.
+        Mutex               _mutex;             // Only used to wait.
+        Condition           _enqueued;          // Signaled when some message is inserted while consumers wait.
+        Condition           _dequeued;          // Signaled when some message is removed while producers wait.
+
+        // Reserve a slot in the queue, without waiting. With force, ignore the maximum number of messages.
+        bool reserve(bool force);
+
+        // Reserve a slot in the queue, waiting for free space.
+        bool reserve(bool force, MilliSecond timeout);
+
+        // Push a message in a previously reserved slot and wake up consumers.
+        void push(MessagePtr&& ptr);
+
+        // Pop a message from the queue, without waiting.
+        bool pop(MessagePtr& msg);
+    };
+}
+
+#include "tsLockFreeMessageQueueTemplate.h"
@@ -0,0 +1,333 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsGuard.h"
+#include "tsTime.h"
+#include "tsThread.h"
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+template <typename MSG, class MUTEX>
+constexpr size_t ts::LockFreeMessageQueue<MSG, MUTEX>::DEFAULT_MAX_MESSAGES;
+template <typename MSG, class MUTEX>
+constexpr size_t ts::LockFreeMessageQueue<MSG, MUTEX>::FORCE_SLOTS;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+ts::LockFreeMessageQueue<MSG, MUTEX>::LockFreeMessageQueue(size_t maxMessages) :
+    _maxMessages(maxMessages == 0 ? DEFAULT_MAX_MESSAGES : maxMessages),
+    _ring(_maxMessages + FORCE_SLOTS),
+    _writePos(0),
+    _readPos(0),
+    _count(0),
+    _waitingConsumers(0),
+    _waitingProducers(0),
+    _mutex(),
+    _enqueued(),
+    _dequeued()
+{
+    for (size_t i = 0; i < _ring.size(); ++i) {
+        _ring[i].sequence = i;
+    }
+}
+
+template <typename MSG, class MUTEX>
+ts::LockFreeMessageQueue<MSG, MUTEX>::~LockFreeMessageQueue()
+{
+    clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Reserve a slot in the queue.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+bool ts::LockFreeMessageQueue<MSG, MUTEX>::reserve(bool force)
+{
+    const size_t limit = force ? _ring.size() : _maxMessages;
+    size_t count = _count.load();
+    while (count < limit) {
+        if (_count.compare_exchange_weak(count, count + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename MSG, class MUTEX>
+bool ts::LockFreeMessageQueue<MSG, MUTEX>::reserve(bool force, MilliSecond timeout)
+{
+    // Lock-free fast path.
+    if (reserve(force)) {
+        return true;
+    }
+    else if (timeout <= 0) {
+        return false;
+    }
+
+    // The queue is full, wait for a message to be dequeued.
+    GuardCondition lock(_mutex, _dequeued);
+    _waitingProducers++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool ok = false;
+    Time start(Time::CurrentUTC());
+    while (!(ok = reserve(force))) {
+
+        // Reduce timeout
+        if (timeout != Infinite) {
+            const Time now(Time::CurrentUTC());
+            timeout -= now - start;
+            start = now;
+            if (timeout <= 0) {
+                break; // timeout
+            }
+        }
+
+        // Temporarily release mutex and wait for dequeued condition.
+        if (!lock.waitCondition(timeout)) {
+            ok = reserve(force);
+            break; // timeout
+        }
+    }
+
+    _waitingProducers--;
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Push a message in a previously reserved slot and wake up consumers.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+void ts::LockFreeMessageQueue<MSG, MUTEX>::push(MessagePtr&& ptr)
+{
+    // The slot was reserved but, with several consumers, the previous message
+    // in this slot may not yet be completely removed.
+    const size_t pos = _writePos.fetch_add(1);
+    Slot& slot(_ring[pos % _ring.size()]);
+    while (slot.sequence.load(std::memory_order_acquire) != pos) {
+        Thread::Yield();
+    }
+    slot.msg = std::move(ptr);
+    slot.sequence.store(pos + 1, std::memory_order_release);
+
+    // Wake up consumers if some of them are waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waitingConsumers.load() > 0) {
+        GuardCondition lock(_mutex, _enqueued);
+        lock.signal();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Pop a message from the queue, without waiting.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+bool ts::LockFreeMessageQueue<MSG, MUTEX>::pop(MessagePtr& msg)
+{
+    size_t pos = _readPos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot(_ring[pos % _ring.size()]);
+        const size_t seq = slot.sequence.load(std::memory_order_acquire);
+        if (seq == pos + 1) {
+            if (_readPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                // Got the message, release the slot.
+                msg = std::move(slot.msg);
+                slot.sequence.store(pos + _ring.size(), std::memory_order_release);
+                _count--;
+
+                // Wake up producers if some of them are waiting.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (_waitingProducers.load() > 0) {
+                    GuardCondition lock(_mutex, _dequeued);
+                    lock.signal();
+                }
+                return true;
+            }
+            // pos was reloaded by compare_exchange_weak, retry.
+        }
+        else if (seq < pos + 1) {
+            // Queue empty or next message not yet completely inserted.
+            return false;
+        }
+        else {
+            // Another consumer got this message, retry with the next one.
+            pos = _readPos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Insert a message in the queue with a timeout.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+bool ts::LockFreeMessageQueue<MSG, MUTEX>::enqueue(MessagePtr& msg, MilliSecond timeout)
+{
+    if (reserve(false, timeout)) {
+        // Transfer ownership of the pointed object.
+        push(MessagePtr(msg.release()));
+        return true;
+    }
+    else {
+        // Timeout, queue still full.
+        return false;
+    }
+}
+
+template <typename MSG, class MUTEX>
+bool ts::LockFreeMessageQueue<MSG, MUTEX>::enqueue(MSG* msg, MilliSecond timeout)
+{
+    if (reserve(false, timeout)) {
+        push(MessagePtr(msg));
+        return true;
+    }
+    else {
+        // Timeout, queue still full. Deallocated the message.
+        delete msg;
+        return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Insert a message in the queue, even if the queue is full.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+void ts::LockFreeMessageQueue<MSG, MUTEX>::forceEnqueue(MessagePtr& msg)
+{
+    reserve(true, Infinite);
+    push(MessagePtr(msg.release()));
+}
+
+template <typename MSG, class MUTEX>
+void ts::LockFreeMessageQueue<MSG, MUTEX>::forceEnqueue(MSG* msg)
+{
+    reserve(true, Infinite);
+    push(MessagePtr(msg));
+}
+
+
+//----------------------------------------------------------------------------
+// Remove a message from the queue.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+bool ts::LockFreeMessageQueue<MSG, MUTEX>::dequeue(MessagePtr& msg, MilliSecond timeout)
+{
+    // Lock-free fast path.
+    if (pop(msg)) {
+        return true;
+    }
+    else if (timeout <= 0) {
+        return false;
+    }
+
+    // The queue is empty, wait for a message to be enqueued.
+    GuardCondition lock(_mutex, _enqueued);
+    _waitingConsumers++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool ok = false;
+    Time start(Time::CurrentUTC());
+    while (!(ok = pop(msg))) {
+
+        // Reduce timeout
+        if (timeout != Infinite) {
+            const Time now(Time::CurrentUTC());
+            timeout -= now - start;
+            start = now;
+            if (timeout <= 0) {
+                break; // timeout
+            }
+        }
+
+        // Temporarily release mutex and wait for enqueued condition.
+        if (!lock.waitCondition(timeout)) {
+            ok = pop(msg);
+            break; // timeout
+        }
+    }
+
+    _waitingConsumers--;
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Peek the next message from the queue, without dequeueing it.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+typename ts::LockFreeMessageQueue<MSG, MUTEX>::MessagePtr ts::LockFreeMessageQueue<MSG, MUTEX>::peek()
+{
+    // Temporarily take the slot back to the "not yet inserted" state while copying the message.
+    // Meanwhile, no consumer can remove the message and no producer can reuse the slot.
+    const size_t pos = _readPos.load(std::memory_order_relaxed);
+    Slot& slot(_ring[pos % _ring.size()]);
+    size_t seq = pos + 1;
+    if (!slot.sequence.compare_exchange_strong(seq, pos, std::memory_order_acquire)) {
+        // Queue empty or message removed by another consumer.
+        return MessagePtr();
+    }
+    const MessagePtr msg(slot.msg);
+    slot.sequence.store(pos + 1, std::memory_order_release);
+
+    // Consumers which saw the queue empty meanwhile may be waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waitingConsumers.load() > 0) {
+        GuardCondition lock(_mutex, _enqueued);
+        lock.signal();
+    }
+    return msg;
+}
+
+
+//----------------------------------------------------------------------------
+// Clear the queue.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+void ts::LockFreeMessageQueue<MSG, MUTEX>::clear()
+{
+    MessagePtr msg;
+    while (pop(msg)) {
+    }
+}
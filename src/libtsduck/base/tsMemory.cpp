@@ -32,6 +32,24 @@
 //----------------------------------------------------------------------------
 
 #include "tsMemory.h"
+#include "tsSysInfo.h"
+
+// Vector instructions for LocateZeroZero(), when the compiler can generate them.
+#if (defined(TS_I386) || defined(TS_X86_64)) && (defined(TS_GCC) || defined(TS_MSC))
+    #define TS_MEMORY_X86 1
+    #include <immintrin.h>
+    #if defined(TS_GCC)
+        #define TS_MEMORY_AVX2_TARGET __attribute__((target("avx2")))
+        #define TS_MEMORY_SSE2_TARGET __attribute__((target("sse2")))
+    #else
+        #define TS_MEMORY_AVX2_TARGET
+        #define TS_MEMORY_SSE2_TARGET
+    #endif
+#elif defined(TS_ARM64) && defined(__ARM_NEON)
+    #define TS_MEMORY_ARM 1
+    #include <arm_neon.h>
+#endif
+
 TSDUCK_SOURCE;
 
 
@@ -71,6 +89,127 @@ const void* ts::LocatePattern(const void* area, size_t area_size, const void* pa
 }
 
 
+//----------------------------------------------------------------------------
+// Locate a 3-byte pattern 00 00 XY into a memory area.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Portable version, used for the end of the area in all versions.
+    const uint8_t* LocateZeroZeroPortable(const uint8_t* a, size_t size, uint8_t third)
+    {
+        // When the third byte of the window is not zero (nor the searched value),
+        // no pattern can start in the window, skip 3 bytes.
+        size_t i = 0;
+        while (i + 2 < size) {
+            if (a[i + 2] > 0x00 && a[i + 2] != third) {
+                i += 3;
+            }
+            else if (a[i] == 0x00 && a[i + 1] == 0x00 && a[i + 2] == third) {
+                return a + i;
+            }
+            else {
+                i++;
+            }
+        }
+        return nullptr;
+    }
+
+#if defined(TS_MEMORY_X86)
+
+    // Intel SSE2 version, 16 bytes at a time.
+    TS_MEMORY_SSE2_TARGET const uint8_t* LocateZeroZeroSSE2(const uint8_t* a, size_t size, uint8_t third)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i last = _mm_set1_epi8(char(third));
+        size_t i = 0;
+        for (; i + 18 <= size; i += 16) {
+            const __m128i b0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), zero);
+            const __m128i b1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 1)), zero);
+            const __m128i b2 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 2)), last);
+            const int mask = _mm_movemask_epi8(_mm_and_si128(_mm_and_si128(b0, b1), b2));
+            if (mask != 0) {
+                for (int bit = 0; ; ++bit) {
+                    if ((mask & (1 << bit)) != 0) {
+                        return a + i + bit;
+                    }
+                }
+            }
+        }
+        return LocateZeroZeroPortable(a + i, size - i, third);
+    }
+
+    // Intel AVX2 version, 32 bytes at a time.
+    TS_MEMORY_AVX2_TARGET const uint8_t* LocateZeroZeroAVX2(const uint8_t* a, size_t size, uint8_t third)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i last = _mm256_set1_epi8(char(third));
+        size_t i = 0;
+        for (; i + 34 <= size; i += 32) {
+            const __m256i b0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), zero);
+            const __m256i b1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 1)), zero);
+            const __m256i b2 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 2)), last);
+            const uint32_t mask = uint32_t(_mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(b0, b1), b2)));
+            if (mask != 0) {
+                for (int bit = 0; ; ++bit) {
+                    if ((mask & (uint32_t(1) << bit)) != 0) {
+                        return a + i + bit;
+                    }
+                }
+            }
+        }
+        return LocateZeroZeroSSE2(a + i, size - i, third);
+    }
+
+#elif defined(TS_MEMORY_ARM)
+
+    // Arm NEON version, 16 bytes at a time.
+    const uint8_t* LocateZeroZeroNEON(const uint8_t* a, size_t size, uint8_t third)
+    {
+        const uint8x16_t last = vdupq_n_u8(third);
+        size_t i = 0;
+        for (; i + 18 <= size; i += 16) {
+            const uint8x16_t b0 = vceqzq_u8(vld1q_u8(a + i));
+            const uint8x16_t b1 = vceqzq_u8(vld1q_u8(a + i + 1));
+            const uint8x16_t b2 = vceqq_u8(vld1q_u8(a + i + 2), last);
+            const uint8x16_t match = vandq_u8(vandq_u8(b0, b1), b2);
+            if (vmaxvq_u8(match) != 0) {
+                uint8_t bytes[16];
+                vst1q_u8(bytes, match);
+                for (size_t k = 0; ; ++k) {
+                    if (bytes[k] != 0) {
+                        return a + i + k;
+                    }
+                }
+            }
+        }
+        return LocateZeroZeroPortable(a + i, size - i, third);
+    }
+
+#endif
+
+    // Select the fastest version for the current CPU.
+    typedef const uint8_t* (*LocateZeroZeroFunction)(const uint8_t*, size_t, uint8_t);
+
+    LocateZeroZeroFunction GetLocateZeroZeroFunction()
+    {
+#if defined(TS_MEMORY_X86)
+        return ts::SysInfo::Instance()->avx2Instructions() ? LocateZeroZeroAVX2 : LocateZeroZeroSSE2;
+#elif defined(TS_MEMORY_ARM)
+        return LocateZeroZeroNEON;
+#else
+        return LocateZeroZeroPortable;
+#endif
+    }
+}
+
+const uint8_t* ts::LocateZeroZero(const void* area, size_t area_size, uint8_t third)
+{
+    // The selection of the fastest version is done once.
+    static const LocateZeroZeroFunction locate = GetLocateZeroZeroFunction();
+    return area == nullptr ? nullptr : locate(reinterpret_cast<const uint8_t*>(area), area_size, third);
+}
+
+
 //----------------------------------------------------------------------------
 // Check if a memory area contains all identical byte values.
 //----------------------------------------------------------------------------
@@ -78,6 +78,18 @@ namespace ts {
     //!
     TSDUCKDLL const void* LocatePattern(const void* area, size_t area_size, const void* pattern, size_t pattern_size);
 
+    //!
+    //! Locate a 3-byte pattern 00 00 XY into a memory area.
+    //! This is a specialized and much faster version of LocatePattern() for video start codes
+    //! (00 00 01) and end of AVC NALunits (00 00 00). Depending on the CPU, SIMD instructions
+    //! are used (AVX2 or SSE2 on Intel, NEON on Arm), the selection is done at run time.
+    //! @param [in] area Address of a memory area to check.
+    //! @param [in] area_size Size in bytes of the memory area.
+    //! @param [in] third The third byte of the pattern.
+    //! @return Address of the first occurence of 00 00 @a third in @a area or zero if not found.
+    //!
+    TSDUCKDLL const uint8_t* LocateZeroZero(const void* area, size_t area_size, uint8_t third);
+
     //!
     //! Check if a memory area contains all identical byte values.
     //! @param [in] area Address of a memory area to check.
@@ -35,6 +35,10 @@
 #include "tsSysUtils.h"
 TSDUCK_SOURCE;
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr ts::NanoSecond ts::Monotonic::DEFAULT_SPIN_NS;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -171,6 +175,35 @@ void ts::Monotonic::wait()
 }
 
 
+//----------------------------------------------------------------------------
+// Wait until the time of the monotonic clock with sub-millisecond accuracy.
+//----------------------------------------------------------------------------
+
+void ts::Monotonic::preciseWait(NanoSecond spin)
+{
+#if defined(TS_WINDOWS)
+    // Windows timers have a millisecond granularity at best.
+    spin = std::max(spin, NanoSecPerMilliSec);
+#endif
+
+    Monotonic now(*this);
+    now.getSystemTime();
+
+    // Sleep until the beginning of the active wait.
+    if (*this - now > spin) {
+        Monotonic approach(*this);
+        approach -= spin;
+        approach.wait();
+        now.getSystemTime();
+    }
+
+    // Actively poll the clock until due time.
+    while (now < *this) {
+        now.getSystemTime();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // This static method requests a minimum resolution, in nano-seconds, for the
 // timers. Return the guaranteed value (can be equal to or greater than the
@@ -177,6 +177,22 @@ namespace ts {
         //!
         void wait();
 
+        //!
+        //! Default duration of the final active wait in preciseWait(), in nano-seconds.
+        //!
+        static constexpr NanoSecond DEFAULT_SPIN_NS = 200 * NanoSecPerMicroSec;
+
+        //!
+        //! Wait until the time of the monotonic clock with sub-millisecond accuracy.
+        //! The thread sleeps until shortly before the due time and then actively
+        //! polls the clock during the last @a spin nano-seconds. This uses some CPU
+        //! but removes the wake-up latency and the granularity of system timers.
+        //! @param [in] spin Duration of the final active wait in nano-seconds.
+        //! When this duration is lower than the timer precision of the system,
+        //! the active wait is longer.
+        //!
+        void preciseWait(NanoSecond spin = DEFAULT_SPIN_NS);
+
         //!
         //! This static method requests a minimum resolution, in nano-seconds, for the timers.
         //! @param [in] precision Requested minimum resolution in nano-seconds.
@@ -0,0 +1,371 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMultiPatternMatcher.h"
+
+// Vector instructions to skip bytes which cannot start a pattern.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define TS_MATCHER_SSE2 1
+    #include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+    #define TS_MATCHER_NEON 1
+    #include <arm_neon.h>
+#endif
+
+TSDUCK_SOURCE;
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::MultiPatternMatcher::MAX_SIMD_START_BYTES;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::MultiPatternMatcher::MultiPatternMatcher() :
+    _patterns(),
+    _max_size(0),
+    _compiled(false),
+    _class_count(0),
+    _classes(),
+    _starts(),
+    _start_bytes(),
+    _start_pairs(),
+    _next(),
+    _match_offset(0),
+    _depth(),
+    _ends()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Clear all patterns.
+//----------------------------------------------------------------------------
+
+void ts::MultiPatternMatcher::clear()
+{
+    _patterns.clear();
+    _max_size = 0;
+    _compiled = false;
+    _next.clear();
+    _depth.clear();
+    _ends.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Add a pattern to search.
+//----------------------------------------------------------------------------
+
+void ts::MultiPatternMatcher::addPattern(const void* pattern, size_t size)
+{
+    if (pattern != nullptr && size > 0) {
+        _patterns.push_back(ByteBlock(pattern, size));
+        _max_size = std::max(_max_size, size);
+        _compiled = false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Compile all patterns into the search automaton.
+//----------------------------------------------------------------------------
+
+void ts::MultiPatternMatcher::compile()
+{
+    // Byte values which are not in any pattern share the class zero.
+    // The transition table uses byte classes instead of byte values to
+    // keep it small with many patterns.
+    TS_ZERO(_classes);
+    TS_ZERO(_starts);
+    _class_count = 1;
+    _start_bytes.clear();
+    _start_pairs.assign(65536 / 8, 0);
+    for (auto it = _patterns.begin(); it != _patterns.end(); ++it) {
+        for (auto b = it->begin(); b != it->end(); ++b) {
+            if (_classes[*b] == 0) {
+                _classes[*b] = uint16_t(_class_count++);
+            }
+        }
+        const uint8_t first = it->front();
+        if (!_starts[first]) {
+            _starts[first] = true;
+            _start_bytes.push_back(first);
+        }
+        // A one-byte pattern starts all pairs with this first byte.
+        const size_t pair_first = size_t(first) << 8;
+        for (size_t pair = pair_first; pair < pair_first + 256; ++pair) {
+            if (it->size() == 1 || (pair & 0xFF) == (*it)[1]) {
+                _start_pairs[pair >> 3] |= uint8_t(1 << (pair & 0x07));
+            }
+        }
+    }
+
+    // Invalid state value in the transition table while building the trie.
+    const State none = std::numeric_limits<State>::max();
+
+    // Build the trie of all patterns. The state 0 is the root.
+    std::vector<State> next(_class_count, none);
+    std::vector<size_t> depth(1, 0);
+    std::vector<bool> ends(1, false);
+    for (auto it = _patterns.begin(); it != _patterns.end(); ++it) {
+        State state = 0;
+        for (auto b = it->begin(); b != it->end(); ++b) {
+            const size_t index = state * _class_count + _classes[*b];
+            if (next[index] == none) {
+                next[index] = State(depth.size());
+                depth.push_back(depth[state] + 1);
+                ends.push_back(false);
+                next.resize(next.size() + _class_count, none);
+            }
+            state = next[index];
+        }
+        ends[state] = true;
+    }
+
+    // Transform the trie into a deterministic automaton, breadth first.
+    // The missing transitions of a state are the transitions of its failure state,
+    // the longest proper suffix of the state which is also a prefix in the trie.
+    // A state matches when a pattern ends in this state or in one of its suffixes.
+    const size_t state_count = depth.size();
+    std::vector<bool> matches(ends);
+    std::vector<State> failure(state_count, 0);
+    std::vector<State> queue;
+    queue.reserve(state_count);
+    queue.push_back(0);
+    for (size_t c = 0; c < _class_count; ++c) {
+        if (next[c] == none) {
+            next[c] = 0;
+        }
+        else {
+            queue.push_back(next[c]);
+        }
+    }
+    for (size_t index = 1; index < queue.size(); ++index) {
+        const State state = queue[index];
+        for (size_t c = 0; c < _class_count; ++c) {
+            State& target(next[state * _class_count + c]);
+            const State fallback = next[failure[state] * _class_count + c];
+            if (target == none) {
+                target = fallback;
+            }
+            else {
+                failure[target] = fallback;
+                matches[target] = matches[target] || matches[fallback];
+                queue.push_back(target);
+            }
+        }
+    }
+
+    // Renumber the states in breadth first order, the matching states last.
+    // Shallow states, which are the most used ones, are contiguous in memory
+    // and a single comparison detects a match during the search.
+    std::vector<State> order;
+    order.reserve(state_count);
+    for (size_t pass = 0; pass < 2; ++pass) {
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            if (matches[*it] == (pass == 1)) {
+                order.push_back(*it);
+            }
+        }
+    }
+    std::vector<State> renum(state_count, 0);
+    for (size_t i = 0; i < state_count; ++i) {
+        renum[order[i]] = State(i);
+    }
+
+    // Build the final transition table. The transitions are offsets of the target
+    // state in the table instead of state numbers, to avoid a multiplication.
+    _next.resize(state_count * _class_count);
+    _depth.resize(state_count);
+    _ends.resize(state_count);
+    size_t non_matching = 0;
+    for (size_t i = 0; i < state_count; ++i) {
+        const State old = order[i];
+        for (size_t c = 0; c < _class_count; ++c) {
+            _next[i * _class_count + c] = State(renum[next[old * _class_count + c]] * _class_count);
+        }
+        _depth[i] = depth[old];
+        _ends[i] = ends[old];
+        if (!matches[old]) {
+            non_matching++;
+        }
+    }
+    _match_offset = State(non_matching * _class_count);
+    _compiled = true;
+}
+
+
+//----------------------------------------------------------------------------
+// Skip bytes which cannot start a pattern.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::MultiPatternMatcher::skip(const uint8_t* data, const uint8_t* end) const
+{
+    const size_t count = _start_bytes.size();
+
+    if (count == 1) {
+        // The C library is usually the fastest for one byte value.
+        const void* p = ::memchr(data, _start_bytes[0], end - data);
+        return p == nullptr ? end : reinterpret_cast<const uint8_t*>(p);
+    }
+
+#if defined(TS_MATCHER_SSE2)
+    if (count <= MAX_SIMD_START_BYTES) {
+        __m128i starts[MAX_SIMD_START_BYTES];
+        for (size_t i = 0; i < count; ++i) {
+            starts[i] = _mm_set1_epi8(char(_start_bytes[i]));
+        }
+        for (; data + 16 <= end; data += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            __m128i found = _mm_cmpeq_epi8(block, starts[0]);
+            for (size_t i = 1; i < count; ++i) {
+                found = _mm_or_si128(found, _mm_cmpeq_epi8(block, starts[i]));
+            }
+            const int mask = _mm_movemask_epi8(found);
+            if (mask != 0) {
+                for (int bit = 0; ; ++bit) {
+                    if ((mask & (1 << bit)) != 0) {
+                        return data + bit;
+                    }
+                }
+            }
+        }
+    }
+#elif defined(TS_MATCHER_NEON)
+    if (count <= MAX_SIMD_START_BYTES) {
+        uint8x16_t starts[MAX_SIMD_START_BYTES];
+        for (size_t i = 0; i < count; ++i) {
+            starts[i] = vdupq_n_u8(_start_bytes[i]);
+        }
+        for (; data + 16 <= end; data += 16) {
+            const uint8x16_t block = vld1q_u8(data);
+            uint8x16_t found = vceqq_u8(block, starts[0]);
+            for (size_t i = 1; i < count; ++i) {
+                found = vorrq_u8(found, vceqq_u8(block, starts[i]));
+            }
+            if (vmaxvq_u8(found) != 0) {
+                uint8_t bytes[16];
+                vst1q_u8(bytes, found);
+                for (size_t k = 0; ; ++k) {
+                    if (bytes[k] != 0) {
+                        return data + k;
+                    }
+                }
+            }
+        }
+    }
+#endif
+
+    // Portable version, used for the end of the area in all versions.
+    while (data < end && !_starts[*data]) {
+        ++data;
+    }
+    return data;
+}
+
+
+//----------------------------------------------------------------------------
+// Check if any pattern is present anywhere in a memory area.
+//----------------------------------------------------------------------------
+
+bool ts::MultiPatternMatcher::search(const void* area, size_t size) const
+{
+    assert(_compiled);
+    if (area == nullptr || _patterns.empty()) {
+        return false;
+    }
+
+    // Use local copies of the tables: the searched data are bytes and the
+    // compiler would otherwise reload all table addresses at each byte.
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(area);
+    const uint8_t* const end = data + size;
+    const State* const next = _next.data();
+    const uint16_t* const classes = _classes;
+    const uint8_t* const pairs = _start_pairs.data();
+    const State match = _match_offset;
+    const bool use_skip = _start_bytes.size() <= MAX_SIMD_START_BYTES;
+    State state = 0;
+
+    while (data < end) {
+        // In the initial state, directly go to the next byte which can start a pattern.
+        // Without a pattern starting there, the automaton would go back to the initial
+        // state after the next byte anyway. Unlike the automaton steps, the checks of
+        // successive positions are independent from each other and run much faster.
+        if (state == 0) {
+            if (use_skip) {
+                data = skip(data, end);
+            }
+            else {
+                while (data + 1 < end && (pairs[data[0] << 5 | data[1] >> 3] & (1 << (data[1] & 0x07))) == 0) {
+                    ++data;
+                }
+            }
+            if (data == end) {
+                break;
+            }
+        }
+        state = next[state + classes[*data++]];
+        if (state >= match) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Check if any pattern is present at the beginning of a memory area.
+//----------------------------------------------------------------------------
+
+bool ts::MultiPatternMatcher::matchAt(const void* area, size_t size) const
+{
+    assert(_compiled);
+    if (area == nullptr || _patterns.empty()) {
+        return false;
+    }
+
+    // The automaton follows the trie as long as the depth of the state is the
+    // number of bytes read. Otherwise, the area does not start with a pattern.
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(area);
+    State state = 0;
+    for (size_t i = 0; i < size && i < _max_size; ++i) {
+        state = _next[state + _classes[data[i]]];
+        const size_t index = state / _class_count;
+        if (_depth[index] != i + 1) {
+            return false;
+        }
+        else if (_ends[index]) {
+            return true;
+        }
+    }
+    return false;
+}
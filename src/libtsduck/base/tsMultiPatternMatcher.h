@@ -0,0 +1,143 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Search any of a set of binary patterns in memory areas.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsByteBlock.h"
+
+namespace ts {
+    //!
+    //! Search any of a set of binary patterns in memory areas.
+    //! @ingroup cpp
+    //!
+    //! The patterns are compiled into a deterministic automaton (Aho-Corasick).
+    //! The search time depends on the size of the searched area only, not on
+    //! the number of patterns. Bytes which cannot start a pattern are skipped
+    //! by blocks, using SIMD instructions when available, or using a bitmap of
+    //! the pairs of bytes which start a pattern when there are too many different
+    //! start bytes.
+    //!
+    //! Typical usage: add all patterns, compile the matcher once and search
+    //! as many memory areas as necessary.
+    //!
+    class TSDUCKDLL MultiPatternMatcher
+    {
+    public:
+        //!
+        //! Default constructor.
+        //!
+        MultiPatternMatcher();
+
+        //!
+        //! Clear all patterns.
+        //!
+        void clear();
+
+        //!
+        //! Add a pattern to search.
+        //! The matcher must be compiled again before searching.
+        //! @param [in] pattern Address of the pattern.
+        //! @param [in] size Size in bytes of the pattern. Empty patterns are ignored.
+        //!
+        void addPattern(const void* pattern, size_t size);
+
+        //!
+        //! Add a pattern to search.
+        //! The matcher must be compiled again before searching.
+        //! @param [in] pattern The pattern. Empty patterns are ignored.
+        //!
+        void addPattern(const ByteBlock& pattern) { addPattern(pattern.data(), pattern.size()); }
+
+        //!
+        //! Get the number of patterns.
+        //! @return The number of patterns.
+        //!
+        size_t patternCount() const { return _patterns.size(); }
+
+        //!
+        //! Check if there is no pattern to search.
+        //! @return True if there is no pattern.
+        //!
+        bool empty() const { return _patterns.empty(); }
+
+        //!
+        //! Get the size of the largest pattern.
+        //! @return The size in bytes of the largest pattern.
+        //!
+        size_t maxPatternSize() const { return _max_size; }
+
+        //!
+        //! Compile all patterns into the search automaton.
+        //! Must be called after adding patterns and before searching.
+        //!
+        void compile();
+
+        //!
+        //! Check if any pattern is present anywhere in a memory area.
+        //! @param [in] area Address of a memory area to search.
+        //! @param [in] size Size in bytes of the memory area.
+        //! @return True if at least one pattern is found in the memory area.
+        //!
+        bool search(const void* area, size_t size) const;
+
+        //!
+        //! Check if any pattern is present at the beginning of a memory area.
+        //! @param [in] area Address of a memory area to check.
+        //! @param [in] size Size in bytes of the memory area.
+        //! @return True if at least one pattern starts at @a area.
+        //!
+        bool matchAt(const void* area, size_t size) const;
+
+    private:
+        typedef uint32_t State;
+
+        // Largest number of pattern start bytes which are skipped with SIMD instructions.
+        static constexpr size_t MAX_SIMD_START_BYTES = 8;
+
+        std::vector<ByteBlock> _patterns;     // All patterns.
+        size_t                 _max_size;     // Size of largest pattern.
+        bool                   _compiled;     // The automaton is built from all patterns.
+        size_t                 _class_count;  // Number of byte classes.
+        uint16_t               _classes[256]; // Byte class of each byte value, zero for bytes in no pattern.
+        bool                   _starts[256];  // Byte values which start a pattern.
+        ByteBlock              _start_bytes;  // List of byte values which start a pattern.
+        ByteBlock              _start_pairs;  // Bitmap of the 65536 pairs of bytes which start a pattern.
+        std::vector<State>     _next;         // Transition table, _class_count entries per state, contains offsets of states.
+        State                  _match_offset; // States with this offset and above are matching states.
+        std::vector<size_t>    _depth;        // Length of the pattern prefix of each state.
+        std::vector<bool>      _ends;         // A pattern ends exactly in this state.
+
+        // Skip bytes which cannot start a pattern. Return the address of the first byte which can, or end.
+        const uint8_t* skip(const uint8_t* data, const uint8_t* end) const;
+    };
+}
@@ -38,8 +38,66 @@
 #include "tsGuard.h"
 #include "tsMutex.h"
 #include "tsNullMutex.h"
+#include "tsAtomicRefCount.h"
 
 namespace ts {
+    //!
+    //! Internal implementation types of ts::SafePtr, depending on its thread-safety policy.
+    //! @tparam MUTEX The @a MUTEX parameter of ts::SafePtr.
+    //!
+    template <class MUTEX>
+    struct SafePtrTraits
+    {
+        //!
+        //! Type of the reference counter.
+        //!
+        typedef int RefCount;
+        //!
+        //! Type of the pointer to the object.
+        //! @tparam T The type of the pointed object.
+        //!
+        template <typename T>
+        struct Pointer
+        {
+            typedef T* type;  //!< The pointer type.
+        };
+        //!
+        //! Type of a lock guard on the mutex.
+        //!
+        typedef Guard Lock;
+    };
+
+    //!
+    //! Internal implementation types of ts::SafePtr using atomic operations.
+    //!
+    template <>
+    struct SafePtrTraits<AtomicRefCount>
+    {
+        //!
+        //! Type of the reference counter.
+        //!
+        typedef std::atomic<int> RefCount;
+        //!
+        //! Type of the pointer to the object.
+        //! @tparam T The type of the pointed object.
+        //!
+        template <typename T>
+        struct Pointer
+        {
+            typedef std::atomic<T*> type;  //!< The pointer type.
+        };
+        //!
+        //! Type of a lock guard on the mutex, does nothing.
+        //!
+        struct Lock
+        {
+            //!
+            //! Constructor.
+            //!
+            Lock(MutexInterface&) {}
+        };
+    };
+
     //!
     //!  Template safe pointer (reference-counted, auto-delete, thread-safe).
     //!  @ingroup cpp
@@ -80,7 +138,10 @@ namespace ts {
     //!  ts::NullMutex is used. The default implementation is consequently
     //!  not thread-safe but there is no synchronization overhead. To use
     //!  safe pointers in a multi-thread environment, specify an actual
-    //!  mutex implementation for the target environment.
+    //!  mutex implementation for the target environment. Alternatively, the
+    //!  lock-free policy ts::AtomicRefCount uses atomic operations instead of
+    //!  a mutex. It is the preferred policy for pointers which are exchanged
+    //!  between threads on a hot path.
     //!
     //!  @tparam T The type of the pointed object. Cannot be an array type.
     //!  @tparam MUTEX A subclass of ts::MutexInterface which is used to
@@ -474,10 +535,22 @@ namespace ts {
         {
             TS_NOBUILD_NOCOPY(SafePtrShared);
         private:
+            // Actual types depend on the thread-safety policy.
+            typedef SafePtrTraits<MUTEX> Traits;
+            typedef typename Traits::Lock Lock;
+
             // Private members:
-            T*    _ptr;        // pointer to actual object
-            int   _ref_count;  // reference counter
-            MUTEX _mutex;      // protect the SafePtrShared
+            typename Traits::template Pointer<T>::type _ptr;  // pointer to actual object
+            typename Traits::RefCount _ref_count;            // reference counter
+            MUTEX _mutex;                                     // protect the SafePtrShared
+
+            // Exchange or load the pointer, atomically when required by the policy.
+            static T* Exchange(T*& ptr, T* value) { T* previous = ptr; ptr = value; return previous; }
+            static T* Exchange(std::atomic<T*>& ptr, T* value) { return ptr.exchange(value); }
+            static T* Load(T* ptr) { return ptr; }
+            static T* Load(const std::atomic<T*>& ptr) { return ptr.load(); }
+            static bool CompareExchange(T*& ptr, T* expected, T* value) { if (ptr != expected) return false; ptr = value; return true; }
+            static bool CompareExchange(std::atomic<T*>& ptr, T* expected, T* value) { return ptr.compare_exchange_strong(expected, value); }
 
         public:
             // Constructor. Initial reference count is 1.
@@ -509,11 +582,13 @@ namespace ts {
             // Perform a class downcast (cast to a subclass).
             template <typename ST> SafePtr<ST,MUTEX> downcast()
             {
-                Guard lock(_mutex);
-                ST* sp = dynamic_cast<ST*>(_ptr);
-                if (sp != nullptr) {
-                    // Successful downcast, the original safe pointer must be released.
-                    _ptr = nullptr;
+                Lock lock(_mutex);
+                T* p = Load(_ptr);
+                ST* sp = dynamic_cast<ST*>(p);
+                if (sp != nullptr && !CompareExchange(_ptr, p, nullptr)) {
+                    // Successful downcast but the original safe pointer was concurrently
+                    // released by another thread (lock-free policy only), which now owns the object.
+                    sp = nullptr;
                 }
                 return SafePtr<ST,MUTEX>(sp);
             }
@@ -521,18 +596,16 @@ namespace ts {
             // Perform a class upcast.
             template <typename ST> SafePtr<ST,MUTEX> upcast()
             {
-                Guard lock(_mutex);
-                ST* sp = _ptr;
-                _ptr = nullptr;
+                Lock lock(_mutex);
+                ST* sp = Exchange(_ptr, nullptr);
                 return SafePtr<ST,MUTEX>(sp);
             }
 
             // Change mutex type.
             template <typename NEWMUTEX> SafePtr<T,NEWMUTEX> changeMutex()
             {
-                Guard lock(_mutex);
-                T* sp = _ptr;
-                _ptr = nullptr;
+                Lock lock(_mutex);
+                T* sp = Exchange(_ptr, nullptr);
                 return SafePtr<T,NEWMUTEX>(sp);
             }
         };
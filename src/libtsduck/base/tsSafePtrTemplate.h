@@ -91,9 +91,9 @@ ts::SafePtr<T,MUTEX>& ts::SafePtr<T,MUTEX>::operator=(T* p)
 template <typename T, class MUTEX>
 ts::SafePtr<T,MUTEX>::SafePtrShared::~SafePtrShared()
 {
-    if (_ptr != nullptr) {
-        delete _ptr;
-        _ptr = nullptr;
+    T* previous = Exchange(_ptr, nullptr);
+    if (previous != nullptr) {
+        delete previous;
     }
 }
 
@@ -106,10 +106,8 @@ ts::SafePtr<T,MUTEX>::SafePtrShared::~SafePtrShared()
 template <typename T, class MUTEX>
 T* ts::SafePtr<T,MUTEX>::SafePtrShared::release()
 {
-    Guard lock(_mutex);
-    T* previous = _ptr;
-    _ptr = nullptr;
-    return previous;
+    Lock lock(_mutex);
+    return Exchange(_ptr, nullptr);
 }
 
 
@@ -120,11 +118,11 @@ T* ts::SafePtr<T,MUTEX>::SafePtrShared::release()
 template <typename T, class MUTEX>
 void ts::SafePtr<T,MUTEX>::SafePtrShared::reset(T* p)
 {
-    Guard lock(_mutex);
-    if (_ptr != nullptr) {
-        delete _ptr;
+    Lock lock(_mutex);
+    T* previous = Exchange(_ptr, p);
+    if (previous != nullptr) {
+        delete previous;
     }
-    _ptr = p;
 }
 
 
@@ -135,8 +133,8 @@ void ts::SafePtr<T,MUTEX>::SafePtrShared::reset(T* p)
 template <typename T, class MUTEX>
 T* ts::SafePtr<T,MUTEX>::SafePtrShared::pointer()
 {
-    Guard lock(_mutex);
-    return _ptr;
+    Lock lock(_mutex);
+    return Load(_ptr);
 }
 
 
@@ -147,7 +145,7 @@ T* ts::SafePtr<T,MUTEX>::SafePtrShared::pointer()
 template <typename T, class MUTEX>
 int ts::SafePtr<T,MUTEX>::SafePtrShared::count()
 {
-    Guard lock(_mutex);
+    Lock lock(_mutex);
     return _ref_count;
 }
 
@@ -159,8 +157,8 @@ int ts::SafePtr<T,MUTEX>::SafePtrShared::count()
 template <typename T, class MUTEX>
 bool ts::SafePtr<T,MUTEX>::SafePtrShared::isNull()
 {
-    Guard lock(_mutex);
-    return _ptr == nullptr;
+    Lock lock(_mutex);
+    return Load(_ptr) == nullptr;
 }
 
 
@@ -171,7 +169,7 @@ bool ts::SafePtr<T,MUTEX>::SafePtrShared::isNull()
 template <typename T, class MUTEX>
 typename ts::SafePtr<T,MUTEX>::SafePtrShared* ts::SafePtr<T,MUTEX>::SafePtrShared::attach()
 {
-    Guard lock(_mutex);
+    Lock lock(_mutex);
     _ref_count++;
     return this;
 }
@@ -187,7 +185,7 @@ bool ts::SafePtr<T,MUTEX>::SafePtrShared::detach()
 {
     int refcount;
     {
-        Guard lock(_mutex);
+        Lock lock(_mutex);
         refcount = --_ref_count;
     }
     if (refcount == 0) {
@@ -35,6 +35,16 @@
 #include <sys/param.h>
 #include <sys/sysctl.h>
 #endif
+#if defined(TS_LINUX) && defined(TS_ARM64)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#if (defined(TS_I386) || defined(TS_X86_64)) && defined(TS_GCC)
+#include <cpuid.h>
+#elif (defined(TS_I386) || defined(TS_X86_64)) && defined(TS_MSC)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
 TSDUCK_SOURCE;
 
 // Define singleton instance
@@ -79,7 +89,10 @@ ts::SysInfo::SysInfo() :
     _systemVersion(),
     _systemName(),
     _hostName(),
-    _memoryPageSize(0)
+    _memoryPageSize(0),
+    _crcInstructions(false),
+    _avx2Instructions(false),
+    _aesInstructions(false)
 {
     //
     // Get operating system name and version.
@@ -223,5 +236,62 @@ ts::SysInfo::SysInfo() :
         _memoryPageSize = size_t(pageSize);
     }
 
+#endif
+
+    //
+    // Get CPU features.
+    //
+#if defined(TS_I386) || defined(TS_X86_64)
+
+    // Intel CPU: use CPUID leaf 1, features in ECX, and leaf 7, extended features in EBX.
+    uint32_t ecx = 0;
+    uint32_t ebx7 = 0;
+    uint64_t xcr0 = 0;
+#if defined(TS_MSC)
+    int regs[4];
+    ::__cpuid(regs, 1);
+    ecx = uint32_t(regs[2]);
+    ::__cpuidex(regs, 7, 0);
+    ebx7 = uint32_t(regs[1]);
+    if ((ecx & 0x08000000) != 0) {
+        xcr0 = ::_xgetbv(0);
+    }
+#else
+    unsigned int eax = 0, ebx = 0, edx = 0, c = 0;
+    if (::__get_cpuid(1, &eax, &ebx, &c, &edx)) {
+        ecx = c;
+    }
+    if (::__get_cpuid_count(7, 0, &eax, &ebx, &c, &edx)) {
+        ebx7 = ebx;
+    }
+    if ((ecx & 0x08000000) != 0) {
+        // OSXSAVE is set, XGETBV is available.
+        uint32_t lo = 0, hi = 0;
+        __asm__ __volatile__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+        xcr0 = (uint64_t(hi) << 32) | lo;
+    }
+#endif
+    // PCLMULQDQ is bit 1, SSSE3 is bit 9.
+    _crcInstructions = (ecx & 0x00000202) == 0x00000202;
+
+    // AVX2 is bit 5 in leaf 7. The OS must also save the XMM and YMM registers (XCR0 bits 1 and 2).
+    _avx2Instructions = (ebx7 & 0x00000020) != 0 && (xcr0 & 0x06) == 0x06;
+
+    // AES-NI is bit 25.
+    _aesInstructions = (ecx & 0x02000000) != 0;
+
+#elif defined(TS_ARM64) && defined(TS_LINUX)
+
+    // Arm CPU on Linux: use the hardware capabilities as provided by the kernel.
+    const unsigned long hwcap = ::getauxval(AT_HWCAP);
+    _crcInstructions = (hwcap & HWCAP_PMULL) != 0;
+    _aesInstructions = (hwcap & HWCAP_AES) != 0;
+
+#elif defined(TS_ARM64) && defined(TS_MAC)
+
+    // All Apple Silicon CPU's have the cryptographic extensions.
+    _crcInstructions = true;
+    _aesInstructions = true;
+
 #endif
 }
@@ -117,6 +117,23 @@ namespace ts {
         //! @return The system memory page size in bytes.
         //!
         size_t memoryPageSize() const { return _memoryPageSize; }
+        //!
+        //! Check if the CPU supports the carry-less multiplication instructions which accelerate CRC computations.
+        //! These instructions are PCLMULQDQ (with SSSE3) on Intel CPU's and PMULL on Arm CPU's.
+        //! @return True if the CPU supports carry-less multiplication instructions.
+        //!
+        bool crcInstructions() const { return _crcInstructions; }
+        //!
+        //! Check if the CPU supports the AVX2 instructions, 256-bit integer vectors on Intel CPU's.
+        //! @return True if the CPU and the operating system support AVX2 instructions.
+        //!
+        bool avx2Instructions() const { return _avx2Instructions; }
+        //!
+        //! Check if the CPU supports the AES instructions.
+        //! These instructions are AES-NI on Intel CPU's and the AES cryptographic extensions on Arm CPU's.
+        //! @return True if the CPU supports AES instructions.
+        //!
+        bool aesInstructions() const { return _aesInstructions; }
 
     private:
         bool    _isLinux;
@@ -133,5 +150,8 @@ namespace ts {
         UString _systemName;
         UString _hostName;
         size_t  _memoryPageSize;
+        bool    _crcInstructions;
+        bool    _avx2Instructions;
+        bool    _aesInstructions;
     };
 }
@@ -43,6 +43,7 @@ ts::TextFormatter::TextFormatter(Report& report) :
     _out(&_outFile), // _out is never null, points by default to a closed file (discard output)
     _margin(0),
     _indent(2),
+    _eolMode(EndOfLineMode::NATURAL),
     _curMargin(_margin),
     _tabSize(8),
     _column(0),
@@ -198,6 +199,13 @@ bool ts::TextFormatter::writeStreamBuffer(const void* addr, size_t size)
                 *_out << ' ';
             }
         }
+        else if ((*p == '\r' || *p == '\n') && _eolMode != EndOfLineMode::NATURAL) {
+            // One-line mode, CR are ignored, LF are replaced by one space or removed.
+            if (*p == '\n' && _eolMode == EndOfLineMode::SPACING) {
+                *_out << ' ';
+                ++_column;
+            }
+        }
         else if (*p == '\r' || *p == '\n') {
             // CR and LF indifferently move back to begining of current/next line.
             *_out << *p;
@@ -223,6 +231,12 @@ ts::TextFormatter& ts::TextFormatter::margin()
     // Flush pending output.
     flush();
 
+    // There is no margin in one-line mode.
+    if (_eolMode != EndOfLineMode::NATURAL) {
+        _afterSpace = false;
+        return *this;
+    }
+
     // New line if we are farther than the margin.
     // Also new line when we are no longer in the margin ("after space")
     // even if we do not exceed the margin size.
@@ -247,8 +261,11 @@ ts::TextFormatter& ts::TextFormatter::column(size_t col)
     // Flush pending output.
     flush();
 
-    // New line if we are farther than the target col.
-    if (_column > col) {
+    // New line if we are farther than the target col (just stay there in one-line mode).
+    if (_column > col && _eolMode != EndOfLineMode::NATURAL) {
+        return *this;
+    }
+    else if (_column > col) {
         *_out << std::endl;
         _column = 0;
         _afterSpace = false;
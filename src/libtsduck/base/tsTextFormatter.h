@@ -88,6 +88,30 @@ namespace ts {
         //!
         TextFormatter& setIndentSize(size_t indent) { _indent = indent; return *this; }
 
+        //!
+        //! End of line mode.
+        //!
+        enum class EndOfLineMode {
+            NATURAL,  //!< Natural end of lines, the default.
+            SPACING,  //!< End of lines are replaced by one space, the text is formatted on one line.
+            NONE,     //!< End of lines are removed, the text is formatted on one line.
+        };
+
+        //!
+        //! Get the end of line mode.
+        //! @return The end of line mode.
+        //!
+        EndOfLineMode endOfLineMode() const { return _eolMode; }
+
+        //!
+        //! Set the end of line mode.
+        //! With a mode other than NATURAL, margins are ignored and the formatted
+        //! document is written on one single line, as in JSON Lines for instance.
+        //! @param [in] mode The end of line mode.
+        //! @return A reference to this object.
+        //!
+        TextFormatter& setEndOfLineMode(EndOfLineMode mode) { _eolMode = mode; return *this; }
+
         //!
         //! Set output to an open text stream.
         //! @param [in,out] strm The output text stream.
@@ -198,6 +222,7 @@ namespace ts {
         std::ostream*      _out;         // Address of current output stream.
         size_t             _margin;      // Margin size for outer-most element.
         size_t             _indent;      // Indent size for inner elements.
+        EndOfLineMode      _eolMode;     // End of line mode.
         size_t             _curMargin;   // Current margin size.
         size_t             _tabSize;     // Tabulation size in characters.
         size_t             _column;      // Current column in line, starting at 0.
@@ -80,8 +80,11 @@ namespace ts {
         //! Load the document to parse from a list of lines.
         //! @param [in] lines Reference to a list of text lines forming the document.
         //! The lifetime of the referenced list must equals or exceeds the lifetime of the parser.
+        //! @param [in] firstLineNumber Line number of the first line in @a lines. This is useful
+        //! when @a lines is an extract of a larger document and error messages shall reference
+        //! line numbers in the larger document.
         //!
-        void loadDocument(const UStringList& lines);
+        void loadDocument(const UStringList& lines, size_t firstLineNumber = 1);
 
         //!
         //! Load the document to parse.
@@ -142,7 +145,7 @@ namespace ts {
         private:
             // Constructors.
             Position() = delete;
-            Position(const UStringList&);
+            Position(const UStringList&, size_t firstLineNumber = 1);
 
             // Everything is private to the application.
             // Only TextParser can use it.
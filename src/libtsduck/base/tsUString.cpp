@@ -38,6 +38,15 @@
 #include "tsSysUtils.h"
 TSDUCK_SOURCE;
 
+// SIMD instructions for the ASCII fast paths of the UTF-8 conversions.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define TS_UTF8_SSE2 1
+    #include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+    #define TS_UTF8_NEON 1
+    #include <arm_neon.h>
+#endif
+
 // The UTF-8 Byte Order Mark
 const char* const ts::UString::UTF8_BOM = "\xEF\xBB\xBF";
 
@@ -89,6 +98,110 @@ const ::WCHAR* ts::UString::wc_str() const
 #endif
 
 
+//----------------------------------------------------------------------------
+// ASCII fast paths for the UTF-8 conversions.
+// Most strings are mainly ASCII (XML, JSON, reports). ASCII characters are
+// converted by blocks, using SIMD instructions when available. Each function
+// converts the leading ASCII characters of a buffer with 'count' characters
+// and returns the number of converted characters. When a block contains some
+// non-ASCII character, the full block may be written in the output buffer but
+// only the leading ASCII characters are accounted.
+//----------------------------------------------------------------------------
+
+namespace {
+
+#if defined(TS_UTF8_SSE2) || defined(TS_UTF8_NEON)
+    const size_t ASCII_BLOCK = 16;
+#else
+    const size_t ASCII_BLOCK = 8;
+#endif
+
+    // Convert the leading ASCII characters of a block, when the block is not all ASCII.
+    template <typename CHAR1, typename CHAR2>
+    inline size_t ASCIIPrefix(const CHAR1* in, CHAR2* out)
+    {
+        size_t n = 0;
+        while (n < ASCII_BLOCK && (in[n] & ~CHAR1(0x7F)) == 0) {
+            out[n] = CHAR2(in[n]);
+            n++;
+        }
+        return n;
+    }
+
+    // From ASCII in UTF-8 to UTF-16.
+    inline size_t ASCIIToUTF16(const char* in, size_t count, ts::UChar* out)
+    {
+        size_t done = 0;
+        while (done + ASCII_BLOCK <= count) {
+#if defined(TS_UTF8_SSE2)
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+            const __m128i zero = _mm_setzero_si128();
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done + 8), _mm_unpackhi_epi8(bytes, zero));
+            const bool ascii = _mm_movemask_epi8(bytes) == 0;
+#elif defined(TS_UTF8_NEON)
+            const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(in + done));
+            vst1q_u16(reinterpret_cast<uint16_t*>(out + done), vmovl_u8(vget_low_u8(bytes)));
+            vst1q_u16(reinterpret_cast<uint16_t*>(out + done + 8), vmovl_u8(vget_high_u8(bytes)));
+            const bool ascii = vmaxvq_u8(bytes) < 0x80;
+#else
+            uint64_t bytes = 0;
+            ::memcpy(&bytes, in + done, sizeof(bytes));
+            const bool ascii = (bytes & TS_UCONST64(0x8080808080808080)) == 0;
+            if (ascii) {
+                for (size_t i = 0; i < ASCII_BLOCK; ++i) {
+                    out[done + i] = ts::UChar(uint8_t(in[done + i]));
+                }
+            }
+#endif
+            if (!ascii) {
+                return done + ASCIIPrefix(in + done, out + done);
+            }
+            done += ASCII_BLOCK;
+        }
+        return done;
+    }
+
+    // From ASCII in UTF-16 to UTF-8.
+    inline size_t ASCIIFromUTF16(const ts::UChar* in, size_t count, char* out)
+    {
+        size_t done = 0;
+        while (done + ASCII_BLOCK <= count) {
+#if defined(TS_UTF8_SSE2)
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done + 8));
+            const __m128i nonascii = _mm_and_si128(_mm_or_si128(low, high), _mm_set1_epi16(int16_t(0xFF80)));
+            const bool ascii = _mm_movemask_epi8(_mm_cmpeq_epi16(nonascii, _mm_setzero_si128())) == 0xFFFF;
+            if (ascii) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), _mm_packus_epi16(low, high));
+            }
+#elif defined(TS_UTF8_NEON)
+            const uint16x8_t low = vld1q_u16(reinterpret_cast<const uint16_t*>(in + done));
+            const uint16x8_t high = vld1q_u16(reinterpret_cast<const uint16_t*>(in + done + 8));
+            const bool ascii = vmaxvq_u16(vorrq_u16(low, high)) < 0x80;
+            if (ascii) {
+                vst1q_u8(reinterpret_cast<uint8_t*>(out + done), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+            }
+#else
+            uint64_t words[2] = {0, 0};
+            ::memcpy(words, in + done, sizeof(words));
+            const bool ascii = ((words[0] | words[1]) & TS_UCONST64(0xFF80FF80FF80FF80)) == 0;
+            if (ascii) {
+                for (size_t i = 0; i < ASCII_BLOCK; ++i) {
+                    out[done + i] = char(in[done + i]);
+                }
+            }
+#endif
+            if (!ascii) {
+                return done + ASCIIPrefix(in + done, out + done);
+            }
+            done += ASCII_BLOCK;
+        }
+        return done;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // General routine to convert from UTF-16 to UTF-8.
 //----------------------------------------------------------------------------
@@ -100,6 +213,17 @@ void ts::UString::ConvertUTF16ToUTF8(const UChar*& inStart, const UChar* inEnd,
 
     while (inStart < inEnd && outStart < outEnd) {
 
+        // Fast path for sequences of ASCII characters. Isolated ASCII characters,
+        // such as spaces in non-latin texts, are processed one by one.
+        if (inStart + 1 < inEnd && ((inStart[0] | inStart[1]) & 0xFF80) == 0) {
+            const size_t ascii = ASCIIFromUTF16(inStart, std::min<size_t>(inEnd - inStart, outEnd - outStart), outStart);
+            inStart += ascii;
+            outStart += ascii;
+            if (inStart >= inEnd || outStart >= outEnd) {
+                break;
+            }
+        }
+
         // Get current code point as 16-bit value.
         code = *inStart++;
 
@@ -211,6 +335,17 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UC
 
     while (inStart < inEnd && outStart < outEnd) {
 
+        // Fast path for sequences of ASCII characters. Isolated ASCII characters,
+        // such as spaces in non-latin texts, are processed one by one.
+        if (inStart + 1 < inEnd && ((inStart[0] | inStart[1]) & 0x80) == 0) {
+            const size_t ascii = ASCIIToUTF16(inStart, std::min<size_t>(inEnd - inStart, outEnd - outStart), outStart);
+            inStart += ascii;
+            outStart += ascii;
+            if (inStart >= inEnd || outStart >= outEnd) {
+                break;
+            }
+        }
+
         // Get current code point at 8-bit value.
         code = *inStart++ & 0xFF;
 
@@ -62,9 +62,10 @@ const ts::xml::Tweaks& ts::xml::Document::tweaks() const
 // Parse an XML document.
 //----------------------------------------------------------------------------
 
-bool ts::xml::Document::parse(const UStringList& lines)
+bool ts::xml::Document::parse(const UStringList& lines, size_t firstLineNumber)
 {
-    TextParser parser(lines, _report);
+    TextParser parser(_report);
+    parser.loadDocument(lines, firstLineNumber);
     return parseNode(parser, nullptr);
 }
 
@@ -0,0 +1,474 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlStreamReader.h"
+#include "tsxmlElement.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::xml::StreamReader::StreamReader(Report& report) :
+    _report(report),
+    _phase(CLOSED),
+    _error(false),
+    _file(),
+    _input(nullptr),
+    _text(),
+    _textNext(_text.end()),
+    _line(),
+    _lineNumber(0),
+    _index(0),
+    _capture(nullptr),
+    _captureStart(0),
+    _rootName(),
+    _doc(report)
+{
+}
+
+ts::xml::StreamReader::~StreamReader()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Open or close the input document.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamReader::open(const UString& fileName)
+{
+    close();
+    _file.open(fileName.toUTF8().c_str());
+    if (!_file) {
+        _report.error(u"error reading file %s", {fileName});
+        _error = true;
+        return false;
+    }
+    _input = &_file;
+    return start();
+}
+
+bool ts::xml::StreamReader::open(std::istream& strm)
+{
+    close();
+    _input = &strm;
+    return start();
+}
+
+bool ts::xml::StreamReader::openText(const UString& text)
+{
+    close();
+    text.toSubstituted(u"\r", UString()).split(_text, u'\n', false);
+    _textNext = _text.begin();
+    return start();
+}
+
+void ts::xml::StreamReader::close()
+{
+    if (_file.is_open()) {
+        _file.close();
+    }
+    _file.clear();
+    _input = nullptr;
+    _text.clear();
+    _textNext = _text.end();
+    _phase = CLOSED;
+    _error = false;
+    _line.clear();
+    _lineNumber = 0;
+    _index = 0;
+    _capture = nullptr;
+    _captureStart = 0;
+    _rootName.clear();
+    _doc.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Read the prolog of the document, up to the start tag of the root element.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamReader::start()
+{
+    // The prolog is collected up to the end of the start tag of the root element.
+    UStringList prolog;
+    bool found = false;
+    bool empty = false;
+
+    if (nextLine()) {
+        startCapture(prolog);
+        bool nonSpace = false;
+        Markup kind = MK_OTHER;
+        while (!found && skipText(&nonSpace)) {
+            // Name of the element, if this is a start tag. An XML name cannot span lines.
+            size_t end = _index + 1;
+            while (end < _line.length() && !IsSpace(_line[end]) && _line[end] != u'/' && _line[end] != u'>') {
+                end++;
+            }
+            const UString name(_line.substr(_index + 1, end - _index - 1));
+            if (!skipMarkup(kind)) {
+                break;
+            }
+            if (kind == MK_START || kind == MK_EMPTY) {
+                // End of the start tag of the root element.
+                found = true;
+                empty = kind == MK_EMPTY;
+                _rootName = name;
+                stopCapture();
+            }
+            else if (kind == MK_END || kind == MK_CDATA) {
+                // Invalid document, let the XML parser report the error.
+                break;
+            }
+        }
+    }
+    if (_capture != nullptr) {
+        // Invalid document, collect the rest of the current line for the XML parser.
+        _index = _line.length();
+        stopCapture();
+    }
+
+    // When the root element is not empty, temporarily close it.
+    if (found && !empty) {
+        prolog.back().append(u"</" + _rootName + u">");
+    }
+
+    // Parse the prolog as a regular document. Errors, including the absence of root, are reported by the parser.
+    if (!_doc.parse(prolog)) {
+        _error = true;
+        return false;
+    }
+
+    _phase = empty ? DONE : CONTENT;
+    if (empty) {
+        readTrailer();
+    }
+    return !_error;
+}
+
+
+//----------------------------------------------------------------------------
+// Read the next child element of the root.
+//----------------------------------------------------------------------------
+
+const ts::xml::Element* ts::xml::StreamReader::next()
+{
+    // Release previous element.
+    _doc.clear();
+
+    if (_phase != CONTENT || _error) {
+        return nullptr;
+    }
+
+    // Locate the start tag of the next child element, skipping text and comments.
+    UStringList lines;
+    size_t firstLine = 0;
+    Markup kind = MK_OTHER;
+    do {
+        if (!skipText()) {
+            _report.error(u"line %d: unexpected end of XML document, missing </%s>", {_lineNumber, _rootName});
+            _error = true;
+            return nullptr;
+        }
+        firstLine = _lineNumber;
+        startCapture(lines);
+        if (!skipMarkup(kind)) {
+            _report.error(u"line %d: unexpected end of XML document, missing </%s>", {_lineNumber, _rootName});
+            _error = true;
+            return nullptr;
+        }
+        if (kind == MK_END) {
+            // End tag of the root element.
+            _capture = nullptr;
+            _phase = DONE;
+            readTrailer();
+            return nullptr;
+        }
+    } while (kind != MK_START && kind != MK_EMPTY);
+
+    // Skip the content of the child element, up to its end tag.
+    size_t depth = kind == MK_START ? 1 : 0;
+    while (depth > 0) {
+        if (!skipText() || !skipMarkup(kind)) {
+            _report.error(u"line %d: unexpected end of XML document, unterminated element at line %d", {_lineNumber, firstLine});
+            _error = true;
+            return nullptr;
+        }
+        if (kind == MK_START) {
+            depth++;
+        }
+        else if (kind == MK_END) {
+            depth--;
+        }
+    }
+    stopCapture();
+
+    // Enclose the element text inside the root element and parse it.
+    // The root start tag is on the same line as the start of the element to keep line numbers.
+    lines.front().insert(0, u"<" + _rootName + u">");
+    lines.back().append(u"</" + _rootName + u">");
+    if (!_doc.parse(lines, firstLine)) {
+        _error = true;
+        return nullptr;
+    }
+
+    const Element* root = _doc.rootElement();
+    return root == nullptr ? nullptr : root->firstChildElement();
+}
+
+
+//----------------------------------------------------------------------------
+// Read up to the end of the document, after the end tag of the root element.
+//----------------------------------------------------------------------------
+
+void ts::xml::StreamReader::readTrailer()
+{
+    bool nonSpace = false;
+    Markup kind = MK_OTHER;
+    size_t line = _lineNumber;
+
+    // Only comments are allowed after the root element.
+    while (skipText(&nonSpace) && !nonSpace) {
+        line = _lineNumber;
+        if (!skipMarkup(kind) || kind != MK_COMMENT) {
+            break;
+        }
+    }
+    if (nonSpace || (kind != MK_COMMENT && kind != MK_OTHER)) {
+        _report.error(u"line %d: trailing %s, invalid XML document, need one single root element", {line, nonSpace ? u"Text" : u"Element"});
+        _error = true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Read the next line in the input document.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamReader::nextLine()
+{
+    // Collect the rest of the current line.
+    if (_capture != nullptr && _lineNumber > 0) {
+        _capture->push_back(_line.substr(_captureStart));
+        _captureStart = 0;
+    }
+
+    _index = 0;
+    if (_input != nullptr) {
+        if (!_line.getLine(*_input)) {
+            if (!_input->eof()) {
+                _report.error(u"error reading input document");
+                _error = true;
+            }
+            return false;
+        }
+    }
+    else if (_textNext != _text.end()) {
+        _line = *_textNext++;
+    }
+    else {
+        _line.clear();
+        return false;
+    }
+    _lineNumber++;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Collect text from the current index in the current line.
+//----------------------------------------------------------------------------
+
+void ts::xml::StreamReader::startCapture(UStringList& lines)
+{
+    lines.clear();
+    _capture = &lines;
+    _captureStart = _index;
+}
+
+void ts::xml::StreamReader::stopCapture()
+{
+    if (_capture != nullptr) {
+        _capture->push_back(_line.substr(_captureStart, _index - _captureStart));
+        _capture = nullptr;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Skip text up to the next '<'.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamReader::skipText(bool* nonSpace)
+{
+    for (;;) {
+        const size_t end = std::min(_line.find(u'<', _index), _line.length());
+        if (nonSpace != nullptr) {
+            while (!*nonSpace && _index < end) {
+                *nonSpace = !IsSpace(_line[_index++]);
+            }
+        }
+        _index = end;
+        if (_index < _line.length()) {
+            return true;
+        }
+        if (!nextLine()) {
+            return false;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Skip up to the end of a given token.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamReader::skipPast(const UString& token)
+{
+    for (;;) {
+        const size_t pos = _line.find(token, _index);
+        if (pos != NPOS) {
+            _index = pos + token.length();
+            return true;
+        }
+        if (!nextLine()) {
+            return false;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Skip the markup at the current index.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamReader::skipMarkup(Markup& kind)
+{
+    assert(_index < _line.length() && _line[_index] == u'<');
+
+    if (_line.compare(_index, 4, u"<!--") == 0) {
+        kind = MK_COMMENT;
+        _index += 4;
+        return skipPast(u"-->");
+    }
+    else if (_line.compare(_index, 9, u"<![CDATA[") == 0) {
+        kind = MK_CDATA;
+        _index += 9;
+        return skipPast(u"]]>");
+    }
+    else if (_line.compare(_index, 2, u"<!") == 0) {
+        kind = MK_OTHER;
+        _index += 2;
+        return skipDeclaration();
+    }
+    else if (_line.compare(_index, 2, u"<?") == 0) {
+        kind = MK_OTHER;
+        _index += 2;
+        return skipPast(u"?>");
+    }
+    else {
+        bool empty = false;
+        const bool end = _line.compare(_index, 2, u"</") == 0;
+        _index += end ? 2 : 1;
+        if (!skipTag(empty)) {
+            return false;
+        }
+        kind = end ? MK_END : (empty ? MK_EMPTY : MK_START);
+        return true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Skip a tag or a DTD up to the final '>'.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamReader::skipTag(bool& empty)
+{
+    UChar quote = CHAR_NULL;
+    for (;;) {
+        while (_index < _line.length()) {
+            // Locate the end of the quoted string or the next significant character.
+            const size_t pos = quote != CHAR_NULL ? _line.find(quote, _index) : _line.find_first_of(u"\"'>", _index);
+            if (pos == NPOS) {
+                _index = _line.length();
+            }
+            else if (quote != CHAR_NULL) {
+                quote = CHAR_NULL;
+                _index = pos + 1;
+            }
+            else if (_line[pos] == u'>') {
+                empty = pos > 0 && _line[pos - 1] == u'/';
+                _index = pos + 1;
+                return true;
+            }
+            else {
+                quote = _line[pos];
+                _index = pos + 1;
+            }
+        }
+        if (!nextLine()) {
+            return false;
+        }
+    }
+}
+
+bool ts::xml::StreamReader::skipDeclaration()
+{
+    UChar quote = CHAR_NULL;
+    size_t brackets = 0;
+    for (;;) {
+        while (_index < _line.length()) {
+            const UChar c = _line[_index++];
+            if (quote != CHAR_NULL) {
+                if (c == quote) {
+                    quote = CHAR_NULL;
+                }
+            }
+            else if (c == u'"' || c == u'\'') {
+                quote = c;
+            }
+            else if (c == u'[') {
+                brackets++;
+            }
+            else if (c == u']' && brackets > 0) {
+                brackets--;
+            }
+            else if (c == u'>' && brackets == 0) {
+                return true;
+            }
+        }
+        if (!nextLine()) {
+            return false;
+        }
+    }
+}
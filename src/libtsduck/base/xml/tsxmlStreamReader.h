@@ -0,0 +1,203 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Streaming reader of the top-level elements of an XML document.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsxmlDocument.h"
+
+namespace ts {
+    namespace xml {
+        //!
+        //! Streaming reader of the top-level elements of an XML document.
+        //! @ingroup xml
+        //!
+        //! Some XML documents, such as TSDuck section files, are made of a root
+        //! element containing a long list of independent elements. Loading such
+        //! a document in memory as one xml::Document may be expensive when the
+        //! file is huge.
+        //!
+        //! This class reads the document sequentially and builds one child of the
+        //! root element at a time. The application pulls the children one by one
+        //! using next(). The previous child is released each time next() is called.
+        //! Only the text of the current child element is kept in memory.
+        //!
+        //! Each child element is returned inside a small xml::Document which
+        //! contains a copy of the root element (without attributes) and the child
+        //! element. This document can be validated against a model using
+        //! xml::Document::validate(). The line numbers of the nodes are the line
+        //! numbers in the complete input document.
+        //!
+        class TSDUCKDLL StreamReader
+        {
+            TS_NOCOPY(StreamReader);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in,out] report Where to report errors.
+            //!
+            explicit StreamReader(Report& report = NULLREP);
+
+            //!
+            //! Destructor.
+            //!
+            ~StreamReader();
+
+            //!
+            //! Set the global XML parsing and formatting tweaks for the documents which are built.
+            //! @param [in] tw The new global XML tweaks.
+            //!
+            void setTweaks(const Tweaks& tw) { _doc.setTweaks(tw); }
+
+            //!
+            //! Open an XML file and read its prolog, up to the start tag of the root element.
+            //! @param [in] fileName Name of the XML file to read.
+            //! @return True on success, false on error.
+            //!
+            bool open(const UString& fileName);
+
+            //!
+            //! Start reading an XML document from a text stream and read its prolog, up to the start tag of the root element.
+            //! @param [in,out] strm A standard text stream in input mode. The lifetime of the stream
+            //! must equal or exceed the time the document is read.
+            //! @return True on success, false on error.
+            //!
+            bool open(std::istream& strm);
+
+            //!
+            //! Start reading an XML document from a string and read its prolog, up to the start tag of the root element.
+            //! @param [in] text The XML document.
+            //! @return True on success, false on error.
+            //!
+            bool openText(const UString& text);
+
+            //!
+            //! Close the document and release all resources.
+            //!
+            void close();
+
+            //!
+            //! Get the current document.
+            //!
+            //! After open(), this document contains the prolog of the input document
+            //! and its root element, with all attributes but without children.
+            //!
+            //! After next(), this document contains a root element without attributes
+            //! and the child element which was returned by next().
+            //!
+            //! @return A constant reference to the current document.
+            //!
+            const Document& document() const { return _doc; }
+
+            //!
+            //! Read the next child element of the root.
+            //! The previous child element is released.
+            //! @return The next child element of the root or a null pointer at end of
+            //! document or on error. The returned element remains valid until the next
+            //! call to next() or close().
+            //!
+            const Element* next();
+
+            //!
+            //! Check if an error was found in the input document.
+            //! @return True if an error was found in the input document.
+            //!
+            bool error() const { return _error; }
+
+            //!
+            //! Get the report for errors.
+            //! @return A reference to the report for errors.
+            //!
+            Report& report() const { return _report; }
+
+        private:
+            // Reading phases in the input document.
+            enum Phase {
+                CLOSED,    // No open document.
+                CONTENT,   // Reading the children of the root element.
+                DONE,      // After the end tag of the root element.
+            };
+
+            // Kinds of markup in the input document.
+            enum Markup {
+                MK_COMMENT,  // <!-- ... -->
+                MK_CDATA,    // <![CDATA[ ... ]]>
+                MK_OTHER,    // <?...?> or <!DOCTYPE ...>
+                MK_START,    // <name ...>
+                MK_EMPTY,    // <name .../>
+                MK_END,      // </name>
+            };
+
+            Report&                     _report;       // Where to report errors.
+            Phase                       _phase;        // Current phase in the input document.
+            bool                        _error;        // An error was found.
+            std::ifstream               _file;         // Input file, when the document is read from a file.
+            std::istream*               _input;        // Input stream, null when the document is read from a string.
+            UStringList                 _text;         // All text lines, when the document is read from a string.
+            UStringList::const_iterator _textNext;     // Next line in _text.
+            UString                     _line;         // Current input line.
+            size_t                      _lineNumber;   // Line number of _line, zero before first line.
+            size_t                      _index;        // Index of next character to analyze in _line.
+            UStringList*                _capture;      // When not null, collect the text which is read.
+            size_t                      _captureStart; // Index in _line of the first character to collect.
+            UString                     _rootName;     // Name of root element.
+            Document                    _doc;          // Current document.
+
+            // Start reading the document, once the input is set.
+            bool start();
+
+            // Read the next line in the input document. Return false at end of document.
+            bool nextLine();
+
+            // Collect text from the current index in the current line.
+            void startCapture(UStringList& lines);
+            void stopCapture();
+
+            // Skip text up to the next '<'. Return false at end of document.
+            // When nonSpace is not null, set *nonSpace to true if non-space characters were found.
+            bool skipText(bool* nonSpace = nullptr);
+
+            // Skip up to the end of a given token. Return false at end of document.
+            bool skipPast(const UString& token);
+
+            // Skip the markup at the current index, which must be a '<'. Return false at end of document.
+            bool skipMarkup(Markup& kind);
+
+            // Skip a tag or a DTD up to the final '>', taking quotes (and brackets in DTD) into account.
+            bool skipTag(bool& empty);
+            bool skipDeclaration();
+
+            // Read up to the end of the document, after the end tag of the root element.
+            void readTrailer();
+        };
+    }
+}
@@ -0,0 +1,59 @@
+//-----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-----------------------------------------------------------------------------
+//
+//  Bitsliced DVB-CSA2 stream cipher using AVX2 instructions.
+//
+//  This module is compiled with AVX2 instructions enabled (see the makefile).
+//  Its code shall be called only when the CPU supports AVX2. Do not use any
+//  external inline function here, it could be merged by the linker with
+//  versions from other modules which must run without AVX2.
+//
+//----------------------------------------------------------------------------
+
+#include "tsDVBCSA2Bitslice.h"
+TSDUCK_SOURCE;
+
+#if defined(TS_GCC) && defined(__AVX2__)
+
+namespace {
+    typedef uint64_t Word256 __attribute__((vector_size(32)));
+
+    void KeystreamAVX2(const uint8_t* key, const uint8_t* const* init, uint8_t* const* out, size_t count, size_t nblocks)
+    {
+        CSA2BitslicedStream<Word256>::Keystream(key, init, out, count, nblocks);
+    }
+}
+
+const ts::DVBCSA2KeystreamFunction ts::DVBCSA2KeystreamAVX2 = KeystreamAVX2;
+
+#else
+
+const ts::DVBCSA2KeystreamFunction ts::DVBCSA2KeystreamAVX2 = nullptr;
+
+#endif
@@ -0,0 +1,370 @@
+//-----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Bitsliced implementation of the DVB-CSA2 stream cipher (internal use only).
+//!
+//!  The stream cipher of many packets using the same control word is computed
+//!  in parallel. Each bit of the cipher state is a word of type @a WORD and
+//!  each bit of the word belongs to a distinct packet ("lane"). The type @a WORD
+//!  can be any integer or compiler vector type with bitwise operators.
+//!
+//!  Warning: this header is included in modules which are compiled with
+//!  specific instruction sets. All its code is declared in an anonymous
+//!  namespace to avoid the merge of inline functions by the linker.
+//!
+//-----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    //!
+    //! Profile of a bitsliced DVB-CSA2 keystream generator.
+    //! @param [in] key Address of the 8-byte control word, after entropy reduction if necessary.
+    //! @param [in] init Array of @a count addresses of the 8-byte blocks which initialize the stream cipher.
+    //! @param [out] out Array of @a count addresses of output buffers, each receiving 8 * @a nblocks bytes of keystream.
+    //! @param [in] count Number of packets, up to the number of lanes of the generator.
+    //! @param [in] nblocks Number of 8-byte keystream blocks to generate.
+    //!
+    typedef void (*DVBCSA2KeystreamFunction)(const uint8_t* key, const uint8_t* const* init, uint8_t* const* out, size_t count, size_t nblocks);
+
+    //!
+    //! Keystream generator using 256-bit AVX2 registers.
+    //! Defined in a separate module which is compiled with AVX2 instructions.
+    //! Null pointer when AVX2 instructions could not be compiled on this platform.
+    //! Shall be used only when SysInfo reports AVX2 support.
+    //!
+    extern const DVBCSA2KeystreamFunction DVBCSA2KeystreamAVX2;
+
+    //!
+    //! Number of parallel packets in DVBCSA2KeystreamAVX2.
+    //!
+    constexpr size_t DVBCSA2_AVX2_LANES = 256;
+}
+
+#if !defined(DOXYGEN)
+namespace {
+
+    //------------------------------------------------------------------------
+    // Bitsliced evaluation of a boolean function from its truth table.
+    // TT is the truth table of a function with N inputs. Bit i of TT is the
+    // result of the function for the input value i. The input bits are in
+    // x[0] (least significant) to x[N-1] (most significant). The evaluation
+    // is a tree of multiplexers where all constants are folded at compile time.
+    //------------------------------------------------------------------------
+
+    template <typename WORD, uint32_t TT, int N>
+    struct CSA2TruthTable
+    {
+        static inline WORD Eval(const WORD* x)
+        {
+            // Select between the lower half of the truth table (x[N-1] == 0) and the upper half (x[N-1] == 1).
+            const WORD lo = CSA2TruthTable<WORD, TT & ((uint32_t(1) << (1 << (N-1))) - 1), N-1>::Eval(x);
+            const WORD hi = CSA2TruthTable<WORD, (TT >> (1 << (N-1))) & ((uint32_t(1) << (1 << (N-1))) - 1), N-1>::Eval(x);
+            return lo ^ (x[N-1] & (lo ^ hi));
+        }
+    };
+
+    template <typename WORD, uint32_t TT>
+    struct CSA2TruthTable<WORD, TT, 1>
+    {
+        static inline WORD Eval(const WORD* x)
+        {
+            switch (TT & 3) {
+                case 0: return WORD();   // constant 0
+                case 1: return ~x[0];    // 1 when x[0] == 0
+                case 2: return x[0];     // 1 when x[0] == 1
+                default: return ~WORD(); // constant 1
+            }
+        }
+    };
+
+    //------------------------------------------------------------------------
+    // Bitsliced DVB-CSA2 stream cipher, same algorithm as the scalar version
+    // in DVBCSA2::StreamCipher, one bit of each WORD per packet.
+    //------------------------------------------------------------------------
+
+    template <typename WORD>
+    class CSA2BitslicedStream
+    {
+    public:
+        // Number of packets which are processed in parallel.
+        static constexpr size_t LANES = 8 * sizeof(WORD);
+
+        // Implementation of DVBCSA2KeystreamFunction.
+        static void Keystream(const uint8_t* key, const uint8_t* const* init, uint8_t* const* out, size_t count, size_t nblocks);
+
+    private:
+        // Number of 64-bit chunks in a WORD.
+        static constexpr size_t CHUNKS = sizeof(WORD) / 8;
+
+        // Cipher state, 107 bits. Each register is an array of bits, index 0 is the least significant bit.
+        struct State {
+            WORD A[11][4];  // A[1]..A[10], index 0 unused.
+            WORD B[11][4];  // B[1]..B[10], index 0 unused.
+            WORD X[4];
+            WORD Y[4];
+            WORD Z[4];
+            WORD D[4];
+            WORD E[4];
+            WORD F[4];
+            WORD p;
+            WORD q;
+            WORD r;
+        };
+
+        // Initialize the state from a control word, identical in all lanes.
+        static void InitState(State& st, const uint8_t* key);
+
+        // One clock of the cipher, producing two output bits. When INIT is true, ina and inb are the
+        // input nibbles for registers A and B. Otherwise, they are ignored.
+        template <bool INIT>
+        static void Clock(State& st, const WORD* ina, const WORD* inb, WORD& out_hi, WORD& out_lo);
+
+        // Transpose lanes of bytes into bitsliced words and the reverse.
+        // For byte i of a lane, bits[8*i+k] contains bit k of all lanes.
+        static void LoadBits(WORD* bits, const uint8_t* const* bytes, size_t count, size_t size);
+        static void StoreBits(const WORD* bits, uint8_t* const* bytes, size_t offset, size_t count, size_t size);
+    };
+
+    //------------------------------------------------------------------------
+    // Initialize the state from a control word, identical in all lanes.
+    //------------------------------------------------------------------------
+
+    template <typename WORD>
+    void CSA2BitslicedStream<WORD>::InitState(State& st, const uint8_t* key)
+    {
+        const WORD zero = WORD();
+        const WORD ones = ~zero;
+
+        // Load first 32 bits of key into A[1]..A[8] and last 32 bits of key into B[1]..B[8].
+        // All other registers are zero.
+        for (size_t i = 0; i < 8; ++i) {
+            const uint8_t a = uint8_t(i % 2 == 0 ? key[i / 2] >> 4 : key[i / 2]);
+            const uint8_t b = uint8_t(i % 2 == 0 ? key[4 + i / 2] >> 4 : key[4 + i / 2]);
+            for (size_t k = 0; k < 4; ++k) {
+                st.A[1 + i][k] = (a >> k) & 1 ? ones : zero;
+                st.B[1 + i][k] = (b >> k) & 1 ? ones : zero;
+            }
+        }
+        for (size_t k = 0; k < 4; ++k) {
+            st.A[0][k] = st.A[9][k] = st.A[10][k] = zero;
+            st.B[0][k] = st.B[9][k] = st.B[10][k] = zero;
+            st.X[k] = st.Y[k] = st.Z[k] = st.D[k] = st.E[k] = st.F[k] = zero;
+        }
+        st.p = st.q = st.r = zero;
+    }
+
+    //------------------------------------------------------------------------
+    // One clock of the cipher, producing two output bits.
+    //------------------------------------------------------------------------
+
+    template <typename WORD>
+    template <bool INIT>
+    inline void CSA2BitslicedStream<WORD>::Clock(State& st, const WORD* ina, const WORD* inb, WORD& out_hi, WORD& out_lo)
+    {
+        // From A[1]..A[10], 35 bits are selected as inputs to 7 s-boxes, most significant input last.
+        // The truth tables are derived from the s-boxes of the scalar implementation.
+        const WORD (&A)[11][4] = st.A;
+        const WORD (&B)[11][4] = st.B;
+        const WORD in1[5] = {A[9][0], A[7][3], A[6][1], A[1][2], A[4][0]};
+        const WORD in2[5] = {A[9][1], A[7][0], A[6][3], A[3][2], A[2][1]};
+        const WORD in3[5] = {A[6][2], A[5][3], A[5][1], A[2][0], A[1][3]};
+        const WORD in4[5] = {A[8][0], A[4][2], A[2][3], A[1][1], A[3][3]};
+        const WORD in5[5] = {A[9][2], A[8][1], A[6][0], A[4][3], A[5][2]};
+        const WORD in6[5] = {A[9][3], A[7][2], A[5][0], A[4][1], A[3][1]};
+        const WORD in7[5] = {A[8][3], A[8][2], A[7][1], A[3][0], A[2][2]};
+
+        const WORD s1h = CSA2TruthTable<WORD, 0x4B368771, 5>::Eval(in1);
+        const WORD s1l = CSA2TruthTable<WORD, 0x78C6B16C, 5>::Eval(in1);
+        const WORD s2h = CSA2TruthTable<WORD, 0x58B98679, 5>::Eval(in2);
+        const WORD s2l = CSA2TruthTable<WORD, 0xE41B4B63, 5>::Eval(in2);
+        const WORD s3h = CSA2TruthTable<WORD, 0x69D25879, 5>::Eval(in3);
+        const WORD s3l = CSA2TruthTable<WORD, 0xE41B1BE4, 5>::Eval(in3);
+        const WORD s4h = CSA2TruthTable<WORD, 0x66B492AD, 5>::Eval(in4);
+        const WORD s4l = CSA2TruthTable<WORD, 0x92AD994B, 5>::Eval(in4);
+        const WORD s5h = CSA2TruthTable<WORD, 0x9C274CF1, 5>::Eval(in5);
+        const WORD s5l = CSA2TruthTable<WORD, 0x35E29E58, 5>::Eval(in5);
+        const WORD s6h = CSA2TruthTable<WORD, 0x691BB46C, 5>::Eval(in6);
+        const WORD s6l = CSA2TruthTable<WORD, 0x66D2E61A, 5>::Eval(in6);
+        const WORD s7h = CSA2TruthTable<WORD, 0xB38C691E, 5>::Eval(in7);
+        const WORD s7l = CSA2TruthTable<WORD, 0x266D9D92, 5>::Eval(in7);
+
+        // Use 4x4 xor to produce extra nibble for T3.
+        const WORD extra_B[4] = {
+            B[9][2] ^ B[6][3] ^ B[3][1] ^ B[8][0],
+            B[5][3] ^ B[8][2] ^ B[4][0] ^ B[5][1],
+            B[6][0] ^ B[8][1] ^ B[3][3] ^ B[4][2],
+            B[3][0] ^ B[6][1] ^ B[7][2] ^ B[9][3]
+        };
+
+        WORD next_A1[4];
+        WORD next_B1[4];
+        WORD next_F[4];
+        WORD carry(st.r);
+
+        for (size_t k = 0; k < 4; ++k) {
+            // T1 and T2, inputs and D are used only during initialization.
+            next_A1[k] = st.A[10][k] ^ st.X[k];
+            next_B1[k] = st.B[7][k] ^ st.B[10][k] ^ st.Y[k];
+            if (INIT) {
+                next_A1[k] ^= st.D[k] ^ ina[k];
+                next_B1[k] ^= inb[k];
+            }
+
+            // T3, new value of D, from previous values of E and Z.
+            st.D[k] = st.E[k] ^ st.Z[k] ^ extra_B[k];
+
+            // T4, if q=1, F = Z + E + r (r is the carry), otherwise F = E.
+            const WORD ze = st.Z[k] ^ st.E[k];
+            next_F[k] = st.E[k] ^ (st.q & (ze ^ carry ^ st.E[k]));
+            carry = (st.Z[k] & st.E[k]) | (carry & ze);
+        }
+        st.r ^= st.q & (carry ^ st.r);
+
+        // If p=1, rotate next_B1 left.
+        const WORD rot[4] = {next_B1[3], next_B1[0], next_B1[1], next_B1[2]};
+        for (size_t k = 0; k < 4; ++k) {
+            next_B1[k] ^= st.p & (next_B1[k] ^ rot[k]);
+        }
+
+        // Shift registers.
+        for (size_t k = 0; k < 4; ++k) {
+            st.E[k] = st.F[k];
+            st.F[k] = next_F[k];
+            for (size_t i = 10; i > 1; --i) {
+                st.A[i][k] = st.A[i-1][k];
+                st.B[i][k] = st.B[i-1][k];
+            }
+            st.A[1][k] = next_A1[k];
+            st.B[1][k] = next_B1[k];
+        }
+
+        // New values of X, Y, Z, p, q from the s-boxes.
+        st.X[0] = s1h; st.X[1] = s2h; st.X[2] = s3l; st.X[3] = s4l;
+        st.Y[0] = s3h; st.Y[1] = s4h; st.Y[2] = s5l; st.Y[3] = s6l;
+        st.Z[0] = s5h; st.Z[1] = s6h; st.Z[2] = s1l; st.Z[3] = s2l;
+        st.p = s7h;
+        st.q = s7l;
+
+        // 2 output bits are a function of the 4 bits of D, xor 2 by 2.
+        out_hi = st.D[2] ^ st.D[3];
+        out_lo = st.D[0] ^ st.D[1];
+    }
+
+    //------------------------------------------------------------------------
+    // Transpose lanes of bytes into bitsliced words.
+    //------------------------------------------------------------------------
+
+    template <typename WORD>
+    void CSA2BitslicedStream<WORD>::LoadBits(WORD* bits, const uint8_t* const* bytes, size_t count, size_t size)
+    {
+        uint64_t chunks[CHUNKS];
+        for (size_t bit = 0; bit < 8 * size; ++bit) {
+            const size_t index = bit / 8;
+            const size_t shift = bit % 8;
+            for (size_t c = 0; c < CHUNKS; ++c) {
+                chunks[c] = 0;
+            }
+            for (size_t lane = 0; lane < count; ++lane) {
+                chunks[lane / 64] |= uint64_t((bytes[lane][index] >> shift) & 1) << (lane % 64);
+            }
+            ::memcpy(&bits[bit], chunks, sizeof(WORD));
+        }
+    }
+
+    //------------------------------------------------------------------------
+    // Transpose bitsliced words into lanes of bytes.
+    //------------------------------------------------------------------------
+
+    template <typename WORD>
+    void CSA2BitslicedStream<WORD>::StoreBits(const WORD* bits, uint8_t* const* bytes, size_t offset, size_t count, size_t size)
+    {
+        uint64_t chunks[8][CHUNKS];
+        for (size_t index = 0; index < size; ++index) {
+            ::memcpy(chunks, &bits[8 * index], sizeof(chunks));
+            // Process lanes 8 by 8: an 8x8 bit matrix, one byte per bit position, is transposed
+            // into one byte per lane. Byte k of x contains bit k of 8 consecutive lanes.
+            for (size_t lane = 0; lane < count; lane += 8) {
+                const size_t c = lane / 64;
+                const size_t shift = lane % 64;
+                uint64_t x = 0;
+                for (size_t k = 0; k < 8; ++k) {
+                    x |= ((chunks[k][c] >> shift) & 0xFF) << (8 * k);
+                }
+                uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AA;
+                x ^= t ^ (t << 7);
+                t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCC;
+                x ^= t ^ (t << 14);
+                t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0;
+                x ^= t ^ (t << 28);
+                for (size_t j = 0; j < 8 && lane + j < count; ++j) {
+                    bytes[lane + j][offset + index] = uint8_t(x >> (8 * j));
+                }
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    // Generate the keystream of up to LANES packets.
+    //------------------------------------------------------------------------
+
+    template <typename WORD>
+    void CSA2BitslicedStream<WORD>::Keystream(const uint8_t* key, const uint8_t* const* init, uint8_t* const* out, size_t count, size_t nblocks)
+    {
+        State st;
+        WORD bits[64];
+        WORD hi, lo;
+
+        InitState(st, key);
+
+        // Initialization with the first block of each packet, 4 clocks per byte.
+        // The most significant nibble of each byte goes first into A, then into B.
+        LoadBits(bits, init, count, 8);
+        for (size_t i = 0; i < 8; ++i) {
+            const WORD* const in1 = &bits[8 * i + 4];  // most significant nibble of input byte
+            const WORD* const in2 = &bits[8 * i];      // least significant nibble of input byte
+            for (size_t j = 0; j < 4; ++j) {
+                Clock<true>(st, j % 2 == 0 ? in1 : in2, j % 2 == 0 ? in2 : in1, hi, lo);
+            }
+        }
+
+        // Generation of the keystream, 4 clocks per byte, 2 bits per clock, most significant bits first.
+        for (size_t blk = 0; blk < nblocks; ++blk) {
+            for (size_t i = 0; i < 8; ++i) {
+                for (size_t j = 0; j < 4; ++j) {
+                    Clock<false>(st, nullptr, nullptr, bits[8 * i + 7 - 2 * j], bits[8 * i + 6 - 2 * j]);
+                }
+            }
+            StoreBits(bits, out, 8 * blk, count, 8);
+        }
+    }
+}
+#endif // DOXYGEN
@@ -14,6 +14,23 @@
 //----------------------------------------------------------------------------
 
 #include "tsAES.h"
+#include "tsSysInfo.h"
+
+// AES instructions support, when the compiler can generate them.
+#if (defined(TS_I386) || defined(TS_X86_64)) && (defined(TS_GCC) || defined(TS_MSC))
+    #define TS_AES_X86 1
+    #include <immintrin.h>
+    #if defined(TS_GCC)
+        #define TS_AES_TARGET __attribute__((target("aes,sse2")))
+    #else
+        #define TS_AES_TARGET
+    #endif
+#elif defined(TS_ARM64) && defined(__ARM_FEATURE_CRYPTO)
+    #define TS_AES_ARM 1
+    #define TS_AES_TARGET
+    #include <arm_neon.h>
+#endif
+
 TSDUCK_SOURCE;
 
 #define BYTE(x,n) (((x) >> (8 * (n))) & 255)
@@ -1012,6 +1029,145 @@ namespace {
 }
 
 
+//----------------------------------------------------------------------------
+// Implementation using the AES instructions of the CPU.
+// The round keys are in byte order, as in the standard key expansion.
+// The decryption keys are those of the "equivalent inverse cipher".
+//----------------------------------------------------------------------------
+
+#if defined(TS_AES_X86) || defined(TS_AES_ARM)
+namespace {
+
+    // Check once if the CPU supports the AES instructions.
+    bool Accelerated()
+    {
+        static const bool accel = ts::SysInfo::Instance()->aesInstructions();
+        return accel;
+    }
+
+    // Number of blocks which are processed in parallel. The AES instructions have a latency
+    // of several cycles but a throughput of one or two per cycle. Interleaving the rounds of
+    // independent blocks keeps the AES unit busy.
+    constexpr size_t AES_PARALLEL = 8;
+
+#if defined(TS_AES_X86)
+
+    template <size_t N>
+    TS_AES_TARGET void EncryptN(const uint8_t* keys, int rounds, const uint8_t* in, uint8_t* out)
+    {
+        __m128i b[N];
+        __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys));
+        for (size_t i = 0; i < N; ++i) {
+            b[i] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * i)), k);
+        }
+        for (int r = 1; r < rounds; ++r) {
+            k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + 16 * r));
+            for (size_t i = 0; i < N; ++i) {
+                b[i] = _mm_aesenc_si128(b[i], k);
+            }
+        }
+        k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + 16 * rounds));
+        for (size_t i = 0; i < N; ++i) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * i), _mm_aesenclast_si128(b[i], k));
+        }
+    }
+
+    template <size_t N>
+    TS_AES_TARGET void DecryptN(const uint8_t* keys, int rounds, const uint8_t* in, uint8_t* out)
+    {
+        __m128i b[N];
+        __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys));
+        for (size_t i = 0; i < N; ++i) {
+            b[i] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * i)), k);
+        }
+        for (int r = 1; r < rounds; ++r) {
+            k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + 16 * r));
+            for (size_t i = 0; i < N; ++i) {
+                b[i] = _mm_aesdec_si128(b[i], k);
+            }
+        }
+        k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + 16 * rounds));
+        for (size_t i = 0; i < N; ++i) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * i), _mm_aesdeclast_si128(b[i], k));
+        }
+    }
+
+#elif defined(TS_AES_ARM)
+
+    // On Arm, AESE and AESD include the AddRoundKey at the beginning of the round.
+    template <size_t N>
+    void EncryptN(const uint8_t* keys, int rounds, const uint8_t* in, uint8_t* out)
+    {
+        uint8x16_t b[N];
+        for (size_t i = 0; i < N; ++i) {
+            b[i] = vld1q_u8(in + 16 * i);
+        }
+        for (int r = 0; r < rounds - 1; ++r) {
+            const uint8x16_t k = vld1q_u8(keys + 16 * r);
+            for (size_t i = 0; i < N; ++i) {
+                b[i] = vaesmcq_u8(vaeseq_u8(b[i], k));
+            }
+        }
+        const uint8x16_t k1 = vld1q_u8(keys + 16 * (rounds - 1));
+        const uint8x16_t k2 = vld1q_u8(keys + 16 * rounds);
+        for (size_t i = 0; i < N; ++i) {
+            vst1q_u8(out + 16 * i, veorq_u8(vaeseq_u8(b[i], k1), k2));
+        }
+    }
+
+    template <size_t N>
+    void DecryptN(const uint8_t* keys, int rounds, const uint8_t* in, uint8_t* out)
+    {
+        uint8x16_t b[N];
+        for (size_t i = 0; i < N; ++i) {
+            b[i] = vld1q_u8(in + 16 * i);
+        }
+        for (int r = 0; r < rounds - 1; ++r) {
+            const uint8x16_t k = vld1q_u8(keys + 16 * r);
+            for (size_t i = 0; i < N; ++i) {
+                b[i] = vaesimcq_u8(vaesdq_u8(b[i], k));
+            }
+        }
+        const uint8x16_t k1 = vld1q_u8(keys + 16 * (rounds - 1));
+        const uint8x16_t k2 = vld1q_u8(keys + 16 * rounds);
+        for (size_t i = 0; i < N; ++i) {
+            vst1q_u8(out + 16 * i, veorq_u8(vaesdq_u8(b[i], k1), k2));
+        }
+    }
+
+#endif
+
+    TS_AES_TARGET void EncryptAccelerated(const uint8_t* keys, int rounds, const uint8_t* in, uint8_t* out, size_t count)
+    {
+        for (; count >= AES_PARALLEL; count -= AES_PARALLEL) {
+            EncryptN<AES_PARALLEL>(keys, rounds, in, out);
+            in += 16 * AES_PARALLEL;
+            out += 16 * AES_PARALLEL;
+        }
+        for (; count > 0; --count) {
+            EncryptN<1>(keys, rounds, in, out);
+            in += 16;
+            out += 16;
+        }
+    }
+
+    TS_AES_TARGET void DecryptAccelerated(const uint8_t* keys, int rounds, const uint8_t* in, uint8_t* out, size_t count)
+    {
+        for (; count >= AES_PARALLEL; count -= AES_PARALLEL) {
+            DecryptN<AES_PARALLEL>(keys, rounds, in, out);
+            in += 16 * AES_PARALLEL;
+            out += 16 * AES_PARALLEL;
+        }
+        for (; count > 0; --count) {
+            DecryptN<1>(keys, rounds, in, out);
+            in += 16;
+            out += 16;
+        }
+    }
+}
+#endif
+
+
 //----------------------------------------------------------------------------
 // Schedule a new key. If rounds is zero, the default is used.
 //----------------------------------------------------------------------------
@@ -1164,6 +1320,12 @@ bool ts::AES::setKeyImpl(const void* key_, size_t key_length, size_t rounds)
     *rk++ = *rrk++;
     *rk   = *rrk;
 
+    // Round keys in byte order, for AES instructions.
+    for (i = 0; i < 4 * (_Nr + 1); i++) {
+        PutUInt32(_eKbytes + 4 * i, _eK[i]);
+        PutUInt32(_dKbytes + 4 * i, _dK[i]);
+    }
+
     return true;
 }
 
@@ -1181,6 +1343,16 @@ bool ts::AES::encryptImpl(const void* plain, size_t plain_length, void* cipher,
     const uint8_t* pt = reinterpret_cast<const uint8_t*> (plain);
     uint8_t* ct = reinterpret_cast<uint8_t*> (cipher);
 
+#if defined(TS_AES_X86) || defined(TS_AES_ARM)
+    if (Accelerated()) {
+        EncryptAccelerated(_eKbytes, _Nr, pt, ct, 1);
+        if (cipher_length != nullptr) {
+            *cipher_length = BLOCK_SIZE;
+        }
+        return true;
+    }
+#endif
+
     uint32_t s0, s1, s2, s3, t0, t1, t2, t3, *rk;
     int Nr, r;
 
@@ -1306,6 +1478,16 @@ bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain,
     const uint8_t* ct = reinterpret_cast<const uint8_t*> (cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*> (plain);
 
+#if defined(TS_AES_X86) || defined(TS_AES_ARM)
+    if (Accelerated()) {
+        DecryptAccelerated(_dKbytes, _Nr, ct, pt, 1);
+        if (plain_length != nullptr) {
+            *plain_length = BLOCK_SIZE;
+        }
+        return true;
+    }
+#endif
+
     uint32_t s0, s1, s2, s3, t0, t1, t2, t3, *rk;
     int Nr, r;
 
@@ -1419,6 +1601,33 @@ bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain,
 }
 
 
+//----------------------------------------------------------------------------
+// Encryption and decryption of several blocks in ECB mode.
+//----------------------------------------------------------------------------
+
+bool ts::AES::encryptBlocksImpl(const uint8_t* plain, uint8_t* cipher, size_t count)
+{
+#if defined(TS_AES_X86) || defined(TS_AES_ARM)
+    if (Accelerated()) {
+        EncryptAccelerated(_eKbytes, _Nr, plain, cipher, count);
+        return true;
+    }
+#endif
+    return BlockCipher::encryptBlocksImpl(plain, cipher, count);
+}
+
+bool ts::AES::decryptBlocksImpl(const uint8_t* cipher, uint8_t* plain, size_t count)
+{
+#if defined(TS_AES_X86) || defined(TS_AES_ARM)
+    if (Accelerated()) {
+        DecryptAccelerated(_dKbytes, _Nr, cipher, plain, count);
+        return true;
+    }
+#endif
+    return BlockCipher::decryptBlocksImpl(cipher, plain, count);
+}
+
+
 //----------------------------------------------------------------------------
 // Constructor
 //----------------------------------------------------------------------------
@@ -1426,7 +1635,9 @@ bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain,
 ts::AES::AES() :
     _Nr(0),
     _eK(),
-    _dK()
+    _dK(),
+    _eKbytes(),
+    _dKbytes()
 {
 }
 
@@ -67,10 +67,14 @@ namespace ts {
         virtual bool setKeyImpl(const void* key, size_t key_length, size_t rounds) override;
         virtual bool encryptImpl(const void* plain, size_t plain_length, void* cipher, size_t cipher_maxsize, size_t* cipher_length) override;
         virtual bool decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length) override;
+        virtual bool encryptBlocksImpl(const uint8_t* plain, uint8_t* cipher, size_t count) override;
+        virtual bool decryptBlocksImpl(const uint8_t* cipher, uint8_t* plain, size_t count) override;
 
     private:
-        int      _Nr;     //!< Number of rounds
-        uint32_t _eK[60]; //!< Scheduled encryption keys
-        uint32_t _dK[60]; //!< Scheduled decryption keys
+        int      _Nr;           //!< Number of rounds
+        uint32_t _eK[60];       //!< Scheduled encryption keys
+        uint32_t _dK[60];       //!< Scheduled decryption keys
+        uint8_t  _eKbytes[240]; //!< Scheduled encryption keys in byte order, for AES instructions
+        uint8_t  _dKbytes[240]; //!< Scheduled decryption keys in byte order, for AES instructions
     };
 }
@@ -189,6 +189,34 @@ namespace ts {
         //!
         bool decryptInPlace(void* data, size_t data_length, size_t* max_actual_length = nullptr);
 
+        //!
+        //! Encrypt several consecutive blocks of data, each of them independently (ECB).
+        //!
+        //! This is equivalent to calling encrypt() on each block of the block size of the
+        //! algorithm but some ciphers, such as AES with hardware acceleration, process
+        //! several blocks in parallel. Each block counts as one encryption for the key.
+        //!
+        //! @param [in] plain Address of plain text, @a count blocks.
+        //! @param [out] cipher Address of buffer for cipher text, @a count blocks. Can be the same as @a plain.
+        //! @param [in] count Number of blocks.
+        //! @return True on success, false on error.
+        //!
+        bool encryptBlocks(const void* plain, void* cipher, size_t count);
+
+        //!
+        //! Decrypt several consecutive blocks of data, each of them independently (ECB).
+        //!
+        //! This is equivalent to calling decrypt() on each block of the block size of the
+        //! algorithm but some ciphers, such as AES with hardware acceleration, process
+        //! several blocks in parallel. Each block counts as one decryption for the key.
+        //!
+        //! @param [in] cipher Address of cipher text, @a count blocks.
+        //! @param [out] plain Address of buffer for plain text, @a count blocks. Can be the same as @a cipher.
+        //! @param [in] count Number of blocks.
+        //! @return True on success, false on error.
+        //!
+        bool decryptBlocks(const void* cipher, void* plain, size_t count);
+
         //!
         //! Get the number of times the current key was used for encryption.
         //! @return The number of times the current key was used for encryption.
@@ -314,6 +342,42 @@ namespace ts {
         //!
         virtual bool decryptInPlaceImpl(void* data, size_t data_length, size_t* max_actual_length);
 
+        //!
+        //! Encrypt several consecutive blocks of data (implementation of algorithm-specific part).
+        //! The default implementation is to call encryptImpl() on each block.
+        //! A subclass may provide a more efficient implementation.
+        //! @param [in] plain Address of plain text, @a count blocks.
+        //! @param [out] cipher Address of buffer for cipher text, @a count blocks. Can be the same as @a plain.
+        //! @param [in] count Number of blocks.
+        //! @return True on success, false on error.
+        //!
+        virtual bool encryptBlocksImpl(const uint8_t* plain, uint8_t* cipher, size_t count);
+
+        //!
+        //! Decrypt several consecutive blocks of data (implementation of algorithm-specific part).
+        //! The default implementation is to call decryptImpl() on each block.
+        //! A subclass may provide a more efficient implementation.
+        //! @param [in] cipher Address of cipher text, @a count blocks.
+        //! @param [out] plain Address of buffer for plain text, @a count blocks. Can be the same as @a cipher.
+        //! @param [in] count Number of blocks.
+        //! @return True on success, false on error.
+        //!
+        virtual bool decryptBlocksImpl(const uint8_t* cipher, uint8_t* plain, size_t count);
+
+        //!
+        //! Check if one encryption is allowed with the current key and count it.
+        //! To be used by subclasses which provide additional encryption methods.
+        //! @return True if the encryption is allowed, false otherwise.
+        //!
+        bool allowEncrypt();
+
+        //!
+        //! Check if one decryption is allowed with the current key and count it.
+        //! To be used by subclasses which provide additional decryption methods.
+        //! @return True if the decryption is allowed, false otherwise.
+        //!
+        bool allowDecrypt();
+
     private:
         bool      _key_set;                // Current key successfully set.
         int       _cipher_id;              // Cipher identity (from application).
@@ -323,9 +387,5 @@ namespace ts {
         size_t    _key_decrypt_max;        // Maximum number of times a key should be used for decryption.
         ByteBlock _current_key;            // Current unscheduled key.
         BlockCipherAlertInterface* _alert; // Alert handler.
-
-        // Check if encryption or decryption is allowed. Increment counters.
-        bool allowEncrypt();
-        bool allowDecrypt();
     };
 }
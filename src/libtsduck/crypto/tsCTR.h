@@ -87,9 +87,9 @@ namespace ts {
     private:
         size_t _counter_bits; // size in bits of the counter part.
 
-        // We need two work blocks.
+        // We need 1 + 2 * PARALLEL_BLOCKS work blocks.
         // The first one contains the "input block" or counter.
-        // The second one contains the "output block", the encrypted counter.
+        // The next ones contain successive counter values, then the "output blocks", the encrypted counters.
         // This private method increments the counter block.
         bool incrementCounter();
     };
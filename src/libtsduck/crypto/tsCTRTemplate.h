@@ -37,7 +37,7 @@
 
 template<class CIPHER>
 ts::CTR<CIPHER>::CTR(size_t counter_bits) :
-    CipherChainingTemplate<CIPHER>(1, 1, 2),
+    CipherChainingTemplate<CIPHER>(1, 1, 1 + 2 * CipherChaining::PARALLEL_BLOCKS),
     _counter_bits(0)
 {
     setCounterBits(counter_bits);
@@ -121,7 +121,7 @@ bool ts::CTR<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
 {
     if (this->algo == nullptr ||
         this->iv.size() != this->block_size ||
-        this->work.size() < 2 * this->block_size ||
+        this->work.size() < (1 + 2 * this->PARALLEL_BLOCKS) * this->block_size ||
         cipher_maxsize < plain_length)
     {
         return false;
@@ -133,27 +133,35 @@ bool ts::CTR<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
     // work[0] = iv
     ::memcpy(this->work.data(), this->iv.data(), this->block_size);
 
-    // Loop on all blocks, including last truncated one.
+    // The following work blocks contain successive counter values, then the encrypted counters.
+    uint8_t* const counters = this->work.data() + this->block_size;
+    uint8_t* const mask = counters + this->PARALLEL_BLOCKS * this->block_size;
+
+    // Loop on all blocks, including last truncated one, several blocks at a time.
 
     const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
     uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
 
     while (plain_length > 0) {
-        // work[1] = encrypt(work[0])
-        if (!this->algo->encrypt(this->work.data(), this->block_size, this->work.data() + this->block_size, this->block_size)) {
+        // Number of blocks to process, including last truncated one:
+        const size_t count = std::min((plain_length + this->block_size - 1) / this->block_size, size_t(this->PARALLEL_BLOCKS));
+        // counters[i] = work[0]++
+        for (size_t i = 0; i < count; ++i) {
+            ::memcpy(counters + i * this->block_size, this->work.data(), this->block_size);
+            if (!incrementCounter()) {
+                return false;
+            }
+        }
+        // mask = encrypt(counters), all blocks in parallel
+        if (!this->algo->encryptBlocks(counters, mask, count)) {
             return false;
         }
-        // This block size:
-        const size_t size = std::min(plain_length, this->block_size);
-        // cipher-text = plain-text XOR work[1]
+        // cipher-text = plain-text XOR mask
+        const size_t size = std::min(plain_length, count * this->block_size);
         for (size_t i = 0; i < size; ++i) {
-            ct[i] = this->work[this->block_size + i] ^ pt[i];
-        }
-        // work[0] += 1
-        if (!incrementCounter()) {
-            return false;
+            ct[i] = mask[i] ^ pt[i];
         }
-        // advance one block
+        // advance
         ct += size;
         pt += size;
         plain_length -= size;
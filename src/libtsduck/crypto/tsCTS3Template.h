@@ -85,13 +85,14 @@ bool ts::CTS3<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
 
     // Process in ECB mode, except the last 2 blocks
 
-    while (plain_length > 2 * this->block_size) {
-        if (!this->algo->encrypt (pt, this->block_size, ct, this->block_size)) {
+    const size_t count = (plain_length - this->block_size - 1) / this->block_size;
+    if (count > 0) {
+        if (!this->algo->encryptBlocks(pt, ct, count)) {
             return false;
         }
-        ct += this->block_size;
-        pt += this->block_size;
-        plain_length -= this->block_size;
+        ct += count * this->block_size;
+        pt += count * this->block_size;
+        plain_length -= count * this->block_size;
     }
 
     // Process final two blocks.
@@ -135,13 +136,14 @@ bool ts::CTS3<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, voi
 
     // Process in ECB mode, except the last 2 blocks
 
-    while (cipher_length > 2 * this->block_size) {
-        if (!this->algo->decrypt (ct, this->block_size, pt, this->block_size)) {
+    const size_t count = (cipher_length - this->block_size - 1) / this->block_size;
+    if (count > 0) {
+        if (!this->algo->decryptBlocks(ct, pt, count)) {
             return false;
         }
-        ct += this->block_size;
-        pt += this->block_size;
-        cipher_length -= this->block_size;
+        ct += count * this->block_size;
+        pt += count * this->block_size;
+        cipher_length -= count * this->block_size;
     }
 
     // Process final two blocks.
@@ -30,6 +30,10 @@
 #include "tsCipherChaining.h"
 TSDUCK_SOURCE;
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::CipherChaining::PARALLEL_BLOCKS;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructor for subclasses
@@ -125,3 +129,24 @@ bool ts::CipherChaining::setIV(const void* iv_data, size_t iv_length)
         return true;
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Decrypt complete blocks in CBC mode.
+//----------------------------------------------------------------------------
+
+bool ts::CipherChaining::decryptCBC(const uint8_t* cipher, uint8_t* plain, size_t count, const uint8_t* previous)
+{
+    if (algo == nullptr || !algo->decryptBlocks(cipher, plain, count)) {
+        return false;
+    }
+    // plain-text XOR= previous-cipher
+    for (size_t blk = 0; blk < count; ++blk) {
+        uint8_t* const pt = plain + blk * block_size;
+        const uint8_t* const prev = blk == 0 ? previous : cipher + (blk - 1) * block_size;
+        for (size_t i = 0; i < block_size; ++i) {
+            pt[i] ^= prev[i];
+        }
+    }
+    return true;
+}
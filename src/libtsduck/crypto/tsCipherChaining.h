@@ -100,6 +100,12 @@ namespace ts {
         ByteBlock    iv;          //!< Current initialization vector.
         ByteBlock    work;        //!< Temporary working buffer.
 
+        //!
+        //! Number of blocks which are processed at once by the chaining modes which
+        //! allow parallel processing (the block cipher may process them in parallel).
+        //!
+        static constexpr size_t PARALLEL_BLOCKS = 8;
+
         //!
         //! Constructor for subclasses.
         //! @param [in,out] cipher An instance of block cipher.
@@ -112,6 +118,18 @@ namespace ts {
                        size_t iv_max_blocks = 1,
                        size_t work_blocks = 1);
 
+        //!
+        //! Decrypt complete blocks in CBC mode, for use by subclasses.
+        //! All cipher blocks are independently decrypted first, allowing parallel processing
+        //! in the block cipher. Then each block is xor'ed with the previous cipher block.
+        //! @param [in] cipher Address of cipher text, @a count blocks.
+        //! @param [out] plain Address of plain text, @a count blocks. Must not overlap @a cipher.
+        //! @param [in] count Number of blocks.
+        //! @param [in] previous Address of the cipher block before @a cipher, typically the IV.
+        //! @return True on success, false on error.
+        //!
+        bool decryptCBC(const uint8_t* cipher, uint8_t* plain, size_t count, const uint8_t* previous);
+
         // Implementation of BlockCipher interface:
         virtual bool setKeyImpl(const void* key, size_t key_length, size_t rounds) override;
     };
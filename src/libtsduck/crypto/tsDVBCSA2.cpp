@@ -10,6 +10,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCSA2.h"
+#include "tsDVBCSA2Bitslice.h"
+#include "tsSysInfo.h"
 TSDUCK_SOURCE;
 
 // Operations on 64-bit areas.
@@ -61,7 +63,8 @@ ts::DVBCSA2::DVBCSA2(EntropyMode mode) :
     _init(false),
     _mode(mode),
     _block(),
-    _stream()
+    _stream(),
+    _keystream()
 {
 }
 
@@ -719,6 +722,201 @@ bool ts::DVBCSA2::decryptInPlaceImpl(void* addr, size_t size, size_t* max_actual
 }
 
 
+//----------------------------------------------------------------------------
+// Bitsliced stream cipher engines.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // Generic 128-bit vectors are used when they map to actual SIMD instructions (SSE2, Neon).
+#if defined(TS_GCC) && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #define TS_CSA2_VECTOR128 1
+    typedef uint64_t Word128 __attribute__((vector_size(16)));
+#endif
+
+    // Below this number of data blocks, the scalar stream cipher is faster.
+    const size_t CSA2_MIN_BITSLICE = 16;
+
+    // Maximum size of a data block in a batch and of its keystream.
+    const size_t CSA2_MAX_SIZE = 8 * (MAX_NBLOCKS + 1);
+
+    // Description of a bitsliced engine.
+    class CSA2Engine
+    {
+    public:
+        ts::DVBCSA2KeystreamFunction keystream;  // Keystream generator.
+        size_t lanes;                            // Number of data blocks in parallel.
+        CSA2Engine(ts::DVBCSA2KeystreamFunction k = nullptr, size_t l = 0) : keystream(k), lanes(l) {}
+    };
+
+    // Build the list of available engines, from the widest to the narrowest.
+    std::vector<CSA2Engine> AvailableEngines()
+    {
+        std::vector<CSA2Engine> engines;
+        if (ts::DVBCSA2KeystreamAVX2 != nullptr && ts::SysInfo::Instance()->avx2Instructions()) {
+            engines.push_back(CSA2Engine(ts::DVBCSA2KeystreamAVX2, ts::DVBCSA2_AVX2_LANES));
+        }
+#if defined(TS_CSA2_VECTOR128)
+        engines.push_back(CSA2Engine(CSA2BitslicedStream<Word128>::Keystream, CSA2BitslicedStream<Word128>::LANES));
+#endif
+        engines.push_back(CSA2Engine(CSA2BitslicedStream<uint64_t>::Keystream, CSA2BitslicedStream<uint64_t>::LANES));
+        return engines;
+    }
+
+    // Select the engine for a given number of data blocks: the widest one which is at least half used.
+    const CSA2Engine& SelectEngine(size_t count)
+    {
+        static const std::vector<CSA2Engine> engines(AvailableEngines());
+        size_t index = 0;
+        while (index + 1 < engines.size() && 2 * count <= engines[index].lanes) {
+            index++;
+        }
+        return engines[index];
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt / decrypt a batch of data blocks.
+//----------------------------------------------------------------------------
+
+bool ts::DVBCSA2::encryptBatch(uint8_t* const data[], const size_t sizes[], size_t count)
+{
+    return processBatch(data, sizes, count, true);
+}
+
+bool ts::DVBCSA2::decryptBatch(uint8_t* const data[], const size_t sizes[], size_t count)
+{
+    return processBatch(data, sizes, count, false);
+}
+
+bool ts::DVBCSA2::processBatch(uint8_t* const data[], const size_t sizes[], size_t count, bool encrypt)
+{
+    // Filter invalid parameters.
+    if (data == nullptr || sizes == nullptr || !_init) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (data[i] == nullptr || sizes[i] / 8 > MAX_NBLOCKS) {
+            return false;
+        }
+    }
+
+    // Each data block counts as one encryption or decryption with the current key.
+    for (size_t i = 0; i < count; ++i) {
+        if (!(encrypt ? allowEncrypt() : allowDecrypt())) {
+            return false;
+        }
+    }
+
+    uint8_t* init[DVBCSA2_AVX2_LANES];  // First block of each data block in a group.
+    uint8_t* ks[DVBCSA2_AVX2_LANES];    // Keystream of each data block in a group.
+    size_t index[DVBCSA2_AVX2_LANES];   // Index of each data block in a group.
+
+    // Process groups of data blocks, as large as the selected engine allows.
+    size_t next = 0;
+    while (next < count) {
+
+        // Small groups are faster with the scalar stream cipher.
+        if (count - next < CSA2_MIN_BITSLICE) {
+            for (; next < count; ++next) {
+                if (encrypt) {
+                    encryptInPlaceImpl(data[next], sizes[next], nullptr);
+                }
+                else {
+                    decryptInPlaceImpl(data[next], sizes[next], nullptr);
+                }
+            }
+            break;
+        }
+
+        // Build a group of data blocks. Data blocks smaller than 8 bytes are left unscrambled.
+        const CSA2Engine& engine(SelectEngine(count - next));
+        _keystream.resize(engine.lanes * CSA2_MAX_SIZE);
+        size_t lanes = 0;
+        size_t nblocks = 0;
+        for (; next < count && lanes < engine.lanes; ++next) {
+            if (sizes[next] >= 8) {
+                index[lanes] = next;
+                init[lanes] = data[next];
+                ks[lanes] = _keystream.data() + lanes * CSA2_MAX_SIZE;
+                // Number of keystream blocks after the first block, including residue.
+                nblocks = std::max(nblocks, (sizes[next] - 1) / 8);
+                // When encrypting, the first block after the block cipher initializes the stream cipher.
+                if (encrypt) {
+                    encipherBlocks(data[next], sizes[next] / 8);
+                }
+                lanes++;
+            }
+        }
+
+        // Compute the keystream of all data blocks in the group.
+        if (lanes > 0) {
+            engine.keystream(_key, init, ks, lanes, nblocks);
+        }
+
+        // Apply the keystream on each data block.
+        for (size_t l = 0; l < lanes; ++l) {
+            uint8_t* const d = data[index[l]];
+            const size_t size = sizes[index[l]];
+            if (encrypt) {
+                for (size_t i = 8; i < size; ++i) {
+                    d[i] ^= ks[l][i - 8];
+                }
+            }
+            else {
+                decipherBlocks(d, size, ks[l]);
+            }
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Block cipher in reverse CBC mode on the blocks of a data block, in place.
+//----------------------------------------------------------------------------
+
+void ts::DVBCSA2::encipherBlocks(uint8_t* data, size_t nblocks)
+{
+    // After last block is initialization vector (zero in DVB-CSA).
+    uint8_t iblock[8];
+    uint8_t ib[8];
+    clear_8(ib);
+    for (size_t i = nblocks; i-- > 0; ) {
+        xor_8(iblock, data + 8*i, ib);
+        _block.encipher(iblock, ib);
+        memcpy_8(data + 8*i, ib);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt a data block using the keystream after its first block.
+//----------------------------------------------------------------------------
+
+void ts::DVBCSA2::decipherBlocks(uint8_t* data, size_t size, const uint8_t* keystream)
+{
+    const size_t nblocks = size / 8;
+    uint8_t ib[8];      // intermediate block
+    uint8_t oblock[8];  // output of block cipher
+
+    // Same chaining as decryptInPlaceImpl() with a precomputed keystream.
+    memcpy_8(ib, data);
+    for (size_t i = 1; i < nblocks; i++) {
+        _block.decipher(ib, oblock);
+        xor_8(ib, data + 8*i, keystream + 8*(i-1));
+        xor_8(data + 8*(i-1), ib, oblock);
+    }
+    _block.decipher(ib, data + 8*(nblocks-1));
+
+    // Decipher residue, if any.
+    for (size_t i = 8*nblocks; i < size; i++) {
+        data[i] ^= keystream[i - 8];
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Wrappers for encrypt and decrypt.
 //----------------------------------------------------------------------------
@@ -88,6 +88,36 @@ namespace ts {
         //!
         static bool IsReducedCW(const uint8_t *cw);
 
+        //!
+        //! Encrypt a batch of data blocks in place, typically the payloads of TS packets.
+        //!
+        //! All data blocks are encrypted with the current key. The result is identical to
+        //! encryptInPlace() on each data block, in the same order. However, the stream cipher
+        //! of the data blocks is computed in parallel, using a bitsliced implementation in the
+        //! widest registers which are available on the CPU (64-bit, SSE2 or AVX2).
+        //!
+        //! @param [in,out] data Array of @a count addresses of data blocks.
+        //! @param [in] sizes Array of @a count sizes in bytes of the data blocks.
+        //! @param [in] count Number of data blocks.
+        //! @return True on success, false on error.
+        //!
+        bool encryptBatch(uint8_t* const data[], const size_t sizes[], size_t count);
+
+        //!
+        //! Decrypt a batch of data blocks in place, typically the payloads of TS packets.
+        //!
+        //! All data blocks are decrypted with the current key. The result is identical to
+        //! decryptInPlace() on each data block, in the same order. However, the stream cipher
+        //! of the data blocks is computed in parallel, using a bitsliced implementation in the
+        //! widest registers which are available on the CPU (64-bit, SSE2 or AVX2).
+        //!
+        //! @param [in,out] data Array of @a count addresses of data blocks.
+        //! @param [in] sizes Array of @a count sizes in bytes of the data blocks.
+        //! @param [in] count Number of data blocks.
+        //! @return True on success, false on error.
+        //!
+        bool decryptBatch(uint8_t* const data[], const size_t sizes[], size_t count);
+
         // Implementation of CipherChaining interface. Cannot set IV with DVB CSA.
         virtual bool setIV(const void*, size_t) override;
         virtual size_t minIVSize() const override;
@@ -151,5 +181,15 @@ namespace ts {
         uint8_t      _key[KEY_SIZE];
         BlockCipher  _block;
         StreamCipher _stream;
+        ByteBlock    _keystream;  // Keystream buffer for batch operations.
+
+        // Common code for encryptBatch() and decryptBatch().
+        bool processBatch(uint8_t* const data[], const size_t sizes[], size_t count, bool encrypt);
+
+        // Block cipher in reverse CBC mode on the blocks of a data block, in place.
+        void encipherBlocks(uint8_t* data, size_t nblocks);
+
+        // Decrypt a data block using the keystream after its first block.
+        void decipherBlocks(uint8_t* data, size_t size, const uint8_t* keystream);
     };
 }
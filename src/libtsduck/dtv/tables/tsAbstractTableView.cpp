@@ -0,0 +1,88 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "tsAbstractTableView.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::AbstractTableView::AbstractTableView(const BinaryTable& table, TID tid, TID tid2) :
+    _table(table),
+    _is_valid(table.isValid() && (table.tableId() == tid || (tid2 != TID_NULL && table.tableId() == tid2)))
+{
+}
+
+ts::AbstractTableView::~AbstractTableView()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Locate the next loop entry.
+//----------------------------------------------------------------------------
+
+size_t ts::AbstractTableView::nextEntry(size_t& section, size_t offset, size_t skip, const uint8_t*& data, size_t& size) const
+{
+    if (!_is_valid) {
+        return NPOS;
+    }
+    while (section < _table.sectionCount()) {
+        const SectionPtr& sect(_table.sectionAt(section));
+        const uint8_t* const payload = sect.isNull() ? nullptr : sect->payload();
+        const size_t payload_size = sect.isNull() ? 0 : sect->payloadSize();
+
+        // Compute the offset of the candidate entry in the current section.
+        if (payload == nullptr) {
+            offset = NPOS;
+        }
+        else if (offset == NPOS) {
+            offset = loopOffset(payload, payload_size);
+        }
+        else {
+            offset += skip;
+        }
+
+        // Check that the entry is complete.
+        if (offset != NPOS && offset < payload_size) {
+            size = entrySize(payload + offset, payload_size - offset);
+            if (size > 0 && size <= payload_size - offset) {
+                data = payload + offset;
+                return offset;
+            }
+        }
+
+        // No more entry in this section, move to the beginning of next section.
+        section++;
+        offset = NPOS;
+        skip = 0;
+    }
+    return NPOS;
+}
@@ -0,0 +1,178 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//!
+//!  @file
+//!  Abstract base class for read-only views of binary tables.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsBinaryTable.h"
+#include "tsSection.h"
+
+namespace ts {
+    //!
+    //! Abstract base class for read-only views of binary tables.
+    //! @ingroup mpeg
+    //!
+    //! A table view decodes the fields of a table directly from the sections of a
+    //! BinaryTable, without deserializing it into a C++ object and without allocating
+    //! memory. This is useful when only a few fields of a table are needed.
+    //! The BinaryTable must remain valid and unmodified while the view and its
+    //! iterators are used.
+    //!
+    //! Most tables contain a main loop of variable-size entries, potentially
+    //! spread over several sections. Subclasses describe this loop and get a
+    //! generic iterator over the loop entries.
+    //!
+    class TSDUCKDLL AbstractTableView
+    {
+        TS_NOBUILD_NOCOPY(AbstractTableView);
+    public:
+        //!
+        //! Check if the view is valid, ie. if the binary table is valid and has the expected type.
+        //! @return True if the view is valid.
+        //!
+        bool isValid() const { return _is_valid; }
+
+        //!
+        //! Get the binary table which is viewed.
+        //! @return A constant reference to the binary table.
+        //!
+        const BinaryTable& table() const { return _table; }
+
+        //!
+        //! Virtual destructor.
+        //!
+        virtual ~AbstractTableView();
+
+    protected:
+        //!
+        //! Constructor for subclasses.
+        //! @param [in] table The binary table to view.
+        //! @param [in] tid The expected table id.
+        //! @param [in] tid2 An alternative expected table id (for instance "actual" and "other" tables).
+        //!
+        AbstractTableView(const BinaryTable& table, TID tid, TID tid2 = TID_NULL);
+
+        //!
+        //! Get the offset of the main loop in the payload of a section.
+        //! @param [in] payload Address of the section payload.
+        //! @param [in] size Size of the section payload.
+        //! @return The offset of the main loop in the payload or NPOS if the section is invalid.
+        //!
+        virtual size_t loopOffset(const uint8_t* payload, size_t size) const = 0;
+
+        //!
+        //! Get the size of an entry of the main loop.
+        //! @param [in] data Address of the entry.
+        //! @param [in] size Remaining size of the payload, starting at @a data.
+        //! @return The size of the entry at @a data or zero if the entry is truncated.
+        //!
+        virtual size_t entrySize(const uint8_t* data, size_t size) const = 0;
+
+        //!
+        //! Generic forward iterator over the entries of the main loop.
+        //! @tparam ENTRY A lightweight view of one loop entry. It must have a default constructor
+        //! and a constructor from a <code>const uint8_t*</code> and a @c size_t (address and size
+        //! of the entry).
+        //!
+        template <class ENTRY>
+        class Iterator
+        {
+        public:
+            //!
+            //! Default constructor, the end of the loop.
+            //!
+            Iterator() : _view(nullptr), _section(0), _offset(0), _entry_size(0), _entry() {}
+            //!
+            //! Constructor from a table view, the beginning of the loop.
+            //! @param [in] view The table view.
+            //!
+            explicit Iterator(const AbstractTableView* view) : _view(view), _section(0), _offset(NPOS), _entry_size(0), _entry() { locate(0); }
+            //!
+            //! Access the current entry.
+            //! @return A constant reference to the current entry view.
+            //!
+            const ENTRY& operator*() const { return _entry; }
+            //!
+            //! Access the current entry.
+            //! @return A constant pointer to the current entry view.
+            //!
+            const ENTRY* operator->() const { return &_entry; }
+            //!
+            //! Move to next entry.
+            //! @return A reference to this object.
+            //!
+            Iterator& operator++() { locate(_entry_size); return *this; }
+            //!
+            //! Equality operator.
+            //! @param [in] other Another iterator to compare.
+            //! @return True if the two iterators point to the same entry.
+            //!
+            bool operator==(const Iterator& other) const { return _view == other._view && _section == other._section && _offset == other._offset; }
+            //!
+            //! Unequality operator.
+            //! @param [in] other Another iterator to compare.
+            //! @return True if the two iterators point to different entries.
+            //!
+            bool operator!=(const Iterator& other) const { return !(*this == other); }
+        private:
+            const AbstractTableView* _view;
+            size_t _section;
+            size_t _offset;
+            size_t _entry_size;
+            ENTRY  _entry;
+
+            // Move forward by 'skip' bytes and locate next valid entry, possibly in next sections.
+            void locate(size_t skip)
+            {
+                const uint8_t* data = nullptr;
+                size_t size = 0;
+                _entry_size = 0;
+                if (_view != nullptr && (_offset = _view->nextEntry(_section, _offset, skip, data, size)) != NPOS) {
+                    _entry_size = size;
+                    _entry = ENTRY(data, size);
+                }
+                else {
+                    // End of loop.
+                    _view = nullptr;
+                    _section = _offset = 0;
+                }
+            }
+        };
+
+    private:
+        const BinaryTable& _table;
+        bool _is_valid;
+
+        // Locate the next loop entry. The offset NPOS means the beginning of the section.
+        // Update section index, return payload offset or NPOS at end of loop.
+        size_t nextEntry(size_t& section, size_t offset, size_t skip, const uint8_t*& data, size_t& size) const;
+    };
+}
@@ -0,0 +1,85 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPATView.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::PATView::PATView(const BinaryTable& table) :
+    AbstractTableView(table, TID_PAT)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Description of the program loop.
+//----------------------------------------------------------------------------
+
+size_t ts::PATView::loopOffset(const uint8_t*, size_t) const
+{
+    return 0;
+}
+
+size_t ts::PATView::entrySize(const uint8_t*, size_t size) const
+{
+    return size < 4 ? 0 : 4;
+}
+
+
+//----------------------------------------------------------------------------
+// Search services.
+//----------------------------------------------------------------------------
+
+ts::PID ts::PATView::pmtPID(uint16_t service_id) const
+{
+    // Same as PAT deserialization: the last entry of a program number is used.
+    PID pid = PID_NULL;
+    for (const_iterator it = begin(); it != end(); ++it) {
+        if (it->programNumber() == service_id) {
+            pid = it->pid();
+        }
+    }
+    return pid;
+}
+
+uint16_t ts::PATView::firstServiceId() const
+{
+    uint16_t first = 0;
+    for (const_iterator it = begin(); it != end(); ++it) {
+        const uint16_t id = it->programNumber();
+        if (id != 0 && (first == 0 || id < first)) {
+            first = id;
+        }
+    }
+    return first;
+}
@@ -0,0 +1,130 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view of a binary Program Association Table (PAT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTableView.h"
+#include "tsMemory.h"
+
+namespace ts {
+    //!
+    //! Read-only view of a binary Program Association Table (PAT).
+    //! @ingroup mpeg
+    //! @see ISO/IEC 13818-1, ITU-T Rec. H.222.0, 2.4.4.3
+    //!
+    //! The view iterates over the program loop of all sections of the PAT, without
+    //! deserializing it. The entry with program number zero, if any, is the NIT PID.
+    //!
+    class TSDUCKDLL PATView : public AbstractTableView
+    {
+        TS_NOBUILD_NOCOPY(PATView);
+    public:
+        //!
+        //! Read-only view of an entry in the program loop.
+        //!
+        class TSDUCKDLL Program
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the entry (4 bytes).
+            //!
+            Program(const uint8_t* data = nullptr, size_t = 0) : _data(data) {}
+            //!
+            //! Get the program number (aka service id).
+            //! @return The program number. Zero means that pid() is the NIT PID.
+            //!
+            uint16_t programNumber() const { return GetUInt16(_data); }
+            //!
+            //! Get the PMT PID of the program (or the NIT PID when the program number is zero).
+            //! @return The PMT PID.
+            //!
+            PID pid() const { return GetUInt16(_data + 2) & 0x1FFF; }
+        private:
+            const uint8_t* _data;
+        };
+
+        //!
+        //! Iterator over the program loop.
+        //!
+        typedef Iterator<Program> const_iterator;
+
+        //!
+        //! Constructor.
+        //! @param [in] table The binary PAT to view. It must remain valid and unmodified while the view is used.
+        //!
+        explicit PATView(const BinaryTable& table);
+
+        //!
+        //! Get the transport stream id.
+        //! @return The transport stream id.
+        //!
+        uint16_t tsId() const { return isValid() ? table().tableIdExtension() : 0; }
+
+        //!
+        //! Get an iterator to the first entry in the program loop.
+        //! @return An iterator to the first entry in the program loop.
+        //!
+        const_iterator begin() const { return const_iterator(this); }
+
+        //!
+        //! Get an iterator after the last entry in the program loop.
+        //! @return An iterator after the last entry in the program loop.
+        //!
+        const_iterator end() const { return const_iterator(); }
+
+        //!
+        //! Get the PMT PID of a service.
+        //! @param [in] service_id The service id to search.
+        //! @return The PMT PID of the service or PID_NULL if the service is not in the PAT.
+        //!
+        PID pmtPID(uint16_t service_id) const;
+
+        //!
+        //! Get the NIT PID, as declared in the PAT.
+        //! @return The NIT PID or PID_NULL if there is none in the PAT.
+        //!
+        PID nitPID() const { return pmtPID(0); }
+
+        //!
+        //! Get the first service in the PAT, the one with the lowest non-zero program number.
+        //! @return The program number of the first service or zero if the PAT contains no service.
+        //!
+        uint16_t firstServiceId() const;
+
+    protected:
+        // Inherited methods
+        virtual size_t loopOffset(const uint8_t* payload, size_t size) const override;
+        virtual size_t entrySize(const uint8_t* data, size_t size) const override;
+    };
+}
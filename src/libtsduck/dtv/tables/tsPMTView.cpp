@@ -0,0 +1,93 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPMTView.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::PMTView::PMTView(const BinaryTable& table) :
+    AbstractTableView(table, TID_PMT)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Description of the elementary stream loop.
+//----------------------------------------------------------------------------
+
+size_t ts::PMTView::loopOffset(const uint8_t* payload, size_t size) const
+{
+    // Fixed part: PCR PID and program_info_length.
+    if (size < 4) {
+        return NPOS;
+    }
+    const size_t offset = 4 + (GetUInt16(payload + 2) & 0x0FFF);
+    return offset <= size ? offset : NPOS;
+}
+
+size_t ts::PMTView::entrySize(const uint8_t* data, size_t size) const
+{
+    return size < 5 ? 0 : 5 + (GetUInt16(data + 3) & 0x0FFF);
+}
+
+
+//----------------------------------------------------------------------------
+// Access the fixed part of the PMT.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::PMTView::firstPayload(size_t& size) const
+{
+    if (isValid() && table().sectionCount() > 0 && !table().sectionAt(0).isNull()) {
+        const Section& sect(*table().sectionAt(0));
+        if (sect.payload() != nullptr && loopOffset(sect.payload(), sect.payloadSize()) != NPOS) {
+            size = sect.payloadSize();
+            return sect.payload();
+        }
+    }
+    size = 0;
+    return nullptr;
+}
+
+ts::PID ts::PMTView::pcrPID() const
+{
+    size_t size = 0;
+    const uint8_t* data = firstPayload(size);
+    return data == nullptr ? PID(PID_NULL) : PID(GetUInt16(data) & 0x1FFF);
+}
+
+ts::DescriptorListView ts::PMTView::descriptors() const
+{
+    size_t size = 0;
+    const uint8_t* data = firstPayload(size);
+    return data == nullptr ? DescriptorListView() : DescriptorListView(data + 4, GetUInt16(data + 2) & 0x0FFF);
+}
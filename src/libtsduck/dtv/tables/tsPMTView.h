@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view of a binary Program Map Table (PMT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTableView.h"
+#include "tsDescriptorListView.h"
+#include "tsMemory.h"
+
+namespace ts {
+    //!
+    //! Read-only view of a binary Program Map Table (PMT).
+    //! @ingroup mpeg
+    //! @see ISO/IEC 13818-1, ITU-T Rec. H.222.0, 2.4.4.8
+    //!
+    //! The view iterates over the elementary streams and descriptors of the PMT,
+    //! without deserializing it.
+    //!
+    class TSDUCKDLL PMTView : public AbstractTableView
+    {
+        TS_NOBUILD_NOCOPY(PMTView);
+    public:
+        //!
+        //! Read-only view of an elementary stream entry.
+        //!
+        class TSDUCKDLL Stream
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the entry.
+            //! @param [in] size Size of the entry.
+            //!
+            Stream(const uint8_t* data = nullptr, size_t size = 0) : _data(data), _size(size) {}
+            //!
+            //! Get the stream type.
+            //! @return The stream type.
+            //!
+            uint8_t streamType() const { return _data[0]; }
+            //!
+            //! Get the PID of the elementary stream.
+            //! @return The elementary stream PID.
+            //!
+            PID pid() const { return GetUInt16(_data + 1) & 0x1FFF; }
+            //!
+            //! Get the descriptor list of the elementary stream.
+            //! @return A view of the descriptor list.
+            //!
+            DescriptorListView descriptors() const { return DescriptorListView(_data + 5, _size - 5); }
+        private:
+            const uint8_t* _data;
+            size_t         _size;
+        };
+
+        //!
+        //! Iterator over the elementary streams.
+        //!
+        typedef Iterator<Stream> const_iterator;
+
+        //!
+        //! Constructor.
+        //! @param [in] table The binary PMT to view. It must remain valid and unmodified while the view is used.
+        //!
+        explicit PMTView(const BinaryTable& table);
+
+        //!
+        //! Get the service id.
+        //! @return The service id.
+        //!
+        uint16_t serviceId() const { return isValid() ? table().tableIdExtension() : 0; }
+
+        //!
+        //! Get the PCR PID.
+        //! @return The PCR PID or PID_NULL if there is none.
+        //!
+        PID pcrPID() const;
+
+        //!
+        //! Get the program-level descriptor list.
+        //! @return A view of the program-level descriptor list.
+        //!
+        DescriptorListView descriptors() const;
+
+        //!
+        //! Get an iterator to the first elementary stream.
+        //! @return An iterator to the first elementary stream.
+        //!
+        const_iterator begin() const { return const_iterator(this); }
+
+        //!
+        //! Get an iterator after the last elementary stream.
+        //! @return An iterator after the last elementary stream.
+        //!
+        const_iterator end() const { return const_iterator(); }
+
+    protected:
+        // Inherited methods
+        virtual size_t loopOffset(const uint8_t* payload, size_t size) const override;
+        virtual size_t entrySize(const uint8_t* data, size_t size) const override;
+
+    private:
+        // Get the payload of the first section, return null if invalid or too short.
+        const uint8_t* firstPayload(size_t& size) const;
+    };
+}
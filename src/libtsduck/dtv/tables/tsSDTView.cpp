@@ -0,0 +1,142 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsSDTView.h"
+#include "tsDuckContext.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::SDTView::SDTView(const BinaryTable& table) :
+    AbstractTableView(table, TID_SDT_ACT, TID_SDT_OTH)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Description of the service loop.
+//----------------------------------------------------------------------------
+
+size_t ts::SDTView::loopOffset(const uint8_t*, size_t size) const
+{
+    // Fixed part: original_network_id and reserved byte.
+    return size < 3 ? NPOS : 3;
+}
+
+size_t ts::SDTView::entrySize(const uint8_t* data, size_t size) const
+{
+    return size < 5 ? 0 : 5 + (GetUInt16(data + 3) & 0x0FFF);
+}
+
+
+//----------------------------------------------------------------------------
+// Access the fixed part of the SDT.
+//----------------------------------------------------------------------------
+
+uint16_t ts::SDTView::onetwId() const
+{
+    if (isValid() && table().sectionCount() > 0 && !table().sectionAt(0).isNull()) {
+        const Section& sect(*table().sectionAt(0));
+        if (sect.payload() != nullptr && sect.payloadSize() >= 2) {
+            return GetUInt16(sect.payload());
+        }
+    }
+    return 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Search services.
+//----------------------------------------------------------------------------
+
+ts::SDTView::const_iterator ts::SDTView::findService(uint16_t service_id) const
+{
+    const_iterator it(begin());
+    while (it != end() && it->serviceId() != service_id) {
+        ++it;
+    }
+    return it;
+}
+
+ts::SDTView::const_iterator ts::SDTView::findService(const DuckContext& duck, const UString& name, bool exact_match) const
+{
+    const_iterator it(begin());
+    while (it != end()) {
+        const UString service_name(it->serviceName(duck));
+        if ((exact_match && service_name == name) || (!exact_match && service_name.similar(name))) {
+            break;
+        }
+        ++it;
+    }
+    return it;
+}
+
+
+//----------------------------------------------------------------------------
+// Decode the content of the first service_descriptor of a service.
+//----------------------------------------------------------------------------
+
+uint8_t ts::SDTView::Service::serviceType() const
+{
+    const DescriptorListView dlist(descriptors());
+    const DescriptorListView::const_iterator it(dlist.search(DID_SERVICE));
+    return it == dlist.end() || it->payloadSize() < 1 ? 0 : it->payload()[0];
+}
+
+ts::UString ts::SDTView::Service::providerName(const DuckContext& duck) const
+{
+    return getString(duck, 0);
+}
+
+ts::UString ts::SDTView::Service::serviceName(const DuckContext& duck) const
+{
+    return getString(duck, 1);
+}
+
+ts::UString ts::SDTView::Service::getString(const DuckContext& duck, size_t index) const
+{
+    const DescriptorListView dlist(descriptors());
+    const DescriptorListView::const_iterator it(dlist.search(DID_SERVICE));
+    if (it == dlist.end() || it->payloadSize() < 1) {
+        return UString();
+    }
+
+    // Skip service type, then skip the strings before the requested one.
+    const uint8_t* data = it->payload() + 1;
+    size_t size = it->payloadSize() - 1;
+    for (; index > 0 && size > 0; --index) {
+        const size_t len = std::min<size_t>(1 + data[0], size);
+        data += len;
+        size -= len;
+    }
+    return duck.decodedWithByteLength(data, size);
+}
@@ -0,0 +1,180 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view of a binary Service Description Table (SDT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTableView.h"
+#include "tsDescriptorListView.h"
+#include "tsMemory.h"
+
+namespace ts {
+
+    class DuckContext;
+
+    //!
+    //! Read-only view of a binary Service Description Table (SDT).
+    //! @ingroup mpeg
+    //! @see ETSI EN 300 468, 5.2.3
+    //!
+    //! The view iterates over the services and descriptors of the SDT, in all
+    //! sections, without deserializing it. Only strings are decoded, on demand.
+    //!
+    class TSDUCKDLL SDTView : public AbstractTableView
+    {
+        TS_NOBUILD_NOCOPY(SDTView);
+    public:
+        //!
+        //! Read-only view of a service entry.
+        //!
+        class TSDUCKDLL Service
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the entry.
+            //! @param [in] size Size of the entry.
+            //!
+            Service(const uint8_t* data = nullptr, size_t size = 0) : _data(data), _size(size) {}
+            //!
+            //! Get the service id.
+            //! @return The service id.
+            //!
+            uint16_t serviceId() const { return GetUInt16(_data); }
+            //!
+            //! Check if EIT schedule are present for the service.
+            //! @return True if EIT schedule are present.
+            //!
+            bool EITsPresent() const { return (_data[2] & 0x02) != 0; }
+            //!
+            //! Check if EIT present/following are present for the service.
+            //! @return True if EIT present/following are present.
+            //!
+            bool EITpfPresent() const { return (_data[2] & 0x01) != 0; }
+            //!
+            //! Get the running status of the service.
+            //! @return The running status of the service.
+            //!
+            uint8_t runningStatus() const { return uint8_t(_data[3] >> 5); }
+            //!
+            //! Check if the service is controlled by a CA system.
+            //! @return True if the service is controlled by a CA system.
+            //!
+            bool CAControlled() const { return (_data[3] & 0x10) != 0; }
+            //!
+            //! Get the descriptor list of the service.
+            //! @return A view of the descriptor list.
+            //!
+            DescriptorListView descriptors() const { return DescriptorListView(_data + 5, _size - 5); }
+            //!
+            //! Get the service type from the first service_descriptor.
+            //! @return The service type or zero if there is no service_descriptor.
+            //!
+            uint8_t serviceType() const;
+            //!
+            //! Get the service name from the first service_descriptor.
+            //! @param [in] duck TSDuck execution context, used to decode the string.
+            //! @return The service name or an empty string if there is no service_descriptor.
+            //!
+            UString serviceName(const DuckContext& duck) const;
+            //!
+            //! Get the provider name from the first service_descriptor.
+            //! @param [in] duck TSDuck execution context, used to decode the string.
+            //! @return The provider name or an empty string if there is no service_descriptor.
+            //!
+            UString providerName(const DuckContext& duck) const;
+        private:
+            const uint8_t* _data;
+            size_t         _size;
+            // Decode the provider name (index 0) or service name (index 1).
+            UString getString(const DuckContext& duck, size_t index) const;
+        };
+
+        //!
+        //! Iterator over the services.
+        //!
+        typedef Iterator<Service> const_iterator;
+
+        //!
+        //! Constructor.
+        //! @param [in] table The binary SDT (actual or other) to view.
+        //! It must remain valid and unmodified while the view is used.
+        //!
+        explicit SDTView(const BinaryTable& table);
+
+        //!
+        //! Get the transport stream id.
+        //! @return The transport stream id.
+        //!
+        uint16_t tsId() const { return isValid() ? table().tableIdExtension() : 0; }
+
+        //!
+        //! Get the original network id.
+        //! @return The original network id.
+        //!
+        uint16_t onetwId() const;
+
+        //!
+        //! Get an iterator to the first service.
+        //! @return An iterator to the first service.
+        //!
+        const_iterator begin() const { return const_iterator(this); }
+
+        //!
+        //! Get an iterator after the last service.
+        //! @return An iterator after the last service.
+        //!
+        const_iterator end() const { return const_iterator(); }
+
+        //!
+        //! Search a service by id.
+        //! @param [in] service_id The service id to search.
+        //! @return An iterator to the service or end() if not found.
+        //!
+        const_iterator findService(uint16_t service_id) const;
+
+        //!
+        //! Search a service by name.
+        //! @param [in] duck TSDuck execution context, used to decode the names.
+        //! @param [in] name The service name to search.
+        //! @param [in] exact_match If true, the service name must be exactly identical to @a name.
+        //! If it is false, the search is case-insensitive and blanks are ignored.
+        //! @return An iterator to the service or end() if not found.
+        //!
+        const_iterator findService(const DuckContext& duck, const UString& name, bool exact_match = false) const;
+
+    protected:
+        // Inherited methods
+        virtual size_t loopOffset(const uint8_t* payload, size_t size) const override;
+        virtual size_t entrySize(const uint8_t* data, size_t size) const override;
+    };
+}
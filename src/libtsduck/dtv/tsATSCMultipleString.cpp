@@ -580,8 +580,7 @@ void ts::ATSCMultipleString::Display(TablesDisplay& display, const UString& titl
 {
     if (buffer != nullptr && buffer_size > 0 && mss_size > 0) {
 
-        DuckContext& duck(display.duck());
-        std::ostream& strm(duck.out());
+        std::ostream& strm(display.out());
         StringElement elem;
 
         // Get number of strings.
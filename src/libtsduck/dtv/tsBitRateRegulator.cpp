@@ -31,6 +31,10 @@
 #include "tsNullReport.h"
 TSDUCK_SOURCE;
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr ts::NanoSecond ts::BitRateRegulator::PRECISE_MIN_BURST_NS;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructor
@@ -40,6 +44,8 @@ ts::BitRateRegulator::BitRateRegulator(Report* report, int log_level) :
     _report(report == nullptr ? NullReport::Instance() : report),
     _log_level(log_level),
     _state(INITIAL),
+    _precise(false),
+    _spin(Monotonic::DEFAULT_SPIN_NS),
     _opt_bitrate(0),
     _cur_bitrate(0),
     _opt_burst(0),
@@ -76,9 +82,10 @@ void ts::BitRateRegulator::start()
     // wait on durations lower than the minimum, this will introduce
     // latencies which mess up the regulation. We try to request 2
     // milliseconds as time precision and we keep what the operating
-    // system gives.
+    // system gives. With precise pacing, the final active wait removes
+    // this limitation.
 
-    _burst_min = Monotonic::SetPrecision(2000000); // 2 milliseconds in nanoseconds
+    _burst_min = _precise ? PRECISE_MIN_BURST_NS : Monotonic::SetPrecision(2000000); // 2 milliseconds in nanoseconds
 
     _report->log(_log_level, u"minimum packet burst duration is %'d nano-seconds", {_burst_min});
 
@@ -105,10 +112,12 @@ void ts::BitRateRegulator::handleNewBitrate()
     _burst_duration = (NanoSecPerSec * PKT_SIZE * 8 * _burst_pkt_max) / _cur_bitrate;
 
     // If the result is too small for the time precision of the operating
-    // system, recompute a larger burst duration
+    // system, recompute a larger burst duration. Round the number of packets
+    // up and recompute the exact duration of that number of packets, otherwise
+    // the bitrate is slightly lower than expected.
     if (_burst_duration < _burst_min) {
-        _burst_duration = _burst_min;
-        _burst_pkt_max = (_burst_duration * _cur_bitrate) / (NanoSecPerSec * PKT_SIZE * 8);
+        _burst_pkt_max = (_burst_min * _cur_bitrate + NanoSecPerSec * PKT_SIZE * 8 - 1) / (NanoSecPerSec * PKT_SIZE * 8);
+        _burst_duration = (NanoSecPerSec * PKT_SIZE * 8 * _burst_pkt_max) / _cur_bitrate;
     }
 
     _report->debug(u"new regulation, burst: %'d nano-seconds, %'d packets", {_burst_duration, _burst_pkt_max});
@@ -142,7 +151,12 @@ void ts::BitRateRegulator::regulatePacket(bool& flush, bool smoothen)
     // Recheck end of burst, just in case we added some more packets to smoothen.
     if (_burst_pkt_cnt == 0) {
         // Wait until scheduled end of burst.
-        _burst_end.wait();
+        if (_precise) {
+            _burst_end.preciseWait(_spin);
+        }
+        else {
+            _burst_end.wait();
+        }
         // Restart a new burst, use monotonic time
         _burst_pkt_cnt = _burst_pkt_max;
         _burst_end += _burst_duration;
@@ -79,6 +79,28 @@ namespace ts {
             _opt_bitrate = bitrate;
         }
 
+        //!
+        //! Minimum duration of a burst with precise pacing, in nano-seconds.
+        //!
+        static constexpr NanoSecond PRECISE_MIN_BURST_NS = 20 * NanoSecPerMicroSec;
+
+        //!
+        //! Enable or disable precise pacing.
+        //! By default, the regulator waits using the system timers and bursts
+        //! are at least 2 milliseconds long (or longer, depending on the system).
+        //! With precise pacing, bursts can be as short as one packet and each burst
+        //! is released at its own due time using Monotonic::preciseWait().
+        //! Must be called before start().
+        //! @param [in] precise If true, use precise pacing.
+        //! @param [in] spin Duration of the final active wait in nano-seconds.
+        //! @see Monotonic::preciseWait()
+        //!
+        void setPrecise(bool precise, NanoSecond spin = Monotonic::DEFAULT_SPIN_NS)
+        {
+            _precise = precise;
+            _spin = spin;
+        }
+
         //!
         //! Start regulation, initialize all timers.
         //!
@@ -108,6 +130,8 @@ namespace ts {
         Report*       _report;
         int           _log_level;
         State         _state;           // Current regulation state
+        bool          _precise;         // Use precise pacing
+        NanoSecond    _spin;            // Active wait duration with precise pacing
         BitRate       _opt_bitrate;     // Bitrate option, zero means use input
         BitRate       _cur_bitrate;     // Current bitrate
         PacketCounter _opt_burst;       // Number of packets to burst at a time
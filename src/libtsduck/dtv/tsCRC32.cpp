@@ -32,6 +32,23 @@
 //----------------------------------------------------------------------------
 
 #include "tsCRC32.h"
+#include "tsSysInfo.h"
+#include "tsMemory.h"
+
+// Carry-less multiplication support, when the compiler can generate it.
+#if (defined(TS_I386) || defined(TS_X86_64)) && (defined(TS_GCC) || defined(TS_MSC))
+    #define TS_CRC32_X86 1
+    #include <immintrin.h>
+    #if defined(TS_GCC)
+        #define TS_CRC32_TARGET __attribute__((target("pclmul,ssse3")))
+    #else
+        #define TS_CRC32_TARGET
+    #endif
+#elif defined(TS_ARM64) && defined(__ARM_FEATURE_CRYPTO)
+    #define TS_CRC32_ARM 1
+    #include <arm_neon.h>
+#endif
+
 TSDUCK_SOURCE;
 
 
@@ -41,6 +58,9 @@ TSDUCK_SOURCE;
 //     x**22 + x**23 + x**26 + x**32.
 
 namespace {
+    // The polynomial, without x**32, MSB-first (bit N is x**N).
+    constexpr uint32_t POLYNOMIAL = 0x04C11DB7;
+
     const uint32_t fcstab_32 [256] = {
         0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9,
         0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
@@ -109,13 +129,387 @@ namespace {
     };
 }
 
-// Continue the computation of a data area, following a previous CRC32
 
-void ts::CRC32::add (const void* data, size_t size)
-{
-    const uint8_t* cp = static_cast <const uint8_t*> (data);
+//----------------------------------------------------------------------------
+// Polynomial arithmetics modulo the FCS-32 generator polynomial.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Multiply two polynomials modulo the generator polynomial.
+    uint32_t MultModP(uint32_t a, uint32_t b)
+    {
+        uint32_t res = 0;
+        for (uint32_t mask = 0x80000000; mask != 0; mask >>= 1) {
+            res = (res << 1) ^ ((res & 0x80000000) != 0 ? POLYNOMIAL : 0);
+            if ((b & mask) != 0) {
+                res ^= a;
+            }
+        }
+        return res;
+    }
+
+    // Compute x**n modulo the generator polynomial, in log(n) steps.
+    uint32_t XPowModP(uint64_t n)
+    {
+        // Table of x**(2**i) modulo the generator polynomial.
+        struct PowersOfTwo {
+            uint32_t pow[64];
+            PowersOfTwo()
+            {
+                pow[0] = 0x00000002; // x**1
+                for (size_t i = 1; i < 64; ++i) {
+                    pow[i] = MultModP(pow[i-1], pow[i-1]);
+                }
+            }
+        };
+        static const PowersOfTwo p2;
+
+        uint32_t res = 0x00000001; // x**0
+        for (size_t i = 0; n != 0; ++i, n >>= 1) {
+            if ((n & 1) != 0) {
+                res = MultModP(res, p2.pow[i]);
+            }
+        }
+        return res;
+    }
+
+    // Compute x**(8*size) modulo the generator polynomial, in constant time.
+    // With tab[k][v] = x**(8 * v * 256**k), one multiplication per non-zero byte of size.
+    uint32_t BytesPowModP(size_t size)
+    {
+        struct PowersOfBytes {
+            uint32_t tab[sizeof(size_t)][256];
+            PowersOfBytes()
+            {
+                for (size_t k = 0; k < sizeof(size_t); ++k) {
+                    tab[k][0] = 0x00000001; // x**0
+                    tab[k][1] = XPowModP(uint64_t(8) << (8 * k));
+                    for (size_t v = 2; v < 256; ++v) {
+                        tab[k][v] = MultModP(tab[k][v-1], tab[k][1]);
+                    }
+                }
+            }
+        };
+        static const PowersOfBytes pb;
 
-    while (size-- > 0) {
-        _fcs = (_fcs << 8) ^ fcstab_32 [((_fcs >> 24) ^ (*cp++)) & 0xFF];
+        uint32_t res = 0x00000001; // x**0
+        for (size_t k = 0; size != 0; ++k, size >>= 8) {
+            if ((size & 0xFF) != 0) {
+                res = MultModP(res, pb.tab[k][size & 0xFF]);
+            }
+        }
+        return res;
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Portable software implementations.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Tables for slice-by-N algorithms: tab[k][b] is the CRC of byte b followed by k zero bytes.
+    struct SliceTables {
+        uint32_t tab[16][256];
+        SliceTables()
+        {
+            for (size_t b = 0; b < 256; ++b) {
+                tab[0][b] = fcstab_32[b];
+                for (size_t k = 1; k < 16; ++k) {
+                    tab[k][b] = (tab[k-1][b] << 8) ^ fcstab_32[tab[k-1][b] >> 24];
+                }
+            }
+        }
+    };
+
+    const SliceTables& Slices()
+    {
+        static const SliceTables slices;
+        return slices;
+    }
+
+    // Classical byte-at-a-time algorithm.
+    uint32_t AddBytewise(uint32_t fcs, const uint8_t* cp, size_t size)
+    {
+        while (size-- > 0) {
+            fcs = (fcs << 8) ^ fcstab_32[((fcs >> 24) ^ (*cp++)) & 0xFF];
+        }
+        return fcs;
+    }
+
+    // Slice-by-8 algorithm.
+    uint32_t AddSlice8(uint32_t fcs, const uint8_t* cp, size_t size)
+    {
+        const SliceTables& st(Slices());
+        while (size >= 8) {
+            fcs ^= ts::GetUInt32(cp);
+            fcs = st.tab[7][fcs >> 24] ^ st.tab[6][(fcs >> 16) & 0xFF] ^ st.tab[5][(fcs >> 8) & 0xFF] ^ st.tab[4][fcs & 0xFF] ^
+                  st.tab[3][cp[4]] ^ st.tab[2][cp[5]] ^ st.tab[1][cp[6]] ^ st.tab[0][cp[7]];
+            cp += 8;
+            size -= 8;
+        }
+        return AddBytewise(fcs, cp, size);
+    }
+
+    // Slice-by-16 algorithm.
+    uint32_t AddSlice16(uint32_t fcs, const uint8_t* cp, size_t size)
+    {
+        const SliceTables& st(Slices());
+        while (size >= 16) {
+            fcs ^= ts::GetUInt32(cp);
+            fcs = st.tab[15][fcs >> 24] ^ st.tab[14][(fcs >> 16) & 0xFF] ^ st.tab[13][(fcs >> 8) & 0xFF] ^ st.tab[12][fcs & 0xFF] ^
+                  st.tab[11][cp[4]] ^ st.tab[10][cp[5]] ^ st.tab[9][cp[6]] ^ st.tab[8][cp[7]] ^
+                  st.tab[7][cp[8]] ^ st.tab[6][cp[9]] ^ st.tab[5][cp[10]] ^ st.tab[4][cp[11]] ^
+                  st.tab[3][cp[12]] ^ st.tab[2][cp[13]] ^ st.tab[1][cp[14]] ^ st.tab[0][cp[15]];
+            cp += 16;
+            size -= 16;
+        }
+        return AddBytewise(fcs, cp, size);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Hardware-accelerated implementations, using carry-less multiplications.
+//
+// The data are processed as polynomials, MSB-first. Blocks of 128 bits are
+// "folded" forward: X * x**d is congruent to H * (x**(64+d) mod P) + L * (x**d mod P)
+// where H and L are the high and low 64-bit halves of X. Four blocks are folded
+// in parallel. The final 128-bit remainder is reduced using the tables.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Minimum data size for the accelerated algorithms.
+    constexpr size_t MIN_ACCELERATED_SIZE = 64;
+
+    // Folding constants.
+    struct FoldConstants {
+        uint64_t k512_hi;  // x**(512+64) mod P
+        uint64_t k512_lo;  // x**512 mod P
+        uint64_t k128_hi;  // x**(128+64) mod P
+        uint64_t k128_lo;  // x**128 mod P
+        FoldConstants() :
+            k512_hi(XPowModP(512 + 64)),
+            k512_lo(XPowModP(512)),
+            k128_hi(XPowModP(128 + 64)),
+            k128_lo(XPowModP(128))
+        {
+        }
+    };
+
+    const FoldConstants& Folds()
+    {
+        static const FoldConstants folds;
+        return folds;
+    }
+
+#if defined(TS_CRC32_X86)
+
+    // Load 16 bytes as a big-endian 128-bit integer.
+    TS_CRC32_TARGET inline __m128i Load128(const uint8_t* cp, __m128i bswap)
+    {
+        return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cp)), bswap);
+    }
+
+    // Fold a 128-bit block.
+    TS_CRC32_TARGET inline __m128i Fold128(__m128i x, __m128i k)
+    {
+        return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00));
+    }
+
+    TS_CRC32_TARGET uint32_t AddAccelerated(uint32_t fcs, const uint8_t* cp, size_t size)
+    {
+        if (size < MIN_ACCELERATED_SIZE) {
+            return AddSlice16(fcs, cp, size);
+        }
+
+        const FoldConstants& fc(Folds());
+        const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m128i k512 = _mm_set_epi64x(int64_t(fc.k512_hi), int64_t(fc.k512_lo));
+        const __m128i k128 = _mm_set_epi64x(int64_t(fc.k128_hi), int64_t(fc.k128_lo));
+
+        // Load the first four blocks. The current CRC is merged in the first 32 bits.
+        __m128i x0 = _mm_xor_si128(Load128(cp, bswap), _mm_set_epi32(int32_t(fcs), 0, 0, 0));
+        __m128i x1 = Load128(cp + 16, bswap);
+        __m128i x2 = Load128(cp + 32, bswap);
+        __m128i x3 = Load128(cp + 48, bswap);
+        cp += 64;
+        size -= 64;
+
+        // Fold four blocks in parallel.
+        while (size >= 64) {
+            x0 = _mm_xor_si128(Fold128(x0, k512), Load128(cp, bswap));
+            x1 = _mm_xor_si128(Fold128(x1, k512), Load128(cp + 16, bswap));
+            x2 = _mm_xor_si128(Fold128(x2, k512), Load128(cp + 32, bswap));
+            x3 = _mm_xor_si128(Fold128(x3, k512), Load128(cp + 48, bswap));
+            cp += 64;
+            size -= 64;
+        }
+
+        // Fold the four blocks into one, then the remaining full blocks.
+        x1 = _mm_xor_si128(Fold128(x0, k128), x1);
+        x2 = _mm_xor_si128(Fold128(x1, k128), x2);
+        x3 = _mm_xor_si128(Fold128(x2, k128), x3);
+        while (size >= 16) {
+            x3 = _mm_xor_si128(Fold128(x3, k128), Load128(cp, bswap));
+            cp += 16;
+            size -= 16;
+        }
+
+        // The CRC of the 128-bit remainder, from a zero state, is the CRC so far.
+        uint8_t rem[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rem), _mm_shuffle_epi8(x3, bswap));
+        fcs = AddSlice16(0, rem, sizeof(rem));
+
+        // Process the trailing bytes.
+        return AddBytewise(fcs, cp, size);
+    }
+
+#elif defined(TS_CRC32_ARM)
+
+    // Load 16 bytes as a big-endian 128-bit integer.
+    inline uint64x2_t Load128(const uint8_t* cp)
+    {
+        const uint8x16_t b = vrev64q_u8(vld1q_u8(cp));
+        return vreinterpretq_u64_u8(vextq_u8(b, b, 8));
+    }
+
+    // Store a 128-bit integer as 16 big-endian bytes.
+    inline void Store128(uint8_t* cp, uint64x2_t x)
+    {
+        const uint8x16_t b = vrev64q_u8(vreinterpretq_u8_u64(x));
+        vst1q_u8(cp, vextq_u8(b, b, 8));
+    }
+
+    // Fold a 128-bit block.
+    inline uint64x2_t Fold128(uint64x2_t x, poly64_t k_hi, poly64_t k_lo)
+    {
+        const poly128_t hi = vmull_p64(poly64_t(vgetq_lane_u64(x, 1)), k_hi);
+        const poly128_t lo = vmull_p64(poly64_t(vgetq_lane_u64(x, 0)), k_lo);
+        return veorq_u64(vreinterpretq_u64_p128(hi), vreinterpretq_u64_p128(lo));
+    }
+
+    uint32_t AddAccelerated(uint32_t fcs, const uint8_t* cp, size_t size)
+    {
+        if (size < MIN_ACCELERATED_SIZE) {
+            return AddSlice16(fcs, cp, size);
+        }
+
+        const FoldConstants& fc(Folds());
+        const poly64_t k512_hi = poly64_t(fc.k512_hi);
+        const poly64_t k512_lo = poly64_t(fc.k512_lo);
+        const poly64_t k128_hi = poly64_t(fc.k128_hi);
+        const poly64_t k128_lo = poly64_t(fc.k128_lo);
+
+        // Load the first four blocks. The current CRC is merged in the first 32 bits.
+        uint64x2_t x0 = veorq_u64(Load128(cp), vsetq_lane_u64(uint64_t(fcs) << 32, vdupq_n_u64(0), 1));
+        uint64x2_t x1 = Load128(cp + 16);
+        uint64x2_t x2 = Load128(cp + 32);
+        uint64x2_t x3 = Load128(cp + 48);
+        cp += 64;
+        size -= 64;
+
+        // Fold four blocks in parallel.
+        while (size >= 64) {
+            x0 = veorq_u64(Fold128(x0, k512_hi, k512_lo), Load128(cp));
+            x1 = veorq_u64(Fold128(x1, k512_hi, k512_lo), Load128(cp + 16));
+            x2 = veorq_u64(Fold128(x2, k512_hi, k512_lo), Load128(cp + 32));
+            x3 = veorq_u64(Fold128(x3, k512_hi, k512_lo), Load128(cp + 48));
+            cp += 64;
+            size -= 64;
+        }
+
+        // Fold the four blocks into one, then the remaining full blocks.
+        x1 = veorq_u64(Fold128(x0, k128_hi, k128_lo), x1);
+        x2 = veorq_u64(Fold128(x1, k128_hi, k128_lo), x2);
+        x3 = veorq_u64(Fold128(x2, k128_hi, k128_lo), x3);
+        while (size >= 16) {
+            x3 = veorq_u64(Fold128(x3, k128_hi, k128_lo), Load128(cp));
+            cp += 16;
+            size -= 16;
+        }
+
+        // The CRC of the 128-bit remainder, from a zero state, is the CRC so far.
+        uint8_t rem[16];
+        Store128(rem, x3);
+        fcs = AddSlice16(0, rem, sizeof(rem));
+
+        // Process the trailing bytes.
+        return AddBytewise(fcs, cp, size);
+    }
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Algorithm selection.
+//----------------------------------------------------------------------------
+
+namespace {
+    typedef uint32_t (*AddFunction)(uint32_t, const uint8_t*, size_t);
+
+    AddFunction GetAddFunction(ts::CRC32::Algorithm algo)
+    {
+        switch (algo) {
+            case ts::CRC32::BYTEWISE:
+                return AddBytewise;
+            case ts::CRC32::SLICE8:
+                return AddSlice8;
+            case ts::CRC32::SLICE16:
+                return AddSlice16;
+            case ts::CRC32::ACCELERATED:
+            case ts::CRC32::DEFAULT:
+            default:
+#if defined(TS_CRC32_X86) || defined(TS_CRC32_ARM)
+                if (ts::CRC32::IsAvailable(ts::CRC32::ACCELERATED)) {
+                    return AddAccelerated;
+                }
+#endif
+                return AddSlice16;
+        }
+    }
+}
+
+bool ts::CRC32::IsAvailable(Algorithm algo)
+{
+    if (algo == ACCELERATED) {
+#if defined(TS_CRC32_X86) || defined(TS_CRC32_ARM)
+        return SysInfo::Instance()->crcInstructions();
+#else
+        return false;
+#endif
+    }
+    else {
+        return true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Continue the computation of a data area, following a previous CRC32.
+//----------------------------------------------------------------------------
+
+void ts::CRC32::add(const void* data, size_t size)
+{
+    // The selection of the fastest algorithm is done once.
+    static const AddFunction add_function = GetAddFunction(DEFAULT);
+    _fcs = add_function(_fcs, static_cast<const uint8_t*>(data), size);
+}
+
+void ts::CRC32::add(const void* data, size_t size, Algorithm algo)
+{
+    _fcs = GetAddFunction(algo)(_fcs, static_cast<const uint8_t*>(data), size);
+}
+
+
+//----------------------------------------------------------------------------
+// Combine the CRC32 values of two consecutive data areas.
+//----------------------------------------------------------------------------
+
+uint32_t ts::CRC32::Combine(uint32_t crc1, uint32_t crc2, size_t size2)
+{
+    // Processing the second area from the state crc1 instead of the initial state
+    // differs by (crc1 xor initial_state) * x**(8 * size2), modulo the polynomial.
+    return crc2 ^ MultModP(crc1 ^ 0xFFFFFFFF, BytesPowModP(size2));
+}
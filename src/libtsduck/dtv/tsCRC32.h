@@ -61,13 +61,63 @@ namespace ts {
             add(data, size);
         }
 
+        //!
+        //! Algorithms to compute a CRC32.
+        //! All algorithms produce the same result. Only the performance differs.
+        //!
+        enum Algorithm {
+            DEFAULT,      //!< Fastest algorithm which is available on the current CPU.
+            BYTEWISE,     //!< Classical byte-at-a-time algorithm with one 256-entry table.
+            SLICE8,       //!< Slice-by-8 algorithm, 8 bytes at a time with 8 tables.
+            SLICE16,      //!< Slice-by-16 algorithm, 16 bytes at a time with 16 tables.
+            ACCELERATED   //!< Carry-less multiplication folding (PCLMULQDQ on Intel, PMULL on Arm).
+        };
+
+        //!
+        //! Check if an algorithm is available on the current CPU.
+        //! @param [in] algo The algorithm to check.
+        //! @return True if @a algo can be used on the current CPU.
+        //!
+        static bool IsAvailable(Algorithm algo);
+
         //!
         //! Continue the computation of a data area, following a previous CRC32.
+        //! The fastest available algorithm is used.
         //! @param [in] data Address of area to analyze.
         //! @param [in] size Size in bytes of area to analyze.
         //!
         void add(const void* data, size_t size);
 
+        //!
+        //! Continue the computation of a data area, following a previous CRC32, using a specific algorithm.
+        //! This is typically used for tests and benchmarks.
+        //! @param [in] data Address of area to analyze.
+        //! @param [in] size Size in bytes of area to analyze.
+        //! @param [in] algo The algorithm to use. If not available on the current CPU, use the default one.
+        //!
+        void add(const void* data, size_t size, Algorithm algo);
+
+        //!
+        //! Combine with the CRC32 of a following data area.
+        //! After this call, this object contains the CRC32 of the concatenation of the two data areas,
+        //! without reprocessing the data. The cost is constant, independent of @a next_size.
+        //! @param [in] next The CRC32 of the following data area, computed from the initial state.
+        //! @param [in] next_size Size in bytes of the following data area.
+        //!
+        void combine(const CRC32& next, size_t next_size)
+        {
+            _fcs = Combine(_fcs, next._fcs, next_size);
+        }
+
+        //!
+        //! Combine the CRC32 values of two consecutive data areas.
+        //! @param [in] crc1 CRC32 of the first data area, computed from the initial state.
+        //! @param [in] crc2 CRC32 of the second data area, computed from the initial state.
+        //! @param [in] size2 Size in bytes of the second data area.
+        //! @return The CRC32 of the concatenation of the two data areas.
+        //!
+        static uint32_t Combine(uint32_t crc1, uint32_t crc2, size_t size2);
+
         //!
         //! Get the value of the CRC32 as computed so far.
         //! @return The value of the CRC32 as computed so far.
@@ -46,6 +46,7 @@ ts::CyclingPacketizer::CyclingPacketizer(const DuckContext& duck, PID pid, Stuff
     _bitrate(bitrate),
     _section_count(0),
     _sched_sections(),
+    _sched_count(0),
     _other_sections(),
     _sched_packets(0),
     _current_cycle(1),
@@ -145,7 +146,7 @@ bool ts::CyclingPacketizer::SectionDesc::insertAfter(const SectionDesc& other) c
 
 
 //----------------------------------------------------------------------------
-// Insert a scheduled section in the list, sorted by due_packet.
+// Insert a scheduled section, according to its due_packet.
 //----------------------------------------------------------------------------
 
 void ts::CyclingPacketizer::addScheduledSection(const SectionDescPtr& sect)
@@ -155,11 +156,14 @@ void ts::CyclingPacketizer::addScheduledSection(const SectionDescPtr& sect)
                   sect->section->sectionNumber(), sect->section->lastSectionNumber(),
                   sect->last_cycle, sect->last_packet, sect->due_packet});
 
-    auto it = _sched_sections.begin();
-    while (it != _sched_sections.end() && sect->insertAfter(**it)) {
+    // Only the sections with the same due packet need to be compared.
+    SectionDescList& list(_sched_sections[sect->due_packet]);
+    auto it = list.begin();
+    while (it != list.end() && sect->insertAfter(**it)) {
         ++it;
     }
-    _sched_sections.insert(it, sect);
+    list.insert(it, sect);
+    _sched_count++;
 }
 
 
@@ -195,8 +199,7 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, MilliSecond rep_r
 
 void ts::CyclingPacketizer::removeSections(TID tid)
 {
-    removeSections(_sched_sections, tid, 0, false, true);
-    removeSections(_other_sections, tid, 0, false, false);
+    removeSections(tid, 0, false);
 }
 
 
@@ -206,8 +209,27 @@ void ts::CyclingPacketizer::removeSections(TID tid)
 
 void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext)
 {
-    removeSections(_sched_sections, tid, tid_ext, true, true);
-    removeSections(_other_sections, tid, tid_ext, true, false);
+    removeSections(tid, tid_ext, true);
+}
+
+
+//----------------------------------------------------------------------------
+// Remove all sections with the specified tid/tid_ext in all lists.
+//----------------------------------------------------------------------------
+
+void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext, bool use_tid_ext)
+{
+    auto it = _sched_sections.begin();
+    while (it != _sched_sections.end()) {
+        _sched_count -= removeSections(it->second, tid, tid_ext, use_tid_ext, true);
+        if (it->second.empty()) {
+            it = _sched_sections.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    removeSections(_other_sections, tid, tid_ext, use_tid_ext, false);
 }
 
 
@@ -215,8 +237,9 @@ void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext)
 // Remove all sections with the specified tid/tid_ext in the specified list.
 //----------------------------------------------------------------------------
 
-void ts::CyclingPacketizer::removeSections(SectionDescList& list, TID tid, uint16_t tid_ext, bool use_tid_ext, bool scheduled)
+size_t ts::CyclingPacketizer::removeSections(SectionDescList& list, TID tid, uint16_t tid_ext, bool use_tid_ext, bool scheduled)
 {
+    size_t count = 0;
     SectionDescList::iterator it(list.begin());
     while (it != list.end()) {
         const SectionDescPtr& sp(*it);
@@ -234,11 +257,13 @@ void ts::CyclingPacketizer::removeSections(SectionDescList& list, TID tid, uint1
                 _sched_packets -= sect.packetCount();
             }
             it = list.erase(it);
+            count++;
         }
         else {
             ++it;
         }
     }
+    return count;
 }
 
 
@@ -252,6 +277,7 @@ void ts::CyclingPacketizer::removeAll()
     _remain_in_cycle = 0;
     _sched_packets = 0;
     _sched_sections.clear();
+    _sched_count = 0;
     _other_sections.clear();
 }
 
@@ -283,10 +309,11 @@ void ts::CyclingPacketizer::setBitRate(BitRate new_bitrate)
     else if (new_bitrate == 0) {
         // Bitrate now unknown, unable to schedule sections, move them all
         // into the list of unscheduled sections.
-        while (!_sched_sections.empty()) {
-            _other_sections.push_back(_sched_sections.front());
-            _sched_sections.pop_front();
+        for (auto it = _sched_sections.begin(); it != _sched_sections.end(); ++it) {
+            _other_sections.splice(_other_sections.end(), it->second);
         }
+        _sched_sections.clear();
+        _sched_count = 0;
         _sched_packets = 0;
     }
     else if (_bitrate == 0) {
@@ -315,7 +342,11 @@ void ts::CyclingPacketizer::setBitRate(BitRate new_bitrate)
         // Old and new bitrate not null. Compute new due packet for all
         // scheduled sections and re-sort list according to new due packet.
         SectionDescList tmp_list;
-        tmp_list.swap(_sched_sections);
+        for (auto it = _sched_sections.begin(); it != _sched_sections.end(); ++it) {
+            tmp_list.splice(tmp_list.end(), it->second);
+        }
+        _sched_sections.clear();
+        _sched_count = 0;
         while (!tmp_list.empty()) {
             SectionDesc* sp(tmp_list.back().pointer());
             sp->due_packet = sp->last_packet + PacketDistance(new_bitrate, sp->repetition);
@@ -358,10 +389,15 @@ void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& s
          // .. or previous unscheduled section passed in this cycle a long time ago
          spp->last_packet + spp->section->packetCount() + _sched_packets < current_packet);
 
-    if (!force_unscheduled && !_sched_sections.empty() && _sched_sections.front()->due_packet <= current_packet) {
+    if (!force_unscheduled && !_sched_sections.empty() && _sched_sections.begin()->first <= current_packet) {
         // One scheduled section is ready
-        sp = _sched_sections.front();
-        _sched_sections.pop_front();
+        const auto first = _sched_sections.begin();
+        sp = first->second.front();
+        first->second.pop_front();
+        if (first->second.empty()) {
+            _sched_sections.erase(first);
+        }
+        _sched_count--;
         // Reschedule the section. Make sure we add at least one packet to
         // ensure that all scheduled sections may pass.
         sp->due_packet = current_packet + std::max(PacketCounter(1), PacketDistance(_bitrate, sp->repetition));
@@ -453,10 +489,12 @@ std::ostream& ts::CyclingPacketizer::display(std::ostream& strm) const
         << "  Remaining sections in cycle: " << _remain_in_cycle << std::endl
         << "  Section cycle end: " << (_cycle_end == UNDEFINED ? u"undefined" : UString::Decimal(_cycle_end)) << std::endl
         << "  Stored sections: " << _section_count << std::endl
-        << "  Scheduled sections: " << _sched_sections.size() << std::endl
+        << "  Scheduled sections: " << _sched_count << std::endl
         << "  Scheduled packets max: " << _sched_packets << std::endl;
-    for (SectionDescList::const_iterator it = _sched_sections.begin(); it != _sched_sections.end(); ++it) {
-        (*it)->display(duck(), strm);
+    for (SectionDescMap::const_iterator it1 = _sched_sections.begin(); it1 != _sched_sections.end(); ++it1) {
+        for (SectionDescList::const_iterator it2 = it1->second.begin(); it2 != it1->second.end(); ++it2) {
+            (*it2)->display(duck(), strm);
+        }
     }
     strm << "  Unscheduled sections: " << _other_sections.size() << std::endl;
     for (SectionDescList::const_iterator it = _other_sections.begin(); it != _other_sections.end(); ++it) {
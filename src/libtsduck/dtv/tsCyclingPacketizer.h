@@ -65,6 +65,10 @@ namespace ts {
     //! Note that when sections have different repetition rates, some
     //! sections may be repeated into one cycle of the Packetizer.
     //!
+    //! Scheduled sections are indexed by due packet. The cost of providing
+    //! a section is logarithmic with the number of scheduled sections,
+    //! allowing large carousels such as EIT schedule.
+    //!
     //! Section stuffing may occur at the end of a section. If the section
     //! ends in the middle of an MPEG packet, the beginning of the next section
     //! can start immediately or can be delayed to the beginning of the next
@@ -241,11 +245,16 @@ namespace ts {
         // List of sections
         typedef std::list <SectionDescPtr> SectionDescList;
 
+        // Lists of scheduled sections, indexed by due packet.
+        // In each list, all sections have the same due packet.
+        typedef std::map <PacketCounter, SectionDescList> SectionDescMap;
+
         // Private members:
         StuffingPolicy  _stuffing;
         BitRate         _bitrate;
         size_t          _section_count;   // Number of sections in the 2 lists
-        SectionDescList _sched_sections;  // Scheduled sections, with repetition rates
+        SectionDescMap  _sched_sections;  // Scheduled sections, with repetition rates, by due packet
+        size_t          _sched_count;     // Number of sections in _sched_sections
         SectionDescList _other_sections;  // Unscheduled sections
         PacketCounter   _sched_packets;   // Size in TS packets of all sections in _sched_sections
         SectionCounter  _current_cycle;   // Cycle number (start at 1, always increasing)
@@ -254,11 +263,15 @@ namespace ts {
 
         static const SectionCounter UNDEFINED = ~SectionCounter(0);
 
-        // Insert a scheduled section in the list, sorted by due_packet.
+        // Insert a scheduled section, according to its due_packet.
         void addScheduledSection(const SectionDescPtr&);
 
+        // Remove all sections with the specified tid/tid_ext in the scheduled and unscheduled sections.
+        void removeSections(TID, uint16_t tid_ext, bool use_tid_ext);
+
         // Remove all sections with the specified tid/tid_ext in the specified list.
-        void removeSections(SectionDescList&, TID, uint16_t tid_ext, bool use_tid_ext, bool scheduled);
+        // Return the number of removed sections.
+        size_t removeSections(SectionDescList&, TID, uint16_t tid_ext, bool use_tid_ext, bool scheduled);
 
         // Inherited from SectionProviderInterface
         virtual void provideSection(SectionCounter, SectionPtr&) override;
@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "tsDescriptorListView.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Iterator.
+//----------------------------------------------------------------------------
+
+ts::DescriptorListView::const_iterator::const_iterator(const uint8_t* data, const uint8_t* end) :
+    _data(data),
+    _end(end),
+    _desc(data)
+{
+    validate();
+}
+
+// Become an end iterator if there is no complete descriptor at current position.
+void ts::DescriptorListView::const_iterator::validate()
+{
+    if (_data != nullptr && (_data + 2 > _end || _data + 2 + _data[1] > _end)) {
+        _data = _end = nullptr;
+    }
+    _desc = DescriptorView(_data);
+}
+
+ts::DescriptorListView::const_iterator& ts::DescriptorListView::const_iterator::operator++()
+{
+    if (_data != nullptr) {
+        _data += 2 + size_t(_data[1]);
+        validate();
+    }
+    return *this;
+}
+
+ts::DescriptorListView::const_iterator ts::DescriptorListView::const_iterator::operator++(int)
+{
+    const_iterator previous(*this);
+    ++*this;
+    return previous;
+}
+
+
+//----------------------------------------------------------------------------
+// Count, check and search descriptors.
+//----------------------------------------------------------------------------
+
+size_t ts::DescriptorListView::count() const
+{
+    size_t n = 0;
+    for (const_iterator it = begin(); it != end(); ++it) {
+        n++;
+    }
+    return n;
+}
+
+bool ts::DescriptorListView::isValid() const
+{
+    size_t total = 0;
+    for (const_iterator it = begin(); it != end(); ++it) {
+        total += it->size();
+    }
+    return total == _size;
+}
+
+ts::DescriptorListView::const_iterator ts::DescriptorListView::search(DID tag, const_iterator start) const
+{
+    while (start != end() && start->tag() != tag) {
+        ++start;
+    }
+    return start;
+}
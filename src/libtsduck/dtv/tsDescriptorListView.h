@@ -0,0 +1,209 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//!
+//!  @file
+//!  Read-only view of a list of descriptors, directly over binary data.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsMPEG.h"
+
+namespace ts {
+    //!
+    //! Read-only view of a list of descriptors, directly over binary data.
+    //! @ingroup mpeg
+    //!
+    //! Unlike DescriptorList, a DescriptorListView does not copy or decode anything.
+    //! It iterates over the descriptors in place, typically inside the sections of
+    //! a BinaryTable. The referenced memory must remain valid while the view and its
+    //! iterators are used. The iteration stops at the first truncated descriptor.
+    //!
+    class TSDUCKDLL DescriptorListView
+    {
+    public:
+        //!
+        //! Read-only view of one descriptor.
+        //!
+        class TSDUCKDLL DescriptorView
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the complete descriptor.
+            //!
+            explicit DescriptorView(const uint8_t* data = nullptr) : _data(data) {}
+            //!
+            //! Get the descriptor tag.
+            //! @return The descriptor tag.
+            //!
+            DID tag() const { return _data[0]; }
+            //!
+            //! Get the address of the complete descriptor, including the header.
+            //! @return The address of the complete descriptor.
+            //!
+            const uint8_t* content() const { return _data; }
+            //!
+            //! Get the size of the complete descriptor, including the header.
+            //! @return The size of the complete descriptor.
+            //!
+            size_t size() const { return 2 + size_t(_data[1]); }
+            //!
+            //! Get the address of the descriptor payload.
+            //! @return The address of the descriptor payload.
+            //!
+            const uint8_t* payload() const { return _data + 2; }
+            //!
+            //! Get the size of the descriptor payload.
+            //! @return The size of the descriptor payload.
+            //!
+            size_t payloadSize() const { return _data[1]; }
+        private:
+            const uint8_t* _data;
+        };
+
+        //!
+        //! Forward iterator over the descriptors of the list.
+        //!
+        class TSDUCKDLL const_iterator
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the current descriptor.
+            //! @param [in] end Address after the end of the descriptor list.
+            //!
+            const_iterator(const uint8_t* data = nullptr, const uint8_t* end = nullptr);
+            //!
+            //! Access the current descriptor.
+            //! @return A constant reference to the current descriptor view.
+            //!
+            const DescriptorView& operator*() const { return _desc; }
+            //!
+            //! Access the current descriptor.
+            //! @return A constant pointer to the current descriptor view.
+            //!
+            const DescriptorView* operator->() const { return &_desc; }
+            //!
+            //! Move to next descriptor.
+            //! @return A reference to this object.
+            //!
+            const_iterator& operator++();
+            //!
+            //! Move to next descriptor.
+            //! @return A copy of this object before the increment.
+            //!
+            const_iterator operator++(int);
+            //!
+            //! Equality operator.
+            //! @param [in] other Another iterator to compare.
+            //! @return True if the two iterators point to the same descriptor.
+            //!
+            bool operator==(const const_iterator& other) const { return _data == other._data; }
+            //!
+            //! Unequality operator.
+            //! @param [in] other Another iterator to compare.
+            //! @return True if the two iterators point to different descriptors.
+            //!
+            bool operator!=(const const_iterator& other) const { return _data != other._data; }
+        private:
+            const uint8_t* _data;
+            const uint8_t* _end;
+            DescriptorView _desc;
+            void validate();
+        };
+
+        //!
+        //! Constructor.
+        //! @param [in] data Address of the binary descriptor list.
+        //! @param [in] size Size in bytes of the binary descriptor list.
+        //!
+        DescriptorListView(const uint8_t* data = nullptr, size_t size = 0) : _data(data), _size(data == nullptr ? 0 : size) {}
+
+        //!
+        //! Get an iterator to the first descriptor.
+        //! @return An iterator to the first descriptor.
+        //!
+        const_iterator begin() const { return const_iterator(_data, _data + _size); }
+
+        //!
+        //! Get an iterator after the last descriptor.
+        //! @return An iterator after the last descriptor.
+        //!
+        const_iterator end() const { return const_iterator(); }
+
+        //!
+        //! Check if the descriptor list is empty.
+        //! @return True if the descriptor list is empty.
+        //!
+        bool empty() const { return begin() == end(); }
+
+        //!
+        //! Count the number of complete descriptors in the list.
+        //! @return The number of complete descriptors in the list.
+        //!
+        size_t count() const;
+
+        //!
+        //! Check if the binary list contains complete descriptors only, without truncated descriptor.
+        //! @return True if the binary list is well-formed.
+        //!
+        bool isValid() const;
+
+        //!
+        //! Search a descriptor with the specified tag.
+        //! @param [in] tag Tag of descriptor to search.
+        //! @param [in] start Where to start the search.
+        //! @return An iterator to the first descriptor with the specified tag, starting at @a start, or end() if not found.
+        //!
+        const_iterator search(DID tag, const_iterator start) const;
+
+        //!
+        //! Search a descriptor with the specified tag.
+        //! @param [in] tag Tag of descriptor to search.
+        //! @return An iterator to the first descriptor with the specified tag or end() if not found.
+        //!
+        const_iterator search(DID tag) const { return search(tag, begin()); }
+
+        //!
+        //! Get the address of the binary descriptor list.
+        //! @return The address of the binary descriptor list.
+        //!
+        const uint8_t* content() const { return _data; }
+
+        //!
+        //! Get the size of the binary descriptor list.
+        //! @return The size in bytes of the binary descriptor list.
+        //!
+        size_t size() const { return _size; }
+
+    private:
+        const uint8_t* _data;
+        size_t         _size;
+    };
+}
@@ -0,0 +1,352 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMappedPacketRing.h"
+#include "tsGuardCondition.h"
+#include "tsIntegerUtils.h"
+#include "tsSysUtils.h"
+#include "tsSysInfo.h"
+#include "tsNullReport.h"
+TSDUCK_SOURCE;
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::MappedPacketRing::MIN_WINDOW_PACKETS;
+constexpr size_t ts::MappedPacketRing::READ_AHEAD_WINDOWS;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors
+//----------------------------------------------------------------------------
+
+ts::MappedPacketRing::MappedPacketRing() :
+    Thread(),
+    _base(nullptr),
+    _count(0),
+    _window(MIN_WINDOW_PACKETS),
+    _window_count(0),
+    _page_size(SysInfo::Instance()->memoryPageSize()),
+#if defined(TS_WINDOWS)
+    _file(INVALID_HANDLE_VALUE),
+    _mapping(NULL),
+#else
+    _fd(-1),
+#endif
+    _mutex(),
+    _wakeup(),
+    _current(0),
+    _entered(0),
+    _terminate(false)
+{
+}
+
+ts::MappedPacketRing::~MappedPacketRing()
+{
+    close(NULLREP);
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Create the file and map it in memory.
+//----------------------------------------------------------------------------
+
+bool ts::MappedPacketRing::open(const UString& filename, size_t count, size_t window, Report& report)
+{
+    if (isOpen()) {
+        report.error(u"memory-mapped packet ring already open");
+        return false;
+    }
+    if (count == 0 || count > std::numeric_limits<size_t>::max() / sizeof(Record)) {
+        report.error(u"invalid size for memory-mapped file: %'d packets", {count});
+        return false;
+    }
+
+    const size_t file_size = count * sizeof(Record);
+    void* base = nullptr;
+
+#if defined(TS_WINDOWS)
+
+    // The file is created hidden and automatically deleted when closed.
+    _file = ::CreateFileW(filename.wc_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_NEW,
+                          FILE_ATTRIBUTE_TEMPORARY | FILE_ATTRIBUTE_HIDDEN | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+    if (_file == INVALID_HANDLE_VALUE) {
+        report.error(u"error creating %s: %s", {filename, ErrorCodeMessage()});
+        return false;
+    }
+
+    // Creating the mapping extends the file to the requested size.
+    ::LARGE_INTEGER size;
+    size.QuadPart = ::LONGLONG(file_size);
+    _mapping = ::CreateFileMappingW(_file, NULL, PAGE_READWRITE, size.HighPart, size.LowPart, NULL);
+    if (_mapping != NULL) {
+        base = ::MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, file_size);
+    }
+    if (base == nullptr) {
+        report.error(u"error mapping %s (%'d bytes): %s", {filename, file_size, ErrorCodeMessage()});
+        if (_mapping != NULL) {
+            ::CloseHandle(_mapping);
+            _mapping = NULL;
+        }
+        ::CloseHandle(_file);
+        _file = INVALID_HANDLE_VALUE;
+        return false;
+    }
+
+#else
+
+    // The file is deleted immediately, it remains accessible as long as it is open.
+    _fd = ::open(filename.toUTF8().c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (_fd < 0) {
+        report.error(u"error creating %s: %s", {filename, ErrorCodeMessage()});
+        return false;
+    }
+    ::unlink(filename.toUTF8().c_str());
+
+    // Preallocate the disk space. This avoids fragmentation and prevents a SIGBUS
+    // on a full disk when the mapped memory is written. Not all filesystems support
+    // preallocation, then simply set the file size.
+    bool success = true;
+#if defined(TS_LINUX)
+    if (::fallocate(_fd, 0, 0, off_t(file_size)) < 0) {
+        success = (errno == EOPNOTSUPP || errno == ENOSYS) && ::ftruncate(_fd, off_t(file_size)) == 0;
+    }
+#else
+    success = ::ftruncate(_fd, off_t(file_size)) == 0;
+#endif
+    if (!success) {
+        report.error(u"error allocating %'d bytes in %s: %s", {file_size, filename, ErrorCodeMessage()});
+    }
+    else {
+        base = ::mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        if (base == MAP_FAILED) {
+            report.error(u"error mapping %s (%'d bytes): %s", {filename, file_size, ErrorCodeMessage()});
+            base = nullptr;
+            success = false;
+        }
+    }
+    if (!success) {
+        ::close(_fd);
+        _fd = -1;
+        return false;
+    }
+
+    // The access pattern is sequential.
+    ::madvise(base, file_size, MADV_SEQUENTIAL);
+
+#endif
+
+    _base = reinterpret_cast<Record*>(base);
+    _count = count;
+    _window = std::max(window, MIN_WINDOW_PACKETS);
+    _window_count = (_count + _window - 1) / _window;
+    _current = 0;
+    _entered = 0;
+    _terminate = false;
+
+    // The background thread is useless when the ring is too small to separate
+    // the windows which are read ahead from the ones which are written back.
+    if (_window_count > READ_AHEAD_WINDOWS + 1 && !Thread::start()) {
+        report.warning(u"cannot start read-ahead thread on %s", {filename});
+    }
+
+    report.debug(u"mapped %'d packets (%'d bytes) from %s, %'d windows of %'d packets", {_count, file_size, filename, _window_count, _window});
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Unmap and delete the file.
+//----------------------------------------------------------------------------
+
+bool ts::MappedPacketRing::close(Report& report)
+{
+    if (!isOpen()) {
+        return false;
+    }
+
+    // Stop the background thread.
+    {
+        GuardCondition lock(_mutex, _wakeup);
+        _terminate = true;
+        lock.signal();
+    }
+    waitForTermination();
+
+    // Since the file is deleted, there is no need to flush it.
+    bool success = true;
+#if defined(TS_WINDOWS)
+    success = ::UnmapViewOfFile(_base) != 0;
+    ::CloseHandle(_mapping);
+    ::CloseHandle(_file);
+    _mapping = NULL;
+    _file = INVALID_HANDLE_VALUE;
+#else
+    success = ::munmap(_base, _count * sizeof(Record)) == 0;
+    ::close(_fd);
+    _fd = -1;
+#endif
+    if (!success) {
+        report.error(u"error unmapping packet ring: %s", {ErrorCodeMessage()});
+    }
+
+    _base = nullptr;
+    _count = 0;
+    _window_count = 0;
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// Called by the application thread when a window is entered.
+//----------------------------------------------------------------------------
+
+void ts::MappedPacketRing::enterWindow(size_t window)
+{
+    if (_window_count > READ_AHEAD_WINDOWS + 1) {
+        GuardCondition lock(_mutex, _wakeup);
+        _current = window;
+        _entered++;
+        lock.signal();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Thread main code: read-ahead and writeback.
+//----------------------------------------------------------------------------
+
+void ts::MappedPacketRing::main()
+{
+    uint64_t done = 0;
+
+    for (;;) {
+        size_t current = 0;
+        uint64_t entered = 0;
+
+        // Wait for the application to enter a new window.
+        {
+            GuardCondition lock(_mutex, _wakeup);
+            while (!_terminate && _entered == done) {
+                lock.waitCondition();
+            }
+            if (_terminate) {
+                break;
+            }
+            current = _current;
+            entered = _entered;
+        }
+
+        // Process all windows which were entered since last time. The application
+        // accesses the ring sequentially, the previous windows are before the current one.
+        for (; done < entered; ++done) {
+            const size_t back = size_t(entered - done - 1) % _window_count;
+            const size_t window = (current + _window_count - back) % _window_count;
+            if (done == 0) {
+                // First window: load all windows ahead.
+                for (size_t i = 1; i < READ_AHEAD_WINDOWS; ++i) {
+                    loadWindow((window + i) % _window_count);
+                }
+            }
+            else {
+                // Write back the window we just left.
+                flushWindow((window + _window_count - 1) % _window_count);
+            }
+            loadWindow((window + READ_AHEAD_WINDOWS) % _window_count);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Memory range of a window, rounded to page boundaries.
+//----------------------------------------------------------------------------
+
+void ts::MappedPacketRing::windowRange(size_t window, char*& start, size_t& size) const
+{
+    const size_t first = window * _window;
+    const size_t last = std::min(first + _window, _count);
+
+    // Work on offsets, the base address is page-aligned.
+    const size_t start_offset = RoundDown(first * sizeof(Record), _page_size);
+    const size_t end_offset = last == _count ? RoundUp(last * sizeof(Record), _page_size) : RoundDown(last * sizeof(Record), _page_size);
+
+    start = reinterpret_cast<char*>(_base) + start_offset;
+    size = end_offset > start_offset ? end_offset - start_offset : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Load a window in memory.
+//----------------------------------------------------------------------------
+
+void ts::MappedPacketRing::loadWindow(size_t window)
+{
+    char* start = nullptr;
+    size_t size = 0;
+    windowRange(window, start, size);
+
+#if !defined(TS_WINDOWS)
+    // Start asynchronous read of all pages.
+    ::madvise(start, size, MADV_WILLNEED);
+#endif
+
+    // Touch all pages, page faults occur in this thread, not in the application thread.
+    TS_UNUSED volatile char sink = 0;
+    for (size_t offset = 0; offset < size; offset += _page_size) {
+        sink = start[offset];
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Write a window on disk and release its memory.
+//----------------------------------------------------------------------------
+
+void ts::MappedPacketRing::flushWindow(size_t window)
+{
+    char* start = nullptr;
+    size_t size = 0;
+    windowRange(window, start, size);
+
+    if (size > 0) {
+#if defined(TS_WINDOWS)
+        // Removing unlocked pages from the working set releases them.
+        ::FlushViewOfFile(start, size);
+        ::VirtualUnlock(start, size);
+#else
+        // The pages won't be used again before a complete turn of the ring.
+        ::msync(start, size, MS_SYNC);
+        ::madvise(start, size, MADV_DONTNEED);
+#if defined(TS_LINUX)
+        ::posix_fadvise(_fd, off_t(start - reinterpret_cast<char*>(_base)), off_t(size), POSIX_FADV_DONTNEED);
+#endif
+#endif
+    }
+}
@@ -0,0 +1,182 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  A ring of TS packets in a memory-mapped file.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSPacket.h"
+#include "tsTSPacketMetadata.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! A ring of TS packets and metadata in a preallocated memory-mapped file.
+    //! @ingroup mpeg
+    //!
+    //! Each record in the file contains a TS packet and its metadata, at fixed
+    //! and aligned positions, and is accessed directly in the mapped memory.
+    //! The ring is divided in windows of packets. The application is expected
+    //! to access the ring sequentially. When a new window is entered, an internal
+    //! thread loads the next windows in memory (read-ahead) and writes the previous
+    //! one on disk (writeback), then releases its memory. Thus, the application
+    //! thread does not block on disk I/O, as long as the disk is fast enough.
+    //!
+    //! The file is deleted when the ring is closed. On UNIX systems, it is
+    //! deleted immediately after opening and is never visible.
+    //!
+    class TSDUCKDLL MappedPacketRing : private Thread
+    {
+        TS_NOCOPY(MappedPacketRing);
+    public:
+        //!
+        //! Minimum number of packets in an I/O window.
+        //!
+        static constexpr size_t MIN_WINDOW_PACKETS = 1024;
+        //!
+        //! Number of windows which are loaded in advance by the read-ahead thread.
+        //!
+        static constexpr size_t READ_AHEAD_WINDOWS = 2;
+
+        //!
+        //! Constructor.
+        //!
+        MappedPacketRing();
+
+        //!
+        //! Destructor.
+        //!
+        virtual ~MappedPacketRing() override;
+
+        //!
+        //! Create the file and map it in memory.
+        //! @param [in] filename Name of the file to create.
+        //! @param [in] count Number of packets in the ring.
+        //! @param [in] window Number of packets in an I/O window.
+        //! Adjusted to MIN_WINDOW_PACKETS if lower.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool open(const UString& filename, size_t count, size_t window, Report& report);
+
+        //!
+        //! Unmap and delete the file.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool close(Report& report);
+
+        //!
+        //! Check if the ring is open.
+        //! @return True if the ring is open.
+        //!
+        bool isOpen() const { return _base != nullptr; }
+
+        //!
+        //! Get the size of the ring.
+        //! @return The number of packets in the ring.
+        //!
+        size_t size() const { return _count; }
+
+        //!
+        //! Read a packet from the ring.
+        //! @param [in] index Index of the packet in the ring. Must be less than size().
+        //! @param [out] packet Returned packet.
+        //! @param [out] mdata Returned packet metadata.
+        //!
+        void read(size_t index, TSPacket& packet, TSPacketMetadata& mdata) const
+        {
+            assert(index < _count);
+            packet = _base[index].packet;
+            mdata = _base[index].mdata;
+        }
+
+        //!
+        //! Write a packet in the ring.
+        //! Writing the first packet of a window triggers the read-ahead and
+        //! writeback of the neighbour windows.
+        //! @param [in] index Index of the packet in the ring. Must be less than size().
+        //! @param [in] packet Packet to write.
+        //! @param [in] mdata Packet metadata.
+        //!
+        void write(size_t index, const TSPacket& packet, const TSPacketMetadata& mdata)
+        {
+            assert(index < _count);
+            _base[index].packet = packet;
+            _base[index].mdata = mdata;
+            if (index % _window == 0) {
+                enterWindow(index / _window);
+            }
+        }
+
+    private:
+        // One record in the file.
+        struct Record {
+            TSPacket         packet;
+            TSPacketMetadata mdata;
+        };
+
+        Record*   _base;           // Base address of mapped file.
+        size_t    _count;          // Number of records in the ring.
+        size_t    _window;         // Number of records in a window.
+        size_t    _window_count;   // Number of windows in the ring.
+        size_t    _page_size;      // System memory page size.
+#if defined(TS_WINDOWS)
+        ::HANDLE  _file;           // File handle.
+        ::HANDLE  _mapping;        // File mapping handle.
+#else
+        int       _fd;             // File descriptor.
+#endif
+        Mutex     _mutex;          // Protect the following fields.
+        Condition _wakeup;         // Signaled when a window is entered or on termination.
+        size_t    _current;        // Last window entered by the application.
+        uint64_t  _entered;        // Number of windows entered by the application.
+        bool      _terminate;      // Request the thread to terminate.
+
+        // Called by the application thread when a window is entered.
+        void enterWindow(size_t window);
+
+        // Thread main code: read-ahead and writeback.
+        virtual void main() override;
+
+        // Memory range of a window, rounded to page boundaries.
+        // The range includes all complete pages in the window, the page which overlaps the
+        // start of the window and excludes the page which overlaps the end of the window.
+        void windowRange(size_t window, char*& start, size_t& size) const;
+
+        // Load a window in memory, write a window on disk and release its memory.
+        void loadWindow(size_t window);
+        void flushWindow(size_t window);
+    };
+}
@@ -36,6 +36,10 @@
 #include "tsPSIRepository.h"
 TSDUCK_SOURCE;
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr ts::Names::SectionId ts::Names::NO_SECTION;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Configuration instances.
@@ -58,7 +62,7 @@ ts::UString ts::names::TID(const DuckContext& duck, uint8_t tid, uint16_t cas, F
 {
     // Where to search table ids.
     const Names* const repo = NamesMain::Instance();
-    const UString section(u"TableId");
+    static const Names::SectionId section = repo->sectionId(u"TableId");
 
     // Check without standard, then with all known standards in TSDuck context.
     // In all cases, use version with CAS first, then without CAS.
@@ -115,181 +119,216 @@ ts::UString ts::names::TID(const DuckContext& duck, uint8_t tid, uint16_t cas, F
 
 bool ts::names::HasTableSpecificName(uint8_t did, uint8_t tid)
 {
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"DescriptorId");
     return tid != TID_NULL &&
         did < 0x80 &&
-        NamesMain::Instance()->nameExists(u"DescriptorId", (Names::Value(tid) << 40) | TS_UCONST64(0x000000FFFFFFFF00) | Names::Value(did));
+        NamesMain::Instance()->nameExists(section, (Names::Value(tid) << 40) | TS_UCONST64(0x000000FFFFFFFF00) | Names::Value(did));
 }
 
 ts::UString ts::names::DID(uint8_t did, uint32_t pds, uint8_t tid, Flags flags)
 {
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"DescriptorId");
+
     if (did >= 0x80 && pds != 0 && pds != PDS_NULL) {
         // If this is a private descriptor, only consider the private value.
         // Do not fallback because the same value with PDS == 0 can be different.
-        return NamesMain::Instance()->nameFromSection(u"DescriptorId", (Names::Value(pds) << 8) | Names::Value(did), flags, 8);
+        return NamesMain::Instance()->nameFromSection(section, (Names::Value(pds) << 8) | Names::Value(did), flags, 8);
     }
     else if (tid != 0xFF) {
         // Could be a table-specific descriptor.
         const Names::Value fullValue = (Names::Value(tid) << 40) | TS_UCONST64(0x000000FFFFFFFF00) | Names::Value(did);
-        return NamesMain::Instance()->nameFromSectionWithFallback(u"DescriptorId", fullValue, Names::Value(did), flags, 8);
+        return NamesMain::Instance()->nameFromSectionWithFallback(section, fullValue, Names::Value(did), flags, 8);
     }
     else {
-        return NamesMain::Instance()->nameFromSection(u"DescriptorId", Names::Value(did), flags, 8);
+        return NamesMain::Instance()->nameFromSection(section, Names::Value(did), flags, 8);
     }
 }
 
 //----------------------------------------------------------------------------
 // Public functions returning names.
+// Section identifiers are resolved only once, on first use.
 //----------------------------------------------------------------------------
 
 ts::UString ts::names::EDID(uint8_t edid, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DVBExtendedDescriptorId", Names::Value(edid), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"DVBExtendedDescriptorId");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(edid), flags, 8);
 }
 
 ts::UString ts::names::StreamType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"StreamType", Names::Value(type), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"StreamType");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::Content(uint8_t x, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"ContentId", Names::Value(x), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"ContentId");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(x), flags, 8);
 }
 
 ts::UString ts::names::PrivateDataSpecifier(uint32_t pds, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"PrivateDataSpecifier", Names::Value(pds), flags, 32);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"PrivateDataSpecifier");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(pds), flags, 32);
 }
 
 ts::UString ts::names::CASFamily(ts::CASFamily cas)
 {
-    return NamesMain::Instance()->nameFromSection(u"CASFamily", Names::Value(cas), NAME | DECIMAL);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"CASFamily");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(cas), NAME | DECIMAL);
 }
 
 ts::UString ts::names::CASId(const DuckContext& duck, uint16_t id, Flags flags)
 {
-    const UChar* section = (duck.standards() & Standards::ISDB) == Standards::ISDB ? u"ARIBCASystemId" : u"CASystemId";
+    static const Names::SectionId dvbSection = NamesMain::Instance()->sectionId(u"CASystemId");
+    static const Names::SectionId aribSection = NamesMain::Instance()->sectionId(u"ARIBCASystemId");
+    const Names::SectionId section = (duck.standards() & Standards::ISDB) == Standards::ISDB ? aribSection : dvbSection;
     return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 16);
 }
 
 ts::UString ts::names::BouquetId(uint16_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"BouquetId", Names::Value(id), flags, 16);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"BouquetId");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 16);
 }
 
 ts::UString ts::names::OriginalNetworkId(uint16_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"OriginalNetworkId", Names::Value(id), flags, 16);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"OriginalNetworkId");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 16);
 }
 
 ts::UString ts::names::NetworkId(uint16_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"NetworkId", Names::Value(id), flags, 16);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"NetworkId");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 16);
 }
 
 ts::UString ts::names::PlatformId(uint32_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"PlatformId", Names::Value(id), flags, 24);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"PlatformId");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 24);
 }
 
 ts::UString ts::names::DataBroadcastId(uint16_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DataBroadcastId", Names::Value(id), flags, 16);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"DataBroadcastId");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 16);
 }
 
 ts::UString ts::names::OUI(uint32_t oui, Flags flags)
 {
-    return NamesOUI::Instance()->nameFromSection(u"OUI", Names::Value(oui), flags, 24);
+    static const Names::SectionId section = NamesOUI::Instance()->sectionId(u"OUI");
+    return NamesOUI::Instance()->nameFromSection(section, Names::Value(oui), flags, 24);
 }
 
 ts::UString ts::names::StreamId(uint8_t sid, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"StreamId", Names::Value(sid), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"StreamId");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(sid), flags, 8);
 }
 
 ts::UString ts::names::PESStartCode(uint8_t code, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"PESStartCode", Names::Value(code), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"PESStartCode");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(code), flags, 8);
 }
 
 ts::UString ts::names::AspectRatio(uint8_t ar, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"AspectRatio", Names::Value(ar), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"AspectRatio");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(ar), flags, 8);
 }
 
 ts::UString ts::names::ChromaFormat(uint8_t cf, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"ChromaFormat", Names::Value(cf), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"ChromaFormat");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(cf), flags, 8);
 }
 
 ts::UString ts::names::AVCUnitType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"AVCUnitType", Names::Value(type), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"AVCUnitType");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::AVCProfile(int profile, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"AVCProfile", Names::Value(profile), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"AVCProfile");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(profile), flags, 8);
 }
 
 ts::UString ts::names::ServiceType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"ServiceType", Names::Value(type), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"ServiceType");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::LinkageType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"LinkageType", Names::Value(type), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"LinkageType");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::TeletextType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"TeletextType", Names::Value(type), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"TeletextType");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::RunningStatus(uint8_t status, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"RunningStatus", Names::Value(status), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"RunningStatus");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(status), flags, 8);
 }
 
 ts::UString ts::names::AudioType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"AudioType", Names::Value(type), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"AudioType");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::SubtitlingType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"SubtitlingType", Names::Value(type), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"SubtitlingType");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::DTSSampleRateCode(uint8_t x, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DTSSampleRate", Names::Value(x), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"DTSSampleRate");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(x), flags, 8);
 }
 
 ts::UString ts::names::DTSBitRateCode(uint8_t x, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DTSBitRate", Names::Value(x), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"DTSBitRate");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(x), flags, 8);
 }
 
 ts::UString ts::names::DTSSurroundMode(uint8_t x, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DTSSurroundMode", Names::Value(x), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"DTSSurroundMode");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(x), flags, 8);
 }
 
 ts::UString ts::names::DTSExtendedSurroundMode(uint8_t x, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DTSExtendedSurroundMode", Names::Value(x), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"DTSExtendedSurroundMode");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(x), flags, 8);
 }
 
 ts::UString ts::names::ScramblingControl(uint8_t scv, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"ScramblingControl", Names::Value(scv), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"ScramblingControl");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(scv), flags, 8);
 }
 
 ts::UString ts::names::T2MIPacketType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"T2MIPacketType", Names::Value(type), flags, 8);
+    static const Names::SectionId section = NamesMain::Instance()->sectionId(u"T2MIPacketType");
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 
@@ -326,7 +365,8 @@ ts::UString ts::names::ComponentType(const DuckContext& duck, uint16_t type, Fla
 
     if ((duck.standards() & Standards::JAPAN) == Standards::JAPAN) {
         // Japan / ISDB uses a completely different mapping.
-        return NamesMain::Instance()->nameFromSection(u"ComponentTypeJapan", Names::Value(nType), flags | names::ALTERNATE, 16, dType);
+        static const Names::SectionId section = NamesMain::Instance()->sectionId(u"ComponentTypeJapan");
+        return NamesMain::Instance()->nameFromSection(section, Names::Value(nType), flags | names::ALTERNATE, 16, dType);
     }
     else if ((nType & 0xFF00) == 0x3F00) {
         return SubtitlingType(nType & 0x00FF, flags);
@@ -335,7 +375,8 @@ ts::UString ts::names::ComponentType(const DuckContext& duck, uint16_t type, Fla
         return AC3ComponentType(nType & 0x00FF, flags);
     }
     else {
-        return NamesMain::Instance()->nameFromSection(u"ComponentType", Names::Value(nType), flags | names::ALTERNATE, 16, dType);
+        static const Names::SectionId section = NamesMain::Instance()->sectionId(u"ComponentType");
+        return NamesMain::Instance()->nameFromSection(section, Names::Value(nType), flags | names::ALTERNATE, 16, dType);
     }
 }
 
@@ -386,6 +427,7 @@ ts::Names::Names(const UString& fileName, bool mergeExtensions) :
     _log(CERR),
     _configFile(SearchConfigurationFile(fileName)),
     _configErrors(0),
+    _sectionIds(),
     _sections()
 {
     // Locate the configuration file.
@@ -447,15 +489,15 @@ void ts::Names::loadFile(const UString& fileName)
             line.convertToLower();
 
             // Get or create associated section.
-            ConfigSectionMap::iterator it = _sections.find(line);
-            if (it != _sections.end()) {
-                section = it->second;
+            const SectionIdMap::const_iterator it = _sectionIds.find(line);
+            if (it != _sectionIds.end()) {
+                section = &_sections[it->second];
             }
             else {
-                // Create new section.
-                section = new ConfigSection;
-                CheckNonNull(section);
-                _sections.insert(std::make_pair(line, section));
+                // Create new section. Its identifier is its index in the vector.
+                _sectionIds.insert(std::make_pair(line, _sections.size()));
+                _sections.resize(_sections.size() + 1);
+                section = &_sections.back();
             }
         }
         else if (!decodeDefinition(line, section)) {
@@ -528,16 +570,11 @@ bool ts::Names::decodeDefinition(const UString& line, ConfigSection* section)
 
 
 //----------------------------------------------------------------------------
-// Destructor: free all resources.
+// Destructor.
 //----------------------------------------------------------------------------
 
 ts::Names::~Names()
 {
-    // Deallocate all configuration sections.
-    for (ConfigSectionMap::iterator it = _sections.begin(); it != _sections.end(); ++it) {
-        delete it->second;
-    }
-    _sections.clear();
 }
 
 
@@ -545,7 +582,8 @@ ts::Names::~Names()
 // Configuration entry.
 //----------------------------------------------------------------------------
 
-ts::Names::ConfigEntry::ConfigEntry(Value l, const UString& n) :
+ts::Names::ConfigEntry::ConfigEntry(Value f, Value l, const UString& n) :
+    first(f),
     last(l),
     name(n)
 {
@@ -562,15 +600,6 @@ ts::Names::ConfigSection::ConfigSection() :
 {
 }
 
-ts::Names::ConfigSection::~ConfigSection()
-{
-    // Deallocate all configuration entries.
-    for (ConfigEntryMap::iterator it = entries.begin(); it != entries.end(); ++it) {
-        delete it->second;
-    }
-    entries.clear();
-}
-
 
 //----------------------------------------------------------------------------
 // Check if a range is free, ie no value is defined in the range.
@@ -579,7 +608,7 @@ ts::Names::ConfigSection::~ConfigSection()
 bool ts::Names::ConfigSection::freeRange(Value first, Value last) const
 {
     // Get an iterator pointing to the first element that is "not less" than 'first'.
-    ConfigEntryMap::const_iterator it = entries.lower_bound(first);
+    ConfigEntryVector::const_iterator it = std::lower_bound(entries.begin(), entries.end(), first, [](const ConfigEntry& e, Value v) { return e.first < v; });
 
     if (it != entries.end() && it->first <= last) {
         // This is an existing range which starts inside [first..last].
@@ -587,7 +616,7 @@ bool ts::Names::ConfigSection::freeRange(Value first, Value last) const
         return false;
     }
 
-    if (it != entries.begin() && (--it)->second->last >= first) {
+    if (it != entries.begin() && (--it)->last >= first) {
         // The previous range ends inside [first..last].
         assert(it->first < first);
         return false;
@@ -604,37 +633,45 @@ bool ts::Names::ConfigSection::freeRange(Value first, Value last) const
 
 void ts::Names::ConfigSection::addEntry(Value first, Value last, const UString& name)
 {
-    ConfigEntry* entry = new ConfigEntry(last, name);
-    CheckNonNull(entry);
-    entries.insert(std::make_pair(first, entry));
+    // Configuration files are mostly sorted, the insertion point is usually the end.
+    if (entries.empty() || entries.back().first < first) {
+        entries.push_back(ConfigEntry(first, last, name));
+    }
+    else {
+        const ConfigEntryVector::iterator it = std::lower_bound(entries.begin(), entries.end(), first, [](const ConfigEntry& e, Value v) { return e.first < v; });
+        entries.insert(it, ConfigEntry(first, last, name));
+    }
 }
 
 
 //----------------------------------------------------------------------------
-// Get a name from a value, empty if not found.
+// Get a name from a value, null if not found.
 //----------------------------------------------------------------------------
 
-ts::UString ts::Names::ConfigSection::getName(Value val) const
+const ts::UString* ts::Names::ConfigSection::getName(Value val) const
 {
-    // Eliminate trivial cases which would cause issues with code below.
-    if (entries.empty()) {
-        return UString();
-    }
+    // Get an iterator pointing to the first element with a range starting after 'val'.
+    // The only range which may contain 'val' is the previous one.
+    ConfigEntryVector::const_iterator it = std::upper_bound(entries.begin(), entries.end(), val, [](Value v, const ConfigEntry& e) { return v < e.first; });
+    return it != entries.begin() && val <= (--it)->last ? &it->name : nullptr;
+}
 
-    // The key in the 'entries' map is the _first_ value of a range.
-    // Get an iterator pointing to the first element that is "not less" than 'val'.
-    ConfigEntryMap::const_iterator it = entries.lower_bound(val);
 
-    if (it == entries.end() || (it != entries.begin() && it->first != val)) {
-        // There is no entry with a value range starting at 'val'.
-        // Maybe 'val' is in the range of the previous entry.
-        --it;
-    }
-
-    assert(it != entries.end());
-    assert(it->second != nullptr);
+//----------------------------------------------------------------------------
+// Case-insensitive comparison of section names.
+//----------------------------------------------------------------------------
 
-    return val >= it->first && val <= it->second->last ? it->second->name : UString();
+bool ts::Names::NoCaseLess::operator()(const UString& s1, const UString& s2) const
+{
+    const size_t len = std::min(s1.length(), s2.length());
+    for (size_t i = 0; i < len; ++i) {
+        const UChar c1 = ToLower(s1[i]);
+        const UChar c2 = ToLower(s2[i]);
+        if (c1 != c2) {
+            return c1 < c2;
+        }
+    }
+    return s1.length() < s2.length();
 }
 
 
@@ -732,15 +769,32 @@ ts::UString ts::Names::Formatted(Value value, const UString& name, names::Flags
 }
 
 
+//----------------------------------------------------------------------------
+// Get the identifier of a section.
+//----------------------------------------------------------------------------
+
+ts::Names::SectionId ts::Names::sectionId(const UString& sectionName) const
+{
+    // Section names are not case-sensitive, only trim spaces when necessary.
+    const bool trim = !sectionName.empty() && (IsSpace(sectionName.front()) || IsSpace(sectionName.back()));
+    const SectionIdMap::const_iterator it = _sectionIds.find(trim ? sectionName.toTrimmed() : sectionName);
+    return it == _sectionIds.end() ? NO_SECTION : it->second;
+}
+
+
 //----------------------------------------------------------------------------
 // Check if a name exists in a specified section.
 //----------------------------------------------------------------------------
 
 bool ts::Names::nameExists(const UString& sectionName, Value value) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    return it != _sections.end() && !it->second->getName(value).empty();
+    return nameExists(sectionId(sectionName), value);
+}
+
+bool ts::Names::nameExists(SectionId section, Value value) const
+{
+    const ConfigSection* const sec = getSection(section);
+    return sec != nullptr && sec->getName(value) != nullptr;
 }
 
 
@@ -750,16 +804,20 @@ bool ts::Names::nameExists(const UString& sectionName, Value value) const
 
 ts::UString ts::Names::nameFromSection(const UString& sectionName, Value value, names::Flags flags, size_t bits, Value alternateValue) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    const ConfigSection* section = it == _sections.end() ? nullptr : it->second;
+    return nameFromSection(sectionId(sectionName), value, flags, bits, alternateValue);
+}
+
+ts::UString ts::Names::nameFromSection(SectionId section, Value value, names::Flags flags, size_t bits, Value alternateValue) const
+{
+    const ConfigSection* const sec = getSection(section);
+    const UString* const name = sec == nullptr ? nullptr : sec->getName(value);
 
-    if (section == nullptr) {
+    if (sec == nullptr) {
         // Non-existent section, no name.
         return Formatted(value, UString(), flags, bits, alternateValue);
     }
     else {
-        return Formatted(value, section->getName(value), flags, bits != 0 ? bits : section->bits, alternateValue);
+        return Formatted(value, name == nullptr ? UString() : *name, flags, bits != 0 ? bits : sec->bits, alternateValue);
     }
 }
 
@@ -770,23 +828,26 @@ ts::UString ts::Names::nameFromSection(const UString& sectionName, Value value,
 
 ts::UString ts::Names::nameFromSectionWithFallback(const UString& sectionName, Value value1, Value value2, names::Flags flags, size_t bits, Value alternateValue) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    const ConfigSection* section = it == _sections.end() ? nullptr : it->second;
+    return nameFromSectionWithFallback(sectionId(sectionName), value1, value2, flags, bits, alternateValue);
+}
+
+ts::UString ts::Names::nameFromSectionWithFallback(SectionId section, Value value1, Value value2, names::Flags flags, size_t bits, Value alternateValue) const
+{
+    const ConfigSection* const sec = getSection(section);
 
-    if (section == nullptr) {
+    if (sec == nullptr) {
         // Non-existent section, no name.
         return Formatted(value1, UString(), flags, bits, alternateValue);
     }
+
+    const UString* name = sec->getName(value1);
+    if (name != nullptr) {
+        // value1 has a name
+        return Formatted(value1, *name, flags, bits != 0 ? bits : sec->bits, alternateValue);
+    }
     else {
-        const UString name(section->getName(value1));
-        if (!name.empty()) {
-            // value1 has a name
-            return Formatted(value1, name, flags, bits != 0 ? bits : section->bits, alternateValue);
-        }
-        else {
-            // value1 has no name, use value2.
-            return Formatted(value2, section->getName(value2), flags, bits != 0 ? bits : section->bits, alternateValue);
-        }
+        // value1 has no name, use value2.
+        name = sec->getName(value2);
+        return Formatted(value2, name == nullptr ? UString() : *name, flags, bits != 0 ? bits : sec->bits, alternateValue);
     }
 }
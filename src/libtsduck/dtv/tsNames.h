@@ -384,6 +384,20 @@ namespace ts {
         //!
         typedef uint64_t Value;
 
+        //!
+        //! Identifier of a section in the repository of names.
+        //! Resolving a section name into an identifier once and then using the identifier
+        //! avoids the lookup of the section name on each request.
+        //! Section identifiers are allocated in the order of the configuration files,
+        //! they remain valid as long as the same configuration files are used.
+        //!
+        typedef size_t SectionId;
+
+        //!
+        //! Identifier of a non-existent section.
+        //!
+        static constexpr SectionId NO_SECTION = NPOS;
+
         //!
         //! Get the complete path of the configuration file from which the names were loaded.
         //! @return The complete path of the configuration file. Empty if does not exist.
@@ -410,6 +424,21 @@ namespace ts {
         //!
         bool nameExists(const UString& sectionName, Value value) const;
 
+        //!
+        //! Get the identifier of a section.
+        //! @param [in] sectionName Name of section to search. Not case-sensitive.
+        //! @return The identifier of the section or NO_SECTION if it does not exist.
+        //!
+        SectionId sectionId(const UString& sectionName) const;
+
+        //!
+        //! Check if a name exists in a specified section.
+        //! @param [in] section Identifier of section to search.
+        //! @param [in] value Value to get the name for.
+        //! @return True if a name exists for @a value in @a section.
+        //!
+        bool nameExists(SectionId section, Value value) const;
+
         //!
         //! Get a name from a specified section.
         //! @param [in] sectionName Name of section to search. Not case-sensitive.
@@ -421,6 +450,17 @@ namespace ts {
         //!
         UString nameFromSection(const UString& sectionName, Value value, names::Flags flags = names::NAME, size_t bits = 0, Value alternateValue = 0) const;
 
+        //!
+        //! Get a name from a specified section.
+        //! @param [in] section Identifier of section to search.
+        //! @param [in] value Value to get the name for.
+        //! @param [in] flags Presentation flags.
+        //! @param [in] bits Nominal size in bits of the data, optional.
+        //! @param [in] alternateValue Display this integer value if flags ALTERNATE is set.
+        //! @return The corresponding name.
+        //!
+        UString nameFromSection(SectionId section, Value value, names::Flags flags = names::NAME, size_t bits = 0, Value alternateValue = 0) const;
+
         //!
         //! Get a name from a specified section, with alternate fallback value.
         //! @param [in] sectionName Name of section to search. Not case-sensitive.
@@ -433,6 +473,18 @@ namespace ts {
         //!
         UString nameFromSectionWithFallback(const UString& sectionName, Value value1, Value value2, names::Flags flags = names::NAME, size_t bits = 0, Value alternateValue = 0) const;
 
+        //!
+        //! Get a name from a specified section, with alternate fallback value.
+        //! @param [in] section Identifier of section to search.
+        //! @param [in] value1 Value to get the name for.
+        //! @param [in] value2 Alternate value if no name is found for @a value1.
+        //! @param [in] flags Presentation flags.
+        //! @param [in] bits Nominal size in bits of the data, optional.
+        //! @param [in] alternateValue Display this integer value if flags ALTERNATE is set.
+        //! @return The corresponding name.
+        //!
+        UString nameFromSectionWithFallback(SectionId section, Value value1, Value value2, names::Flags flags = names::NAME, size_t bits = 0, Value alternateValue = 0) const;
+
         //!
         //! Format a name using flags.
         //! @param [in] value Value for the name.
@@ -445,30 +497,29 @@ namespace ts {
         static UString Formatted(Value value, const UString& name, names::Flags flags, size_t bits, Value alternateValue = 0);
 
     private:
-        // Description of a configuration entry.
-        // The first value of the range is the key in a map.
+        // Description of a configuration entry: a range of values with the same name.
         class ConfigEntry
         {
         public:
+            Value   first;  // First value in the range.
             Value   last;   // Last value in the range.
             UString name;   // Associated name.
 
-            ConfigEntry(Value l = 0, const UString& n = UString());
+            ConfigEntry(Value f = 0, Value l = 0, const UString& n = UString());
         };
 
-        // Map of configuration entries, indexed by first value of the range.
-        typedef std::map<Value, ConfigEntry*> ConfigEntryMap;
+        // Vector of configuration entries, sorted by first value of the range.
+        // Ranges never overlap, the lookup of a value is a binary search.
+        typedef std::vector<ConfigEntry> ConfigEntryVector;
 
         // Description of a configuration section.
-        // The name of the section is the key in a map.
         class ConfigSection
         {
         public:
-            size_t          bits;     // Number of significant bits in values of the type.
-            ConfigEntryMap  entries;  // All entries, indexed by names.
+            size_t            bits;     // Number of significant bits in values of the type.
+            ConfigEntryVector entries;  // All entries, sorted by value.
 
             ConfigSection();
-            ~ConfigSection();
 
             // Check if a range is free, ie no value is defined in the range.
             bool freeRange(Value first, Value last) const;
@@ -476,12 +527,25 @@ namespace ts {
             // Add a new entry.
             void addEntry(Value first, Value last, const UString& name);
 
-            // Get a name from a value, empty if not found.
-            UString getName(Value val) const;
+            // Get a name from a value, null if not found.
+            const UString* getName(Value val) const;
+        };
+
+        // Case-insensitive comparison of section names, without building lower-case strings.
+        class NoCaseLess
+        {
+        public:
+            bool operator()(const UString& s1, const UString& s2) const;
         };
 
-        // Map of configuration sections, indexed by name.
-        typedef std::map<UString, ConfigSection*> ConfigSectionMap;
+        // Map of section identifiers, indexed by section name.
+        typedef std::map<UString, SectionId, NoCaseLess> SectionIdMap;
+
+        // Get a section from its identifier, null if not found.
+        const ConfigSection* getSection(SectionId section) const
+        {
+            return section < _sections.size() ? &_sections[section] : nullptr;
+        }
 
         // Decode a line as "first[-last] = name". Return true on success, false on error.
         bool decodeDefinition(const UString& line, ConfigSection* section);
@@ -496,10 +560,11 @@ namespace ts {
         void loadFile(const UString& fileName);
 
         // Names private fields.
-        Report&          _log;           // Error logger.
-        const UString    _configFile;    // Configuration file path.
-        size_t           _configErrors;  // Number of errors in configuration file.
-        ConfigSectionMap _sections;      // Configuration sections.
+        Report&                    _log;           // Error logger.
+        const UString              _configFile;    // Configuration file path.
+        size_t                     _configErrors;  // Number of errors in configuration file.
+        SectionIdMap               _sectionIds;    // Section identifiers, indexed by name.
+        std::vector<ConfigSection> _sections;      // Configuration sections, indexed by identifier.
     };
 
     //!
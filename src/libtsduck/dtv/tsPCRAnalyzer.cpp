@@ -36,6 +36,10 @@
 #include "tsUString.h"
 TSDUCK_SOURCE;
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::PCRAnalyzer::INSTANT_WINDOW_SIZE;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructor
@@ -59,7 +63,11 @@ ts::PCRAnalyzer::PCRAnalyzer(size_t min_pid, size_t min_pcr) :
     _pcr_pids(0),
     _discontinuities(0),
     _pid(),
-    _packet_pcr_index_map()
+    _inst_first(0),
+    _inst_count(0),
+    _inst_period_pcr(INVALID_PCR),
+    _inst_period_length(0),
+    _inst_window()
 {
     TS_ZERO(_pid);
 }
@@ -86,7 +94,9 @@ ts::PCRAnalyzer::PIDAnalysis::PIDAnalysis() :
     last_pcr_packet(0),
     ts_bitrate_188(0),
     ts_bitrate_204(0),
-    ts_bitrate_cnt(0)
+    ts_bitrate_cnt(0),
+    inst_pkt_base(0),
+    inst_pkt_cnt(0)
 {
 }
 
@@ -152,6 +162,7 @@ void ts::PCRAnalyzer::reset()
     _pcr_pids = 0;
     _inst_ts_bitrate_188 = 0;
     _inst_ts_bitrate_204 = 0;
+    _inst_period_length = 0;
 
     for (size_t i = 0; i < PID_MAX; ++i) {
         if (_pid[i] != nullptr) {
@@ -160,7 +171,7 @@ void ts::PCRAnalyzer::reset()
         }
     }
 
-    _packet_pcr_index_map.clear();
+    clearInstantaneousPCR();
 }
 
 
@@ -200,7 +211,74 @@ void ts::PCRAnalyzer::processDiscontinuity()
             _pid[i]->last_pcr_value = INVALID_PCR;
         }
     }
-    _packet_pcr_index_map.clear();
+    clearInstantaneousPCR();
+}
+
+
+//----------------------------------------------------------------------------
+// Distance between two PCR/DTS values, in PCR units, with wrap up.
+//----------------------------------------------------------------------------
+
+uint64_t ts::PCRAnalyzer::clockDistance(uint64_t from, uint64_t to) const
+{
+    return _use_dts ? DiffPTS(from, to) * SYSTEM_CLOCK_SUBFACTOR : DiffPCR(from, to);
+}
+
+bool ts::PCRAnalyzer::clockBefore(uint64_t pcr1, uint64_t pcr2) const
+{
+    // Without wrap up, the forward distance is lower than the backward one.
+    return pcr1 != pcr2 && clockDistance(pcr1, pcr2) < clockDistance(pcr2, pcr1);
+}
+
+
+//----------------------------------------------------------------------------
+// Manage the PCR/DTS values for instantaneous bitrates.
+//----------------------------------------------------------------------------
+
+void ts::PCRAnalyzer::clearInstantaneousPCR()
+{
+    _inst_first = 0;
+    _inst_count = 0;
+    _inst_period_pcr = INVALID_PCR;
+}
+
+void ts::PCRAnalyzer::addInstantaneousPCR(uint64_t pcr_dts)
+{
+    // The window contains strictly increasing values. Remove the most recent values
+    // which are not before the new one (different clock on another PID, duplicate).
+    while (_inst_count > 0 && !clockBefore(_inst_window[(_inst_first + _inst_count - 1) & (INSTANT_WINDOW_SIZE - 1)].pcr_dts, pcr_dts)) {
+        _inst_count--;
+    }
+
+    // When the window is full, erase the oldest entry.
+    if (_inst_count == INSTANT_WINDOW_SIZE) {
+        _inst_first = (_inst_first + 1) & (INSTANT_WINDOW_SIZE - 1);
+        _inst_count--;
+    }
+
+    PCRPacket& last(_inst_window[(_inst_first + _inst_count++) & (INSTANT_WINDOW_SIZE - 1)]);
+    last.pcr_dts = pcr_dts;
+    last.packet = _ts_pkt_cnt;
+
+    // Per-PID instantaneous bitrates are computed by periods of at least one second.
+    // Collecting the packet counts of all PID's occurs only once per period.
+    const bool start_period = _inst_period_pcr == INVALID_PCR;
+    const bool end_period = !start_period && clockBefore(_inst_period_pcr, pcr_dts) && clockDistance(_inst_period_pcr, pcr_dts) >= SYSTEM_CLOCK_FREQ;
+    if (start_period || end_period) {
+        for (size_t i = 0; i < PID_MAX; ++i) {
+            PIDAnalysis* const ps = _pid[i];
+            if (ps != nullptr) {
+                if (end_period) {
+                    ps->inst_pkt_cnt = ps->ts_pkt_cnt - ps->inst_pkt_base;
+                }
+                ps->inst_pkt_base = ps->ts_pkt_cnt;
+            }
+        }
+        if (end_period) {
+            _inst_period_length = clockDistance(_inst_period_pcr, pcr_dts);
+        }
+        _inst_period_pcr = pcr_dts;
+    }
 }
 
 
@@ -229,6 +307,18 @@ ts::BitRate ts::PCRAnalyzer::instantaneousBitrate204() const
     return BitRate(_inst_ts_bitrate_204);
 }
 
+ts::BitRate ts::PCRAnalyzer::instantaneousBitrate188(PID pid) const
+{
+    return (pid >= PID_MAX || _inst_period_length == 0 || _pid[pid] == nullptr) ? 0 :
+        BitRate((_pid[pid]->inst_pkt_cnt * SYSTEM_CLOCK_FREQ * PKT_SIZE * 8) / _inst_period_length);
+}
+
+ts::BitRate ts::PCRAnalyzer::instantaneousBitrate204(PID pid) const
+{
+    return (pid >= PID_MAX || _inst_period_length == 0 || _pid[pid] == nullptr) ? 0 :
+        BitRate((_pid[pid]->inst_pkt_cnt * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE * 8) / _inst_period_length);
+}
+
 
 //----------------------------------------------------------------------------
 // Return the evaluated PID bitrate in bits/second
@@ -352,31 +442,21 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
         if (ps->last_pcr_value != INVALID_PCR && ps->last_pcr_value != pcr_dts) {
 
             // Compute transport rate in b/s since last PCR/DTS
-            uint64_t diff_values = _use_dts ?
-                DiffPTS(ps->last_pcr_value, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
-                DiffPCR(ps->last_pcr_value, pcr_dts);
+            uint64_t diff_values = clockDistance(ps->last_pcr_value, pcr_dts);
 
             uint64_t ts_bitrate_188 = diff_values == 0 ? 0 :
                 ((_ts_pkt_cnt - ps->last_pcr_packet) * SYSTEM_CLOCK_FREQ * PKT_SIZE * 8) / diff_values;
             uint64_t ts_bitrate_204 = diff_values == 0 ? 0 :
                 ((_ts_pkt_cnt - ps->last_pcr_packet) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE * 8) / diff_values;
 
-            // Clear out values older than 1 second from _packet_pcr_index_map.
-            // Note that this is a map that covers PCR/DTS packets across all PIDs
+            // Clear out values older than 1 second from _inst_window.
+            // Note that this window covers PCR/DTS packets across all PIDs
             // as long as the clocks used to generate the PCR/DTS values for different
             // programs is the same clock, there should be no issue, but if the PCR/DTS values
             // across the two programs are wildly different, then the following approach won't work.
-            while (!_packet_pcr_index_map.empty()) {
-                const uint64_t earliestPCR_DTS = _packet_pcr_index_map.begin()->first;
-                diff_values = _use_dts ?
-                    DiffPTS(earliestPCR_DTS, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
-                    DiffPCR(earliestPCR_DTS, pcr_dts);
-                if (diff_values > SYSTEM_CLOCK_FREQ) {
-                    _packet_pcr_index_map.erase(_packet_pcr_index_map.begin());
-                }
-                else {
-                    break;
-                }
+            while (_inst_count > 0 && clockDistance(_inst_window[_inst_first].pcr_dts, pcr_dts) > SYSTEM_CLOCK_FREQ) {
+                _inst_first = (_inst_first + 1) & (INSTANT_WINDOW_SIZE - 1);
+                _inst_count--;
             }
 
             // Per-PID statistics:
@@ -395,14 +475,13 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
 
             // Transport stream instantaneous statistics.
             // For instantaneous bit rates, these are the actual bit rates, and it doesn't use the "count" approach.
-            if (!_packet_pcr_index_map.empty()) {
-                diff_values = _use_dts ?
-                    DiffPTS(_packet_pcr_index_map.begin()->first, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
-                    DiffPCR(_packet_pcr_index_map.begin()->first, pcr_dts);
+            if (_inst_count > 0) {
+                const PCRPacket& first(_inst_window[_inst_first]);
+                diff_values = clockDistance(first.pcr_dts, pcr_dts);
                 _inst_ts_bitrate_188 = diff_values == 0 ? 0 :
-                    ((_ts_pkt_cnt - _packet_pcr_index_map.begin()->second) * SYSTEM_CLOCK_FREQ * PKT_SIZE * 8) / diff_values;
+                    ((_ts_pkt_cnt - first.packet) * SYSTEM_CLOCK_FREQ * PKT_SIZE * 8) / diff_values;
                 _inst_ts_bitrate_204 = diff_values == 0 ? 0 :
-                    ((_ts_pkt_cnt - _packet_pcr_index_map.begin()->second) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE * 8) / diff_values;
+                    ((_ts_pkt_cnt - first.packet) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE * 8) / diff_values;
             }
 
             // Check if we got enough values for this PID
@@ -417,14 +496,8 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
             ps->last_pcr_value = pcr_dts;
             ps->last_pcr_packet = _ts_pkt_cnt;
 
-            // Also add PCR (or DTS)/packet index combo to map for use in instantaneous bit rate calculations.
-            _packet_pcr_index_map[pcr_dts] = _ts_pkt_cnt;
-
-            // Make sure that some crazy TS does not accumulate thousands of PCR values in the same second range.
-            while (_packet_pcr_index_map.size() > FOOLPROOF_MAP_LIMIT) {
-                // Erase older entries.
-                _packet_pcr_index_map.erase(_packet_pcr_index_map.begin());
-            }
+            // Also add PCR (or DTS)/packet index combo for use in instantaneous bit rate calculations.
+            addInstantaneousPCR(pcr_dts);
         }
     }
 
@@ -153,6 +153,24 @@ namespace ts {
         //!
         BitRate instantaneousBitrate204() const;
 
+        //!
+        //! Get the instantaneous bitrate of a PID in bits/second based on 188-byte packets.
+        //! The instantaneous bitrate of a PID is evaluated on the last complete period of
+        //! at least one second, as measured by the PCR or DTS values.
+        //! @param [in] pid The PID to evaluate.
+        //! @return The instantaneous bitrate of @a pid in bits/second based on 188-byte packets.
+        //!
+        BitRate instantaneousBitrate188(PID pid) const;
+
+        //!
+        //! Get the instantaneous bitrate of a PID in bits/second based on 204-byte packets.
+        //! The instantaneous bitrate of a PID is evaluated on the last complete period of
+        //! at least one second, as measured by the PCR or DTS values.
+        //! @param [in] pid The PID to evaluate.
+        //! @return The instantaneous bitrate of @a pid in bits/second based on 204-byte packets.
+        //!
+        BitRate instantaneousBitrate204(PID pid) const;
+
         //!
         //! Get the number of TS packets on a PID.
         //! @param [in] pid The PID to evaluate.
@@ -201,6 +219,18 @@ namespace ts {
         // Process a discontinuity in the transport stream
         void processDiscontinuity();
 
+        // Distance between two PCR/DTS values, in PCR units, with wrap up.
+        uint64_t clockDistance(uint64_t from, uint64_t to) const;
+
+        // Check if a PCR/DTS value is strictly before another one, with wrap up.
+        bool clockBefore(uint64_t pcr1, uint64_t pcr2) const;
+
+        // Add a PCR/DTS value for instantaneous bitrates.
+        void addInstantaneousPCR(uint64_t pcr_dts);
+
+        // Clear all PCR/DTS values for instantaneous bitrates.
+        void clearInstantaneousPCR();
+
         // Analysis of one PID
         struct PIDAnalysis
         {
@@ -214,8 +244,22 @@ namespace ts {
             uint64_t ts_bitrate_188;   // Sum of all computed TS bitrates (188-byte)
             uint64_t ts_bitrate_204;   // Sum of all computed TS bitrates (204-byte)
             uint64_t ts_bitrate_cnt;   // Count of computed TS bitrates
+            uint64_t inst_pkt_base;    // Value of ts_pkt_cnt at start of current instantaneous period
+            uint64_t inst_pkt_cnt;     // Count of TS packets in last complete instantaneous period
         };
 
+        // A PCR/DTS value and the index of the packet containing it.
+        struct PCRPacket
+        {
+            uint64_t pcr_dts;          // PCR or DTS value
+            uint64_t packet;           // Packet index containing the PCR/DTS
+        };
+
+        // Max number of PCR/DTS values in the instantaneous window. Make sure that some
+        // crazy TS does not accumulate thousands of PCR values in the same second range.
+        // Must be a power of 2.
+        static constexpr size_t INSTANT_WINDOW_SIZE = 1024;
+
         // Private members:
         bool     _use_dts;             // Use DTS instead of PCR
         bool     _ignore_errors;       // Ignore TS errors such as discontinuities.
@@ -232,7 +276,10 @@ namespace ts {
         size_t   _pcr_pids;            // Number of PIDs with PCRs
         size_t   _discontinuities;     // Number of discontinuities
         PIDAnalysis* _pid[PID_MAX];    // Per-PID stats
-        std::map<uint64_t, uint64_t> _packet_pcr_index_map; // Map of PCR/DTS to packet index across entire TS
-        static constexpr size_t FOOLPROOF_MAP_LIMIT = 1000; // Max number of entries in the PCR map
+        size_t   _inst_first;          // Index of first (oldest) entry in _inst_window
+        size_t   _inst_count;          // Number of entries in _inst_window
+        uint64_t _inst_period_pcr;     // PCR/DTS at start of current per-PID instantaneous period
+        uint64_t _inst_period_length;  // Duration in PCR units of last complete per-PID instantaneous period
+        PCRPacket _inst_window[INSTANT_WINDOW_SIZE];  // Ring buffer of increasing PCR/DTS values, across entire TS, for the last second
     };
 }
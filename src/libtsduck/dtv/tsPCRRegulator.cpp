@@ -44,12 +44,17 @@ ts::PCRRegulator::PCRRegulator(Report* report, int log_level) :
     _opt_burst(0),
     _burst_pkt_cnt(0),
     _wait_min(0),
+    _precise(false),
+    _spin(Monotonic::DEFAULT_SPIN_NS),
     _started(false),
     _pcr_first(0),
     _pcr_last(0),
     _pcr_offset(0),
     _clock_first(),
-    _clock_last()
+    _clock_last(),
+    _clock_pcr(),
+    _pcr_pkt_cnt(0),
+    _pkt_duration(0)
 {
 }
 
@@ -109,6 +114,22 @@ void ts::PCRRegulator::reset()
 }
 
 
+//----------------------------------------------------------------------------
+// Wait until the specified due time.
+//----------------------------------------------------------------------------
+
+void ts::PCRRegulator::waitUntil(const Monotonic& due)
+{
+    _clock_last = due;
+    if (_precise) {
+        _clock_last.preciseWait(_spin);
+    }
+    else {
+        _clock_last.wait();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Regulate the flow, to be called at each packet.
 //----------------------------------------------------------------------------
@@ -152,6 +173,9 @@ bool ts::PCRRegulator::regulate(const TSPacket& pkt)
             _clock_last = _clock_first;
             _pcr_first = pcr;
             _pcr_offset = 0;
+            _clock_pcr = _clock_first;
+            _pcr_pkt_cnt = 0;
+            _pkt_duration = 0;
 
             // Compute minimum wait is none is set.
             if (_wait_min <= 0) {
@@ -181,11 +205,22 @@ bool ts::PCRRegulator::regulate(const TSPacket& pkt)
             Monotonic clock_due(_clock_first);
             clock_due += ns;
 
-            // Do not wait less than the user-specified minimum.
-            if (clock_due - _clock_last >= _wait_min) {
+            if (_precise) {
+                // Compute the duration of one packet in the last PCR interval.
+                // It is used to interpolate the release time of packets until next PCR.
+                if (_pcr_pkt_cnt > 0) {
+                    _pkt_duration = (clock_due - _clock_pcr) / NanoSecond(_pcr_pkt_cnt);
+                }
+                _clock_pcr = clock_due;
+                _pcr_pkt_cnt = 0;
+                // Wait until system time for current PCR and flush.
+                waitUntil(clock_due);
+                flush = true;
+            }
+            else if (clock_due - _clock_last >= _wait_min) {
+                // Do not wait less than the user-specified minimum.
                 // Wait until system time for current PCR.
-                _clock_last = clock_due;
-                _clock_last.wait();
+                waitUntil(clock_due);
                 // Always flush after wait.
                 flush = true;
             }
@@ -194,6 +229,15 @@ bool ts::PCRRegulator::regulate(const TSPacket& pkt)
         // Always keep last PCR value.
         _pcr_last = pcr;
     }
+    else if (_precise && _started && _pkt_duration > 0 && _burst_pkt_cnt + 1 >= _opt_burst) {
+        // Last packet of a burst between two PCR's, wait until its interpolated release time.
+        Monotonic clock_due(_clock_pcr);
+        clock_due += NanoSecond(_pcr_pkt_cnt) * _pkt_duration;
+        waitUntil(clock_due);
+    }
+
+    // One more packet since last PCR.
+    _pcr_pkt_cnt++;
 
     // One more packet in current burst.
     if (++_burst_pkt_cnt >= _opt_burst) {
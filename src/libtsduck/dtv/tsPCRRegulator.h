@@ -94,6 +94,24 @@ namespace ts {
         //!
         void setMinimimWait(NanoSecond ns = DEFAULT_MIN_WAIT_NS);
 
+        //!
+        //! Enable or disable precise pacing.
+        //! By default, the regulator waits only on PCR's, at least the minimum wait
+        //! interval, using the system timers. With precise pacing, the release time
+        //! of each burst of packets is interpolated between PCR's, using the packet
+        //! rate of the previous PCR interval, and each burst is released at its own
+        //! due time using Monotonic::preciseWait(). The minimum wait interval is
+        //! not used in that case.
+        //! @param [in] precise If true, use precise pacing.
+        //! @param [in] spin Duration of the final active wait in nano-seconds.
+        //! @see Monotonic::preciseWait()
+        //!
+        void setPrecise(bool precise, NanoSecond spin = Monotonic::DEFAULT_SPIN_NS)
+        {
+            _precise = precise;
+            _spin = spin;
+        }
+
         //!
         //! Re-initialize state.
         //!
@@ -115,11 +133,19 @@ namespace ts {
         PacketCounter _opt_burst;       // Number of packets to burst at a time
         PacketCounter _burst_pkt_cnt;   // Number of packets in current burst
         NanoSecond    _wait_min;        // Minimum delay between two waits (ns)
+        bool          _precise;         // Use precise pacing
+        NanoSecond    _spin;            // Active wait duration with precise pacing
         bool          _started;         // First PCR found, regulation started.
         uint64_t      _pcr_first;       // First PCR value.
         uint64_t      _pcr_last;        // Last PCR value.
         uint64_t      _pcr_offset;      // Offset to add to PCR value, accumulate all PCR wrap-down sequences.
         Monotonic     _clock_first;     // System time at first PCR.
         Monotonic     _clock_last;      // System time at last wait
+        Monotonic     _clock_pcr;       // System time of last PCR (precise pacing)
+        PacketCounter _pcr_pkt_cnt;     // Number of packets since last PCR (precise pacing)
+        NanoSecond    _pkt_duration;    // Duration of one packet in last PCR interval, zero if unknown (precise pacing)
+
+        // Wait until the specified due time.
+        void waitUntil(const Monotonic& due);
     };
 }
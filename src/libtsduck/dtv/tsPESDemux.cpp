@@ -36,20 +36,6 @@
 TSDUCK_SOURCE;
 
 
-//----------------------------------------------------------------------------
-// Delimiters
-//----------------------------------------------------------------------------
-
-namespace {
-
-    // Start code prefix for ISO 11172-2 (MPEG-1 video) and ISO 13818-2 (MPEG-2 video)
-    const uint8_t StartCodePrefix[] = {0x00, 0x00, 0x01};
-
-    // End of AVC NALunit delimiter
-    const uint8_t Zero3[] = {0x00, 0x00, 0x00};
-}
-
-
 //----------------------------------------------------------------------------
 // Constructor
 //----------------------------------------------------------------------------
@@ -57,6 +43,7 @@ namespace {
 ts::PESDemux::PESDemux(DuckContext& duck, PESHandlerInterface* pes_handler, const PIDSet& pid_filter) :
     SuperClass(duck, pid_filter),
     _pes_handler(pes_handler),
+    _scatter_gather(false),
     _pids(),
     _stream_types(),
     _section_demux(_duck, this)
@@ -87,6 +74,7 @@ ts::PESDemux::PIDContext::PIDContext() :
     last_pkt(0),
     pcr(INVALID_PCR),
     ts(new ByteBlock()),
+    scattered(),
     audio(),
     video(),
     avc(),
@@ -175,6 +163,22 @@ bool ts::PESDemux::allAC3(PID pid) const
 }
 
 
+//----------------------------------------------------------------------------
+// Set the scatter-gather mode.
+//----------------------------------------------------------------------------
+
+void ts::PESDemux::setScatterGather(bool on)
+{
+    if (on != _scatter_gather) {
+        _scatter_gather = on;
+        // Drop partially demuxed PES packets, they were accumulated in the other mode.
+        for (auto it = _pids.begin(); it != _pids.end(); ++it) {
+            it->second.syncLost();
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Feed the demux with a TS packet.
 //----------------------------------------------------------------------------
@@ -242,7 +246,13 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
             PIDContext& pc(_pids[pid]);
             pc.continuity = pkt.getCC();
             pc.sync = true;
-            pc.ts->copy(pl, pl_size);
+            if (_scatter_gather) {
+                pc.scattered.clear();
+                pc.scattered.append(pkt);
+            }
+            else {
+                pc.ts->copy(pl, pl_size);
+            }
             pc.first_pkt = _packet_count;
             pc.last_pkt = _packet_count;
             pc.pcr = pkt.getPCR(); // can be invalid
@@ -274,25 +284,30 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
     }
     pc.continuity = pkt.getCC();
 
-    // Append the TS payload in PID context.
-    size_t capacity = pc.ts->capacity();
-    if (pc.ts->size() + pl_size > capacity) {
-        // Internal reallocation needed in ts buffer.
-        // Do not allow implicit reallocation, do it manually for better performance.
-        // Use two predefined thresholds: 64 kB and 512 kB. Above that, double the size.
-        // Note that 64 kB is OK for audio PIDs. Video PIDs are usually unbounded. The
-        // maximum observed PES rate is 2 PES/s, meaning 512 kB / PES at 8 Mb/s.
-        if (capacity < 64 * 1024) {
-            pc.ts->reserve(64 * 1024);
-        }
-        else if (capacity < 512 * 1024) {
-            pc.ts->reserve(512 * 1024);
-        }
-        else {
-            pc.ts->reserve(2 * capacity);
+    // Append the TS payload in PID context. In scatter-gather mode, only keep the TS packet.
+    if (_scatter_gather) {
+        pc.scattered.append(pkt);
+    }
+    else {
+        const size_t capacity = pc.ts->capacity();
+        if (pc.ts->size() + pl_size > capacity) {
+            // Internal reallocation needed in ts buffer.
+            // Do not allow implicit reallocation, do it manually for better performance.
+            // Use two predefined thresholds: 64 kB and 512 kB. Above that, double the size.
+            // Note that 64 kB is OK for audio PIDs. Video PIDs are usually unbounded. The
+            // maximum observed PES rate is 2 PES/s, meaning 512 kB / PES at 8 Mb/s.
+            if (capacity < 64 * 1024) {
+                pc.ts->reserve(64 * 1024);
+            }
+            else if (capacity < 512 * 1024) {
+                pc.ts->reserve(512 * 1024);
+            }
+            else {
+                pc.ts->reserve(2 * capacity);
+            }
         }
+        pc.ts->append(pl, pl_size);
     }
-    pc.ts->append(pl, pl_size);
 
     // Last TS packet containing actual data for this PES packet
     pc.last_pkt = _packet_count;
@@ -303,16 +318,23 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
     }
 
     // Check if the complete PES packet is now present (without waiting for the next PUSI).
-    if (pc.ts->size() >= 6 && pc.sync) {
+    const size_t size = _scatter_gather ? pc.scattered.size() : pc.ts->size();
+    if (size >= 6 && pc.sync) {
         // There is enought to get the PES packet length.
-        const size_t len = GetUInt16(pc.ts->data() + 4);
+        uint8_t header[6];
+        const uint8_t* const data = _scatter_gather ? header : pc.ts->data();
+        if (_scatter_gather) {
+            pc.scattered.read(0, header, sizeof(header));
+        }
+        const size_t len = GetUInt16(data + 4);
         // If the size is zero, the PES packet is "unbounded", meaning it ends at the next PUSI.
         // But if the PES packet size is specified, check if we have the complete PES packet.
-        if (len != 0 && pc.ts->size() >= 4 + len) {
+        if (len != 0 && size >= 6 + len) {
             // We have the complete PES packet.
             processPESPacket(pid, pc);
             // Reset PES buffer.
             pc.ts->clear();
+            pc.scattered.clear();
         }
     }
 }
@@ -365,6 +387,13 @@ void ts::PESDemux::handlePESPacket(const PESPacket& packet)
     }
 }
 
+void ts::PESDemux::handleScatteredPESPacket(const ScatteredPESPacket& packet)
+{
+    if (_pes_handler != nullptr) {
+        _pes_handler->handleScatteredPESPacket(*this, packet);
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Process a complete PES packet
@@ -372,6 +401,12 @@ void ts::PESDemux::handlePESPacket(const PESPacket& packet)
 
 void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
 {
+    // In scatter-gather mode, the PES packet is not built.
+    if (_scatter_gather) {
+        processScatteredPESPacket(pid, pc);
+        return;
+    }
+
     // Build a PES packet object around the TS buffer
     PESPacket pp(pc.ts, pid);
     if (!pp.isValid()) {
@@ -409,9 +444,9 @@ void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
             // Locate all start codes and invoke handler.
             // The beginning of the payload is already a start code prefix.
             for (size_t offset = 0; offset < psize; ) {
-                // Look for next start code
-                const void* pnext = LocatePattern(pdata + offset + 1, psize - offset - 1, StartCodePrefix, sizeof(StartCodePrefix));
-                size_t next = pnext == nullptr ? psize : reinterpret_cast<const uint8_t*>(pnext) - pdata;
+                // Look for next start code prefix 00 00 01.
+                const uint8_t* pnext = LocateZeroZero(pdata + offset + 1, psize - offset - 1, 0x01);
+                size_t next = pnext == nullptr ? psize : pnext - pdata;
                 // Invoke handler
                 if (_pes_handler != nullptr) {
                     _pes_handler->handleVideoStartCode(*this, pp, pdata[offset + 3], offset, next - offset);
@@ -430,18 +465,17 @@ void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
         else if (pp.isAVC()) {
             for (size_t offset = 0; offset < psize; ) {
                 // Locate next access unit: starts with 00 00 01 (this start code is not part of the NALunit)
-                const uint8_t* p1 = reinterpret_cast<const uint8_t*>(
-                            LocatePattern(pdata + offset, psize - offset, StartCodePrefix, sizeof(StartCodePrefix)));
+                const uint8_t* p1 = LocateZeroZero(pdata + offset, psize - offset, 0x01);
                 if (p1 == nullptr) {
                     break;
                 }
-                offset = p1 - pdata + sizeof(StartCodePrefix);
+                offset = p1 - pdata + 3;
 
                 // Locate end of access unit: ends with 00 00 00, 00 00 01 or end of data.
-                const uint8_t* p2 = reinterpret_cast<const uint8_t*>(
-                            LocatePattern(pdata + offset, psize - offset, StartCodePrefix, sizeof(StartCodePrefix)));
-                const uint8_t* p3 = reinterpret_cast<const uint8_t*>(
-                            LocatePattern(pdata + offset, psize - offset, Zero3, sizeof(Zero3)));
+                // The 00 00 00 sequence is searched only before the next 00 00 01, avoiding
+                // to rescan the rest of the PES packet for each NALunit.
+                const uint8_t* p2 = LocateZeroZero(pdata + offset, psize - offset, 0x01);
+                const uint8_t* p3 = LocateZeroZero(pdata + offset, (p2 == nullptr ? psize : p2 - pdata + 2) - offset, 0x00);
                 size_t nalunit_size = 0;
                 if (p2 == nullptr && p3 == nullptr) {
                     // No 00 00 01, no 00 00 00, the NALunit extends up to the end of data.
@@ -501,8 +535,9 @@ void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
                 }
 
                 // Accumulate info from access units to extract video attributes.
+                // Only sequence parameter sets are interesting, don't parse other NALunits.
                 // If new attributes were found, invoke handler.
-                if (pc.avc.moreBinaryData(pdata + offset, nalunit_size) && _pes_handler != nullptr) {
+                if (nalunit_type == AVC_AUT_SEQPARAMS && pc.avc.moreBinaryData(pdata + offset, nalunit_size) && _pes_handler != nullptr) {
                     _pes_handler->handleNewAVCAttributes(*this, pp, pc.avc);
                 }
 
@@ -537,3 +572,40 @@ void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
     }
     afterCallingHandler(true);
 }
+
+
+//----------------------------------------------------------------------------
+// Process a complete PES packet in scatter-gather mode
+//----------------------------------------------------------------------------
+
+void ts::PESDemux::processScatteredPESPacket(PID pid, PIDContext& pc)
+{
+    ScatteredPESPacket& pp(pc.scattered);
+    if (!pp.validate()) {
+        return;
+    }
+
+    // Count valid PES packets
+    pc.pes_count++;
+
+    // Location of the PES packet inside the demultiplexed stream
+    pp.setSourcePID(pid);
+    pp.setFirstTSPacketIndex(pc.first_pkt);
+    pp.setLastTSPacketIndex(pc.last_pkt);
+    pp.setPCR(pc.pcr);
+
+    // Set stream type if known.
+    const StreamTypeMap::const_iterator it = _stream_types.find(pid);
+    pp.setStreamType(it == _stream_types.end() ? uint8_t(ST_NULL) : it->second);
+
+    // Mark that we are in the context of handlers.
+    beforeCallingHandler(pid);
+    try {
+        handleScatteredPESPacket(pp);
+    }
+    catch (...) {
+        afterCallingHandler(false);
+        throw;
+    }
+    afterCallingHandler(true);
+}
@@ -124,6 +124,30 @@ namespace ts {
         //!
         bool allAC3(PID) const;
 
+        //!
+        //! Set the scatter-gather mode.
+        //!
+        //! In scatter-gather mode, the payloads of the TS packets are not concatenated
+        //! into one PES packet buffer. The complete PES packets are passed to the
+        //! handler as ScatteredPESPacket objects, lists of references to the TS packets
+        //! which are kept in a per-PID pool. The PES packet is flattened only when
+        //! the handler asks for it. On high bitrate video PID's, this avoids copying
+        //! and reallocating large buffers.
+        //!
+        //! In that mode, only PESHandlerInterface::handleScatteredPESPacket() is invoked.
+        //! The video start codes and the audio and video attributes are not analyzed.
+        //! Changing the mode drops the partially demuxed PES packets.
+        //!
+        //! @param [in] on True to use scatter-gather mode, false to use contiguous PES packets (the default).
+        //!
+        void setScatterGather(bool on);
+
+        //!
+        //! Check if the demux uses scatter-gather mode.
+        //! @return True if the demux uses scatter-gather mode.
+        //!
+        bool scatterGather() const { return _scatter_gather; }
+
     protected:
         //!
         //! This hook is invoked when a complete PES packet is available.
@@ -132,6 +156,13 @@ namespace ts {
         //!
         virtual void handlePESPacket(const PESPacket& packet);
 
+        //!
+        //! This hook is invoked when a complete PES packet is available in scatter-gather mode.
+        //! Can be overloaded by subclasses to add intermediate processing.
+        //! @param [in] packet The PES packet.
+        //!
+        virtual void handleScatteredPESPacket(const ScatteredPESPacket& packet);
+
         // Inherited methods
         virtual void immediateReset() override;
         virtual void immediateResetPID(PID pid) override;
@@ -140,24 +171,25 @@ namespace ts {
         // This internal structure contains the analysis context for one PID.
         struct PIDContext
         {
-            PacketCounter   pes_count;   // Number of detected valid PES packets on this PID
-            uint8_t         continuity;  // Last continuity counter
-            bool            sync;        // We are synchronous in this PID
-            PacketCounter   first_pkt;   // Index of first TS packet for current PES packet
-            PacketCounter   last_pkt;    // Index of last TS packet for current PES packet
-            uint64_t        pcr;         // First PCR for current PES packet
-            ByteBlockPtr    ts;          // TS payload buffer
-            AudioAttributes audio;       // Current audio attributes
-            VideoAttributes video;       // Current video attributes (MPEG-1, MPEG-2)
-            AVCAttributes   avc;         // Current AVC attributes
-            AC3Attributes   ac3;         // Current AC-3 attributes
-            PacketCounter   ac3_count;   // Number of PES packets with contents which looks like AC-3
+            PacketCounter      pes_count;   // Number of detected valid PES packets on this PID
+            uint8_t            continuity;  // Last continuity counter
+            bool               sync;        // We are synchronous in this PID
+            PacketCounter      first_pkt;   // Index of first TS packet for current PES packet
+            PacketCounter      last_pkt;    // Index of last TS packet for current PES packet
+            uint64_t           pcr;         // First PCR for current PES packet
+            ByteBlockPtr       ts;          // TS payload buffer
+            ScatteredPESPacket scattered;   // TS packets in scatter-gather mode
+            AudioAttributes    audio;       // Current audio attributes
+            VideoAttributes    video;       // Current video attributes (MPEG-1, MPEG-2)
+            AVCAttributes      avc;         // Current AVC attributes
+            AC3Attributes      ac3;         // Current AC-3 attributes
+            PacketCounter      ac3_count;   // Number of PES packets with contents which looks like AC-3
 
             // Default constructor:
             PIDContext();
 
             // Called when packet synchronization is lost on the pid
-            void syncLost() {sync = false; ts->clear();}
+            void syncLost() {sync = false; ts->clear(); scattered.clear();}
         };
 
         // Map of PID contexts, indexed by PID.
@@ -173,12 +205,14 @@ namespace ts {
 
         // Process a complete PES packet
         void processPESPacket(PID, PIDContext&);
+        void processScatteredPESPacket(PID, PIDContext&);
 
         // Implementation of TableHandlerInterface.
         virtual void handleTable(SectionDemux& demux, const BinaryTable& table) override;
 
         // Private members:
         PESHandlerInterface* _pes_handler;
+        bool                 _scatter_gather;
         PIDContextMap        _pids;
         StreamTypeMap        _stream_types;
         SectionDemux         _section_demux;
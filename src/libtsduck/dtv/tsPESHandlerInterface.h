@@ -34,6 +34,7 @@
 
 #pragma once
 #include "tsPESPacket.h"
+#include "tsScatteredPESPacket.h"
 #include "tsAudioAttributes.h"
 #include "tsVideoAttributes.h"
 #include "tsAVCAttributes.h"
@@ -58,6 +59,16 @@ namespace ts {
         //!
         virtual void handlePESPacket(PESDemux& demux, const PESPacket& packet);
 
+        //!
+        //! This hook is invoked when a complete PES packet is available in scatter-gather mode.
+        //! In that mode, this is the only invoked hook.
+        //! @param [in,out] demux A reference to the PES demux.
+        //! @param [in] packet The demultiplexed PES packet. It is valid only during the
+        //! execution of the hook. Use packet.getPESPacket() to keep a flattened copy.
+        //! @see PESDemux::setScatterGather()
+        //!
+        virtual void handleScatteredPESPacket(PESDemux& demux, const ScatteredPESPacket& packet);
+
         //!
         //! This hook is invoked when a video start code is encountered.
         //! @param [in,out] demux A reference to the PES demux.
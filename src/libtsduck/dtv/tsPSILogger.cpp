@@ -33,6 +33,7 @@
 #include "tsTSPacket.h"
 #include "tsNames.h"
 #include "tsPAT.h"
+#include "tsTableCache.h"
 TSDUCK_SOURCE;
 
 #define MIN_CLEAR_PACKETS 100000
@@ -67,6 +68,8 @@ ts::PSILogger::PSILogger(TablesDisplay& display) :
     _demux(_duck, this, _dump ? this : nullptr),
     _standards(Standards::NONE)
 {
+    // Tables which are repeatedly displayed are formatted only once.
+    _display.setUseTableCache(true);
 }
 
 ts::PSILogger::~PSILogger()
@@ -216,12 +219,13 @@ void ts::PSILogger::handleTable(SectionDemux&, const BinaryTable& table)
     switch (table.tableId()) {
 
         case TID_PAT: {
-            PAT pat(_duck, table);
+            TableCache::TablePtr holder;
+            const PAT* pat = TableCache::Instance()->getTable<PAT>(_duck, table, holder);
             if (pid != PID_PAT) {
                 // A PAT is only expected on PID 0
                 strm << UString::Format(u"* Got unexpected PAT on PID %d (0x%X)", {pid, pid}) << std::endl;
             }
-            else if (pat.isValid()) {
+            else if (pat != nullptr) {
                 // Got the PAT.
                 _pat_ok = true;
                 // Stop filtering the PAT PID if we don't need all versions.
@@ -229,12 +233,12 @@ void ts::PSILogger::handleTable(SectionDemux&, const BinaryTable& table)
                     _demux.removePID(pid);
                 }
                 // Add a filter on each referenced PID to get the PMT
-                for (PAT::ServiceMap::const_iterator it = pat.pmts.begin(); it != pat.pmts.end(); ++it) {
+                for (PAT::ServiceMap::const_iterator it = pat->pmts.begin(); it != pat->pmts.end(); ++it) {
                     _demux.addPID(it->second);
                     _expected_pmt++;
                 }
                 // Also include NIT (considered as a PMT)
-                _demux.addPID(pat.nit_pid != PID_NULL ? pat.nit_pid : PID(PID_NIT));
+                _demux.addPID(pat->nit_pid != PID_NULL ? pat->nit_pid : PID(PID_NIT));
                 _expected_pmt++;
             }
             // Display the content of the PAT
@@ -0,0 +1,541 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPacketFilter.h"
+#include "tsArgs.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::PacketFilter::PacketFilter() :
+    pids(),
+    stream_ids(),
+    payload(false),
+    adaptation_field(false),
+    pes(false),
+    pcr(false),
+    has_splice_countdown(false),
+    unit_start(false),
+    nullified(false),
+    input_stuffing(false),
+    valid(false),
+    negate(false),
+    scrambling_control(-1),
+    min_payload(-1),
+    max_payload(-1),
+    min_af(-1),
+    max_af(-1),
+    splice_countdown(INT_MIN),
+    min_splice_countdown(INT_MIN),
+    max_splice_countdown(INT_MIN),
+    after_packets(0),
+    every_packets(0),
+    intervals(),
+    labels(),
+    patterns(),
+    search_payload(false),
+    use_search_offset(false),
+    search_offset(0),
+    _pid_map(),
+    _header_checks(),
+    _checks(),
+    _matcher()
+{
+}
+
+ts::PacketFilter::~PacketFilter()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Clear all selection criteria.
+//----------------------------------------------------------------------------
+
+void ts::PacketFilter::clear()
+{
+    pids.reset();
+    stream_ids.clear();
+    payload = adaptation_field = pes = pcr = has_splice_countdown = false;
+    unit_start = nullified = input_stuffing = valid = negate = false;
+    scrambling_control = min_payload = max_payload = min_af = max_af = -1;
+    splice_countdown = min_splice_countdown = max_splice_countdown = INT_MIN;
+    after_packets = every_packets = 0;
+    intervals.clear();
+    labels.reset();
+    patterns.clear();
+    search_payload = use_search_offset = false;
+    search_offset = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Compile the selection criteria into a selection program.
+//----------------------------------------------------------------------------
+
+void ts::PacketFilter::reset()
+{
+    // PID's which are selected from stream ids are added on the fly.
+    _pid_map = pids;
+
+    // Checks on the TS header, as masked compares on the first 4 bytes.
+    _header_checks.clear();
+    if (valid) {
+        // Sync byte and transport_error_indicator.
+        _header_checks.push_back(std::make_pair(0xFF800000, 0x47000000));
+    }
+    if (unit_start) {
+        _header_checks.push_back(std::make_pair(0x00400000, 0x00400000));
+    }
+    if (adaptation_field) {
+        _header_checks.push_back(std::make_pair(0x00000020, 0x00000020));
+    }
+    if (payload) {
+        _header_checks.push_back(std::make_pair(0x00000010, 0x00000010));
+    }
+    if (scrambling_control >= 0 && scrambling_control <= 3) {
+        _header_checks.push_back(std::make_pair(0x000000C0, uint32_t(scrambling_control) << 6));
+    }
+
+    // Other checks, in increasing order of cost.
+    _checks.clear();
+    if (labels.any()) {
+        _checks.push_back(CHK_LABELS);
+    }
+    if (nullified) {
+        _checks.push_back(CHK_NULLIFIED);
+    }
+    if (input_stuffing) {
+        _checks.push_back(CHK_INPUT_STUFFING);
+    }
+    if (every_packets > 0) {
+        _checks.push_back(CHK_EVERY);
+    }
+    if (!intervals.empty()) {
+        _checks.push_back(CHK_INTERVALS);
+    }
+    if (min_payload >= 0) {
+        _checks.push_back(CHK_MIN_PAYLOAD);
+    }
+    if (max_payload >= 0) {
+        _checks.push_back(CHK_MAX_PAYLOAD);
+    }
+    if (min_af >= 0) {
+        _checks.push_back(CHK_MIN_AF);
+    }
+    if (max_af >= 0) {
+        _checks.push_back(CHK_MAX_AF);
+    }
+    if (pcr) {
+        _checks.push_back(CHK_PCR);
+    }
+    if (has_splice_countdown) {
+        _checks.push_back(CHK_HAS_SPLICE);
+    }
+    if (splice_countdown >= -128) {
+        _checks.push_back(CHK_SPLICE);
+    }
+    if (min_splice_countdown >= -128) {
+        _checks.push_back(CHK_MIN_SPLICE);
+    }
+    if (max_splice_countdown >= -128) {
+        _checks.push_back(CHK_MAX_SPLICE);
+    }
+    if (pes) {
+        _checks.push_back(CHK_PES);
+    }
+
+    // Byte patterns are compiled once, searched last.
+    _matcher.clear();
+    for (auto it = patterns.begin(); it != patterns.end(); ++it) {
+        _matcher.addPattern(*it);
+    }
+    _matcher.compile();
+    if (!_matcher.empty()) {
+        _checks.push_back(CHK_PATTERNS);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a packet matches the selection criteria.
+//----------------------------------------------------------------------------
+
+bool ts::PacketFilter::match(const TSPacket& pkt, const TSPacketMetadata& mdata, PacketCounter index)
+{
+    // Initial packets are not considered.
+    if (index < after_packets) {
+        return false;
+    }
+
+    const PID pid = pkt.getPID();
+
+    // Check stream ids of PES packets. The stream id is in the fourth byte of
+    // the payload of a TS packet containing the start of a PES packet.
+    if (!stream_ids.empty() && pkt.startPES() && pkt.getPayloadSize() >= 4) {
+        const bool selected = stream_ids.find(pkt.getPayload()[3]) != stream_ids.end();
+        _pid_map.set(pid, selected || pids.test(pid));
+    }
+
+    // Stage 1: PID bitmap.
+    bool ok = _pid_map.test(pid);
+
+    // Stage 2: masked compares on the TS header.
+    if (!ok && !_header_checks.empty()) {
+        const uint32_t header = GetUInt32(pkt.b);
+        for (auto it = _header_checks.begin(); !ok && it != _header_checks.end(); ++it) {
+            ok = (header & it->first) == it->second;
+        }
+    }
+
+    // Stage 3: other checks, cheapest first.
+    for (auto it = _checks.begin(); !ok && it != _checks.end(); ++it) {
+        ok = check(*it, pkt, mdata, index);
+    }
+
+    // Reverse selection criteria with --negate.
+    return ok != negate;
+}
+
+
+//----------------------------------------------------------------------------
+// Evaluate one of the other checks.
+//----------------------------------------------------------------------------
+
+bool ts::PacketFilter::check(Check chk, const TSPacket& pkt, const TSPacketMetadata& mdata, PacketCounter index) const
+{
+    switch (chk) {
+        case CHK_LABELS:
+            return mdata.hasAnyLabel(labels);
+        case CHK_NULLIFIED:
+            return mdata.getNullified();
+        case CHK_INPUT_STUFFING:
+            return mdata.getInputStuffing();
+        case CHK_EVERY:
+            return (index - after_packets) % every_packets == 0;
+        case CHK_INTERVALS:
+            for (auto it = intervals.begin(); it != intervals.end(); ++it) {
+                if (index >= it->first && index <= it->second) {
+                    return true;
+                }
+            }
+            return false;
+        case CHK_MIN_PAYLOAD:
+            return int(pkt.getPayloadSize()) >= min_payload;
+        case CHK_MAX_PAYLOAD:
+            return int(pkt.getPayloadSize()) <= max_payload;
+        case CHK_MIN_AF:
+            return int(pkt.getAFSize()) >= min_af;
+        case CHK_MAX_AF:
+            return int(pkt.getAFSize()) <= max_af;
+        case CHK_PCR:
+            return pkt.hasPCR() || pkt.hasOPCR();
+        case CHK_HAS_SPLICE:
+            return pkt.hasSpliceCountdown();
+        case CHK_SPLICE:
+            return pkt.hasSpliceCountdown() && pkt.getSpliceCountdown() == splice_countdown;
+        case CHK_MIN_SPLICE:
+            return pkt.hasSpliceCountdown() && pkt.getSpliceCountdown() >= min_splice_countdown;
+        case CHK_MAX_SPLICE:
+            return pkt.hasSpliceCountdown() && pkt.getSpliceCountdown() <= max_splice_countdown;
+        case CHK_PES:
+            return pkt.startPES();
+        case CHK_PATTERNS: {
+            const size_t start = (search_payload ? pkt.getHeaderSize() : 0) + search_offset;
+            if (start >= PKT_SIZE) {
+                return false;
+            }
+            else if (use_search_offset) {
+                return _matcher.matchAt(pkt.b + start, PKT_SIZE - start);
+            }
+            else {
+                return _matcher.search(pkt.b + start, PKT_SIZE - start);
+            }
+        }
+        default:
+            return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Define command line options in an Args.
+//----------------------------------------------------------------------------
+
+void ts::PacketFilter::defineArgs(Args& args) const
+{
+    args.option(u"adaptation-field");
+    args.help(u"adaptation-field", u"Select packets with an adaptation field.");
+
+    args.option(u"after-packets", 0, Args::UNSIGNED);
+    args.help(u"after-packets", u"count",
+              u"Let the first 'count' packets pass transparently without filtering. Start "
+              u"to apply the filtering criteria after that number of packets.");
+
+    args.option(u"clear", 'c');
+    args.help(u"clear",
+              u"Select clear (unscrambled) packets. "
+              u"Equivalent to --scrambling-control 0.");
+
+    args.option(u"every", 0, Args::UNSIGNED);
+    args.help(u"every", u"count", u"Select one packet every that number of packets.");
+
+    args.option(u"has-splice-countdown");
+    args.help(u"has-splice-countdown", u"Select packets which contain a splice_countdown value in adaptation field.");
+
+    args.option(u"input-stuffing");
+    args.help(u"input-stuffing",
+              u"Select packets which were articially inserted as stuffing before the input "
+              u"plugin (using tsp options --add-start-stuffing, --add-input-stuffing and "
+              u"--add-stop-stuffing). Be aware that these packets may no longer be null "
+              u"packets if some previous plugin injected data, replacing stuffing.");
+
+    args.option(u"interval", 'i', Args::STRING, 0, Args::UNLIMITED_COUNT);
+    args.help(u"interval", u"index1[-[index2]]",
+              u"Select all packets in the specified interval from the start of the stream. "
+              u"The packets in the stream are indexed starting at zero. "
+              u"In the form 'index1', only one packet is selected, at the specified index. "
+              u"In the form 'index1-index2', all packets in the specified range of indexes, inclusive, are selected. "
+              u"In the form 'index1-', all packets starting at the specified index are selected, up to the end of the stream. "
+              u"Several options --interval can be specified.");
+
+    args.option(u"label", 'l', Args::INTEGER, 0, Args::UNLIMITED_COUNT, 0, TSPacketMetadata::LABEL_MAX);
+    args.help(u"label", u"label1[-label2]",
+              u"Select packets with any of the specified labels. "
+              u"Labels should have typically been set by a previous plugin in the chain. "
+              u"Several --label options may be specified.\n\n"
+              u"Note that the option --label is different from the generic option --only-label. "
+              u"The generic option --only-label acts at tsp level and controls which packets are "
+              u"passed to the plugin. All other packets are directly passed to the next plugin "
+              u"without going through this plugin. The option --label, on the other hand, "
+              u"is specific to this plugin and selects packets with specific labels "
+              u"among the packets which are passed to this plugin.");
+
+    args.option(u"max-adaptation-field-size", 0, Args::INTEGER, 0, 1, 0, 184);
+    args.help(u"max-adaptation-field-size",
+              u"Select packets with no adaptation field or with an adaptation field the "
+              u"size (in bytes) of which is not greater than the specified value.");
+
+    args.option(u"max-payload-size", 0, Args::INTEGER, 0, 1, 0, 184);
+    args.help(u"max-payload-size",
+              u"Select packets with no payload or with a payload the size (in bytes) of "
+              u"which is not greater than the specified value.");
+
+    args.option(u"max-splice-countdown", 0, Args::INT8);
+    args.help(u"max-splice-countdown",
+              u"Select packets with a splice_countdown value in adaptation field which is "
+              u"lower than or equal to the specified value.");
+
+    args.option(u"min-adaptation-field-size", 0, Args::INTEGER, 0, 1, 0, 184);
+    args.help(u"min-adaptation-field-size",
+              u"Select packets with an adaptation field the size (in bytes) of which "
+              u"is equal to or greater than the specified value.");
+
+    args.option(u"min-payload-size", 0, Args::INTEGER, 0, 1, 0, 184);
+    args.help(u"min-payload-size",
+              u"Select packets with a payload the size (in bytes) of which is equal "
+              u"to or greater than the specified value.");
+
+    args.option(u"min-splice-countdown", 0, Args::INT8);
+    args.help(u"min-splice-countdown",
+              u"Select packets with a splice_countdown value in adaptation field which is "
+              u"greater than or equal to the specified value.");
+
+    args.option(u"negate", 'n');
+    args.help(u"negate", u"Negate the filter: specified packets are excluded.");
+
+    args.option(u"nullified");
+    args.help(u"nullified",
+              u"Select packets which were explicitly turned into null packets by some previous "
+              u"plugin in the chain (typically using a --stuffing option).");
+
+    args.option(u"pattern", 0, Args::STRING, 0, Args::UNLIMITED_COUNT);
+    args.help(u"pattern",
+              u"Select packets containing the specified pattern bytes. "
+              u"The value must be a string of hexadecimal digits specifying any number of bytes. "
+              u"By default, the packet is selected when the value is anywhere inside the packet. "
+              u"With option --search-payload, only search the pattern in the payload of the packet. "
+              u"With option --search-offset, the packet is selected only if the pattern "
+              u"is at the specified offset in the packet. "
+              u"When --search-payload and --search-offset are both specified, the packet "
+              u"is selected only if the pattern is at the specified offset in the payload. "
+              u"Several --pattern options may be specified, the packet is selected when it contains any of them. "
+              u"The search time does not depend on the number of patterns.");
+
+    args.option(u"pattern-file", 0, Args::STRING, 0, Args::UNLIMITED_COUNT);
+    args.help(u"pattern-file", u"filename",
+              u"Specify a text file containing patterns to search, one pattern per line, "
+              u"as hexadecimal digits. Each line is used as an additional --pattern option. "
+              u"Empty lines and lines starting with '#' are ignored. "
+              u"Several --pattern-file options may be specified.");
+
+    args.option(u"payload");
+    args.help(u"payload", u"Select packets with a payload.");
+
+    args.option(u"pcr");
+    args.help(u"pcr", u"Select packets with PCR or OPCR.");
+
+    args.option(u"pes");
+    args.help(u"pes", u"Select packets with clear PES headers.");
+
+    args.option(u"pid", 'p', Args::PIDVAL, 0, Args::UNLIMITED_COUNT);
+    args.help(u"pid", u"pid1[-pid2]",
+              u"PID filter: select packets with these PID values. "
+              u"Several -p or --pid options may be specified.");
+
+    args.option(u"scrambling-control", 0, Args::INTEGER, 0, 1, 0, 3);
+    args.help(u"scrambling-control",
+              u"Select packets with the specified scrambling control value. Valid "
+              u"values are 0 (clear), 1 (reserved), 2 (even key), 3 (odd key).");
+
+    args.option(u"search-offset", 0, Args::INTEGER, 0, 1, 0, PKT_SIZE - 1);
+    args.help(u"search-offset",
+              u"With --pattern, only search the set of bytes at the specified offset in the packet "
+              u"(the default) or in the payload (with --search-payload).");
+
+    args.option(u"search-payload");
+    args.help(u"search-payload",
+              u"With --pattern, only search the set of bytes in the payload of the packet. "
+              u"Do not search the pattern in the header or adaptation field.");
+
+    args.option(u"splice-countdown", 0, Args::INT8);
+    args.help(u"splice-countdown", u"Select packets with the specified splice_countdown value in adaptation field.");
+
+    args.option(u"stream-id", 0, Args::UINT8, 0, Args::UNLIMITED_COUNT);
+    args.help(u"stream-id", u"id1[-id2]",
+              u"Select PES PID's with any of the specified stream ids. "
+              u"A PID starts to be selected when a specified stream id appears. "
+              u"Such a PID is no longer selected when non-specified stream id is found. "
+              u"Several --stream-id options may be specified.");
+
+    args.option(u"unit-start");
+    args.help(u"unit-start", u"Select packets with payload unit start indicator.");
+
+    args.option(u"valid", 'v');
+    args.help(u"valid",
+              u"Select valid packets. A valid packet starts with 0x47 and has "
+              u"its transport_error_indicator cleared.");
+}
+
+
+//----------------------------------------------------------------------------
+// Load arguments from command line.
+//----------------------------------------------------------------------------
+
+bool ts::PacketFilter::loadArgs(DuckContext& duck, Args& args)
+{
+    scrambling_control = args.present(u"clear") ? 0 : args.intValue(u"scrambling-control", -1);
+    payload = args.present(u"payload");
+    adaptation_field = args.present(u"adaptation-field");
+    pes = args.present(u"pes");
+    pcr = args.present(u"pcr");
+    has_splice_countdown = args.present(u"has-splice-countdown");
+    unit_start = args.present(u"unit-start");
+    nullified = args.present(u"nullified");
+    input_stuffing = args.present(u"input-stuffing");
+    valid = args.present(u"valid");
+    negate = args.present(u"negate");
+    args.getIntValue(min_payload, u"min-payload-size", -1);
+    args.getIntValue(max_payload, u"max-payload-size", -1);
+    args.getIntValue(min_af, u"min-adaptation-field-size", -1);
+    args.getIntValue(max_af, u"max-adaptation-field-size", -1);
+    args.getIntValue(splice_countdown, u"splice-countdown", INT_MIN);
+    args.getIntValue(min_splice_countdown, u"min-splice-countdown", INT_MIN);
+    args.getIntValue(max_splice_countdown, u"max-splice-countdown", INT_MIN);
+    args.getIntValue(after_packets, u"after-packets");
+    args.getIntValue(every_packets, u"every");
+    args.getIntValues(pids, u"pid");
+    args.getIntValues(stream_ids, u"stream-id");
+    args.getIntValues(labels, u"label");
+    search_payload = args.present(u"search-payload");
+    use_search_offset = args.present(u"search-offset");
+    args.getIntValue(search_offset, u"search-offset");
+
+    // Get all patterns to search, from the command line and from files.
+    UStringVector lines;
+    args.getValues(lines, u"pattern");
+    UStringVector files;
+    args.getValues(files, u"pattern-file");
+    for (auto it = files.begin(); it != files.end(); ++it) {
+        UStringList file_lines;
+        if (!UString::Load(file_lines, *it)) {
+            args.error(u"error loading file %s", {*it});
+            return false;
+        }
+        for (auto line = file_lines.begin(); line != file_lines.end(); ++line) {
+            line->trim();
+            if (!line->empty() && !line->startWith(u"#")) {
+                lines.push_back(*line);
+            }
+        }
+    }
+
+    // Decode all patterns.
+    patterns.clear();
+    ByteBlock pattern;
+    for (auto it = lines.begin(); it != lines.end(); ++it) {
+        if (!it->hexaDecode(pattern)) {
+            args.error(u"invalid hexadecimal pattern \"%s\"", {*it});
+            return false;
+        }
+        // Check that the pattern to search is not larger than the packet.
+        if (pattern.size() > PKT_SIZE || (use_search_offset && search_offset + pattern.size() > PKT_SIZE)) {
+            args.error(u"search pattern too large for TS packets");
+            return false;
+        }
+        patterns.push_back(pattern);
+    }
+
+    // Decode all index ranges.
+    intervals.clear();
+    UStringVector ranges;
+    args.getValues(ranges, u"interval");
+    for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+        PacketCounter first = 0;
+        PacketCounter second = 0;
+        if (it->scan(u"%d-%d", {&first, &second})) {
+            intervals.push_back(std::make_pair(first, second));
+        }
+        else if (it->scan(u"%d-", {&first})) {
+            intervals.push_back(std::make_pair(first, std::numeric_limits<PacketCounter>::max()));
+        }
+        else if (it->scan(u"%d", {&first})) {
+            intervals.push_back(std::make_pair(first, first));
+        }
+        else {
+            args.error(u"invalid packet range %s", {*it});
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,168 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Selection of TS packets according to various criteria.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsArgsSupplierInterface.h"
+#include "tsTSPacket.h"
+#include "tsTSPacketMetadata.h"
+#include "tsMultiPatternMatcher.h"
+
+namespace ts {
+    //!
+    //! Selection of TS packets according to various criteria.
+    //! @ingroup mpeg
+    //!
+    //! A packet is selected when it matches any of the selection criteria.
+    //! The criteria are public fields which can be set from the command line
+    //! or directly by the application. They are compiled by reset() into a
+    //! small selection program: a bitmap of PID's, a list of masked compares
+    //! on the 4-byte TS header and a list of the remaining checks which are
+    //! actually used, the most expensive ones last.
+    //!
+    class TSDUCKDLL PacketFilter : public ArgsSupplierInterface
+    {
+    public:
+        //!
+        //! Constructor.
+        //!
+        PacketFilter();
+
+        //!
+        //! Virtual destructor.
+        //!
+        virtual ~PacketFilter();
+
+        //!
+        //! A range of packet indexes, inclusive.
+        //!
+        typedef std::pair<PacketCounter, PacketCounter> PacketRange;
+
+        //!
+        //! A list of ranges of packet indexes.
+        //!
+        typedef std::list<PacketRange> PacketRangeList;
+
+        // Public fields, by options.
+        PIDSet          pids;                 //!< Select packets with these PID values.
+        std::set<uint8_t> stream_ids;         //!< Select PES PID's with these stream ids.
+        bool            payload;              //!< Select packets with payload.
+        bool            adaptation_field;     //!< Select packets with adaptation field.
+        bool            pes;                  //!< Select packets with clear PES headers.
+        bool            pcr;                  //!< Select packets with PCR or OPCR.
+        bool            has_splice_countdown; //!< Select packets with splice_countdown in adaptation field.
+        bool            unit_start;           //!< Select packets with payload unit start.
+        bool            nullified;            //!< Select packets which were nullified by a previous plugin.
+        bool            input_stuffing;       //!< Select null packets which were artificially inserted.
+        bool            valid;                //!< Select packets with valid sync byte and no transport error.
+        bool            negate;               //!< Negate the selection (exclude selected packets).
+        int             scrambling_control;   //!< Select packets with this scrambling control value (<0: none).
+        int             min_payload;          //!< Minimum payload size (<0: none).
+        int             max_payload;          //!< Maximum payload size (<0: none).
+        int             min_af;               //!< Minimum adaptation field size (<0: none).
+        int             max_af;               //!< Maximum adaptation field size (<0: none).
+        int             splice_countdown;     //!< Exact splice_countdown value (<-128: none).
+        int             min_splice_countdown; //!< Minimum splice_countdown value (<-128: none).
+        int             max_splice_countdown; //!< Maximum splice_countdown value (<-128: none).
+        PacketCounter   after_packets;        //!< Number of initial packets to pass without selection.
+        PacketCounter   every_packets;        //!< Select one packet every this number of packets (0: none).
+        PacketRangeList intervals;            //!< Select packets in these ranges of indexes.
+        TSPacketMetadata::LabelSet labels;    //!< Select packets with any of these labels.
+        std::vector<ByteBlock> patterns;      //!< Select packets containing any of these byte patterns.
+        bool            search_payload;       //!< Search patterns in payload only.
+        bool            use_search_offset;    //!< Search patterns at the specified offset only.
+        size_t          search_offset;        //!< Offset where to search patterns.
+
+        //!
+        //! Clear all selection criteria. No packet is selected.
+        //! The method reset() shall be called before using the filter.
+        //!
+        void clear();
+
+        //!
+        //! Compile the selection criteria and reset the state of the filter.
+        //! Must be called after setting the selection criteria, before the first packet.
+        //!
+        void reset();
+
+        //!
+        //! Check if a packet matches the selection criteria.
+        //! Must be called on all packets in sequence since some criteria depend on previous packets.
+        //! @param [in] pkt A TS packet.
+        //! @param [in] mdata The metadata of @a pkt.
+        //! @param [in] index Index of the packet in the stream, starting at zero.
+        //! @return True if the packet is selected (or not selected with @a negate). Always
+        //! false when @a index is lower than @a after_packets, the initial packets are not
+        //! considered at all and the application decides what to do with them.
+        //!
+        bool match(const TSPacket& pkt, const TSPacketMetadata& mdata, PacketCounter index);
+
+        // Implementation of ArgsSupplierInterface.
+        virtual void defineArgs(Args& args) const override;
+        virtual bool loadArgs(DuckContext& duck, Args& args) override;
+
+    private:
+        // Checks which are not done with the PID bitmap or on the TS header.
+        // They are evaluated in this order, when used.
+        enum Check {
+            CHK_LABELS,
+            CHK_NULLIFIED,
+            CHK_INPUT_STUFFING,
+            CHK_EVERY,
+            CHK_INTERVALS,
+            CHK_MIN_PAYLOAD,
+            CHK_MAX_PAYLOAD,
+            CHK_MIN_AF,
+            CHK_MAX_AF,
+            CHK_PCR,
+            CHK_HAS_SPLICE,
+            CHK_SPLICE,
+            CHK_MIN_SPLICE,
+            CHK_MAX_SPLICE,
+            CHK_PES,
+            CHK_PATTERNS,
+        };
+
+        // Masked compare on the 4-byte TS header: selected if (header & mask) == value.
+        typedef std::pair<uint32_t, uint32_t> HeaderCompare;
+
+        // Selection program, built by reset().
+        PIDSet                     _pid_map;         // Selected PID's, explicit ones and from stream ids (updated on the fly).
+        std::vector<HeaderCompare> _header_checks;   // Masked compares on TS header.
+        std::vector<Check>         _checks;          // Other checks, in order of evaluation.
+        MultiPatternMatcher        _matcher;         // Compiled patterns.
+
+        // Evaluate one of the other checks.
+        bool check(Check chk, const TSPacket& pkt, const TSPacketMetadata& mdata, PacketCounter index) const;
+    };
+}
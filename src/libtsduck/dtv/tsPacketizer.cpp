@@ -31,8 +31,13 @@
 #include "tsNullReport.h"
 #include "tsTSPacket.h"
 #include "tsNames.h"
+#include "tsCRC32.h"
 TSDUCK_SOURCE;
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::Packetizer::DEFAULT_CACHE_SIZE;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -45,7 +50,11 @@ ts::Packetizer::Packetizer(const DuckContext& duck, PID pid, SectionProviderInte
     _section(nullptr),
     _next_byte(0),
     _section_out_count(0),
-    _section_in_count(0)
+    _section_in_count(0),
+    _cache_max(DEFAULT_CACHE_SIZE),
+    _cache(),
+    _cache_index(),
+    _cache_entry(nullptr)
 {
 }
 
@@ -54,6 +63,117 @@ ts::Packetizer::~Packetizer()
 }
 
 
+//----------------------------------------------------------------------------
+// Build the pre-built packets of a cached section.
+//----------------------------------------------------------------------------
+
+ts::Packetizer::CachedSection::CachedSection() :
+    key(0),
+    content(),
+    packets()
+{
+}
+
+void ts::Packetizer::CachedSection::build(uint32_t crc, const Section& section)
+{
+    key = crc;
+    content.copy(section.content(), section.size());
+    packets.resize(size_t(section.packetCount()));
+
+    size_t next_byte = 0;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        TSPacket& pkt(packets[i]);
+        pkt.b[0] = SYNC_BYTE;
+        PutUInt16(pkt.b + 1, i == 0 ? 0x4000 : 0x0000);
+        pkt.b[3] = 0x10;  // no adaptation field, has payload
+        uint8_t* data = pkt.b + 4;
+        if (i == 0) {
+            *data++ = 0x00; // pointer field, section starts immediately
+        }
+        const size_t remain_in_packet = pkt.b + PKT_SIZE - data;
+        const size_t length = std::min(content.size() - next_byte, remain_in_packet);
+        ::memcpy(data, content.data() + next_byte, length);  // Flawfinder: ignore: memcpy()
+        ::memset(data + length, 0xFF, remain_in_packet - length);
+        next_byte += length;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get or create the cache entry for a section.
+//----------------------------------------------------------------------------
+
+ts::Packetizer::CachedSection* ts::Packetizer::getCachedSection(const Section& section)
+{
+    if (_cache_max == 0 || !section.isValid()) {
+        return nullptr;
+    }
+
+    // Long sections already end with a CRC32 of their content.
+    const uint8_t* const data = section.content();
+    const size_t size = section.size();
+    const uint32_t key = section.isLongSection() ? GetUInt32(data + size - 4) : CRC32(data, size).value();
+
+    // Look for an identical section in the cache. Move it first in the list when found.
+    const auto range = _cache_index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        const CachedSectionList::iterator entry(it->second);
+        if (entry->content.size() == size && ::memcmp(entry->content.data(), data, size) == 0) {
+            _cache.splice(_cache.begin(), _cache, entry);
+            return &*entry;
+        }
+    }
+
+    // Not found, add a new cache entry. When the cache is full, reuse the least recently used one.
+    if (_cache.size() >= _cache_max) {
+        unindexOldestCachedSection();
+        _cache.splice(_cache.begin(), _cache, std::prev(_cache.end()));
+    }
+    else {
+        _cache.emplace_front();
+    }
+    _cache.front().build(key, section);
+    _cache_index.insert(std::make_pair(key, _cache.begin()));
+    return &_cache.front();
+}
+
+
+//----------------------------------------------------------------------------
+// Remove the least recently used section from the index of the cache.
+//----------------------------------------------------------------------------
+
+void ts::Packetizer::unindexOldestCachedSection()
+{
+    if (!_cache.empty()) {
+        CachedSection* const oldest = &_cache.back();
+        if (oldest == _cache_entry) {
+            _cache_entry = nullptr;
+        }
+        const auto range = _cache_index.equal_range(oldest->key);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (&*it->second == oldest) {
+                _cache_index.erase(it);
+                break;
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Set the maximum number of sections in the cache of pre-built packets.
+//----------------------------------------------------------------------------
+
+void ts::Packetizer::setCacheSize(size_t count)
+{
+    _cache_max = count;
+    while (_cache.size() > _cache_max) {
+        unindexOldestCachedSection();
+        _cache.pop_back();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Reset the content of a packetizer. Becomes empty.
 //----------------------------------------------------------------------------
@@ -63,6 +183,7 @@ void ts::Packetizer::reset()
     AbstractPacketizer::reset();
     _section.clear();
     _next_byte = 0;
+    _cache_entry = nullptr;
 }
 
 
@@ -72,6 +193,15 @@ void ts::Packetizer::reset()
 
 bool ts::Packetizer::getNextPacket(TSPacket& pkt)
 {
+    // If the current section is cached and its remaining part is too large to start another
+    // section in the packet, the provider needs not be queried, use the pre-built packet.
+    if (_cache_entry != nullptr && _cache_entry->content.size() - _next_byte > PKT_SIZE - 5 - (_split_headers ? 0 : SHORT_SECTION_HEADER_SIZE)) {
+        if (getCachedPacket(pkt)) {
+            _section.clear();
+        }
+        return true;
+    }
+
     // If there is no current section, get the next one.
     if (_section.isNull() && _provider != nullptr) {
         _provider->provideSection(_section_in_count, _section);
@@ -87,6 +217,11 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
         return false;
     }
 
+    // When a section starts at the beginning of a packet, its packets may be cached.
+    if (_next_byte == 0) {
+        _cache_entry = getCachedSection(*_section);
+    }
+
     // Various values to build the MPEG header.
     uint16_t pusi = 0x0000;         // payload_unit_start_indicator (set: 0x4000)
     uint8_t pointer_field = 0x00;   // pointer_field (used only if pusi is set)
@@ -131,6 +266,14 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
         pointer_field = uint8_t(remain_in_section);  // point after current section
     }
 
+    // When the packet contains only data from the current section, use the pre-built packet if there is one.
+    if (do_stuffing && _cache_entry != nullptr) {
+        if (getCachedPacket(pkt)) {
+            _section = next_section;
+        }
+        return true;
+    }
+
     // Build the header
     pkt.b[0] = SYNC_BYTE;
     PutUInt16(pkt.b + 1, pusi);
@@ -161,6 +304,7 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
         if (remain_in_section == 0) {
             // Count sections
             _section_out_count++;
+            _cache_entry = nullptr;
             // Remember next section if known
             _section = next_section;
             _next_byte = 0;
@@ -208,6 +352,35 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
 }
 
 
+//----------------------------------------------------------------------------
+// Get the next packet from the cache entry of the current section.
+//----------------------------------------------------------------------------
+
+bool ts::Packetizer::getCachedPacket(TSPacket& pkt)
+{
+    // Since the section started at the beginning of a packet, all previous packets
+    // were full and the pre-built packets are at the same offsets in the section.
+    const size_t index = (_next_byte + 1) / (PKT_SIZE - 4);
+    assert(_next_byte == 0 || (_next_byte + 1) % (PKT_SIZE - 4) == 0);
+    assert(index < _cache_entry->packets.size());
+
+    pkt = _cache_entry->packets[index];
+    configurePacket(pkt, false);  // PID, continuity, count packets.
+
+    // Advance in current section.
+    _next_byte += _next_byte == 0 ? PKT_SIZE - 5 : PKT_SIZE - 4;
+    if (_next_byte < _cache_entry->content.size()) {
+        return false;
+    }
+    else {
+        _section_out_count++;
+        _next_byte = 0;
+        _cache_entry = nullptr;
+        return true;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Display the internal state of the packetizer, mainly for debug
 //----------------------------------------------------------------------------
@@ -217,6 +390,7 @@ std::ostream& ts::Packetizer::display(std::ostream& strm) const
     return AbstractPacketizer::display(strm)
         << UString::Format(u"  Output sections: %'d", {_section_out_count}) << std::endl
         << UString::Format(u"  Provided sections: %'d", {_section_in_count}) << std::endl
+        << UString::Format(u"  Cached sections: %d (max: %d)", {_cache.size(), _cache_max}) << std::endl
         << "  Current section: "
         << (_section.isNull() ? UString(u"none") : UString::Format(u"%s, offset %d", {names::TID(duck(), _section->tableId()), _next_byte}))
         << std::endl;
@@ -35,6 +35,7 @@
 #pragma once
 #include "tsAbstractPacketizer.h"
 #include "tsSectionProviderInterface.h"
+#include "tsTSPacket.h"
 
 namespace ts {
     //!
@@ -43,6 +44,14 @@ namespace ts {
     //!
     //! Sections are provided by an object implementing SectionProviderInterface.
     //!
+    //! The packetizer keeps a cache of pre-built TS packets for the most recently
+    //! packetized sections, identified by their content. When a section which starts
+    //! at the beginning of a TS packet is packetized again, all its packets which do
+    //! not contain data from another section are copied from the cache and only the
+    //! PID and continuity counter are updated. This is typically the case of tables
+    //! which are cyclically broadcast without modification. The generated packets
+    //! are strictly identical with or without cache.
+    //!
     class TSDUCKDLL Packetizer: public AbstractPacketizer
     {
         TS_NOBUILD_NOCOPY(Packetizer);
@@ -94,6 +103,24 @@ namespace ts {
         //!
         void allowHeaderSplit(bool allow) { _split_headers = allow; }
 
+        //!
+        //! Default maximum number of sections in the cache of pre-built packets.
+        //!
+        static constexpr size_t DEFAULT_CACHE_SIZE = 256;
+
+        //!
+        //! Set the maximum number of sections in the cache of pre-built packets.
+        //! When the cache is full, the least recently used section is removed.
+        //! @param [in] count Maximum number of cached sections. Zero disables the cache.
+        //!
+        void setCacheSize(size_t count);
+
+        //!
+        //! Get the maximum number of sections in the cache of pre-built packets.
+        //! @return Maximum number of cached sections. Zero means that the cache is disabled.
+        //!
+        size_t cacheSize() const { return _cache_max; }
+
         //!
         //! Check if splitting section headers across TS packets is allowed.
         //! @return True if splitting section headers across TS packets is allowed.
@@ -106,11 +133,46 @@ namespace ts {
         virtual std::ostream& display(std::ostream& strm) const override;
 
     private:
+        // Pre-built packets of a section starting at the beginning of a TS packet.
+        // All packets are followed by stuffing. PID and CC shall be updated.
+        class CachedSection
+        {
+        public:
+            uint32_t       key;       // CRC32 of section content.
+            ByteBlock      content;   // Section content, to check identity.
+            TSPacketVector packets;   // Pre-built packets.
+
+            // Constructor.
+            CachedSection();
+
+            // Build packets for a section, reuse previously allocated memory.
+            void build(uint32_t key, const Section& section);
+        };
+
+        // Cached sections, most recently used first, and their index by CRC32 of content.
+        typedef std::list<CachedSection> CachedSectionList;
+        typedef std::multimap<uint32_t, CachedSectionList::iterator> CachedSectionIndex;
+
         SectionProviderInterface* _provider;
         bool           _split_headers;     // Allowed to split section header beetwen TS packets.
         SectionPtr     _section;           // Current section to insert
         size_t         _next_byte;         // Next byte to insert in current section
         SectionCounter _section_out_count; // Number of output (packetized) sections
         SectionCounter _section_in_count;  // Number of input (provided) sections
+        size_t         _cache_max;         // Max number of cached sections.
+        CachedSectionList  _cache;         // Cache of pre-built packets.
+        CachedSectionIndex _cache_index;   // Index of cached sections.
+        CachedSection*     _cache_entry;   // Cache entry of current section, null if not cached.
+
+        // Get or create the cache entry for a section. Return null if the cache is disabled.
+        CachedSection* getCachedSection(const Section& section);
+
+        // Get the next packet from the cache entry of the current section.
+        // The packet shall contain no data from another section.
+        // Return true at end of section, the caller shall then set the next current section.
+        bool getCachedPacket(TSPacket& pkt);
+
+        // Remove the least recently used section from the index of the cache.
+        void unindexOldestCachedSection();
     };
 }
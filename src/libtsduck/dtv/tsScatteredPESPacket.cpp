@@ -0,0 +1,186 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsScatteredPESPacket.h"
+#include "tsMemory.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::ScatteredPESPacket::ScatteredPESPacket(PID source_pid) :
+    _is_valid(false),
+    _header_size(0),
+    _stream_id(0),
+    _source_pid(source_pid),
+    _stream_type(ST_NULL),
+    _pcr(INVALID_PCR),
+    _first_pkt(0),
+    _last_pkt(0),
+    _size(0),
+    _count(0),
+    _packets(),
+    _flat()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Clear the packet content, keep the pool of TS packets.
+//----------------------------------------------------------------------------
+
+void ts::ScatteredPESPacket::clear()
+{
+    _is_valid = false;
+    _header_size = 0;
+    _stream_id = 0;
+    _pcr = INVALID_PCR;
+    _first_pkt = 0;
+    _last_pkt = 0;
+    _size = 0;
+    _count = 0;
+    _flat.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Append the payload of a TS packet.
+//----------------------------------------------------------------------------
+
+void ts::ScatteredPESPacket::append(const TSPacket& pkt)
+{
+    // Reuse a TS packet from the pool when possible, without reallocation.
+    if (_count < _packets.size()) {
+        _packets[_count] = pkt;
+    }
+    else {
+        _packets.push_back(pkt);
+    }
+    _count++;
+    _size += pkt.getPayloadSize();
+    _is_valid = false;
+    _flat.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Check the PES header. Same checks as in PESPacket.
+//----------------------------------------------------------------------------
+
+bool ts::ScatteredPESPacket::validate()
+{
+    _is_valid = false;
+    _header_size = 0;
+    _stream_id = 0;
+
+    // Gather the fixed part of the header, possibly over several segments.
+    uint8_t data[9];
+    const size_t size = read(0, data, sizeof(data));
+
+    // Check start code prefix: 00 00 01
+    if (size < 6 || data[0] != 0 || data[1] != 0 || data[2] != 1) {
+        return false;
+    }
+
+    // Packet structure depends on stream_id. The first segment may be shorter than the start of the header.
+    _stream_id = data[3];
+    if (IsLongHeaderSID(_stream_id)) {
+        if (size < 9) {
+            return false;
+        }
+        _header_size = 9 + size_t(data[8]);
+        if (_size < _header_size) {
+            return false;
+        }
+    }
+    else {
+        _header_size = 6;
+    }
+
+    // Check that the embedded size is either zero (unbounded) or within actual data size.
+    const size_t psize = 6 + size_t(GetUInt16(data + 4));
+    _is_valid = psize == 6 || (psize >= _header_size && psize <= _size);
+    return _is_valid;
+}
+
+
+//----------------------------------------------------------------------------
+// Gather a part of the binary content into a contiguous buffer.
+//----------------------------------------------------------------------------
+
+size_t ts::ScatteredPESPacket::read(size_t offset, void* buffer, size_t size) const
+{
+    uint8_t* data = reinterpret_cast<uint8_t*>(buffer);
+    size_t done = 0;
+
+    for (size_t i = 0; i < _count && done < size; ++i) {
+        const size_t seg_size = _packets[i].getPayloadSize();
+        if (offset >= seg_size) {
+            // Segment is before the requested area.
+            offset -= seg_size;
+        }
+        else {
+            const size_t len = std::min(seg_size - offset, size - done);
+            ::memcpy(data + done, _packets[i].getPayload() + offset, len);
+            done += len;
+            offset = 0;
+        }
+    }
+    return done;
+}
+
+
+//----------------------------------------------------------------------------
+// Flatten the binary content of the packet.
+//----------------------------------------------------------------------------
+
+void ts::ScatteredPESPacket::flatten(ByteBlock& data) const
+{
+    data.clear();
+    data.reserve(_size);
+    for (size_t i = 0; i < _count; ++i) {
+        data.append(_packets[i].getPayload(), _packets[i].getPayloadSize());
+    }
+}
+
+ts::PESPacketPtr ts::ScatteredPESPacket::getPESPacket() const
+{
+    if (_flat.isNull()) {
+        ByteBlockPtr data(new ByteBlock);
+        flatten(*data);
+        _flat = new PESPacket(data, _source_pid);
+        _flat->setStreamType(_stream_type);
+        _flat->setPCR(_pcr);
+        _flat->setFirstTSPacketIndex(_first_pkt);
+        _flat->setLastTSPacketIndex(_last_pkt);
+    }
+    return _flat;
+}
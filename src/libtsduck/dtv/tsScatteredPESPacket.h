@@ -0,0 +1,231 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  A PES packet which is scattered over several TS packets.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPESPacket.h"
+#include "tsTSPacket.h"
+
+namespace ts {
+    //!
+    //! A PES packet which is scattered over several TS packets.
+    //! @ingroup mpeg
+    //!
+    //! A scattered PES packet is a list of references to the payloads of the TS packets
+    //! which carry the PES packet. The payloads are not concatenated. The PES packet can
+    //! be analyzed segment by segment, small parts can be gathered using read() and the
+    //! complete PES packet is flattened into one contiguous buffer only on demand.
+    //!
+    //! The TS packets are retained in an internal pool which is reused from one PES packet
+    //! to the next one. After a few PES packets, there is no more memory allocation and
+    //! no reallocation of growing buffers, whatever the size of the PES packets.
+    //!
+    //! This class is used by PESDemux in scatter-gather mode.
+    //!
+    class TSDUCKDLL ScatteredPESPacket
+    {
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] source_pid PID from which the packet is read.
+        //!
+        explicit ScatteredPESPacket(PID source_pid = PID_NULL);
+
+        //!
+        //! Clear the packet content.
+        //! The internal pool of TS packets is kept for the next PES packet.
+        //!
+        void clear();
+
+        //!
+        //! Append the payload of a TS packet.
+        //! The complete TS packet is stored in the internal pool.
+        //! @param [in] pkt A TS packet containing the next part of the PES packet.
+        //!
+        void append(const TSPacket& pkt);
+
+        //!
+        //! Check the PES header after the last TS packet was appended.
+        //! Must be called before checking the validity of the packet.
+        //! @return True if the packet has a valid PES header.
+        //!
+        bool validate();
+
+        //!
+        //! Check if the packet has valid content.
+        //! @return True if the packet has valid content.
+        //!
+        bool isValid() const { return _is_valid; }
+
+        //!
+        //! Get the source PID.
+        //! @return The source PID.
+        //!
+        PID getSourcePID() const { return _source_pid; }
+
+        //!
+        //! Set the source PID.
+        //! @param [in] pid The source PID.
+        //!
+        void setSourcePID(PID pid) { _source_pid = pid; }
+
+        //!
+        //! Get the optional PCR value which was associated to the PES packets.
+        //! @return The 42-bit PCR or INVALID_PCR if there is none.
+        //!
+        uint64_t getPCR() const { return _pcr; }
+
+        //!
+        //! Set the PCR value for this PES packet.
+        //! @param [in] pcr The new 42-bit PCR value. Specify INVALID_PCR to clear the PCR.
+        //!
+        void setPCR(uint64_t pcr) { _pcr = pcr; }
+
+        //!
+        //! Get the stream type, as specified in the PMT (optional).
+        //! @return The stream type.
+        //!
+        uint8_t getStreamType() const { return _stream_type; }
+
+        //!
+        //! Set the stream type, as specified in the PMT.
+        //! @param [in] type The stream type.
+        //!
+        void setStreamType(uint8_t type) { _stream_type = type; }
+
+        //!
+        //! Index of first TS packet of the PES packet in the demultiplexed stream.
+        //! @return The first TS packet of the PES packet in the demultiplexed stream.
+        //!
+        PacketCounter getFirstTSPacketIndex() const { return _first_pkt; }
+
+        //!
+        //! Index of last TS packet of the PES packet in the demultiplexed stream.
+        //! @return The last TS packet of the PES packet in the demultiplexed stream.
+        //!
+        PacketCounter getLastTSPacketIndex() const { return _last_pkt; }
+
+        //!
+        //! Set the first TS packet of the PES packet in the demultiplexed stream.
+        //! @param [in] i The first TS packet of the PES packet in the demultiplexed stream.
+        //!
+        void setFirstTSPacketIndex(PacketCounter i) { _first_pkt = i; }
+
+        //!
+        //! Set the last TS packet of the PES packet in the demultiplexed stream.
+        //! @param [in] i The last TS packet of the PES packet in the demultiplexed stream.
+        //!
+        void setLastTSPacketIndex(PacketCounter i) { _last_pkt = i; }
+
+        //!
+        //! Stream id of the PES packet.
+        //! @return The stream id of the PES packet.
+        //!
+        uint8_t getStreamId() const { return _is_valid ? _stream_id : 0; }
+
+        //!
+        //! Size of the PES header.
+        //! @return The size of the PES header.
+        //!
+        size_t headerSize() const { return _is_valid ? _header_size : 0; }
+
+        //!
+        //! Size of the binary content of the packet, all segments included.
+        //! @return The size of the binary content of the packet.
+        //!
+        size_t size() const { return _size; }
+
+        //!
+        //! Size of the PES packet payload, after the PES header.
+        //! @return The size of the PES packet payload.
+        //!
+        size_t payloadSize() const { return _is_valid ? _size - _header_size : 0; }
+
+        //!
+        //! Get the number of segments, one per TS packet.
+        //! @return The number of segments.
+        //!
+        size_t segmentCount() const { return _count; }
+
+        //!
+        //! Get the address of a segment.
+        //! @param [in] index Index of the segment, from 0 to segmentCount() - 1.
+        //! @return The address of the segment data, inside the payload of a TS packet.
+        //!
+        const uint8_t* segmentData(size_t index) const { return _packets[index].getPayload(); }
+
+        //!
+        //! Get the size of a segment.
+        //! @param [in] index Index of the segment, from 0 to segmentCount() - 1.
+        //! @return The size of the segment data.
+        //!
+        size_t segmentSize(size_t index) const { return _packets[index].getPayloadSize(); }
+
+        //!
+        //! Gather a part of the binary content of the packet into a contiguous buffer.
+        //! @param [in] offset Offset in the binary content of the packet.
+        //! @param [out] buffer Address of the returned data.
+        //! @param [in] size Maximum number of bytes to read.
+        //! @return Number of bytes which were actually read.
+        //!
+        size_t read(size_t offset, void* buffer, size_t size) const;
+
+        //!
+        //! Flatten the binary content of the packet into one contiguous buffer.
+        //! @param [out] data Returned binary content of the packet.
+        //!
+        void flatten(ByteBlock& data) const;
+
+        //!
+        //! Get the PES packet as a contiguous PESPacket object.
+        //! The packet is flattened on the first call only. The returned object
+        //! is independent from the TS packets and can be kept by the application.
+        //! @return A safe pointer to the flattened PES packet. Never null.
+        //!
+        PESPacketPtr getPESPacket() const;
+
+    private:
+        bool                 _is_valid;     // Content of the PES header is valid
+        size_t               _header_size;  // PES header size in bytes
+        uint8_t              _stream_id;    // Stream id, from the PES header
+        PID                  _source_pid;   // Source PID
+        uint8_t              _stream_type;  // Stream type from PMT
+        uint64_t             _pcr;          // PCR of first TS packet
+        PacketCounter        _first_pkt;    // Index of first packet in stream
+        PacketCounter        _last_pkt;     // Index of last packet in stream
+        size_t               _size;         // Total size of all segments
+        size_t               _count;        // Number of TS packets in use in the pool
+        TSPacketVector       _packets;      // Pool of TS packets, only the first _count are used
+        mutable PESPacketPtr _flat;         // Flattened PES packet, built on demand
+    };
+}
@@ -173,6 +173,30 @@ ts::Section::Section(TID tid,
 }
 
 
+//----------------------------------------------------------------------------
+// Reload from full binary content.
+//----------------------------------------------------------------------------
+
+void ts::Section::reload(const void* content, size_t content_size, PID source_pid, CRC32::Validation crc_op)
+{
+    const uint8_t* const data = reinterpret_cast<const uint8_t*>(content);
+
+    // Reuse the previous data block if it is not shared with another section and
+    // if the new content is not taken from it. Otherwise, allocate a new one.
+    if (!_data.isNull() && _data.count() == 1 && (data == nullptr || data + content_size <= _data->data() || data >= _data->data() + _data->size())) {
+        _is_valid = false;
+        _source_pid = source_pid;
+        _first_pkt = 0;
+        _last_pkt = 0;
+        _data->copy(content, content_size);
+        validate(crc_op);
+    }
+    else {
+        initialize(new ByteBlock(content, content_size), source_pid, crc_op);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Reload short section
 //----------------------------------------------------------------------------
@@ -265,9 +289,18 @@ void ts::Section::initialize(const ByteBlockPtr& bbp, PID pid, CRC32::Validation
 {
     initialize(pid);
     _data = bbp;
+    validate(crc_op);
+}
+
 
+//----------------------------------------------------------------------------
+// Private method: Check the validity of the binary content.
+//----------------------------------------------------------------------------
+
+void ts::Section::validate(CRC32::Validation crc_op)
+{
     // Basic validity check using section size
-    const size_t total_size = SectionSize(*bbp);
+    const size_t total_size = SectionSize(*_data);
     _is_valid = total_size > 0 && total_size == _data->size();
 
     // Extract long section header info
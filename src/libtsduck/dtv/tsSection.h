@@ -153,6 +153,8 @@ namespace ts {
         //!
         //! Reload from full binary content.
         //! The content is copied into the section if valid.
+        //! If the previous binary content of the section is not shared with
+        //! any other section, its memory is reused, without reallocation.
         //! @param [in] content Address of the binary section data.
         //! @param [in] content_size Size in bytes of the section.
         //! @param [in] source_pid PID from which the section was read.
@@ -161,10 +163,7 @@ namespace ts {
         void reload(const void* content,
                     size_t content_size,
                     PID source_pid = PID_NULL,
-                    CRC32::Validation crc_op = CRC32::IGNORE)
-        {
-            initialize(new ByteBlock(content, content_size), source_pid, crc_op);
-        }
+                    CRC32::Validation crc_op = CRC32::IGNORE);
 
         //!
         //! Reload from full binary content.
@@ -678,6 +677,7 @@ namespace ts {
         // Helpers for constructors
         void initialize(PID);
         void initialize(const ByteBlockPtr&, PID, CRC32::Validation);
+        void validate(CRC32::Validation);
 
         // Inaccessible operations
         Section(const Section&) = delete;
@@ -140,7 +140,7 @@ void ts::SectionDemux::ETIDContext::init(uint8_t new_version, uint8_t last_secti
 
     // Mark all section entries as unused
     for (size_t i = 0; i < sect_expected; i++) {
-        sects[i].reset();
+        sects[i].clear();
     }
 }
 
@@ -183,6 +183,7 @@ ts::SectionDemux::PIDContext::PIDContext() :
     continuity(0),
     sync(false),
     ts(),
+    scratch(),
     tids()
 {
 }
@@ -205,8 +206,10 @@ ts::SectionDemux::SectionDemux(DuckContext& duck, TableHandlerInterface* table_h
     _section_handler(section_handler),
     _pids(),
     _status(),
+    _pool(),
     _get_current(true),
-    _get_next(false)
+    _get_next(false),
+    _transient(false)
 {
 }
 
@@ -487,15 +490,27 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
                 }
             }
 
-            // Create a new Section object if necessary (ie. if a section
-            // hendler is registered or if this is a new section).
+            // Check if this is a new section to store in the TID context.
+            const bool new_section = section_ok && tc != nullptr && tc->sects[section_number].isNull();
+
+            // Load a Section object if necessary (ie. if a section handler is registered or
+            // if this is a new section). The section comes from the pool, unless it is not
+            // stored and transient sections are allowed.
             SectionPtr sect_ptr;
+            Section* sect = nullptr;
 
-            if (section_ok && (_section_handler != nullptr || (tc != nullptr && tc->sects[section_number].isNull()))) {
-                sect_ptr = new Section(ts_start, section_length, pid, CRC32::CHECK);
-                sect_ptr->setFirstTSPacketIndex(pusi_pkt_index);
-                sect_ptr->setLastTSPacketIndex(_packet_count);
-                if (!sect_ptr->isValid()) {
+            if (section_ok && (_section_handler != nullptr || new_section)) {
+                if (new_section || !_transient) {
+                    sect_ptr = _pool.get(ts_start, section_length, pid, CRC32::CHECK);
+                    sect = sect_ptr.pointer();
+                }
+                else {
+                    pc.scratch.reload(ts_start, section_length, pid, CRC32::CHECK);
+                    sect = &pc.scratch;
+                }
+                sect->setFirstTSPacketIndex(pusi_pkt_index);
+                sect->setLastTSPacketIndex(_packet_count);
+                if (!sect->isValid()) {
                     _status.wrong_crc++;  // only possible error (hum?)
                     section_ok = false;
                 }
@@ -508,11 +523,11 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             try {
                 // If a handler is defined for sections, invoke it.
                 if (section_ok && _section_handler != nullptr) {
-                    _section_handler->handleSection(*this, *sect_ptr);
+                    _section_handler->handleSection(*this, *sect);
                 }
 
                 // Save the section in the TID context if this is a new one.
-                if (section_ok && tc != nullptr && tc->sects[section_number].isNull()) {
+                if (section_ok && new_section) {
 
                     // Save the section
                     tc->sects[section_number] = sect_ptr;
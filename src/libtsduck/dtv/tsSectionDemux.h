@@ -36,6 +36,7 @@
 #include "tsAbstractDemux.h"
 #include "tsTableHandlerInterface.h"
 #include "tsSectionHandlerInterface.h"
+#include "tsSectionPool.h"
 #include "tsETID.h"
 
 namespace ts {
@@ -135,6 +136,40 @@ namespace ts {
             _get_next = next;
         }
 
+        //!
+        //! Set the maximum number of recyclable sections in the internal section pool.
+        //! Extracted sections are allocated from a pool and recycled when the application
+        //! no longer references them. This avoids memory allocations on PID's with high
+        //! section rates. The application behavior is unchanged.
+        //! @param [in] max_size Maximum number of sections in the pool. Zero means
+        //! that all sections are dynamically allocated.
+        //! @see SectionPool
+        //!
+        void setSectionPoolSize(size_t max_size)
+        {
+            _pool.setMaxSize(max_size);
+        }
+
+        //!
+        //! Use transient sections when possible.
+        //!
+        //! When a section is not stored in a table being rebuilt (there is no table handler
+        //! or the section was already received), the section which is passed to the section
+        //! handler is a scratch section object, reused for all sections in the same PID.
+        //! This mode is useful when the section handler only inspects the section.
+        //!
+        //! With transient sections, the Section object which is passed to the section handler
+        //! is valid only during the execution of the handler. The handler shall not keep a
+        //! reference or a pointer to it. However, it can still copy it or share its content.
+        //! Transient sections are disabled by default.
+        //!
+        //! @param [in] on True to use transient sections, false to always allocate sections.
+        //!
+        void setTransientSections(bool on)
+        {
+            _transient = on;
+        }
+
         //!
         //! Demux status information.
         //! It contains error counters.
@@ -238,6 +273,7 @@ namespace ts {
             uint8_t       continuity;         // Last continuity counter
             bool          sync;               // We are synchronous in this PID
             ByteBlock     ts;                 // TS payload buffer
+            Section       scratch;            // Transient section, reused for all sections in the PID
             std::map<ETID,ETIDContext> tids;  // TID analysis contexts
 
             // Default constructor.
@@ -258,8 +294,10 @@ namespace ts {
         SectionHandlerInterface* _section_handler;
         std::map<PID,PIDContext> _pids;
         Status                   _status;
+        SectionPool              _pool;
         bool                     _get_current;
         bool                     _get_next;
+        bool                     _transient;
     };
 }
 
@@ -464,57 +464,59 @@ bool ts::SectionFile::LoadModel(xml::Document& doc)
 bool ts::SectionFile::loadXML(const UString& file_name, Report& report)
 {
     clear();
-    xml::Document doc(report);
-    doc.setTweaks(_xmlTweaks);
-    return doc.load(file_name, false) && parseDocument(doc);
+    xml::StreamReader reader(report);
+    reader.setTweaks(_xmlTweaks);
+    return reader.open(file_name) && parseDocument(reader);
 }
 
 bool ts::SectionFile::loadXML(std::istream& strm, Report& report)
 {
     clear();
-    xml::Document doc(report);
-    doc.setTweaks(_xmlTweaks);
-    return doc.load(strm) && parseDocument(doc);
+    xml::StreamReader reader(report);
+    reader.setTweaks(_xmlTweaks);
+    return reader.open(strm) && parseDocument(reader);
 }
 
 bool ts::SectionFile::parseXML(const UString& xml_content, Report& report)
 {
     clear();
-    xml::Document doc(report);
-    doc.setTweaks(_xmlTweaks);
-    return doc.parse(xml_content) && parseDocument(doc);
+    xml::StreamReader reader(report);
+    reader.setTweaks(_xmlTweaks);
+    return reader.openText(xml_content) && parseDocument(reader);
 }
 
-bool ts::SectionFile::parseDocument(const xml::Document& doc)
+bool ts::SectionFile::parseDocument(xml::StreamReader& reader)
 {
     // Load the XML model for TSDuck files. Search it in TSDuck directory.
-    xml::Document model(doc.report());
+    xml::Document model(reader.report());
     if (!LoadModel(model)) {
         return false;
     }
 
-    // Validate the input document according to the model.
-    if (!doc.validate(model)) {
+    // Validate the root element of the input document according to the model.
+    if (!reader.document().validate(model)) {
         return false;
     }
 
-    // Get the root in the document. Should be ok since we validated the document.
-    const xml::Element* root = doc.rootElement();
+    // Analyze all tables in the document, one by one. Each table is validated
+    // and released before reading the next one to limit the memory usage.
     bool success = true;
-
-    // Analyze all tables in the document.
-    for (const xml::Element* node = root == nullptr ? nullptr : root->firstChildElement(); node != nullptr; node = node->nextSiblingElement()) {
+    for (const xml::Element* node = reader.next(); node != nullptr; node = reader.next()) {
+        if (!reader.document().validate(model)) {
+            success = false;
+            continue;
+        }
         BinaryTablePtr bin(new BinaryTable);
         CheckNonNull(bin.pointer());
         if (bin->fromXML(_duck, node) && bin->isValid()) {
             add(bin);
         }
         else {
-            doc.report().error(u"Error in table <%s> at line %d", {node->name(), node->lineNumber()});
+            reader.report().error(u"Error in table <%s> at line %d", {node->name(), node->lineNumber()});
             success = false;
         }
     }
-    return success;
+    return success && !reader.error();
 }
 
 
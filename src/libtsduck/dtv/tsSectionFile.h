@@ -35,6 +35,7 @@
 #pragma once
 #include "tsxmlDocument.h"
 #include "tsxmlElement.h"
+#include "tsxmlStreamReader.h"
 #include "tsMPEG.h"
 #include "tsSection.h"
 #include "tsBinaryTable.h"
@@ -389,11 +390,11 @@ namespace ts {
         void rebuildTables();
 
         //!
-        //! Parse an XML document.
-        //! @param [in] doc Document to load.
+        //! Parse an XML document, one table at a time.
+        //! @param [in,out] reader XML reader, positioned after the start of the root element.
         //! @return True on success, false on error.
         //!
-        bool parseDocument(const xml::Document& doc);
+        bool parseDocument(xml::StreamReader& reader);
 
         //!
         //! Generate an XML document.
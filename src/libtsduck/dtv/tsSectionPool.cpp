@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsSectionPool.h"
+TSDUCK_SOURCE;
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::SectionPool::DEFAULT_MAX_SIZE;
+constexpr size_t ts::SectionPool::MAX_LOOKUP;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::SectionPool::SectionPool(size_t max_size) :
+    _max_size(max_size),
+    _next(0),
+    _recycled(0),
+    _allocated(0),
+    _sections()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Drop all sections from the pool.
+//----------------------------------------------------------------------------
+
+void ts::SectionPool::clear()
+{
+    _sections.clear();
+    _next = 0;
+    _recycled = 0;
+    _allocated = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Set the maximum number of sections in the pool.
+//----------------------------------------------------------------------------
+
+void ts::SectionPool::setMaxSize(size_t max_size)
+{
+    _max_size = max_size;
+    if (_sections.size() > _max_size) {
+        _sections.resize(_max_size);
+    }
+    if (_next >= _sections.size()) {
+        _next = 0;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get a section from the pool.
+//----------------------------------------------------------------------------
+
+ts::SectionPtr ts::SectionPool::get(const void* content, size_t content_size, PID source_pid, CRC32::Validation crc_op)
+{
+    // Look for a section which is referenced by the pool only.
+    // Sections are usually released in allocation order, start at the oldest one.
+    const size_t count = _sections.size();
+    for (size_t i = 0; i < count && i < MAX_LOOKUP; ++i) {
+        const size_t index = _next;
+        _next = (_next + 1) % count;
+        if (_sections[index].isNull()) {
+            // The section was deallocated by some holder of a shared pointer using reset()
+            // instead of clear(). Replace the entry with a new section, detached from the
+            // null pointer which may still be shared by other holders.
+            _sections[index] = allocate(content, content_size, source_pid, crc_op);
+            return _sections[index];
+        }
+        else if (_sections[index].count() == 1) {
+            // The section is no longer used outside the pool, reuse it.
+            // Section::reload() reuses the data block when not shared.
+            _recycled++;
+            _sections[index]->reload(content, content_size, source_pid, crc_op);
+            return _sections[index];
+        }
+    }
+
+    // No free section found, allocate a new one.
+    SectionPtr sect(allocate(content, content_size, source_pid, crc_op));
+
+    if (_sections.size() < _max_size) {
+        // Room left in the pool, add the new section.
+        _sections.push_back(sect);
+    }
+    else if (count > 0) {
+        // Pool full of retained sections. Replace the oldest one by the new one which
+        // is more likely to be released soon. The replaced one becomes a normal section.
+        _sections[_next] = sect;
+        _next = (_next + 1) % count;
+    }
+    return sect;
+}
+
+
+//----------------------------------------------------------------------------
+// Allocate a new section with a data block for the largest section.
+//----------------------------------------------------------------------------
+
+ts::SectionPtr ts::SectionPool::allocate(const void* content, size_t content_size, PID source_pid, CRC32::Validation crc_op)
+{
+    _allocated++;
+    ByteBlockPtr data(new ByteBlock);
+    data->reserve(MAX_PRIVATE_SECTION_SIZE);
+    data->copy(content, content_size);
+    return SectionPtr(new Section(data, source_pid, crc_op));
+}
@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  A pool of recyclable sections.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsSection.h"
+
+namespace ts {
+    //!
+    //! A pool of recyclable sections.
+    //! @ingroup mpeg
+    //!
+    //! Section demultiplexers allocate one Section object and one ByteBlock per
+    //! extracted section. On PID's carrying thousands of sections per second
+    //! (EIT schedule for instance), the memory allocator becomes a bottleneck.
+    //!
+    //! A section pool keeps references to recently allocated sections. When a
+    //! section of the pool is no longer referenced outside the pool (the application
+    //! released all safe pointers to it), the Section object and its data block,
+    //! sized for the largest private section, are reused for the next section.
+    //!
+    //! There is no explicit release operation. A section is recycled as soon as
+    //! its last external SectionPtr disappears. A section which is retained by
+    //! the application for a long time is simply dropped from the pool when its
+    //! slot is needed and becomes a normal dynamically allocated section.
+    //! A section which is deallocated by the application using SectionPtr::reset()
+    //! is also dropped from the pool and its slot is reused for a new section.
+    //!
+    //! This class is not thread-safe, like SectionPtr.
+    //!
+    class TSDUCKDLL SectionPool
+    {
+        TS_NOCOPY(SectionPool);
+    public:
+        //!
+        //! Default maximum number of sections in a pool.
+        //!
+        static constexpr size_t DEFAULT_MAX_SIZE = 64;
+
+        //!
+        //! Maximum number of pool entries which are checked when looking for a free section.
+        //!
+        static constexpr size_t MAX_LOOKUP = 8;
+
+        //!
+        //! Constructor.
+        //! @param [in] max_size Maximum number of sections in the pool.
+        //! Zero means no pooling, all sections are dynamically allocated.
+        //!
+        explicit SectionPool(size_t max_size = DEFAULT_MAX_SIZE);
+
+        //!
+        //! Get a section from the pool and load it from a full binary content.
+        //! @param [in] content Address of the binary section data.
+        //! @param [in] content_size Size in bytes of the section.
+        //! @param [in] source_pid PID from which the section was read.
+        //! @param [in] crc_op How to process the CRC32.
+        //! @return A safe pointer to the section. The returned section may be invalid
+        //! if the binary content is not a valid section. The pointer is never null.
+        //!
+        SectionPtr get(const void* content, size_t content_size, PID source_pid = PID_NULL, CRC32::Validation crc_op = CRC32::IGNORE);
+
+        //!
+        //! Set the maximum number of sections in the pool.
+        //! @param [in] max_size Maximum number of sections in the pool.
+        //! Zero means no pooling, all sections are dynamically allocated.
+        //!
+        void setMaxSize(size_t max_size);
+
+        //!
+        //! Get the maximum number of sections in the pool.
+        //! @return The maximum number of sections in the pool.
+        //!
+        size_t maxSize() const { return _max_size; }
+
+        //!
+        //! Get the current number of sections in the pool.
+        //! @return The current number of sections in the pool.
+        //!
+        size_t size() const { return _sections.size(); }
+
+        //!
+        //! Get the number of sections which were recycled from the pool.
+        //! @return The number of sections which were recycled from the pool since creation or clear().
+        //!
+        uint64_t recycledCount() const { return _recycled; }
+
+        //!
+        //! Get the number of sections which were allocated because no free section was available.
+        //! @return The number of sections which were allocated since creation or clear().
+        //!
+        uint64_t allocatedCount() const { return _allocated; }
+
+        //!
+        //! Drop all sections from the pool and reset statistics.
+        //! The sections which are still referenced outside the pool remain valid.
+        //!
+        void clear();
+
+    private:
+        size_t           _max_size;   // Maximum number of sections in the pool.
+        size_t           _next;       // Index of next entry to check.
+        uint64_t         _recycled;   // Number of recycled sections.
+        uint64_t         _allocated;  // Number of allocated sections.
+        SectionPtrVector _sections;   // The pool of sections.
+
+        // Allocate a new section.
+        SectionPtr allocate(const void* content, size_t content_size, PID source_pid, CRC32::Validation crc_op);
+    };
+}
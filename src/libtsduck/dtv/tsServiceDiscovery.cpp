@@ -110,7 +110,7 @@ void ts::ServiceDiscovery::handleTable(SectionDemux& demux, const BinaryTable& t
     switch (table.tableId()) {
         case TID_PAT: {
             if (table.sourcePID() == PID_PAT) {
-                PAT pat(_duck, table);
+                const PATView pat(table);
                 if (pat.isValid()) {
                     processPAT(pat);
                 }
@@ -119,7 +119,7 @@ void ts::ServiceDiscovery::handleTable(SectionDemux& demux, const BinaryTable& t
         }
         case TID_SDT_ACT: {
             if (table.sourcePID() == PID_SDT) {
-                SDT sdt(_duck, table);
+                const SDTView sdt(table);
                 if (sdt.isValid()) {
                     processSDT(sdt);
                 }
@@ -148,9 +148,12 @@ void ts::ServiceDiscovery::handleTable(SectionDemux& demux, const BinaryTable& t
             break;
         }
         case TID_PMT: {
-            PMT pmt(_duck, table);
-            if (pmt.isValid() && hasId(pmt.service_id)) {
-                processPMT(pmt, table.sourcePID());
+            // Deserialize only the PMT of our service.
+            if (hasId(table.tableIdExtension())) {
+                PMT pmt(_duck, table);
+                if (pmt.isValid()) {
+                    processPMT(pmt, table.sourcePID());
+                }
             }
             break;
         }
@@ -165,28 +168,21 @@ void ts::ServiceDiscovery::handleTable(SectionDemux& demux, const BinaryTable& t
 // This method processes a Service Description Table (SDT).
 //----------------------------------------------------------------------------
 
-void ts::ServiceDiscovery::processSDT(const SDT& sdt)
+void ts::ServiceDiscovery::processSDT(const SDTView& sdt)
 {
     // Look for the service by name or by service
-    uint16_t service_id = 0;
-    SDT::ServiceMap::const_iterator srv = sdt.services.end();
+    SDTView::const_iterator srv(sdt.end());
 
     if (!hasName()) {
         // Service is known by id only.
         assert(hasId());
-        service_id = getId();
-        srv = sdt.services.find(service_id);
-        if (srv == sdt.services.end()) {
+        srv = sdt.findService(getId());
+        if (srv == sdt.end()) {
             // Service not referenced in the SDT, not a problem, we already know the service id.
             return;
         }
     }
-    else if (sdt.findService(_duck, getName(), service_id)) {
-        // Service is found by name in the SDT.
-        srv = sdt.services.find(service_id);
-        assert(srv != sdt.services.end());
-    }
-    else {
+    else if ((srv = sdt.findService(_duck, getName())) == sdt.end()) {
         // Service not found by name in SDT. If we already know the service id, this is fine.
         // If we do not know the service id, then there is no way to find the service.
         if (!hasId()) {
@@ -198,6 +194,7 @@ void ts::ServiceDiscovery::processSDT(const SDT& sdt)
 
     // If the service id was previously unknown wait for the PAT.
     // If a service id was known but was different, we need to rescan the PAT.
+    const uint16_t service_id = srv->serviceId();
     if (!hasId(service_id)) {
         if (hasId()) {
             // The service was previously known but has changed its service id.
@@ -220,15 +217,15 @@ void ts::ServiceDiscovery::processSDT(const SDT& sdt)
     }
 
     // Now collect suitable information from the SDT.
-    setTSId(sdt.ts_id);
-    setONId(sdt.onetw_id);
-    setCAControlled(srv->second.CA_controlled);
-    setEITpfPresent(srv->second.EITpf_present);
-    setEITsPresent(srv->second.EITs_present);
-    setRunningStatus(srv->second.running_status);
-    setTypeDVB(srv->second.serviceType(_duck));
-    setName(srv->second.serviceName(_duck));
-    setProvider(srv->second.providerName(_duck));
+    setTSId(sdt.tsId());
+    setONId(sdt.onetwId());
+    setCAControlled(srv->CAControlled());
+    setEITpfPresent(srv->EITpfPresent());
+    setEITsPresent(srv->EITsPresent());
+    setRunningStatus(srv->runningStatus());
+    setTypeDVB(srv->serviceType());
+    setName(srv->serviceName(_duck));
+    setProvider(srv->providerName(_duck));
 }
 
 
@@ -315,14 +312,14 @@ void ts::ServiceDiscovery::analyzeVCT(const VCT& vct)
 // This method processes a Program Association Table (PAT).
 //----------------------------------------------------------------------------
 
-void ts::ServiceDiscovery::processPAT(const PAT& pat)
+void ts::ServiceDiscovery::processPAT(const PATView& pat)
 {
     // Locate the service in the PAT.
-    PAT::ServiceMap::const_iterator it = pat.pmts.end();
+    PID pmt_pid = PID_NULL;
     if (hasId()) {
         // A service id was known, locate the service in the PAT.
-        it = pat.pmts.find(getId());
-        if (it == pat.pmts.end()) {
+        pmt_pid = getId() == 0 ? PID(PID_NULL) : pat.pmtPID(getId());
+        if (pmt_pid == PID_NULL) {
             _duck.report().error(u"service id 0x%X (%d) not found in PAT", {getId(), getId()});
             _notFound = true;
             return;
@@ -330,27 +327,28 @@ void ts::ServiceDiscovery::processPAT(const PAT& pat)
     }
     else {
         // If no service was specified, use the first service from the PAT.
-        if (pat.pmts.empty()) {
+        const uint16_t service_id = pat.firstServiceId();
+        if (service_id == 0) {
             _duck.report().error(u"no service found in PAT");
             _notFound = true;
             return;
         }
-        it = pat.pmts.begin();
+        pmt_pid = pat.pmtPID(service_id);
         // Now, we have a service id.
-        setId(it->first);
+        setId(service_id);
         // Intercept the SDT for more details.
         _demux.addPID(PID_SDT);
     }
 
     // If the PMT PID was previously unknown wait for the PMT.
     // If the PMT PID was known but was different, we need to rescan the PMT.
-    if (!hasPMTPID(it->second)) {
+    if (!hasPMTPID(pmt_pid)) {
         // Store new PMT PID.
-        setPMTPID(it->second);
+        setPMTPID(pmt_pid);
 
         // (Re)scan the PMT.
-        _demux.resetPID(it->second);
-        _demux.addPID(it->second);
+        _demux.resetPID(pmt_pid);
+        _demux.addPID(pmt_pid);
 
         // Invalidate out PMT.
         _pmt.invalidate();
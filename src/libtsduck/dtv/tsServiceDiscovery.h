@@ -37,8 +37,9 @@
 #include "tsSectionDemux.h"
 #include "tsNullReport.h"
 #include "tsSignalizationHandlerInterface.h"
-#include "tsPAT.h"
-#include "tsSDT.h"
+#include "tsPATView.h"
+#include "tsSDTView.h"
+#include "tsPMT.h"
 #include "tsMGT.h"
 #include "tsTVCT.h"
 #include "tsCVCT.h"
@@ -118,9 +119,9 @@ namespace ts {
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
 
         // Process specific tables
-        void processPAT(const PAT&);
+        void processPAT(const PATView&);
         void processPMT(const PMT&, PID pid);
-        void processSDT(const SDT&);
+        void processSDT(const SDTView&);
         void analyzeMGT(const MGT&);
         void analyzeVCT(const VCT&);
     };
@@ -29,6 +29,7 @@
 
 #include "tsSignalizationDemux.h"
 #include "tsBinaryTable.h"
+#include "tsTableCache.h"
 TSDUCK_SOURCE;
 
 
@@ -43,9 +44,13 @@ ts::SignalizationDemux::SignalizationDemux(DuckContext& duck, SignalizationHandl
     _tids(),
     _service_ids(),
     _last_pat(),
-    _last_pat_handled(false)
+    _last_pat_holder(),
+    _last_pat_obj(nullptr),
+    _last_pat_decoded(false),
+    _last_pat_handled(false),
+    _no_pat()
 {
-    _last_pat.invalidate();
+    _no_pat.invalidate();
     for (auto it = tids.begin(); it != tids.end(); ++it) {
         addTableId(*it);
     }
@@ -58,7 +63,22 @@ ts::SignalizationDemux::SignalizationDemux(DuckContext& duck, SignalizationHandl
 
 ts::PID ts::SignalizationDemux::nitPID() const
 {
-    return _last_pat.isValid() && _last_pat.nit_pid != PID_NULL ? _last_pat.nit_pid : PID(PID_NIT);
+    const PID pid = PATView(_last_pat).nitPID();
+    return pid != PID_NULL ? pid : PID(PID_NIT);
+}
+
+
+//----------------------------------------------------------------------------
+// Return a constant reference to the last PAT, deserialized on demand.
+//----------------------------------------------------------------------------
+
+const ts::PAT& ts::SignalizationDemux::lastPAT() const
+{
+    if (!_last_pat_decoded) {
+        _last_pat_decoded = true;
+        _last_pat_obj = _last_pat.isValid() ? TableCache::Instance()->getTable<PAT>(_duck, _last_pat, _last_pat_holder) : nullptr;
+    }
+    return _last_pat_obj != nullptr ? *_last_pat_obj : _no_pat;
 }
 
 
@@ -72,7 +92,10 @@ void ts::SignalizationDemux::reset()
     _demux.setPIDFilter(NoPID);
     _tids.clear();
     _service_ids.clear();
-    _last_pat.invalidate();
+    _last_pat.clear();
+    _last_pat_holder.clear();
+    _last_pat_obj = nullptr;
+    _last_pat_decoded = false;
     _last_pat_handled = false;
 }
 
@@ -95,7 +118,7 @@ bool ts::SignalizationDemux::addTableId(TID tid)
             // The current PAT may have already been received without notification to the application.
             if (_last_pat.isValid() && _handler != nullptr && !_last_pat_handled) {
                 _last_pat_handled = true;
-                _handler->handlePAT(_last_pat, PID_PAT);
+                _handler->handlePAT(lastPAT(), PID_PAT);
             }
             break;
         }
@@ -107,9 +130,10 @@ bool ts::SignalizationDemux::addTableId(TID tid)
             // We need the PAT to get PMT PID's.
             _demux.addPID(PID_PAT);
             // If a PAT is known, add all PMT PID's.
-            if (_last_pat.isValid()) {
-                for (auto it = _last_pat.pmts.begin(); it != _last_pat.pmts.end(); ++it) {
-                    _demux.addPID(it->second);
+            const PATView pat(_last_pat);
+            for (auto it = pat.begin(); it != pat.end(); ++it) {
+                if (it->programNumber() != 0) {
+                    _demux.addPID(it->pid());
                 }
             }
             break;
@@ -192,11 +216,10 @@ bool ts::SignalizationDemux::removeTableId(TID tid)
         }
         case TID_PMT: {
             // If a PAT is known, remove all PMT PID's which are not specifically monitored by service id.
-            if (_last_pat.isValid()) {
-                for (auto it = _last_pat.pmts.begin(); it != _last_pat.pmts.end(); ++it) {
-                    if (!hasServiceId(it->first)) {
-                        _demux.removePID(it->second);
-                    }
+            const PATView pat(_last_pat);
+            for (auto it = pat.begin(); it != pat.end(); ++it) {
+                if (it->programNumber() != 0 && !hasServiceId(it->programNumber())) {
+                    _demux.removePID(it->pid());
                 }
             }
             break;
@@ -272,11 +295,9 @@ void ts::SignalizationDemux::addServiceId(uint16_t sid)
         _demux.addPID(PID_PAT);
 
         // If a PAT is known and references the service, add its PMT PID.
-        if (_last_pat.isValid()) {
-            const auto it(_last_pat.pmts.find(sid));
-            if (it != _last_pat.pmts.end()) {
-                _demux.addPID(it->second);
-            }
+        const PID pid = sid == 0 ? PID(PID_NULL) : PATView(_last_pat).pmtPID(sid);
+        if (pid != PID_NULL) {
+            _demux.addPID(pid);
         }
     }
 }
@@ -296,10 +317,10 @@ void ts::SignalizationDemux::removeServiceId(uint16_t sid)
 
         // If a PAT is known and references the service, remove its PMT PID.
         // If all PMT's are still monitored, don't change anything.
-        if (_last_pat.isValid() && !hasTableId(TID_PMT)) {
-            const auto it(_last_pat.pmts.find(sid));
-            if (it != _last_pat.pmts.end()) {
-                _demux.removePID(it->second);
+        if (!hasTableId(TID_PMT)) {
+            const PID pid = sid == 0 ? PID(PID_NULL) : PATView(_last_pat).pmtPID(sid);
+            if (pid != PID_NULL) {
+                _demux.removePID(pid);
             }
         }
     }
@@ -314,9 +335,12 @@ void ts::SignalizationDemux::removeAllServiceIds()
 {
     // If a PAT is known, remove all PMT PID's.
     // If all PMT's are still monitored, don't change anything.
-    if (_last_pat.isValid() && !hasTableId(TID_PMT)) {
-        for (auto it = _last_pat.pmts.begin(); it != _last_pat.pmts.end(); ++it) {
-            _demux.removePID(it->second);
+    if (!hasTableId(TID_PMT)) {
+        const PATView pat(_last_pat);
+        for (auto it = pat.begin(); it != pat.end(); ++it) {
+            if (it->programNumber() != 0) {
+                _demux.removePID(it->pid());
+            }
         }
     }
 
@@ -335,33 +359,35 @@ void ts::SignalizationDemux::handleTable(SectionDemux&, const BinaryTable& table
     const TID tid = table.tableId();
 
     // The PAT needs to be monitored outside explicit filtering.
+    // The PAT is only viewed here, it is deserialized when the application needs it.
     if (tid == TID_PAT && pid == PID_PAT) {
-        const PAT pat(_duck, table);
+        const PATView pat(table);
         if (pat.isValid()) {
 
             // Check if all PMT's are monitored.
             const bool all_pmts = hasTableId(TID_PMT);
 
             // If a previous PAT was there, remove unused PMT PID's.
-            if (_last_pat.isValid() && (all_pmts || !_service_ids.empty())) {
+            if (all_pmts || !_service_ids.empty()) {
                 // Loop on all previous services
-                for (auto it1 = _last_pat.pmts.begin(); it1 != _last_pat.pmts.end(); ++it1) {
+                const PATView last_pat(_last_pat);
+                for (auto it = last_pat.begin(); it != last_pat.end(); ++it) {
                     // If the service no longer exists or has changed its PMT PID, remove the previous PMT PID.
-                    const auto it2(pat.pmts.find(it1->first));
-                    if (it2 == pat.pmts.end() || it2->second != it1->second) {
-                        _demux.removePID(it1->second);
+                    if (it->programNumber() != 0 && pat.pmtPID(it->programNumber()) != it->pid()) {
+                        _demux.removePID(it->pid());
                     }
                 }
             }
 
-            // Remember the last PAT.
-            _last_pat = pat;
+            // Remember the last PAT. The sections are shared, not copied.
+            _last_pat = table;
+            _last_pat_decoded = false;
             _last_pat_handled = false;
 
             // Then, monitor new PMT PID's. Some of them may be already monitored.
-            for (auto it = pat.pmts.begin(); it != pat.pmts.end(); ++it) {
-                if (all_pmts || hasServiceId(it->first)) {
-                    _demux.addPID(it->second);
+            for (auto it = pat.begin(); it != pat.end(); ++it) {
+                if (it->programNumber() != 0 && (all_pmts || hasServiceId(it->programNumber()))) {
+                    _demux.addPID(it->pid());
                 }
             }
 
@@ -373,7 +399,7 @@ void ts::SignalizationDemux::handleTable(SectionDemux&, const BinaryTable& table
             // Notify the PAT to the application.
             if (_handler != nullptr && hasTableId(TID_PAT)) {
                 _last_pat_handled = true;
-                _handler->handlePAT(pat, pid);
+                _handler->handlePAT(lastPAT(), pid);
             }
         }
     }
@@ -381,101 +407,129 @@ void ts::SignalizationDemux::handleTable(SectionDemux&, const BinaryTable& table
     // Other tables have no special treatment. They are directly passed to the application.
     // PMT may be selectively filtered by service id (table id extention).
     else if (_handler != nullptr && (hasTableId(tid) || (tid == TID_PMT && hasServiceId(table.tableIdExtension())))) {
+        // Deserialized tables are shared through the table cache. A table which is
+        // notified again (after a reset for instance) is not deserialized again.
+        TableCache* const cache = TableCache::Instance();
+        TableCache::TablePtr holder;
         switch (tid) {
             case TID_CAT: {
-                const CAT cat(_duck, table);
-                if (cat.isValid() && pid == PID_CAT) {
-                    _handler->handleCAT(cat, pid);
+                if (pid == PID_CAT) {
+                    const CAT* cat = cache->getTable<CAT>(_duck, table, holder);
+                    if (cat != nullptr) {
+                        _handler->handleCAT(*cat, pid);
+                    }
                 }
                 break;
             }
             case TID_PMT: {
-                const PMT pmt(_duck, table);
-                if (pmt.isValid()) {
-                    _handler->handlePMT(pmt, pid);
+                const PMT* pmt = cache->getTable<PMT>(_duck, table, holder);
+                if (pmt != nullptr) {
+                    _handler->handlePMT(*pmt, pid);
                 }
                 break;
             }
             case TID_TSDT: {
-                const TSDT tsdt(_duck, table);
-                if (tsdt.isValid() && pid == PID_TSDT) {
-                    _handler->handleTSDT(tsdt, pid);
+                if (pid == PID_TSDT) {
+                    const TSDT* tsdt = cache->getTable<TSDT>(_duck, table, holder);
+                    if (tsdt != nullptr) {
+                        _handler->handleTSDT(*tsdt, pid);
+                    }
                 }
                 break;
             }
             case TID_NIT_ACT:
             case TID_NIT_OTH:  {
-                const NIT nit(_duck, table);
-                if (nit.isValid() && pid == nitPID()) {
-                    _handler->handleNIT(nit, pid);
+                if (pid == nitPID()) {
+                    const NIT* nit = cache->getTable<NIT>(_duck, table, holder);
+                    if (nit != nullptr) {
+                        _handler->handleNIT(*nit, pid);
+                    }
                 }
                 break;
             }
             case TID_SDT_ACT:
             case TID_SDT_OTH:  {
-                const SDT sdt(_duck, table);
-                if (sdt.isValid() && pid == PID_SDT) {
-                    _handler->handleSDT(sdt, pid);
+                if (pid == PID_SDT) {
+                    const SDT* sdt = cache->getTable<SDT>(_duck, table, holder);
+                    if (sdt != nullptr) {
+                        _handler->handleSDT(*sdt, pid);
+                    }
                 }
                 break;
             }
             case TID_BAT: {
-                const BAT bat(_duck, table);
-                if (bat.isValid() && pid == PID_BAT) {
-                    _handler->handleBAT(bat, pid);
+                if (pid == PID_BAT) {
+                    const BAT* bat = cache->getTable<BAT>(_duck, table, holder);
+                    if (bat != nullptr) {
+                        _handler->handleBAT(*bat, pid);
+                    }
                 }
                 break;
             }
             case TID_RST: {
-                const RST rst(_duck, table);
-                if (rst.isValid() && pid == PID_RST) {
-                    _handler->handleRST(rst, pid);
+                if (pid == PID_RST) {
+                    const RST* rst = cache->getTable<RST>(_duck, table, holder);
+                    if (rst != nullptr) {
+                        _handler->handleRST(*rst, pid);
+                    }
                 }
                 break;
             }
             case TID_TDT: {
-                const TDT tdt(_duck, table);
-                if (tdt.isValid() && pid == PID_TDT) {
-                    _handler->handleTDT(tdt, pid);
+                if (pid == PID_TDT) {
+                    const TDT* tdt = cache->getTable<TDT>(_duck, table, holder);
+                    if (tdt != nullptr) {
+                        _handler->handleTDT(*tdt, pid);
+                    }
                 }
                 break;
             }
             case TID_TOT: {
-                const TOT tot(_duck, table);
-                if (tot.isValid() && pid == PID_TOT) {
-                    _handler->handleTOT(tot, pid);
+                if (pid == PID_TOT) {
+                    const TOT* tot = cache->getTable<TOT>(_duck, table, holder);
+                    if (tot != nullptr) {
+                        _handler->handleTOT(*tot, pid);
+                    }
                 }
                 break;
             }
             case TID_MGT: {
-                const MGT mgt(_duck, table);
-                if (mgt.isValid() && pid == PID_PSIP) {
-                    _handler->handleMGT(mgt, pid);
+                if (pid == PID_PSIP) {
+                    const MGT* mgt = cache->getTable<MGT>(_duck, table, holder);
+                    if (mgt != nullptr) {
+                        _handler->handleMGT(*mgt, pid);
+                    }
                 }
                 break;
             }
             case TID_CVCT: {
-                const CVCT vct(_duck, table);
-                if (vct.isValid() && pid == PID_PSIP) {
-                    // Call specific and generic form of VCT handler.
-                    _handler->handleCVCT(vct, pid);
-                    _handler->handleVCT(vct, pid);
+                if (pid == PID_PSIP) {
+                    const CVCT* vct = cache->getTable<CVCT>(_duck, table, holder);
+                    if (vct != nullptr) {
+                        // Call specific and generic form of VCT handler.
+                        _handler->handleCVCT(*vct, pid);
+                        _handler->handleVCT(*vct, pid);
+                    }
                 }
                 break;
             }
             case TID_TVCT: {
-                const TVCT vct(_duck, table);
-                if (vct.isValid() && pid == PID_PSIP) {
-                    // Call specific and generic form of VCT handler.
-                    _handler->handleTVCT(vct, pid);
-                    _handler->handleVCT(vct, pid);
+                if (pid == PID_PSIP) {
+                    const TVCT* vct = cache->getTable<TVCT>(_duck, table, holder);
+                    if (vct != nullptr) {
+                        // Call specific and generic form of VCT handler.
+                        _handler->handleTVCT(*vct, pid);
+                        _handler->handleVCT(*vct, pid);
+                    }
                 }
                 break;
             }
             case TID_RRT: {
-                const RRT rrt(_duck, table);
-                if (rrt.isValid() && pid == PID_PSIP) {
-                    _handler->handleRRT(rrt, pid);
+                if (pid == PID_PSIP) {
+                    const RRT* rrt = cache->getTable<RRT>(_duck, table, holder);
+                    if (rrt != nullptr) {
+                        _handler->handleRRT(*rrt, pid);
+                    }
                 }
                 break;
             }
@@ -35,6 +35,8 @@
 #pragma once
 #include "tsSignalizationHandlerInterface.h"
 #include "tsSectionDemux.h"
+#include "tsPATView.h"
+#include "tsTableCache.h"
 
 namespace ts {
     //!
@@ -133,9 +135,11 @@ namespace ts {
 
         //!
         //! Return a constant reference to the last PAT which has been received.
+        //! The PAT is internally kept in binary form and deserialized on first access.
+        //! The deserialized PAT is shared through the TableCache.
         //! @return A constant reference to the last PAT.
         //!
-        const PAT& lastPAT() const { return _last_pat; }
+        const PAT& lastPAT() const;
 
     private:
         DuckContext&                   _duck;
@@ -143,8 +147,12 @@ namespace ts {
         SignalizationHandlerInterface* _handler;
         std::set<TID>                  _tids;             // Set of filtered table id's.
         std::set<uint16_t>             _service_ids;      // Set of filtered service id's.
-        PAT                            _last_pat;         // Last received PAT.
+        BinaryTable                    _last_pat;         // Last received PAT, binary form.
+        mutable TableCache::TablePtr   _last_pat_holder;  // Keep the deserialized last PAT alive.
+        mutable const PAT*             _last_pat_obj;     // Last received PAT, deserialized on demand, null if invalid.
+        mutable bool                   _last_pat_decoded; // _last_pat_obj is up to date with _last_pat.
         bool                           _last_pat_handled; // Last received PAT was handled by application.
+        PAT                            _no_pat;           // Invalid PAT, returned when there is no valid last PAT.
 
         // Get the NIT PID, either from last PAT or default PID.
         PID nitPID() const;
@@ -33,12 +33,257 @@
 #include "tsDuckContext.h"
 #include "tsNames.h"
 #include "tsAlgorithm.h"
+#include "tsThread.h"
+#include "tsLockFreeMessageQueue.h"
+#include "tsGuardCondition.h"
 TSDUCK_SOURCE;
 
 // Constant string "Unreferenced"
 const ts::UString ts::TSAnalyzer::UNREFERENCED(u"Unreferenced");
 
 
+//----------------------------------------------------------------------------
+// In parallel mode, a worker thread which analyzes a subset of the PID's.
+// A PID is owned by one single worker thread which computes its packet
+// statistics and its audio/video attributes. The PAT and PMT's are also sent
+// to all worker threads since the PES demux needs the stream types.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Number of TS packets which are sent at once to a worker thread.
+    constexpr size_t SHARD_BATCH_SIZE = 512;
+    // Maximum number of batches in the queue of a worker thread.
+    constexpr size_t SHARD_MAX_BATCHES = 32;
+
+    // The report of the analyzer is not thread-safe. The messages which are logged
+    // in a worker thread are collected and later logged from the analyzer thread.
+    class ShardReport : public ts::Report
+    {
+        TS_NOBUILD_NOCOPY(ShardReport);
+    public:
+        explicit ShardReport(ts::Report& report) : ts::Report(report.maxSeverity()), _report(report), _mutex(), _messages() {}
+
+        // Log the collected messages in the analyzer report. Invoked in the analyzer thread.
+        void flush()
+        {
+            std::list<std::pair<int, ts::UString>> messages;
+            {
+                ts::Guard lock(_mutex);
+                messages.swap(_messages);
+            }
+            for (auto it = messages.begin(); it != messages.end(); ++it) {
+                _report.log(it->first, it->second);
+            }
+        }
+
+    protected:
+        virtual void writeLog(int severity, const ts::UString& msg) override
+        {
+            ts::Guard lock(_mutex);
+            _messages.push_back(std::make_pair(severity, msg));
+        }
+
+    private:
+        ts::Report& _report;
+        ts::Mutex   _mutex;
+        std::list<std::pair<int, ts::UString>> _messages;
+    };
+}
+
+class ts::TSAnalyzer::PIDShard : public Thread, private PESHandlerInterface
+{
+    TS_NOBUILD_NOCOPY(PIDShard);
+public:
+    // Constructor and destructor.
+    PIDShard(Report& report, size_t index, size_t count);
+    virtual ~PIDShard() override;
+
+    // The following methods are invoked in the analyzer thread.
+    void feedPacket(const TSPacket& pkt, uint64_t packet_index, bool owner);
+    void synchronize();
+    void reset();
+    void setPID(const PIDContext& pc);
+
+    // PID contexts of this worker thread. Must be accessed after synchronize() only.
+    PIDContextMap pids;
+
+private:
+    // A TS packet with its index in the stream.
+    struct Packet
+    {
+        TSPacket pkt;
+        uint64_t index;
+        bool     owner;
+    };
+    typedef std::vector<Packet> Batch;
+    typedef LockFreeMessageQueue<Batch> BatchQueue;
+
+    ShardReport            _report;     // Messages from this thread, logged in the analyzer thread.
+    DuckContext            _duck;       // Private context, DuckContext is not thread-safe.
+    const size_t           _index;      // Index of this worker thread.
+    const size_t           _count;      // Total number of worker threads.
+    BatchQueue             _queue;      // Batches of packets to analyze.
+    BatchQueue::MessagePtr _batch;      // Batch which is currently filled in the analyzer thread.
+    Mutex                  _mutex;      // Protect the counters of batches.
+    Condition              _completed;  // Signaled when a batch is completed.
+    uint64_t               _submitted;  // Number of submitted batches.
+    uint64_t               _processed;  // Number of processed batches.
+    uint64_t               _current;    // Index of packet being processed.
+    PESDemux               _pes_demux;  // Audio/video analysis.
+
+    // Get the context of a PID owned by this thread.
+    PIDContextPtr getPID(PID pid);
+
+    // Send the current batch to the worker thread.
+    void flush();
+
+    // Add an audio or video attribute on a PID from this thread.
+    void addAttribute(PID pid, const UString& attr);
+
+    // Implementation of Thread.
+    virtual void main() override;
+
+    // Implementation of PESHandlerInterface
+    virtual void handleNewAudioAttributes(PESDemux&, const PESPacket&, const AudioAttributes&) override;
+    virtual void handleNewVideoAttributes(PESDemux&, const PESPacket&, const VideoAttributes&) override;
+    virtual void handleNewAVCAttributes(PESDemux&, const PESPacket&, const AVCAttributes&) override;
+    virtual void handleNewAC3Attributes(PESDemux&, const PESPacket&, const AC3Attributes&) override;
+};
+
+ts::TSAnalyzer::PIDShard::PIDShard(Report& report, size_t index, size_t count) :
+    Thread(),
+    pids(),
+    _report(report),
+    _duck(&_report),
+    _index(index),
+    _count(count),
+    _queue(SHARD_MAX_BATCHES),
+    _batch(),
+    _mutex(),
+    _completed(),
+    _submitted(0),
+    _processed(0),
+    _current(0),
+    _pes_demux(_duck, this)
+{
+}
+
+ts::TSAnalyzer::PIDShard::~PIDShard()
+{
+    // A null batch terminates the thread.
+    flush();
+    _queue.forceEnqueue(static_cast<Batch*>(nullptr));
+    waitForTermination();
+    _report.flush();
+}
+
+void ts::TSAnalyzer::PIDShard::feedPacket(const TSPacket& pkt, uint64_t packet_index, bool owner)
+{
+    if (_batch.isNull()) {
+        _batch = new Batch;
+        _batch->reserve(SHARD_BATCH_SIZE);
+    }
+    _batch->push_back({pkt, packet_index, owner});
+    if (_batch->size() >= SHARD_BATCH_SIZE) {
+        flush();
+    }
+}
+
+void ts::TSAnalyzer::PIDShard::flush()
+{
+    if (!_batch.isNull()) {
+        {
+            Guard lock(_mutex);
+            _submitted++;
+        }
+        // The batch pointer is released and becomes null.
+        _queue.enqueue(_batch);
+    }
+}
+
+void ts::TSAnalyzer::PIDShard::synchronize()
+{
+    flush();
+    {
+        GuardCondition lock(_mutex, _completed);
+        while (_processed < _submitted) {
+            lock.waitCondition();
+        }
+    }
+    _report.flush();
+}
+
+void ts::TSAnalyzer::PIDShard::reset()
+{
+    synchronize();
+    pids.clear();
+    _pes_demux.reset();
+}
+
+void ts::TSAnalyzer::PIDShard::setPID(const PIDContext& pc)
+{
+    getPID(pc.pid)->merge(pc);
+}
+
+ts::TSAnalyzer::PIDContextPtr ts::TSAnalyzer::PIDShard::getPID(PID pid)
+{
+    PIDContextPtr& pc(pids[pid]);
+    if (pc.isNull()) {
+        pc = new PIDContext(pid);
+    }
+    return pc;
+}
+
+void ts::TSAnalyzer::PIDShard::main()
+{
+    for (;;) {
+        BatchQueue::MessagePtr batch;
+        _queue.dequeue(batch);
+        if (batch.isNull()) {
+            break;
+        }
+        for (auto it = batch->begin(); it != batch->end(); ++it) {
+            _current = it->index;
+            _pes_demux.feedPacket(it->pkt);
+            if (it->owner) {
+                getPID(it->pkt.getPID())->analyzePacket(it->pkt, it->index);
+            }
+        }
+        GuardCondition lock(_mutex, _completed);
+        _processed++;
+        lock.signal();
+    }
+}
+
+void ts::TSAnalyzer::PIDShard::addAttribute(PID pid, const UString& attr)
+{
+    // The PAT and PMT's are demuxed in all threads, keep attributes from our PID's only.
+    if (pid % _count == _index) {
+        getPID(pid)->addAttribute(attr, _current);
+    }
+}
+
+void ts::TSAnalyzer::PIDShard::handleNewAudioAttributes(PESDemux&, const PESPacket& pkt, const AudioAttributes& attr)
+{
+    addAttribute(pkt.getSourcePID(), attr.toString());
+}
+
+void ts::TSAnalyzer::PIDShard::handleNewAC3Attributes(PESDemux&, const PESPacket& pkt, const AC3Attributes& attr)
+{
+    addAttribute(pkt.getSourcePID(), attr.toString());
+}
+
+void ts::TSAnalyzer::PIDShard::handleNewVideoAttributes(PESDemux&, const PESPacket& pkt, const VideoAttributes& attr)
+{
+    addAttribute(pkt.getSourcePID(), attr.toString());
+}
+
+void ts::TSAnalyzer::PIDShard::handleNewAVCAttributes(PESDemux&, const PESPacket& pkt, const AVCAttributes& attr)
+{
+    addAttribute(pkt.getSourcePID(), attr.toString());
+}
+
+
 //----------------------------------------------------------------------------
 // Constructor for the TS analyzer
 //----------------------------------------------------------------------------
@@ -83,20 +328,30 @@ ts::TSAnalyzer::TSAnalyzer(DuckContext& duck, BitRate bitrate_hint) :
     _last_stt(Time::Epoch),
     _country_code(),
     _scrambled_services_cnt(0),
+    _ts_changes(CHANGED_NEW),
     _tid_present(),
     _pids(),
     _services(),
     _modified(false),
+    _track_changes(false),
     _ts_bitrate_sum(0),
     _ts_bitrate_cnt(0),
     _preceding_errors(0),
     _preceding_suspects(0),
     _min_error_before_suspect(1),
     _max_consecutive_suspects(1),
+    _prev_ts_bitrate(0),
+    _prev_pid_cnt(0),
+    _prev_services_cnt(0),
+    _prev_scrambled_services(0),
+    _prev_errors(0),
     _demux(_duck, this, this),
     _pes_demux(_duck, this),
-    _t2mi_demux(_duck, this)
+    _t2mi_demux(_duck, this),
+    _shards(),
+    _shared_pids()
 {
+    _shared_pids.set(PID_PAT);
     resetSectionDemux();
 }
 
@@ -156,6 +411,7 @@ void ts::TSAnalyzer::reset()
     _last_stt = Time::Epoch;
     _country_code.clear();
     _scrambled_services_cnt = 0;
+    _ts_changes = CHANGED_NEW;
     _tid_present.reset();
     _pids.clear();
     _services.clear();
@@ -163,7 +419,18 @@ void ts::TSAnalyzer::reset()
     _ts_bitrate_cnt = 0;
     _preceding_errors = 0;
     _preceding_suspects = 0;
+    _prev_ts_bitrate = 0;
+    _prev_pid_cnt = 0;
+    _prev_services_cnt = 0;
+    _prev_scrambled_services = 0;
+    _prev_errors = 0;
     _pes_demux.reset();
+    _shared_pids.reset();
+    _shared_pids.set(PID_PAT);
+
+    for (size_t i = 0; i < _shards.size(); ++i) {
+        _shards[i]->reset();
+    }
 
     resetSectionDemux();
 }
@@ -281,7 +548,14 @@ ts::TSAnalyzer::PIDContext::PIDContext(PID pid_, const UString& description_) :
     last_pcr(0),
     last_pcr_pkt(0),
     ts_bitrate_sum(0),
-    ts_bitrate_cnt(0)
+    ts_bitrate_cnt(0),
+    changes(CHANGED_NEW),
+    _attributes_index(),
+    _prev_description(),
+    _prev_bitrate(0),
+    _prev_scrambled(false),
+    _prev_errors(0),
+    _prev_services()
 {
     // Guess the initial description, based on the PID
     // Global PID's (PAT, CAT, etc) are marked as "referenced" since they
@@ -313,11 +587,26 @@ ts::TSAnalyzer::ETIDContext::ETIDContext(const ETID& etid_) :
     last_version(0),
     versions(),
     first_pkt(0),
-    last_pkt(0)
+    last_pkt(0),
+    changes(CHANGED_NEW),
+    _prev_version(-1)
 {
 }
 
 
+//----------------------------------------------------------------------------
+// Accumulate the changed fields of the ETID context.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::ETIDContext::updateChanges()
+{
+    if (versions.any() && int(last_version) != _prev_version) {
+        _prev_version = last_version;
+        changes |= CHANGED_VERSION;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Constructor for the Service context
 //----------------------------------------------------------------------------
@@ -335,7 +624,13 @@ ts::TSAnalyzer::ServiceContext::ServiceContext(uint16_t serv_id) :
     ts_pkt_cnt(0),
     bitrate(0),
     carry_ssu(false),
-    carry_t2mi(false)
+    carry_t2mi(false),
+    changes(CHANGED_NEW),
+    _prev_name(),
+    _prev_provider(),
+    _prev_bitrate(0),
+    _prev_pid_cnt(0),
+    _prev_scrambled(false)
 {
 }
 
@@ -372,6 +667,32 @@ ts::UString ts::TSAnalyzer::ServiceContext::getName() const
 }
 
 
+//----------------------------------------------------------------------------
+// Accumulate the changed fields of the service context.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::ServiceContext::updateChanges()
+{
+    if (name != _prev_name || provider != _prev_provider) {
+        _prev_name = name;
+        _prev_provider = provider;
+        changes |= CHANGED_DESCRIPTION;
+    }
+    if (bitrate != _prev_bitrate) {
+        _prev_bitrate = bitrate;
+        changes |= CHANGED_BITRATE;
+    }
+    if (pid_cnt != _prev_pid_cnt) {
+        _prev_pid_cnt = pid_cnt;
+        changes |= CHANGED_COMPONENTS;
+    }
+    if ((scrambled_pid_cnt > 0) != _prev_scrambled) {
+        _prev_scrambled = scrambled_pid_cnt > 0;
+        changes |= CHANGED_SCRAMBLING;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Return an ETID context. Allocate a new entry if ETID not found.
 //----------------------------------------------------------------------------
@@ -617,6 +938,8 @@ void ts::TSAnalyzer::analyzePAT(const PAT& pat)
         ps->carry_section = true;
         // Add a filter on the referenced PID to get the PMT
         _demux.addPID(pmt_pid);
+        // In parallel mode, all worker threads need the PMT's for their PES analysis.
+        _shared_pids.set(pmt_pid);
         // Describe the service
         ServiceContextPtr svp(getService(service_id));
         svp->pmt_pid = pmt_pid;
@@ -766,7 +1089,7 @@ void ts::TSAnalyzer::analyzeMGT(const MGT& mgt)
 
         // An ATSC PID may carry more than one table type.
         if (ps->description != name) {
-            AppendUnique(ps->attributes, name);
+            ps->addAttribute(name, _ts_pkt_cnt);
         }
 
         // Some additional PSIP PID's shall be analyzed.
@@ -854,6 +1177,106 @@ ts::UString ts::TSAnalyzer::PIDContext::fullDescription(bool include_attributes)
 }
 
 
+//----------------------------------------------------------------------------
+// Add an audio or video attribute, if not already present.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::PIDContext::addAttribute(const UString& attr, uint64_t packet_index)
+{
+    if (std::find(attributes.begin(), attributes.end(), attr) == attributes.end()) {
+        attributes.push_back(attr);
+        _attributes_index.push_back(packet_index);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Merge the analysis of the same PID from another context.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::PIDContext::merge(const PIDContext& other)
+{
+    // Packet statistics are entirely computed in the other context.
+    scrambled = other.scrambled;
+    same_stream_id = other.same_stream_id;
+    pes_stream_id = other.pes_stream_id;
+    ts_pkt_cnt = other.ts_pkt_cnt;
+    ts_af_cnt = other.ts_af_cnt;
+    unit_start_cnt = other.unit_start_cnt;
+    pl_start_cnt = other.pl_start_cnt;
+    unexp_discont = other.unexp_discont;
+    exp_discont = other.exp_discont;
+    duplicated = other.duplicated;
+    ts_sc_cnt = other.ts_sc_cnt;
+    inv_ts_sc_cnt = other.inv_ts_sc_cnt;
+    inv_pes_start = other.inv_pes_start;
+    pcr_cnt = other.pcr_cnt;
+    cur_continuity = other.cur_continuity;
+    cur_ts_sc = other.cur_ts_sc;
+    cur_ts_sc_pkt = other.cur_ts_sc_pkt;
+    cryptop_cnt = other.cryptop_cnt;
+    cryptop_ts_cnt = other.cryptop_ts_cnt;
+    last_pcr = other.last_pcr;
+    last_pcr_pkt = other.last_pcr_pkt;
+    ts_bitrate_sum = other.ts_bitrate_sum;
+    ts_bitrate_cnt = other.ts_bitrate_cnt;
+
+    // Both lists of attributes are sorted by packet index. Merge them in the order of
+    // first appearance. On the same packet, our attributes come first because the
+    // PSI/SI are analyzed before the audio/video attributes.
+    UStringVector attrs;
+    std::vector<uint64_t> index;
+    size_t i1 = 0;
+    size_t i2 = 0;
+    while (i1 < attributes.size() || i2 < other.attributes.size()) {
+        const bool first = i2 >= other.attributes.size() || (i1 < attributes.size() && _attributes_index[i1] <= other._attributes_index[i2]);
+        const UString& attr(first ? attributes[i1] : other.attributes[i2]);
+        if (std::find(attrs.begin(), attrs.end(), attr) == attrs.end()) {
+            attrs.push_back(attr);
+            index.push_back(first ? _attributes_index[i1] : other._attributes_index[i2]);
+        }
+        if (first) {
+            i1++;
+        }
+        else {
+            i2++;
+        }
+    }
+    attributes.swap(attrs);
+    _attributes_index.swap(index);
+}
+
+
+//----------------------------------------------------------------------------
+// Accumulate the changed fields of the PID context.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::PIDContext::updateChanges()
+{
+    const UString desc(fullDescription(true));
+    if (desc != _prev_description) {
+        _prev_description = desc;
+        changes |= CHANGED_DESCRIPTION;
+    }
+    if (bitrate != _prev_bitrate) {
+        _prev_bitrate = bitrate;
+        changes |= CHANGED_BITRATE;
+    }
+    if (scrambled != _prev_scrambled) {
+        _prev_scrambled = scrambled;
+        changes |= CHANGED_SCRAMBLING;
+    }
+    if (unexp_discont + duplicated != _prev_errors) {
+        _prev_errors = unexp_discont + duplicated;
+        changes |= CHANGED_ERRORS;
+    }
+    if (services != _prev_services) {
+        _prev_services = services;
+        changes |= CHANGED_COMPONENTS;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 //  Analyse a list of descriptors.
 //  If svp is not 0, we are in the PMT of the specified service.
@@ -936,7 +1359,7 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
                     uint8_t type = data[3];
                     ps->description = u"Subtitles";
                     ps->comment = ps->language;
-                    AppendUnique(ps->attributes, names::SubtitlingType(type));
+                    ps->addAttribute(names::SubtitlingType(type), _ts_pkt_cnt);
                 }
                 break;
             }
@@ -948,7 +1371,7 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
                     uint8_t type(data[3] >> 3);
                     ps->description = u"Teletext";
                     ps->comment = ps->language;
-                    AppendUnique(ps->attributes, names::TeletextType(type));
+                    ps->addAttribute(names::TeletextType(type), _ts_pkt_cnt);
                 }
                 break;
             }
@@ -1253,7 +1676,7 @@ void ts::TSAnalyzer::analyzeCADescriptor(const Descriptor& desc, ServiceContext*
 
 void ts::TSAnalyzer::handleNewAudioAttributes(PESDemux&, const PESPacket& pkt, const AudioAttributes& attr)
 {
-    AppendUnique(getPID(pkt.getSourcePID())->attributes, attr.toString());
+    getPID(pkt.getSourcePID())->addAttribute(attr.toString(), _ts_pkt_cnt);
 }
 
 
@@ -1264,7 +1687,7 @@ void ts::TSAnalyzer::handleNewAudioAttributes(PESDemux&, const PESPacket& pkt, c
 
 void ts::TSAnalyzer::handleNewAC3Attributes(PESDemux&, const PESPacket& pkt, const AC3Attributes& attr)
 {
-    AppendUnique(getPID(pkt.getSourcePID())->attributes, attr.toString());
+    getPID(pkt.getSourcePID())->addAttribute(attr.toString(), _ts_pkt_cnt);
 }
 
 
@@ -1275,7 +1698,7 @@ void ts::TSAnalyzer::handleNewAC3Attributes(PESDemux&, const PESPacket& pkt, con
 
 void ts::TSAnalyzer::handleNewVideoAttributes(PESDemux&, const PESPacket& pkt, const VideoAttributes& attr)
 {
-    AppendUnique(getPID(pkt.getSourcePID())->attributes, attr.toString());
+    getPID(pkt.getSourcePID())->addAttribute(attr.toString(), _ts_pkt_cnt);
 }
 
 
@@ -1286,7 +1709,7 @@ void ts::TSAnalyzer::handleNewVideoAttributes(PESDemux&, const PESPacket& pkt, c
 
 void ts::TSAnalyzer::handleNewAVCAttributes(PESDemux&, const PESPacket& pkt, const AVCAttributes& attr)
 {
-    AppendUnique(getPID(pkt.getSourcePID())->attributes, attr.toString());
+    getPID(pkt.getSourcePID())->addAttribute(attr.toString(), _ts_pkt_cnt);
 }
 
 
@@ -1333,7 +1756,7 @@ void ts::TSAnalyzer::handleT2MIPacket(T2MIDemux& demux, const T2MIPacket& pkt)
         pc->t2mi_plp_ts[pkt.plp()];
 
         // Add the PLP as attributes of this PID.
-        AppendUnique(pc->attributes, UString::Format(u"PLP: 0x%X (%d)", {pkt.plp(), pkt.plp()}));
+        pc->addAttribute(UString::Format(u"PLP: 0x%X (%d)", {pkt.plp(), pkt.plp()}), _ts_pkt_cnt);
     }
 }
 
@@ -1358,8 +1781,6 @@ void ts::TSAnalyzer::handleTSPacket(T2MIDemux& demux, const T2MIPacket& t2mi, co
 
 void ts::TSAnalyzer::feedPacket(const TSPacket& pkt)
 {
-    bool broken_rate(false);
-
     // Store system times of first packet
     if (_first_utc == Time::Epoch) {
         _first_utc = Time::CurrentUTC();
@@ -1406,110 +1827,134 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt)
 
     // Feed packets into the various demux
     _demux.feedPacket(pkt);
-    _pes_demux.feedPacket(pkt);
+    if (_shards.empty()) {
+        _pes_demux.feedPacket(pkt);
+    }
     _t2mi_demux.feedPacket(pkt);
 
     // Get PID context
-    PIDContextPtr ps(getPID(pkt.getPID()));
-    ps->ts_pkt_cnt++;
+    const PID pid = pkt.getPID();
+    PIDContextPtr ps(getPID(pid));
+
+    // Accumulate stat from packet, either here or in the worker thread for this PID.
+    if (_shards.empty()) {
+        ps->analyzePacket(pkt, packet_index);
+    }
+    else {
+        const size_t owner = pid % _shards.size();
+        if (_shared_pids.test(pid)) {
+            for (size_t i = 0; i < _shards.size(); ++i) {
+                _shards[i]->feedPacket(pkt, packet_index, i == owner);
+            }
+        }
+        else {
+            _shards[owner]->feedPacket(pkt, packet_index, true);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze a TS packet from a PID and update the packet statistics.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::PIDContext::analyzePacket(const TSPacket& pkt, uint64_t packet_index)
+{
+    bool broken_rate(false);
+
+    // Count TS packets in this PID
+    ts_pkt_cnt++;
 
     // Accumulate stat from packet
     if (pkt.hasAF()) {
-        ps->ts_af_cnt++;
+        ts_af_cnt++;
     }
     if (pkt.getPUSI()) {
-        ps->unit_start_cnt++;
+        unit_start_cnt++;
     }
     if (pkt.getPUSI() && pkt.hasPayload()) {
-        ps->pl_start_cnt++;
+        pl_start_cnt++;
     }
 
     // Process scrambling information
-    if (pkt.getScrambling() != SC_CLEAR && !ps->scrambled) {
-        ps->scrambled = true;
-        _scrambled_pid_cnt++;
+    if (pkt.getScrambling() != SC_CLEAR) {
+        scrambled = true;
     }
     if (pkt.getScrambling() == SC_DVB_RESERVED) {
-        ps->inv_ts_sc_cnt++;
+        inv_ts_sc_cnt++;
     }
     else if (pkt.getScrambling() != SC_CLEAR) {
-        ps->ts_sc_cnt++;
+        ts_sc_cnt++;
     }
-    if (pkt.getScrambling() != ps->cur_ts_sc) {
+    if (pkt.getScrambling() != cur_ts_sc) {
         // Change of crypto-period
-        if (ps->cur_ts_sc != SC_CLEAR) {
+        if (cur_ts_sc != SC_CLEAR) {
             // End of a crypto-period, not a clear/scramble transition.
             // Count number of crypto-periods:
-            ps->cryptop_cnt++;
+            cryptop_cnt++;
             // Count number of TS packets in all crypto-periods.
             // Ignore first crypto-period since it is truncated and
             // not significant for evaluation of duration.
-            if (ps->cryptop_cnt > 1) {
-                ps->cryptop_ts_cnt += packet_index - ps->cur_ts_sc_pkt;
+            if (cryptop_cnt > 1) {
+                cryptop_ts_cnt += packet_index - cur_ts_sc_pkt;
             }
         }
-        ps->cur_ts_sc = pkt.getScrambling();
-        ps->cur_ts_sc_pkt = packet_index;
+        cur_ts_sc = pkt.getScrambling();
+        cur_ts_sc_pkt = packet_index;
     }
 
     // Process discontinuities.
     // The continuity counter of null packets is undefined.
-    if (ps->pid != PID_NULL) {
-        if (ps->ts_pkt_cnt == 1) {
+    if (pid != PID_NULL) {
+        if (ts_pkt_cnt == 1) {
             // First packet, initialize continuity
-            ps->cur_continuity = pkt.getCC();
+            cur_continuity = pkt.getCC();
         }
         else if (pkt.getDiscontinuityIndicator()) {
             // Expected discontinuity
-            ps->exp_discont++;
+            exp_discont++;
             broken_rate = true;
         }
         else if (pkt.hasPayload()) {
             // Packet has payload.
-            if (pkt.getCC() == ps->cur_continuity) {
+            if (pkt.getCC() == cur_continuity) {
                 // Same counter means duplicated packet.
-                ps->duplicated++;
+                duplicated++;
             }
-            else if (pkt.getCC() != (ps->cur_continuity + 1) % CC_MAX) {
+            else if (pkt.getCC() != (cur_continuity + 1) % CC_MAX) {
                 // Counter not following previous -> discontinuity
-                ps->unexp_discont++;
+                unexp_discont++;
                 broken_rate = true;
             }
         }
-        else if (pkt.getCC() != ps->cur_continuity) {
+        else if (pkt.getCC() != cur_continuity) {
             // Packet has no payload -> should have same counter
-            ps->unexp_discont++;
+            unexp_discont++;
             broken_rate = true;
         }
-        ps->cur_continuity = pkt.getCC();
+        cur_continuity = pkt.getCC();
     }
 
     // Process PCR
     if (broken_rate) {
         // Suspected packet loss, forget last PCR.
-        ps->last_pcr = 0;
+        last_pcr = 0;
     }
     if (pkt.hasPCR()) {
         uint64_t pcr(pkt.getPCR());
-        // Count PID's with PCR
-        if (ps->pcr_cnt++ == 0)
-            _pcr_pid_cnt++;
+        pcr_cnt++;
         // If last PCR valid, compute transport rate between the two
-        if (ps->last_pcr != 0 && ps->last_pcr < pcr) {
+        if (last_pcr != 0 && last_pcr < pcr) {
             // Compute transport rate in b/s since last PCR
             uint64_t ts_bitrate =
-                (uint64_t(packet_index - ps->last_pcr_pkt) * SYSTEM_CLOCK_FREQ * PKT_SIZE * 8) /
-                (pcr - ps->last_pcr);
-            // Per-PID statistics:
-            ps->ts_bitrate_sum += ts_bitrate;
-            ps->ts_bitrate_cnt++;
-            // Transport stream statistics:
-            _ts_bitrate_sum += ts_bitrate;
-            _ts_bitrate_cnt++;
+                (uint64_t(packet_index - last_pcr_pkt) * SYSTEM_CLOCK_FREQ * PKT_SIZE * 8) /
+                (pcr - last_pcr);
+            ts_bitrate_sum += ts_bitrate;
+            ts_bitrate_cnt++;
         }
         // Save PCR for next calculation
-        ps->last_pcr = pcr;
-        ps->last_pcr_pkt = packet_index;
+        last_pcr = pcr;
+        last_pcr_pkt = packet_index;
     }
 
     // Check PES start code: PES packet headers start with the constant
@@ -1533,9 +1978,9 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt)
             // PID carries sections (we may not yet know this, so count
             // all these errors now and ignore them later if we know
             // that the PID does not carry PES packets).
-            ps->inv_pes_start++;
+            inv_pes_start++;
         }
-        else if (header_size <= PKT_SIZE - 4 && ps->pid != 0) {
+        else if (header_size <= PKT_SIZE - 4 && pid != 0) {
             // Here, the start of the packet payload is 00 00 01.
             // The only case where this can happen on a section is a PAT
             // (first 00 = "pointer field", second 00 = table_id = PAT).
@@ -1544,20 +1989,66 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt)
             // As a consequence, we are pretty sure to have a PES packet.
             // Remember the stream_id of the PES packets on this PID
             // (the PES stream_id is next byte after PES start code).
-            if (ps->pes_stream_id == 0) {
+            if (pes_stream_id == 0) {
                 // First PES stream_id found on this PID
-                ps->pes_stream_id = pkt.b [header_size + 3];
-                ps->same_stream_id = true;
+                pes_stream_id = pkt.b [header_size + 3];
+                same_stream_id = true;
             }
-            else if (ps->pes_stream_id != pkt.b [header_size + 3]) {
+            else if (pes_stream_id != pkt.b [header_size + 3]) {
                 // Got different values of stream_id in PES packets
-                ps->same_stream_id = false;
+                same_stream_id = false;
             }
         }
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Set the number of threads for the analysis.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::setThreads(size_t count)
+{
+    const size_t shards_count = count > 1 ? count : 0;
+    if (shards_count == _shards.size()) {
+        return;
+    }
+
+    // Collect the analysis of the previous worker threads and terminate them.
+    mergeShards();
+    _shards.clear();
+    _pes_demux.reset();
+
+    // Start new worker threads, with the current state of their PID's.
+    for (size_t i = 0; i < shards_count; ++i) {
+        _shards.push_back(new PIDShard(_duck.report(), i, shards_count));
+    }
+    for (PIDContextMap::const_iterator it = _pids.begin(); !_shards.empty() && it != _pids.end(); ++it) {
+        if (it->second->ts_pkt_cnt > 0) {
+            _shards[it->first % shards_count]->setPID(*it->second);
+        }
+    }
+    for (size_t i = 0; i < _shards.size(); ++i) {
+        _shards[i]->start();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for all worker threads and merge their analysis in the PID contexts.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::mergeShards()
+{
+    for (size_t i = 0; i < _shards.size(); ++i) {
+        _shards[i]->synchronize();
+        for (PIDContextMap::const_iterator it = _shards[i]->pids.begin(); it != _shards[i]->pids.end(); ++it) {
+            getPID(it->first)->merge(*it->second);
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Specify a "bitrate hint" for the analysis. It is the user-specified
 // bitrate in bits/seconds, based on 188-byte packets. The bitrate is
@@ -1571,6 +2062,19 @@ void ts::TSAnalyzer::setBitrateHint(BitRate bitrate)
 }
 
 
+//----------------------------------------------------------------------------
+// Start tracking changes for delta reports.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::startChangeTracking()
+{
+    if (!_track_changes) {
+        _track_changes = true;
+        _modified = true;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Update the global statistics value if internal data were modified.
 //----------------------------------------------------------------------------
@@ -1586,6 +2090,25 @@ void ts::TSAnalyzer::recomputeStatistics()
     _last_utc = Time::CurrentUTC();
     _last_local = Time::CurrentLocalTime();
 
+    // Collect the analysis from the worker threads, if any.
+    mergeShards();
+
+    // Global counters from the PID packet statistics.
+    _scrambled_pid_cnt = 0;
+    _pcr_pid_cnt = 0;
+    _ts_bitrate_sum = 0;
+    _ts_bitrate_cnt = 0;
+    for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
+        if (it->second->scrambled) {
+            _scrambled_pid_cnt++;
+        }
+        if (it->second->pcr_cnt > 0) {
+            _pcr_pid_cnt++;
+        }
+        _ts_bitrate_sum += it->second->ts_bitrate_sum;
+        _ts_bitrate_cnt += it->second->ts_bitrate_cnt;
+    }
+
     // Compute bitrate and broadcast duration
     _ts_pcr_bitrate_188 = _ts_bitrate_cnt == 0 ? 0 : BitRate(_ts_bitrate_sum / _ts_bitrate_cnt);
     _ts_pcr_bitrate_204 = _ts_bitrate_cnt == 0 ? 0 : BitRate((_ts_bitrate_sum * PKT_RS_SIZE) / (_ts_bitrate_cnt * PKT_SIZE));
@@ -1675,6 +2198,14 @@ void ts::TSAnalyzer::recomputeStatistics()
                 _psisi_scr_pids++;
             }
         }
+
+        // Track changes in the PID and its tables (delta reports only, building descriptions is costly).
+        if (_track_changes) {
+            pc.updateChanges();
+            for (ETIDContextMap::iterator it = pc.sections.begin(); it != pc.sections.end(); ++it) {
+                it->second->updateChanges();
+            }
+        }
     }
 
     // Complete unreferenced and global PID's bitrates
@@ -1701,6 +2232,32 @@ void ts::TSAnalyzer::recomputeStatistics()
         else {
             sci->second->bitrate = uint32_t((uint64_t(_ts_bitrate) * uint64_t(sci->second->ts_pkt_cnt)) / uint64_t(_ts_pkt_cnt));
         }
+
+        // Track changes in the service.
+        if (_track_changes) {
+            sci->second->updateChanges();
+        }
+    }
+
+    // Track changes in the global transport stream information.
+    if (_track_changes) {
+        if (_ts_bitrate != _prev_ts_bitrate) {
+            _prev_ts_bitrate = _ts_bitrate;
+            _ts_changes |= CHANGED_BITRATE;
+        }
+        if (_pid_cnt != _prev_pid_cnt || _services.size() != _prev_services_cnt) {
+            _prev_pid_cnt = _pid_cnt;
+            _prev_services_cnt = _services.size();
+            _ts_changes |= CHANGED_COMPONENTS;
+        }
+        if (_scrambled_services_cnt != _prev_scrambled_services) {
+            _prev_scrambled_services = _scrambled_services_cnt;
+            _ts_changes |= CHANGED_SCRAMBLING;
+        }
+        if (_invalid_sync + _transport_errors + _suspect_ignored != _prev_errors) {
+            _prev_errors = _invalid_sync + _transport_errors + _suspect_ignored;
+            _ts_changes |= CHANGED_ERRORS;
+        }
     }
 
     // Don't redo this unless the analyzer is modified
@@ -124,6 +124,18 @@ namespace ts {
             _max_consecutive_suspects = count;
         }
 
+        //!
+        //! Set the number of threads for the analysis.
+        //! When more than one thread is used, the PID's are distributed across worker threads
+        //! which compute the per-PID packet statistics and the audio/video attributes. The
+        //! PSI/SI analysis remains in the caller thread. All statistics are merged when the
+        //! analysis results are computed, producing the same results as a single-threaded
+        //! analysis. This method should be called before the first packet is analyzed.
+        //! @param [in] count Number of threads. Zero or one means that the complete analysis
+        //! is performed in the caller thread (the default).
+        //!
+        void setThreads(size_t count);
+
         //!
         //! Get the list of service ids.
         //! @param [out] list The returned list of service ids.
@@ -164,6 +176,25 @@ namespace ts {
 
     protected:
 
+        // -------------------
+        // Change tracking
+        // -------------------
+
+        //!
+        //! Flags indicating which fields of an analysis context changed.
+        //! The flags are accumulated in the analysis contexts by recomputeStatistics()
+        //! and are typically cleared by the application after reporting the changes.
+        //!
+        enum : uint32_t {
+            CHANGED_NEW         = 0x0001,  //!< The context was created.
+            CHANGED_DESCRIPTION = 0x0002,  //!< Description, name or attributes.
+            CHANGED_BITRATE     = 0x0004,  //!< Bitrate.
+            CHANGED_SCRAMBLING  = 0x0008,  //!< Scrambling state.
+            CHANGED_ERRORS      = 0x0010,  //!< Error counters.
+            CHANGED_COMPONENTS  = 0x0020,  //!< List of components (services, PID's).
+            CHANGED_VERSION     = 0x0040,  //!< Table version.
+        };
+
         // -------------------
         // Service description
         // -------------------
@@ -189,6 +220,7 @@ namespace ts {
             uint32_t       bitrate;            //!< Average service bitrate in b/s.
             bool           carry_ssu;          //!< Carry System Software Update.
             bool           carry_t2mi;         //!< Carry T2-MI encasulated data.
+            uint32_t       changes;            //!< Changed fields since last cleared (CHANGED_xxx flags).
 
             //!
             //! Constructor.
@@ -212,6 +244,18 @@ namespace ts {
             //! @return A displayable provider name.
             //!
             UString getProvider() const;
+
+            //!
+            //! Accumulate the changed fields since the previous call in @a changes.
+            //!
+            void updateChanges();
+
+        private:
+            UString  _prev_name;       // Values at previous updateChanges().
+            UString  _prev_provider;
+            uint32_t _prev_bitrate;
+            size_t   _prev_pid_cnt;
+            bool     _prev_scrambled;
         };
 
         //!
@@ -264,12 +308,21 @@ namespace ts {
             // Public members - Analysis data: Repetition interval evaluation:
             uint64_t   first_pkt;                 //!< Last packet index of first section# 0.
             uint64_t   last_pkt;                  //!< Last packet index of last section# 0.
+            uint32_t   changes;                   //!< Changed fields since last cleared (CHANGED_xxx flags).
 
             //!
             //! Constructor.
             //! @param [in] etid Extended table id.
             //!
             ETIDContext(const ETID& etid);
+
+            //!
+            //! Accumulate the changed fields since the previous call in @a changes.
+            //!
+            void updateChanges();
+
+        private:
+            int _prev_version;  // Version at previous updateChanges(), -1 if none.
         };
 
         //!
@@ -358,6 +411,8 @@ namespace ts {
             uint64_t       last_pcr_pkt;    //!< Index of packet with last PCR.
             uint64_t       ts_bitrate_sum;  //!< Sum of all computed TS bitrates.
             uint64_t       ts_bitrate_cnt;  //!< Number of computed TS bitrates.
+            // Public members - Change tracking:
+            uint32_t       changes;         //!< Changed fields since last cleared (CHANGED_xxx flags).
 
             //!
             //! Default constructor.
@@ -379,7 +434,41 @@ namespace ts {
             //!
             UString fullDescription(bool include_attributes) const;
 
+            //!
+            //! Add an audio or video attribute, if not already present.
+            //! @param [in] attr Attribute string.
+            //! @param [in] packet_index Index of the TS packet where the attribute was found.
+            //!
+            void addAttribute(const UString& attr, uint64_t packet_index);
+
+            //!
+            //! Analyze a TS packet from this PID and update the packet statistics.
+            //! @param [in] pkt A TS packet from this PID.
+            //! @param [in] packet_index Index of the TS packet in the stream.
+            //!
+            void analyzePacket(const TSPacket& pkt, uint64_t packet_index);
+
+            //!
+            //! Merge the analysis of the same PID from another context.
+            //! The packet statistics are copied from the other context and the attributes
+            //! are merged in their order of appearance in the stream.
+            //! @param [in] other Another analysis context for the same PID.
+            //!
+            void merge(const PIDContext& other);
+
+            //!
+            //! Accumulate the changed fields since the previous call in @a changes.
+            //!
+            void updateChanges();
+
         private:
+            std::vector<uint64_t> _attributes_index;  // Packet index where each attribute was first found.
+            UString               _prev_description;  // Values at previous updateChanges().
+            uint32_t              _prev_bitrate;
+            bool                  _prev_scrambled;
+            uint64_t              _prev_errors;
+            ServiceIdSet          _prev_services;
+
             // Description of a few known PID's
             struct KnownPID
             {
@@ -429,6 +518,13 @@ namespace ts {
         //!
         void recomputeStatistics();
 
+        //!
+        //! Start tracking changes in the analysis for delta reports.
+        //! Building the change information is costly and is not done until this method is called.
+        //! The next call to recomputeStatistics() computes the changes.
+        //!
+        void startChangeTracking();
+
         // TSAnalyzer protected members.
         // Accessible to subclasses, valid after calling recomputeStatistics().
         // Important: subclasses shall not modify these fields, just read them.
@@ -471,6 +567,7 @@ namespace ts {
         Time         _last_stt;           //!< Last STT (ATCS) time stamp.
         UString      _country_code;       //!< TOT country code.
         uint16_t     _scrambled_services_cnt; //!< Number of scrambled services;.
+        uint32_t     _ts_changes;             //!< Changed global fields since last cleared (CHANGED_xxx flags).
         std::bitset<TID_MAX> _tid_present;    //!< Array of detected tables.
         PIDContextMap        _pids;           //!< Description of PIDs.
         ServiceContextMap    _services;       //!< Description of services, map key: service id..
@@ -482,6 +579,14 @@ namespace ts {
         // Reset the section demux.
         void resetSectionDemux();
 
+        // In parallel mode, a worker thread which analyzes a subset of the PID's.
+        class PIDShard;
+        typedef SafePtr<PIDShard, NullMutex> PIDShardPtr;
+        typedef std::vector<PIDShardPtr> PIDShardVector;
+
+        // Wait for all worker threads and merge their analysis in the PID contexts.
+        void mergeShards();
+
         // Analyze the various PSI tables
         void analyzePAT(const PAT&);
         void analyzeCAT(const CAT&);
@@ -523,14 +628,22 @@ namespace ts {
 
         // TSAnalyzer private members (state data, used during analysis):
         bool              _modified;                  // Internal data modified, need recomputeStatistics
+        bool              _track_changes;             // Track changes in recomputeStatistics (delta reports)
         uint64_t          _ts_bitrate_sum;            // Sum of all computed TS bitrates
         uint64_t          _ts_bitrate_cnt;            // Number of computed TS bitrates
         uint64_t          _preceding_errors;          // Number of contiguous invalid packets before current packet
         uint64_t          _preceding_suspects;        // Number of contiguous suspects packets before current packet
         uint64_t          _min_error_before_suspect;  // Required number of invalid packets before starting suspect
         uint64_t          _max_consecutive_suspects;  // Max number of consecutive suspect packets before clearing suspect
+        uint32_t          _prev_ts_bitrate;           // Change tracking: values at previous recomputeStatistics()
+        size_t            _prev_pid_cnt;
+        size_t            _prev_services_cnt;
+        uint16_t          _prev_scrambled_services;
+        uint64_t          _prev_errors;
         SectionDemux      _demux;                     // PSI tables analysis
         PESDemux          _pes_demux;                 // Audio/video analysis
         T2MIDemux         _t2mi_demux;                // T2-MI analysis
+        PIDShardVector    _shards;                    // Worker threads in parallel mode (empty otherwise)
+        PIDSet            _shared_pids;               // PID's which are sent to all worker threads (PAT, PMT's)
     };
 }
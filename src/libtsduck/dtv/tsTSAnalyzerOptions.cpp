@@ -57,7 +57,8 @@ ts::TSAnalyzerOptions::TSAnalyzerOptions() :
     prefix(),
     title(),
     suspect_min_error_count(1),
-    suspect_max_consecutive(1)
+    suspect_max_consecutive(1),
+    threads(1)
 {
 }
 
@@ -177,6 +178,14 @@ void ts::TSAnalyzerOptions::defineArgs(Args &args) const
               u"(see option --suspect-min-error-count)\n"
               u"- it immediately follows no more than the specified number consecutive "
               u"suspect packets.");
+
+    args.option(u"threads", 0, Args::POSITIVE);
+    args.help(u"threads",
+              u"Number of threads to use for the analysis. With more than one thread, "
+              u"the PID's are distributed over worker threads which compute the packet "
+              u"statistics and the audio/video attributes of their PID's, while the PSI/SI "
+              u"are analyzed in the main thread. The results of the analysis are identical. "
+              u"The default is 1, the complete analysis is performed in one single thread.");
 }
 
 
@@ -206,6 +215,7 @@ bool ts::TSAnalyzerOptions::loadArgs(DuckContext &duck, Args &args)
     title = args.value(u"title");
     suspect_min_error_count = args.intValue<uint64_t>(u"suspect-min-error-count", 1);
     suspect_max_consecutive = args.intValue<uint64_t>(u"suspect-max-consecutive", 1);
+    threads = args.intValue<size_t>(u"threads", 1);
 
     // Default: --ts-analysis --service-analysis --pid-analysis
     if (!ts_analysis &&
@@ -87,6 +87,9 @@ namespace ts {
         uint64_t suspect_min_error_count;  //!< Option -\-suspect-min-error-count
         uint64_t suspect_max_consecutive;  //!< Option -\-suspect-max-consecutive
 
+        // Analysis performance
+        size_t threads;              //!< Option -\-threads
+
         // Implementation of ArgsSupplierInterface.
         virtual void defineArgs(Args& args) const override;
         virtual bool loadArgs(DuckContext& duck, Args& args) override;
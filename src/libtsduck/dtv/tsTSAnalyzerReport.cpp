@@ -30,6 +30,7 @@
 #include "tsTSAnalyzerReport.h"
 #include "tsNames.h"
 #include "tsjsonObject.h"
+#include "tsjsonStreamWriter.h"
 #include "tsjsonString.h"
 #include "tsjsonNumber.h"
 TSDUCK_SOURCE;
@@ -60,6 +61,71 @@ TSDUCK_SOURCE;
 #define WIDE_PID_COL3   14   // PID list, column 3 (bitrate).
 
 
+//----------------------------------------------------------------------------
+// Delta reports: format on one line, split when too large.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Format a JSON value on one line, without end of line.
+    std::string OneLineJSON(const ts::json::Value& value, ts::Report& rep)
+    {
+        std::ostringstream line;
+        ts::TextFormatter text(rep);
+        text.setIndentSize(0).setEndOfLineMode(ts::TextFormatter::EndOfLineMode::NONE).setStream(line);
+        value.print(text);
+        text.flush();
+        return line.str();
+    }
+
+    // Split a delta report which is too large into several JSON lines.
+    void SplitDelta(ts::json::Object& root, std::ostream& stm, ts::Report& rep, size_t max_line_size)
+    {
+        // The arrays of changes are dispatched over several lines.
+        // The other fields (transport stream, time) are repeated in each line.
+        static const ts::UChar* const array_names[] = {u"services", u"pids", u"tables"};
+        ts::json::ValuePtr arrays[3];
+        for (size_t i = 0; i < 3; ++i) {
+            arrays[i] = root.extract(array_names[i]);
+        }
+        const size_t base_size = OneLineJSON(root, rep).size();
+
+        ts::json::Object line(root);
+        size_t line_size = base_size;
+        size_t line_items = 0;
+
+        for (size_t i = 0; i < 3; ++i) {
+            const size_t count = arrays[i].isNull() ? 0 : arrays[i]->size();
+            // Estimated overhead of the array in the line: "name":[],
+            const size_t array_overhead = ts::UString(array_names[i]).size() + 8;
+            bool array_in_line = false;
+            for (size_t index = 0; index < count; ++index) {
+                // Add 2 bytes per item for the separator.
+                const ts::json::ValuePtr item(arrays[i]->extractAt(0));
+                const size_t item_size = OneLineJSON(*item, rep).size() + 2;
+                if (line_items > 0 && line_size + item_size + (array_in_line ? 0 : array_overhead) > max_line_size) {
+                    // Flush current line, start a new one.
+                    stm << OneLineJSON(line, rep) << std::endl;
+                    line = root;
+                    line_size = base_size;
+                    line_items = 0;
+                    array_in_line = false;
+                }
+                if (!array_in_line) {
+                    line_size += array_overhead;
+                    array_in_line = true;
+                }
+                line.query(array_names[i], true, ts::json::TypeArray).set(item);
+                line_size += item_size;
+                line_items++;
+            }
+        }
+        if (line_items > 0) {
+            stm << OneLineJSON(line, rep) << std::endl;
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Constructors and destructors.
 //----------------------------------------------------------------------------
@@ -82,6 +148,7 @@ void ts::TSAnalyzerReport::setAnalysisOptions(const TSAnalyzerOptions& opt)
 {
     setMinErrorCountBeforeSuspect(opt.suspect_min_error_count);
     setMaxConsecutiveSuspectCount(opt.suspect_max_consecutive);
+    setThreads(opt.threads);
 }
 
 
@@ -1063,131 +1130,22 @@ void ts::TSAnalyzerReport::reportJSON(const TSAnalyzerOptions& opt, std::ostream
     // Update the global statistics value if internal data were modified.
     recomputeStatistics();
 
-    // JSON root.
-    json::Object root;
-
-    // Add user-supplied title.
-    if (!title.empty()) {
-        root.add(u"title", title);
-    }
-
-    // Add transport stream description
-    if (_ts_id_valid) {
-        root.query(u"ts", true).add(u"id", _ts_id);
-    }
-    root.query(u"ts", true).add(u"bytes", PKT_SIZE * _ts_pkt_cnt);
-    root.query(u"ts", true).add(u"bitrate", _ts_bitrate);
-    root.query(u"ts", true).add(u"bitrate-204", ToBitrate204(_ts_bitrate));
-    root.query(u"ts", true).add(u"user-bitrate", _ts_user_bitrate);
-    root.query(u"ts", true).add(u"user-bitrate-204", ToBitrate204(_ts_user_bitrate));
-    root.query(u"ts", true).add(u"pcr-bitrate", _ts_pcr_bitrate_188);
-    root.query(u"ts", true).add(u"pcr-bitrate-204", _ts_pcr_bitrate_204);
-    root.query(u"ts", true).add(u"duration", _duration / 1000);
-    if (!_country_code.empty()) {
-        root.query(u"ts", true).add(u"country", _country_code);
-    }
-
-    root.query(u"ts.services", true).add(u"total", _services.size());
-    root.query(u"ts.services", true).add(u"clear", _services.size() - _scrambled_services_cnt);
-    root.query(u"ts.services", true).add(u"scrambled", _scrambled_services_cnt);
-
-    root.query(u"ts.packets", true).add(u"total", _ts_pkt_cnt);
-    root.query(u"ts.packets", true).add(u"invalid-syncs", _invalid_sync);
-    root.query(u"ts.packets", true).add(u"transport-errors", _transport_errors);
-    root.query(u"ts.packets", true).add(u"suspect-ignored", _suspect_ignored);
-
-    // Add PID's info.
-    root.query(u"ts.pids", true).add(u"total", _pid_cnt);
-    root.query(u"ts.pids", true).add(u"clear", _pid_cnt - _scrambled_pid_cnt);
-    root.query(u"ts.pids", true).add(u"scrambled", _scrambled_pid_cnt);
-    root.query(u"ts.pids", true).add(u"pcr", _pcr_pid_cnt);
-    root.query(u"ts.pids", true).add(u"unreferenced", _unref_pid_cnt);
-
-    // Global PID's (ie. not attached to a service)
-    root.query(u"ts.pids.global", true).add(u"total", _global_pid_cnt);
-    root.query(u"ts.pids.global", true).add(u"clear", _global_pid_cnt - _global_scr_pids);
-    root.query(u"ts.pids.global", true).add(u"scrambled", _global_scr_pids);
-    root.query(u"ts.pids.global", true).add(u"packets", _global_pkt_cnt);
-    root.query(u"ts.pids.global", true).add(u"bitrate", _global_bitrate);
-    root.query(u"ts.pids.global", true).add(u"bitrate-204", ToBitrate204(_global_bitrate));
-    root.query(u"ts.pids.global", true).add(u"is-scrambled", json::Bool(_global_scr_pids > 0));
-    for (auto it = _pids.begin(); it != _pids.end(); ++it) {
-        const PIDContext& pc(*it->second);
-        if (pc.referenced && pc.services.size() == 0 && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
-            root.query(u"ts.pids.global.pids", true, json::TypeArray).set(pc.pid);
-        }
-    }
-
-    // Unreferenced PIDs
-    root.query(u"ts.pids.unreferenced", true).add(u"total", _unref_pid_cnt);
-    root.query(u"ts.pids.unreferenced", true).add(u"clear", _unref_pid_cnt - _unref_scr_pids);
-    root.query(u"ts.pids.unreferenced", true).add(u"scrambled", _unref_scr_pids);
-    root.query(u"ts.pids.unreferenced", true).add(u"packets", _unref_pkt_cnt);
-    root.query(u"ts.pids.unreferenced", true).add(u"bitrate", _unref_bitrate);
-    root.query(u"ts.pids.unreferenced", true).add(u"bitrate-204", ToBitrate204(_unref_bitrate));
-    root.query(u"ts.pids.unreferenced", true).add(u"is-scrambled", json::Bool(_unref_scr_pids > 0));
-    for (auto it = _pids.begin(); it != _pids.end(); ++it) {
-        const PIDContext& pc (*it->second);
-        if (!pc.referenced && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
-            root.query(u"ts.pids.unreferenced.pids", true, json::TypeArray).set(pc.pid);
-        }
-    }
-
-    // Add first and last UTC and local times.
-    jsonTime(root, u"time.utc.tdt.first", _first_tdt);
-    jsonTime(root, u"time.utc.tdt.last", _last_tdt);
-    jsonTime(root, u"time.utc.tdt.first", _first_tdt);
-    jsonTime(root, u"time.utc.tdt.last", _last_tdt);
-    jsonTime(root, u"time.local.tot.first", _first_tot, _country_code);
-    jsonTime(root, u"time.local.tot.last", _last_tot, _country_code);
-    if (!opt.deterministic) {
-        jsonTime(root, u"time.utc.system.first", _first_utc);
-        jsonTime(root, u"time.utc.system.last", _last_utc);
-        jsonTime(root, u"time.local.system.first", _first_local);
-        jsonTime(root, u"time.local.system.last", _last_local);
-    }
-
-    // One node per service
-    for (auto it = _services.begin(); it != _services.end(); ++it) {
-        const ServiceContext& sv(*it->second);
-        json::Value& jv(root.query(u"services[]", true));
-        jv.add(u"id", sv.service_id);
-        jv.add(u"provider", sv.getProvider());
-        jv.add(u"name", sv.getName());
-        jv.add(u"type", sv.service_type);
-        jv.add(u"type-name", names::StreamType(sv.service_type));
-        jv.add(u"tsid", _ts_id);
-        jv.add(u"original-network-id", sv.orig_netw_id);
-        jv.add(u"is-scrambled", json::Bool(sv.scrambled_pid_cnt > 0));
-        jv.query(u"components", true).add(u"total", sv.pid_cnt);
-        jv.query(u"components", true).add(u"clear", sv.pid_cnt - sv.scrambled_pid_cnt);
-        jv.query(u"components", true).add(u"scrambled", sv.scrambled_pid_cnt);
-        jv.add(u"packets", sv.ts_pkt_cnt);
-        jv.add(u"bitrate", sv.bitrate);
-        jv.add(u"bitrate-204", ToBitrate204(sv.bitrate));
-        jv.add(u"ssu", json::Bool(sv.carry_ssu));
-        jv.add(u"t2mi", json::Bool(sv.carry_t2mi));
-        if (sv.pmt_pid != 0) {
-            jv.add(u"pmt-pid", sv.pmt_pid);
-        }
-        if (sv.pcr_pid != 0 && sv.pcr_pid != PID_NULL) {
-            jv.add(u"pcr-pid", sv.pcr_pid);
-        }
-        for (auto it_pid = _pids.begin(); it_pid != _pids.end(); ++it_pid) {
-            if (it_pid->second->services.count(sv.service_id) != 0) {
-                // This PID belongs to the service
-                jv.query(u"pids", true, json::TypeArray).set(it_pid->first);
-            }
-        }
-    }
+    // The JSON document is streamed on output, one top-level field at a time.
+    // Each PID, service or table is built and printed independently. The fields
+    // are printed in the same order as in a json::Object, sorted by name.
+    TextFormatter text(rep);
+    text.setStream(stm);
+    json::StreamWriter out(text);
+    out.beginObject();
 
     // One node per PID
+    bool has_pids = false;
     for (auto it = _pids.begin(); it != _pids.end(); ++it) {
         const PIDContext& pc(*it->second);
         if (pc.ts_pkt_cnt == 0 && pc.optional) {
             continue;
         }
-        json::Value& jv(root.query(u"pids[]", true));
+        json::Object jv;
         jv.add(u"id", pc.pid);
         jv.add(u"description", pc.fullDescription(true));
         jv.add(u"pmt", json::Bool(pc.is_pmt_pid));
@@ -1241,14 +1199,66 @@ void ts::TSAnalyzerReport::reportJSON(const TSAnalyzerOptions& opt, std::ostream
         else {
             jv.add(u"unit-start", pc.unit_start_cnt);
         }
+        if (!has_pids) {
+            out.beginArray(u"pids");
+            has_pids = true;
+        }
+        out.set(jv);
+    }
+    if (has_pids) {
+        out.end();
+    }
+
+    // One node per service
+    bool has_services = false;
+    for (auto it = _services.begin(); it != _services.end(); ++it) {
+        const ServiceContext& sv(*it->second);
+        json::Object jv;
+        jv.add(u"id", sv.service_id);
+        jv.add(u"provider", sv.getProvider());
+        jv.add(u"name", sv.getName());
+        jv.add(u"type", sv.service_type);
+        jv.add(u"type-name", names::StreamType(sv.service_type));
+        jv.add(u"tsid", _ts_id);
+        jv.add(u"original-network-id", sv.orig_netw_id);
+        jv.add(u"is-scrambled", json::Bool(sv.scrambled_pid_cnt > 0));
+        jv.query(u"components", true).add(u"total", sv.pid_cnt);
+        jv.query(u"components", true).add(u"clear", sv.pid_cnt - sv.scrambled_pid_cnt);
+        jv.query(u"components", true).add(u"scrambled", sv.scrambled_pid_cnt);
+        jv.add(u"packets", sv.ts_pkt_cnt);
+        jv.add(u"bitrate", sv.bitrate);
+        jv.add(u"bitrate-204", ToBitrate204(sv.bitrate));
+        jv.add(u"ssu", json::Bool(sv.carry_ssu));
+        jv.add(u"t2mi", json::Bool(sv.carry_t2mi));
+        if (sv.pmt_pid != 0) {
+            jv.add(u"pmt-pid", sv.pmt_pid);
+        }
+        if (sv.pcr_pid != 0 && sv.pcr_pid != PID_NULL) {
+            jv.add(u"pcr-pid", sv.pcr_pid);
+        }
+        for (auto it_pid = _pids.begin(); it_pid != _pids.end(); ++it_pid) {
+            if (it_pid->second->services.count(sv.service_id) != 0) {
+                // This PID belongs to the service
+                jv.query(u"pids", true, json::TypeArray).set(it_pid->first);
+            }
+        }
+        if (!has_services) {
+            out.beginArray(u"services");
+            has_services = true;
+        }
+        out.set(jv);
+    }
+    if (has_services) {
+        out.end();
     }
 
     // One node per table
+    bool has_tables = false;
     for (auto pci = _pids.begin(); pci != _pids.end(); ++pci) {
         const PIDContext& pc(*pci->second);
         for (auto it = pc.sections.begin(); it != pc.sections.end(); ++it) {
             const ETIDContext& etc(*it->second);
-            json::Value& jv(root.query(u"tables[]", true));
+            json::Object jv;
             jv.add(u"pid", pc.pid);
             jv.add(u"tid", etc.etid.tid());
             if (etc.etid.isLongSection()) {
@@ -1273,17 +1283,252 @@ void ts::TSAnalyzerReport::reportJSON(const TSAnalyzerOptions& opt, std::ostream
                     }
                 }
             }
+            if (!has_tables) {
+                out.beginArray(u"tables");
+                has_tables = true;
+            }
+            out.set(jv);
         }
     }
+    if (has_tables) {
+        out.end();
+    }
 
-    // An output text formatter for JSON output.
-    TextFormatter text(rep);
-    text.setStream(stm);
-    root.print(text);
+    // Add first and last UTC and local times.
+    json::Object jtime;
+    jsonTime(jtime, u"utc.tdt.first", _first_tdt);
+    jsonTime(jtime, u"utc.tdt.last", _last_tdt);
+    jsonTime(jtime, u"utc.tdt.first", _first_tdt);
+    jsonTime(jtime, u"utc.tdt.last", _last_tdt);
+    jsonTime(jtime, u"local.tot.first", _first_tot, _country_code);
+    jsonTime(jtime, u"local.tot.last", _last_tot, _country_code);
+    if (!opt.deterministic) {
+        jsonTime(jtime, u"utc.system.first", _first_utc);
+        jsonTime(jtime, u"utc.system.last", _last_utc);
+        jsonTime(jtime, u"local.system.first", _first_local);
+        jsonTime(jtime, u"local.system.last", _last_local);
+    }
+    if (jtime.size() > 0) {
+        out.add(u"time", jtime);
+    }
+
+    // Add user-supplied title.
+    if (!title.empty()) {
+        out.add(u"title", title);
+    }
+
+    // Add transport stream description
+    json::Object jts;
+    if (_ts_id_valid) {
+        jts.add(u"id", _ts_id);
+    }
+    jts.add(u"bytes", PKT_SIZE * _ts_pkt_cnt);
+    jts.add(u"bitrate", _ts_bitrate);
+    jts.add(u"bitrate-204", ToBitrate204(_ts_bitrate));
+    jts.add(u"user-bitrate", _ts_user_bitrate);
+    jts.add(u"user-bitrate-204", ToBitrate204(_ts_user_bitrate));
+    jts.add(u"pcr-bitrate", _ts_pcr_bitrate_188);
+    jts.add(u"pcr-bitrate-204", _ts_pcr_bitrate_204);
+    jts.add(u"duration", _duration / 1000);
+    if (!_country_code.empty()) {
+        jts.add(u"country", _country_code);
+    }
+
+    jts.query(u"services", true).add(u"total", _services.size());
+    jts.query(u"services", true).add(u"clear", _services.size() - _scrambled_services_cnt);
+    jts.query(u"services", true).add(u"scrambled", _scrambled_services_cnt);
+
+    jts.query(u"packets", true).add(u"total", _ts_pkt_cnt);
+    jts.query(u"packets", true).add(u"invalid-syncs", _invalid_sync);
+    jts.query(u"packets", true).add(u"transport-errors", _transport_errors);
+    jts.query(u"packets", true).add(u"suspect-ignored", _suspect_ignored);
+
+    // Add PID's info.
+    jts.query(u"pids", true).add(u"total", _pid_cnt);
+    jts.query(u"pids", true).add(u"clear", _pid_cnt - _scrambled_pid_cnt);
+    jts.query(u"pids", true).add(u"scrambled", _scrambled_pid_cnt);
+    jts.query(u"pids", true).add(u"pcr", _pcr_pid_cnt);
+    jts.query(u"pids", true).add(u"unreferenced", _unref_pid_cnt);
+
+    // Global PID's (ie. not attached to a service)
+    jts.query(u"pids.global", true).add(u"total", _global_pid_cnt);
+    jts.query(u"pids.global", true).add(u"clear", _global_pid_cnt - _global_scr_pids);
+    jts.query(u"pids.global", true).add(u"scrambled", _global_scr_pids);
+    jts.query(u"pids.global", true).add(u"packets", _global_pkt_cnt);
+    jts.query(u"pids.global", true).add(u"bitrate", _global_bitrate);
+    jts.query(u"pids.global", true).add(u"bitrate-204", ToBitrate204(_global_bitrate));
+    jts.query(u"pids.global", true).add(u"is-scrambled", json::Bool(_global_scr_pids > 0));
+    for (auto it = _pids.begin(); it != _pids.end(); ++it) {
+        const PIDContext& pc(*it->second);
+        if (pc.referenced && pc.services.size() == 0 && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
+            jts.query(u"pids.global.pids", true, json::TypeArray).set(pc.pid);
+        }
+    }
+
+    // Unreferenced PIDs
+    jts.query(u"pids.unreferenced", true).add(u"total", _unref_pid_cnt);
+    jts.query(u"pids.unreferenced", true).add(u"clear", _unref_pid_cnt - _unref_scr_pids);
+    jts.query(u"pids.unreferenced", true).add(u"scrambled", _unref_scr_pids);
+    jts.query(u"pids.unreferenced", true).add(u"packets", _unref_pkt_cnt);
+    jts.query(u"pids.unreferenced", true).add(u"bitrate", _unref_bitrate);
+    jts.query(u"pids.unreferenced", true).add(u"bitrate-204", ToBitrate204(_unref_bitrate));
+    jts.query(u"pids.unreferenced", true).add(u"is-scrambled", json::Bool(_unref_scr_pids > 0));
+    for (auto it = _pids.begin(); it != _pids.end(); ++it) {
+        const PIDContext& pc (*it->second);
+        if (!pc.referenced && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
+            jts.query(u"pids.unreferenced.pids", true, json::TypeArray).set(pc.pid);
+        }
+    }
+    out.add(u"ts", jts);
+
+    out.close();
     text << std::endl;
 }
 
 
+//----------------------------------------------------------------------------
+// This method displays a delta report as one compact JSON line.
+//----------------------------------------------------------------------------
+
+bool ts::TSAnalyzerReport::reportDelta(const TSAnalyzerOptions& opt, std::ostream& stm, Report& rep, size_t max_line_size)
+{
+    // Changes are tracked only after the first delta report was requested.
+    startChangeTracking();
+
+    // Update the global statistics value and the changed fields.
+    recomputeStatistics();
+
+    json::Object root;
+    bool changed = _ts_changes != 0;
+
+    // Transport stream: always display the packet count as reference.
+    json::Value& jts(root.query(u"ts", true));
+    if (_ts_id_valid) {
+        jts.add(u"id", _ts_id);
+    }
+    jts.add(u"packets", _ts_pkt_cnt);
+    if ((_ts_changes & CHANGED_BITRATE) != 0) {
+        jts.add(u"bitrate", _ts_bitrate);
+    }
+    if ((_ts_changes & CHANGED_COMPONENTS) != 0) {
+        jts.add(u"pids", _pid_cnt);
+        jts.add(u"services", _services.size());
+    }
+    if ((_ts_changes & CHANGED_SCRAMBLING) != 0) {
+        jts.add(u"scrambled-services", _scrambled_services_cnt);
+    }
+    if ((_ts_changes & CHANGED_ERRORS) != 0) {
+        jts.add(u"invalid-syncs", _invalid_sync);
+        jts.add(u"transport-errors", _transport_errors);
+        jts.add(u"suspect-ignored", _suspect_ignored);
+    }
+    _ts_changes = 0;
+
+    // Changed services.
+    for (auto it = _services.begin(); it != _services.end(); ++it) {
+        ServiceContext& sv(*it->second);
+        if (sv.changes == 0) {
+            continue;
+        }
+        changed = true;
+        json::Value& jv(root.query(u"services[]", true));
+        jv.add(u"id", sv.service_id);
+        if ((sv.changes & CHANGED_NEW) != 0) {
+            jv.add(u"new", json::Bool(true));
+        }
+        if ((sv.changes & CHANGED_DESCRIPTION) != 0) {
+            jv.add(u"provider", sv.getProvider());
+            jv.add(u"name", sv.getName());
+        }
+        if ((sv.changes & CHANGED_BITRATE) != 0) {
+            jv.add(u"bitrate", sv.bitrate);
+        }
+        if ((sv.changes & CHANGED_SCRAMBLING) != 0) {
+            jv.add(u"is-scrambled", json::Bool(sv.scrambled_pid_cnt > 0));
+        }
+        if ((sv.changes & CHANGED_COMPONENTS) != 0) {
+            json::Value& jpids(jv.query(u"pids", true, json::TypeArray));
+            for (auto it_pid = _pids.begin(); it_pid != _pids.end(); ++it_pid) {
+                if (it_pid->second->services.count(sv.service_id) != 0) {
+                    jpids.set(it_pid->first);
+                }
+            }
+        }
+        sv.changes = 0;
+    }
+
+    // Changed PID's and tables.
+    for (auto it = _pids.begin(); it != _pids.end(); ++it) {
+        PIDContext& pc(*it->second);
+        // Same filter as full reports, the changes are kept until the PID is reported.
+        if (pc.ts_pkt_cnt == 0 && pc.optional) {
+            continue;
+        }
+        if (pc.changes != 0) {
+            changed = true;
+            json::Value& jv(root.query(u"pids[]", true));
+            jv.add(u"id", pc.pid);
+            if ((pc.changes & CHANGED_NEW) != 0) {
+                jv.add(u"new", json::Bool(true));
+            }
+            if ((pc.changes & CHANGED_DESCRIPTION) != 0) {
+                jv.add(u"description", pc.fullDescription(true));
+            }
+            if ((pc.changes & CHANGED_BITRATE) != 0) {
+                jv.add(u"bitrate", pc.bitrate);
+            }
+            if ((pc.changes & CHANGED_SCRAMBLING) != 0) {
+                jv.add(u"is-scrambled", json::Bool(pc.scrambled));
+            }
+            if ((pc.changes & CHANGED_ERRORS) != 0) {
+                jv.add(u"discontinuities", pc.unexp_discont);
+                jv.add(u"duplicated", pc.duplicated);
+            }
+            if ((pc.changes & CHANGED_COMPONENTS) != 0) {
+                json::Value& jsrv(jv.query(u"services", true, json::TypeArray));
+                for (auto it1 = pc.services.begin(); it1 != pc.services.end(); ++it1) {
+                    jsrv.set(*it1);
+                }
+            }
+            pc.changes = 0;
+        }
+        for (auto it1 = pc.sections.begin(); it1 != pc.sections.end(); ++it1) {
+            ETIDContext& etc(*it1->second);
+            if (etc.changes != 0) {
+                changed = true;
+                json::Value& jv(root.query(u"tables[]", true));
+                jv.add(u"pid", pc.pid);
+                jv.add(u"tid", etc.etid.tid());
+                if (etc.etid.isLongSection()) {
+                    jv.add(u"tid-ext", etc.etid.tidExt());
+                }
+                if ((etc.changes & CHANGED_NEW) != 0) {
+                    jv.add(u"new", json::Bool(true));
+                }
+                if ((etc.changes & CHANGED_VERSION) != 0) {
+                    jv.add(u"version", etc.last_version);
+                }
+                etc.changes = 0;
+            }
+        }
+    }
+
+    if (changed) {
+        if (!opt.deterministic) {
+            root.add(u"time", _last_utc.format(Time::DATETIME | Time::MILLISECOND));
+        }
+        const std::string line(OneLineJSON(root, rep));
+        if (max_line_size == 0 || line.size() <= max_line_size) {
+            stm << line << std::endl;
+        }
+        else {
+            SplitDelta(root, stm, rep, max_line_size);
+        }
+    }
+    return changed;
+}
+
+
 //----------------------------------------------------------------------------
 // This static method builds a JSON time.
 //----------------------------------------------------------------------------
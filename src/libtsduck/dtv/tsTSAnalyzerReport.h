@@ -138,6 +138,26 @@ namespace ts {
         //!
         void reportJSON(const TSAnalyzerOptions& opt, std::ostream& strm, const UString& title = UString(), Report& rep = NULLREP);
 
+        //!
+        //! This methods displays a delta report as one compact JSON line.
+        //! Only the values which changed since the previous delta report are displayed:
+        //! new services and PID's, bitrates, descriptions, scrambling state, error
+        //! counters, table versions. The first delta report contains all values.
+        //! Nothing is displayed if nothing changed since the previous delta report.
+        //! This is typically used for continuous monitoring, without resetting the analysis.
+        //! Changes are tracked only after the first call to this method.
+        //! @param [in] opt Analysis options.
+        //! @param [in,out] strm Output text stream.
+        //! @param [in,out] rep Where to report errors.
+        //! @param [in] max_line_size If not zero, maximum size in bytes of each JSON line.
+        //! A delta report which is larger than this is split into several JSON lines,
+        //! each one containing the transport stream fields and a subset of the changed
+        //! services, PID's and tables. A single entry larger than this size is still
+        //! displayed on one line.
+        //! @return True if a line was displayed, false if nothing changed.
+        //!
+        bool reportDelta(const TSAnalyzerOptions& opt, std::ostream& strm, Report& rep = NULLREP, size_t max_line_size = 0);
+
     private:
         // Display header of a service PID list.
         void reportServiceHeader(Grid& grid, const UString& usage, bool scrambled, BitRate bitrate, BitRate ts_bitrate, bool wide) const;
@@ -52,7 +52,10 @@ ts::TSScrambling::TSScrambling(Report& report, uint8_t scrambling) :
     _idsa(),
     _aescbc(),
     _aesctr(),
-    _scrambler{nullptr, nullptr}
+    _scrambler{nullptr, nullptr},
+    _batch_pkts(),
+    _batch_data(),
+    _batch_sizes()
 {
     setScramblingType(scrambling);
 }
@@ -72,7 +75,10 @@ ts::TSScrambling::TSScrambling(const TSScrambling& other) :
     _idsa(),
     _aescbc(),
     _aesctr(),
-    _scrambler{nullptr, nullptr}
+    _scrambler{nullptr, nullptr},
+    _batch_pkts(),
+    _batch_data(),
+    _batch_sizes()
 {
     setScramblingType(_scrambling_type);
     _dvbcsa[0].setEntropyMode(other._dvbcsa[0].entropyMode());
@@ -94,7 +100,10 @@ ts::TSScrambling::TSScrambling(TSScrambling&& other) :
     _idsa(),
     _aescbc(),
     _aesctr(),
-    _scrambler{nullptr, nullptr}
+    _scrambler{nullptr, nullptr},
+    _batch_pkts(),
+    _batch_data(),
+    _batch_sizes()
 {
     setScramblingType(_scrambling_type);
     _dvbcsa[0].setEntropyMode(other._dvbcsa[0].entropyMode());
@@ -582,3 +591,182 @@ bool ts::TSScrambling::decrypt(TSPacket& pkt)
     }
     return ok;
 }
+
+
+//----------------------------------------------------------------------------
+// Manage the batch buffers.
+//----------------------------------------------------------------------------
+
+void ts::TSScrambling::clearBatch()
+{
+    _batch_pkts.clear();
+    _batch_data.clear();
+    _batch_sizes.clear();
+}
+
+void ts::TSScrambling::addToBatch(TSPacket& pkt)
+{
+    // Packets without payload are not scrambled but their scrambling control must be updated.
+    _batch_pkts.push_back(&pkt);
+    const size_t psize = pkt.getPayloadSize();
+    if (psize > 0) {
+        _batch_data.push_back(pkt.getPayload());
+        _batch_sizes.push_back(psize);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt all payloads in the batch buffers.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::processBatch(uint8_t scv, bool encrypt, uint8_t new_scv)
+{
+    CipherChaining* algo = _scrambler[scv & 1];
+    assert(algo != nullptr);
+    bool ok = true;
+    size_t done = 0;  // Number of processed payloads.
+
+    if (algo == &_dvbcsa[scv & 1]) {
+        // DVB-CSA2: all payloads at once. On error, no payload is modified.
+        DVBCSA2& csa(_dvbcsa[scv & 1]);
+        ok = encrypt ?
+            csa.encryptBatch(_batch_data.data(), _batch_sizes.data(), _batch_data.size()) :
+            csa.decryptBatch(_batch_data.data(), _batch_sizes.data(), _batch_data.size());
+        done = ok ? _batch_data.size() : 0;
+    }
+    else {
+        // Other algorithms: each payload is a distinct message. Process it out of place
+        // in a work buffer to avoid the intermediate copy of encryptInPlace().
+        // On error, the failed payload is not modified.
+        uint8_t work[PKT_SIZE];
+        const size_t bsize = algo->blockSize();
+        const bool residue = algo->residueAllowed();
+        assert(bsize != 0);
+        for (; ok && done < _batch_data.size(); ++done) {
+            const size_t psize = residue ? _batch_sizes[done] : _batch_sizes[done] - _batch_sizes[done] % bsize;
+            if (psize > 0) {
+                ok = encrypt ?
+                    algo->encrypt(_batch_data[done], psize, work, sizeof(work)) :
+                    algo->decrypt(_batch_data[done], psize, work, sizeof(work));
+                if (!ok) {
+                    break;
+                }
+                ::memcpy(_batch_data[done], work, psize);  // Flawfinder: ignore: memcpy()
+            }
+        }
+    }
+
+    // Mark the processed packets.
+    markBatch(done, ok, new_scv);
+
+    if (!ok) {
+        _report.error(encrypt ? u"packet encryption error using %s" : u"packet decryption error using %s", {algo->name()});
+    }
+    return ok;
+}
+
+void ts::TSScrambling::markBatch(size_t done_payloads, bool all_done, uint8_t new_scv)
+{
+    size_t payload_index = 0;
+    for (auto it = _batch_pkts.begin(); it != _batch_pkts.end(); ++it) {
+        // Same condition as in addToBatch().
+        const bool has_payload = (*it)->getPayloadSize() > 0;
+        if (has_payload ? payload_index++ < done_payloads : all_done) {
+            (*it)->setScrambling(new_scv);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt a group of TS packets with the current parity and corresponding CW.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::encryptBatch(TSPacket* const pkts[], size_t count, bool nullify_on_error)
+{
+    // Collect packets to encrypt. Already encrypted packets are an error but
+    // they do not prevent the encryption of the other packets in the group.
+    // Packets without payload are silently passed.
+    clearBatch();
+    bool scrambled = false;
+    for (size_t i = 0; i < count; ++i) {
+        if (pkts[i]->isScrambled()) {
+            scrambled = true;
+        }
+        else if (pkts[i]->hasPayload()) {
+            addToBatch(*pkts[i]);
+        }
+    }
+    if (scrambled) {
+        _report.error(u"try to scramble an already scrambled packet");
+    }
+
+    bool ok = true;
+    if (!_batch_pkts.empty()) {
+        // If no current parity is set, start with even by default.
+        if (_encrypt_scv == SC_CLEAR) {
+            ok = setEncryptParity(SC_EVEN_KEY);
+        }
+        // Encrypt all payloads at once.
+        if (ok) {
+            assert(_encrypt_scv == SC_EVEN_KEY || _encrypt_scv == SC_ODD_KEY);
+            ok = processBatch(_encrypt_scv, true, _encrypt_scv);
+        }
+    }
+
+    // On error, the packets which were not encrypted are not marked as scrambled.
+    // Their payload is clear, never let them go out.
+    if (!ok && nullify_on_error) {
+        for (auto it = _batch_pkts.begin(); it != _batch_pkts.end(); ++it) {
+            if (!(*it)->isScrambled()) {
+                **it = NullPacket;
+            }
+        }
+    }
+    return ok && !scrambled;
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt a group of TS packets with the CW corresponding to the parity in each packet.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::decryptBatch(TSPacket* const pkts[], size_t count)
+{
+    size_t next = 0;
+    while (next < count) {
+
+        // Clear or invalid packets are silently accepted.
+        const uint8_t scv = pkts[next]->getScrambling();
+        if (scv != SC_EVEN_KEY && scv != SC_ODD_KEY) {
+            next++;
+            continue;
+        }
+
+        // Update current parity. In case of fixed control word, use next key when the scrambling control changes.
+        const uint8_t previous_scv = _decrypt_scv;
+        _decrypt_scv = scv;
+        if (hasFixedCW() && previous_scv != _decrypt_scv && !setNextFixedCW(_decrypt_scv)) {
+            return false;
+        }
+
+        // Collect all packets with the same parity, up to the next parity change.
+        clearBatch();
+        for (; next < count; ++next) {
+            const uint8_t pkt_scv = pkts[next]->getScrambling();
+            if (pkt_scv == scv) {
+                addToBatch(*pkts[next]);
+            }
+            else if (pkt_scv == (scv ^ 1)) {
+                break;
+            }
+        }
+
+        // Decrypt all payloads at once. Decrypted packets are immediately marked as clear.
+        if (!processBatch(scv, false, SC_CLEAR)) {
+            return false;
+        }
+    }
+    return true;
+}
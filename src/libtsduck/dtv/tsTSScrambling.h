@@ -192,6 +192,38 @@ namespace ts {
         //!
         bool decrypt(TSPacket& pkt);
 
+        //!
+        //! Encrypt a group of TS packets with the current parity and corresponding CW.
+        //! The result is identical to encrypt() on each packet, in the same order.
+        //! The scrambling mode and key are selected once for the whole group.
+        //! With DVB-CSA2, the packets are encrypted in parallel using DVBCSA2::encryptBatch().
+        //! With AES-based algorithms (DVB-CISSA, ATIS-IDSA), each payload uses the
+        //! multi-block path of the chaining mode.
+        //! @param [in,out] pkts Array of @a count addresses of TS packets to encrypt.
+        //! @param [in] count Number of packets in @a pkts.
+        //! @param [in] nullify_on_error When true and the encryption fails, the packets which
+        //! could not be encrypted are replaced by null packets. Thus, a scrambler never
+        //! outputs clear payloads by mistake. When false, the packets which were successfully
+        //! encrypted are marked as scrambled and the other ones are left clear.
+        //! @return True on success, false on error. An already encrypted packet is an error
+        //! but it does not prevent the encryption of the other packets, it is left unmodified.
+        //!
+        bool encryptBatch(TSPacket* const pkts[], size_t count, bool nullify_on_error = false);
+
+        //!
+        //! Decrypt a group of TS packets with the CW corresponding to the parity in each packet.
+        //! The result is identical to decrypt() on each packet, in the same order.
+        //! Consecutive packets with the same parity are grouped and processed together,
+        //! as in encryptBatch(). A parity change in the middle of the group switches the
+        //! key, including the next fixed control word, exactly as decrypt() would do.
+        //! @param [in,out] pkts Array of @a count addresses of TS packets to decrypt.
+        //! @param [in] count Number of packets in @a pkts.
+        //! @return True on success, false on error. Clear packets are not an error.
+        //! On error, the packets which were successfully decrypted are marked as clear.
+        //! The other ones are left unmodified, with their scrambling control value.
+        //!
+        bool decryptBatch(TSPacket* const pkts[], size_t count);
+
     private:
         // List of control words
         typedef std::list<ByteBlock> CWList;
@@ -211,6 +243,24 @@ namespace ts {
         CBC<AES>         _aescbc[2];
         CTR<AES>         _aesctr[2];
         CipherChaining*  _scrambler[2];
+        std::vector<TSPacket*> _batch_pkts;   // Batch operations: packets to process.
+        std::vector<uint8_t*>  _batch_data;   // Batch operations: payloads to process.
+        std::vector<size_t>    _batch_sizes;  // Batch operations: payload sizes.
+
+        // Reset the batch buffers.
+        void clearBatch();
+
+        // Add a packet in the batch buffers.
+        void addToBatch(TSPacket& pkt);
+
+        // Encrypt or decrypt all payloads in the batch buffers with the key of the specified parity.
+        // The scrambling control of each packet is set to new_scv when its payload is processed,
+        // so that a packet is never processed twice after an error in the middle of the batch.
+        bool processBatch(uint8_t scv, bool encrypt, uint8_t new_scv);
+
+        // Set the scrambling control of the first packets in the batch buffers, up to the
+        // payload index done_payloads. Packets without payload are updated when all_done is true.
+        void markBatch(size_t done_payloads, bool all_done, uint8_t new_scv);
 
         // Set the next fixed control word as scrambling key.
         bool setNextFixedCW(int parity);
@@ -0,0 +1,309 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTableCache.h"
+#include "tsPSIRepository.h"
+#include "tsDuckContext.h"
+#include "tsGuard.h"
+#include "tsMemory.h"
+TSDUCK_SOURCE;
+
+TS_DEFINE_SINGLETON(ts::TableCache);
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::TableCache::DEFAULT_MAX_ENTRIES;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::TableCache::TableCache() :
+    _mutex(),
+    _max_entries(DEFAULT_MAX_ENTRIES),
+    _entries(),
+    _lru(),
+    _hits(0),
+    _misses(0)
+{
+}
+
+ts::TableCache::Key::Key(const BinaryTable& table) :
+    pid(table.sourcePID()),
+    tid(table.tableId()),
+    tid_ext(table.tableIdExtension()),
+    version(table.version()),
+    crcs()
+{
+    crcs.reserve(table.sectionCount());
+    for (size_t i = 0; i < table.sectionCount(); ++i) {
+        const SectionPtr& sect(table.sectionAt(i));
+        if (sect.isNull() || !sect->isValid()) {
+            crcs.push_back(0);
+        }
+        else if (sect->isLongSection()) {
+            // Use the CRC32 of the section, no need to recompute it.
+            crcs.push_back(GetUInt32(sect->content() + sect->size() - 4));
+        }
+        else {
+            // Short sections have no CRC32, compute one.
+            crcs.push_back(CRC32(sect->content(), sect->size()).value());
+        }
+    }
+}
+
+ts::TableCache::Context::Context() :
+    standards(Standards::NONE),
+    charset(nullptr),
+    pds(0),
+    cas(CASID_NULL)
+{
+}
+
+ts::TableCache::Context::Context(const DuckContext& duck, uint16_t cas_) :
+    standards(duck.standards()),
+    charset(duck.charsetIn()),
+    pds(duck.actualPDS(0)),
+    cas(duck.casId(cas_))
+{
+}
+
+ts::TableCache::Entry::Entry() :
+    table(),
+    context(),
+    renderings(),
+    lru()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Comparison operators.
+//----------------------------------------------------------------------------
+
+bool ts::TableCache::Key::operator<(const Key& other) const
+{
+    if (pid != other.pid) {
+        return pid < other.pid;
+    }
+    else if (tid != other.tid) {
+        return tid < other.tid;
+    }
+    else if (tid_ext != other.tid_ext) {
+        return tid_ext < other.tid_ext;
+    }
+    else if (version != other.version) {
+        return version < other.version;
+    }
+    else {
+        return crcs < other.crcs;
+    }
+}
+
+bool ts::TableCache::Context::operator==(const Context& other) const
+{
+    return standards == other.standards && charset == other.charset && pds == other.pds && cas == other.cas;
+}
+
+
+//----------------------------------------------------------------------------
+// Find an entry and make it the most recently used one.
+//----------------------------------------------------------------------------
+
+ts::TableCache::Entry* ts::TableCache::lookup(const Key& key)
+{
+    const EntryMap::iterator it(_entries.find(key));
+    if (it == _entries.end()) {
+        return nullptr;
+    }
+    _lru.splice(_lru.begin(), _lru, it->second.lru);
+    return &it->second;
+}
+
+
+//----------------------------------------------------------------------------
+// Find or create an entry.
+//----------------------------------------------------------------------------
+
+ts::TableCache::Entry* ts::TableCache::findOrCreate(const Key& key)
+{
+    if (_max_entries == 0) {
+        return nullptr;
+    }
+    Entry* entry = lookup(key);
+    if (entry == nullptr) {
+        // Remove least recently used entries.
+        while (_entries.size() >= _max_entries && !_lru.empty()) {
+            _entries.erase(_lru.back());
+            _lru.pop_back();
+        }
+        // Create the new entry as most recently used one.
+        const EntryMap::iterator it(_entries.insert(std::make_pair(key, Entry())).first);
+        _lru.push_front(key);
+        it->second.lru = _lru.begin();
+        entry = &it->second;
+    }
+    return entry;
+}
+
+
+//----------------------------------------------------------------------------
+// Get a deserialized table from the cache.
+//----------------------------------------------------------------------------
+
+ts::TableCache::TablePtr ts::TableCache::getTable(DuckContext& duck, const BinaryTable& table, uint16_t cas)
+{
+    if (!table.isValid()) {
+        return TablePtr();
+    }
+
+    const Key key(table);
+    const Context ctx(duck, cas);
+
+    // Look in the cache first.
+    {
+        Guard lock(_mutex);
+        Entry* entry = lookup(key);
+        if (entry != nullptr && !entry->table.isNull() && entry->context == ctx) {
+            _hits++;
+            return entry->table;
+        }
+        _misses++;
+    }
+
+    // Deserialize the table outside the mutex.
+    TablePtr result;
+    PSIRepository::TableFactory fac = PSIRepository::Instance()->getTableFactory(table.tableId(), ctx.standards, table.sourcePID(), ctx.cas);
+    if (fac != nullptr) {
+        AbstractTablePtr tp(fac());
+        if (!tp.isNull()) {
+            tp->deserialize(duck, table);
+            if (tp->isValid()) {
+                // Transfer the object from a non-thread-safe pointer to a thread-safe one.
+                result = tp.release();
+            }
+        }
+    }
+
+    // Store the deserialized table.
+    if (!result.isNull()) {
+        Guard lock(_mutex);
+        Entry* entry = findOrCreate(key);
+        if (entry != nullptr) {
+            entry->table = result;
+            entry->context = ctx;
+        }
+    }
+    return result;
+}
+
+
+//----------------------------------------------------------------------------
+// Get or store a rendering of a table.
+//----------------------------------------------------------------------------
+
+bool ts::TableCache::getRendering(const BinaryTable& table, const UString& format, UString& text)
+{
+    if (table.isValid()) {
+        const Key key(table);
+        Guard lock(_mutex);
+        Entry* entry = lookup(key);
+        if (entry != nullptr) {
+            const RenderingMap::const_iterator it(entry->renderings.find(format));
+            if (it != entry->renderings.end()) {
+                _hits++;
+                text = it->second;
+                return true;
+            }
+        }
+        _misses++;
+    }
+    text.clear();
+    return false;
+}
+
+void ts::TableCache::setRendering(const BinaryTable& table, const UString& format, const UString& text)
+{
+    if (table.isValid()) {
+        const Key key(table);
+        Guard lock(_mutex);
+        Entry* entry = findOrCreate(key);
+        if (entry != nullptr) {
+            entry->renderings[format] = text;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Cache management.
+//----------------------------------------------------------------------------
+
+void ts::TableCache::setMaxEntries(size_t max_entries)
+{
+    Guard lock(_mutex);
+    _max_entries = max_entries;
+    while (_entries.size() > _max_entries && !_lru.empty()) {
+        _entries.erase(_lru.back());
+        _lru.pop_back();
+    }
+}
+
+size_t ts::TableCache::maxEntries() const
+{
+    Guard lock(_mutex);
+    return _max_entries;
+}
+
+size_t ts::TableCache::size() const
+{
+    Guard lock(_mutex);
+    return _entries.size();
+}
+
+void ts::TableCache::clear()
+{
+    Guard lock(_mutex);
+    _entries.clear();
+    _lru.clear();
+    _hits = _misses = 0;
+}
+
+uint64_t ts::TableCache::hitCount() const
+{
+    Guard lock(_mutex);
+    return _hits;
+}
+
+uint64_t ts::TableCache::missCount() const
+{
+    Guard lock(_mutex);
+    return _misses;
+}
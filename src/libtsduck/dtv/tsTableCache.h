@@ -0,0 +1,228 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Process-wide cache of deserialized tables.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTable.h"
+#include "tsBinaryTable.h"
+#include "tsSection.h"
+#include "tsDuckContext.h"
+#include "tsSingletonManager.h"
+#include "tsMutex.h"
+
+namespace ts {
+    //!
+    //! Process-wide cache of deserialized tables.
+    //! @ingroup mpeg
+    //!
+    //! Deserializing and formatting a table is expensive. However, signalization consumers
+    //! frequently receive the same table again: after a reset of a demux, when current and
+    //! next tables are both notified, when several demuxes process the same stream, etc.
+    //!
+    //! This cache keeps the most recently used tables, indexed by PID, table id, table id
+    //! extension, version and CRC32 of all sections. It contains the deserialized table,
+    //! shared between all users, and optional renderings of the table (text display for
+    //! instance), each one identified by a "format" string which is chosen by the application
+    //! and which must include all parameters which influence the rendering.
+    //!
+    //! This class is thread-safe. The cached tables are shared and must not be modified.
+    //!
+    class TSDUCKDLL TableCache
+    {
+        TS_DECLARE_SINGLETON(TableCache);
+    public:
+        //!
+        //! Safe pointer to a shared read-only deserialized table (thread-safe).
+        //!
+        typedef SafePtr<const AbstractTable, Mutex> TablePtr;
+
+        //!
+        //! Default maximum number of tables in the cache.
+        //!
+        static constexpr size_t DEFAULT_MAX_ENTRIES = 256;
+
+        //!
+        //! Get a deserialized table from the cache, deserialize and cache it on cache miss.
+        //! @param [in,out] duck TSDuck execution context.
+        //! @param [in] table The binary table.
+        //! @param [in] cas CAS id to use to find the table class (CAS-specific tables).
+        //! @return A safe pointer to the deserialized table. The pointer is null if the
+        //! table class is unknown or the binary table cannot be deserialized.
+        //!
+        TablePtr getTable(DuckContext& duck, const BinaryTable& table, uint16_t cas = CASID_NULL);
+
+        //!
+        //! Get a deserialized table of a known class from the cache.
+        //! If the cached object is not of the expected class (for instance when the table
+        //! class depends on the standards), the binary table is locally deserialized.
+        //! @tparam TABLE A subclass of AbstractTable.
+        //! @param [in,out] duck TSDuck execution context.
+        //! @param [in] table The binary table.
+        //! @param [out] holder A safe pointer which keeps the returned table alive.
+        //! @return The address of the deserialized table or a null pointer if the table is invalid.
+        //!
+        template <class TABLE>
+        const TABLE* getTable(DuckContext& duck, const BinaryTable& table, TablePtr& holder);
+
+        //!
+        //! Get a rendering of a table from the cache.
+        //! @param [in] table The binary table.
+        //! @param [in] format A string identifying the format and all parameters of the rendering.
+        //! @param [out] text The rendering of the table.
+        //! @return True if the rendering was found in the cache, false otherwise.
+        //!
+        bool getRendering(const BinaryTable& table, const UString& format, UString& text);
+
+        //!
+        //! Store a rendering of a table in the cache.
+        //! @param [in] table The binary table.
+        //! @param [in] format A string identifying the format and all parameters of the rendering.
+        //! @param [in] text The rendering of the table.
+        //!
+        void setRendering(const BinaryTable& table, const UString& format, const UString& text);
+
+        //!
+        //! Set the maximum number of tables in the cache.
+        //! @param [in] max_entries Maximum number of tables. Zero disables the cache.
+        //!
+        void setMaxEntries(size_t max_entries);
+
+        //!
+        //! Get the maximum number of tables in the cache.
+        //! @return The maximum number of tables in the cache.
+        //!
+        size_t maxEntries() const;
+
+        //!
+        //! Get the current number of tables in the cache.
+        //! @return The current number of tables in the cache.
+        //!
+        size_t size() const;
+
+        //!
+        //! Remove all tables from the cache and reset statistics.
+        //!
+        void clear();
+
+        //!
+        //! Get the number of successful lookups (deserialized tables or renderings).
+        //! @return The number of successful lookups since the last clear().
+        //!
+        uint64_t hitCount() const;
+
+        //!
+        //! Get the number of failed lookups (deserialized tables or renderings).
+        //! @return The number of failed lookups since the last clear().
+        //!
+        uint64_t missCount() const;
+
+    private:
+        // Identification of a binary table.
+        class Key
+        {
+        public:
+            PID      pid;
+            TID      tid;
+            uint16_t tid_ext;
+            uint8_t  version;
+            std::vector<uint32_t> crcs;  // One CRC32 per section.
+
+            Key(const BinaryTable& table);
+            bool operator<(const Key& other) const;
+        };
+
+        // Context which was used to deserialize a table.
+        // The same binary table may give different results in different contexts.
+        class Context
+        {
+        public:
+            Standards      standards;
+            const Charset* charset;
+            PDS            pds;
+            uint16_t       cas;
+
+            Context();
+            Context(const DuckContext& duck, uint16_t cas);
+            bool operator==(const Context& other) const;
+        };
+
+        typedef std::list<Key> KeyList;
+        typedef std::map<UString, UString> RenderingMap;
+
+        // Cache entry.
+        class Entry
+        {
+        public:
+            TablePtr          table;       // Deserialized table, can be null.
+            Context           context;     // Deserialization context of table.
+            RenderingMap      renderings;  // Renderings, indexed by format.
+            KeyList::iterator lru;         // Position in LRU list.
+
+            Entry();
+        };
+
+        typedef std::map<Key, Entry> EntryMap;
+
+        mutable Mutex _mutex;
+        size_t        _max_entries;
+        EntryMap      _entries;
+        KeyList       _lru;         // Most recently used first.
+        uint64_t      _hits;
+        uint64_t      _misses;
+
+        // Find an entry and make it the most recently used one. Must be called under the mutex.
+        Entry* lookup(const Key& key);
+
+        // Find or create an entry. Must be called under the mutex. Return null if the cache is disabled.
+        Entry* findOrCreate(const Key& key);
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Template definitions.
+//----------------------------------------------------------------------------
+
+template <class TABLE>
+const TABLE* ts::TableCache::getTable(DuckContext& duck, const BinaryTable& table, TablePtr& holder)
+{
+    holder = getTable(duck, table);
+    const TABLE* result = dynamic_cast<const TABLE*>(holder.pointer());
+    if (result == nullptr && table.isValid()) {
+        // Not in cache or not the expected class, deserialize it here.
+        TABLE* obj = new TABLE(duck, table);
+        holder = obj;
+        result = obj;
+    }
+    return result != nullptr && result->isValid() ? result : nullptr;
+}
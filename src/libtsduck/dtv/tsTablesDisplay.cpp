@@ -37,6 +37,7 @@
 #include "tsATSCMultipleString.h"
 #include "tsNames.h"
 #include "tsIntegerUtils.h"
+#include "tsTableCache.h"
 TSDUCK_SOURCE;
 
 
@@ -49,7 +50,9 @@ ts::TablesDisplay::TablesDisplay(DuckContext& d) :
     _raw_dump(false),
     _raw_flags(UString::HEXA),
     _tlv_syntax(),
-    _min_nested_tlv(0)
+    _min_nested_tlv(0),
+    _use_cache(false),
+    _out(nullptr)
 {
 }
 
@@ -140,7 +143,7 @@ void ts::TablesDisplay::displayExtraData(PSIBuffer& buf, const UString& margin)
 
 void ts::TablesDisplay::displayExtraData(const void* data, size_t size, const UString& margin)
 {
-    std::ostream& strm(_duck.out());
+    std::ostream& strm(out());
     if (size > 0) {
         strm << margin << "Extraneous " << size << " bytes:" << std::endl;
         strm << UString::Dump(data, size, UString::HEXA | UString::ASCII | UString::OFFSET, margin.size());
@@ -154,7 +157,7 @@ void ts::TablesDisplay::displayExtraData(const void* data, size_t size, const US
 
 void ts::TablesDisplay::displayPrivateData(const UString& title, const void* data, size_t size, const UString& margin, size_t single_line_max)
 {
-    std::ostream& strm(_duck.out());
+    std::ostream& strm(out());
 
     if (size > single_line_max) {
         strm << margin << title << " (" << size << " bytes):" << std::endl;
@@ -208,11 +211,11 @@ void ts::TablesDisplay::displayIntAndASCII(const UString& format, PSIBuffer& buf
     }
 
     // Now display the data.
-    _duck.out() << margin << UString::Format(format, {buf.getBits<uint64_t>(8 * size)});
+    out() << margin << UString::Format(format, {buf.getBits<uint64_t>(8 * size)});
     if (!ascii.empty()) {
-        _duck.out() << " (\"" << ascii << "\")";
+        out() << " (\"" << ascii << "\")";
     }
-    _duck.out() << std::endl;
+    out() << std::endl;
 }
 
 
@@ -222,13 +225,42 @@ void ts::TablesDisplay::displayIntAndASCII(const UString& format, PSIBuffer& buf
 
 void ts::TablesDisplay::displayTable(const BinaryTable& table, const UString& margin, uint16_t cas)
 {
-    std::ostream& strm(_duck.out());
-
     // Filter invalid tables
     if (!table.isValid()) {
         return;
     }
 
+    // The TLV syntax options cannot be represented in the cache format, don't use the cache.
+    if (!_use_cache || !_tlv_syntax.empty()) {
+        displayTableNoCache(table, margin, cas);
+        return;
+    }
+
+    // The cache format shall include all parameters which influence the display.
+    const Charset* const charset = _duck.charsetIn();
+    const UString format(UString::Format(u"display:%d:%X:%d:%X:%X:%X:%s:%s",
+                                         {_raw_dump, _raw_flags, _min_nested_tlv, _duck.casId(cas), uint32_t(_duck.standards()),
+                                          _duck.actualPDS(0), charset == nullptr ? UString() : charset->name(), margin}));
+
+    // On cache miss, format the table in a string and store it in the cache.
+    TableCache* const cache = TableCache::Instance();
+    UString text;
+    if (!cache->getRendering(table, format, text)) {
+        std::ostringstream strm;
+        std::ostream* const previous = _out;
+        _out = &strm;
+        displayTableNoCache(table, margin, cas);
+        _out = previous;
+        text.assignFromUTF8(strm.str());
+        cache->setRendering(table, format, text);
+    }
+    out() << text;
+}
+
+void ts::TablesDisplay::displayTableNoCache(const BinaryTable& table, const UString& margin, uint16_t cas)
+{
+    std::ostream& strm(out());
+
     // Display hexa dump of each section in the table
     if (_raw_dump) {
         for (size_t i = 0; i < table.sectionCount(); ++i) {
@@ -281,7 +313,7 @@ void ts::TablesDisplay::displayTable(const BinaryTable& table, const UString& ma
 
 void ts::TablesDisplay::displaySection(const Section& section, const UString& margin, uint16_t cas, bool no_header)
 {
-    std::ostream& strm(_duck.out());
+    std::ostream& strm(out());
 
     // Filter invalid section
     if (!section.isValid()) {
@@ -365,7 +397,7 @@ void ts::TablesDisplay::logSectionData(const Section& section, const UString& he
     }
 
     // Output exactly one line.
-    std::ostream& strm(_duck.out());
+    std::ostream& strm(out());
     strm << header << handler(section, max_bytes) << std::endl;
 }
 
@@ -393,7 +425,7 @@ ts::UString ts::TablesDisplay::LogUnknownSectionData(const Section& section, siz
 
 void ts::TablesDisplay::displayUnkownDescriptor(DID did, const uint8_t * payload, size_t size, const UString& margin, TID tid, PDS pds)
 {
-    _duck.out() << UString::Dump(payload, size, UString::HEXA | UString::ASCII | UString::OFFSET, margin.size());
+    out() << UString::Dump(payload, size, UString::HEXA | UString::ASCII | UString::OFFSET, margin.size());
 }
 
 
@@ -403,7 +435,7 @@ void ts::TablesDisplay::displayUnkownDescriptor(DID did, const uint8_t * payload
 
 void ts::TablesDisplay::displayUnkownSectionData(const ts::Section& section, const UString& margin)
 {
-    std::ostream& strm(_duck.out());
+    std::ostream& strm(out());
 
     // The table id extension was not yet displayed since it depends on the table id.
     if (section.isLongSection()) {
@@ -460,7 +492,7 @@ void ts::TablesDisplay::displayTLV(const uint8_t* data,
                                    size_t innerIndent,
                                    const TLVSyntax& tlv)
 {
-    std::ostream& strm(_duck.out());
+    std::ostream& strm(out());
 
     // We use the same syntax for the optional embedded TLV, except that it is automatically located.
     TLVSyntax tlvInner(tlv);
@@ -558,14 +590,14 @@ void ts::TablesDisplay::displayDescriptorList(const Section& section,
     }
     else if (!buf.error()) {
         if (!title.empty() && (length > 0 || !empty_text.empty())) {
-            _duck.out() << margin << title << std::endl;
+            out() << margin << title << std::endl;
         }
         if (length > 0) {
             displayDescriptorList(section, buf.currentReadAddress(), length, margin, cas);
             buf.skipBytes(length);
         }
         else if (!empty_text.empty()) {
-            _duck.out() << margin << "- " << empty_text << std::endl;
+            out() << margin << "- " << empty_text << std::endl;
         }
     }
 }
@@ -594,7 +626,7 @@ void ts::TablesDisplay::displayDescriptorListWithLength(const Section& section,
 
 void ts::TablesDisplay::displayDescriptorList(const Section& section, const void* data, size_t size, const UString& margin, uint16_t cas)
 {
-    std::ostream& strm(_duck.out());
+    std::ostream& strm(out());
     const uint8_t* desc_start = reinterpret_cast<const uint8_t*>(data);
     size_t desc_index = 0;
     const TID tid = section.tableId();
@@ -650,7 +682,7 @@ void ts::TablesDisplay::displayDescriptorList(const Section& section, const void
 
 void ts::TablesDisplay::displayDescriptorList(const DescriptorList& list, const UString& margin, uint16_t cas)
 {
-    std::ostream& strm(_duck.out());
+    std::ostream& strm(out());
     const TID tid = list.tableId();
 
     for (size_t i = 0; i < list.count(); ++i) {
@@ -672,7 +704,7 @@ void ts::TablesDisplay::displayDescriptorList(const DescriptorList& list, const
 
 void ts::TablesDisplay::displayDescriptorData(DID did, const uint8_t* payload, size_t size, const UString& margin, TID tid, PDS pds, uint16_t cas)
 {
-    std::ostream& strm(_duck.out());
+    std::ostream& strm(out());
 
     // Compute extended descriptor id.
     EDID edid;
@@ -720,7 +752,7 @@ void ts::TablesDisplay::displayDescriptorData(DID did, const uint8_t* payload, s
 
 void ts::TablesDisplay::displayCRC32(const Section& section, const UString& margin)
 {
-    std::ostream& strm(_duck.out());
+    std::ostream& strm(out());
     const uint32_t sect_crc32 = GetUInt32(section.content() + section.size() - 4);
     const CRC32 comp_crc32(section.content(), section.size() - 4);
 
@@ -83,7 +83,15 @@ namespace ts {
         //! Get the output stream.
         //! @return A reference to the output stream.
         //!
-        std::ostream& out() { return _duck.out(); }
+        std::ostream& out() { return _out != nullptr ? *_out : _duck.out(); }
+
+        //!
+        //! Enable or disable the use of the process-wide TableCache in displayTable().
+        //! When enabled, the text display of a table is formatted only once and reused when
+        //! the same table is displayed again with the same options.
+        //! @param [in] on True to use the table cache, false to always format tables.
+        //!
+        void setUseTableCache(bool on) { _use_cache = on; }
 
         //!
         //! Output stream operator to use a TablesDisplay instance directly as an output stream.
@@ -93,7 +101,7 @@ namespace ts {
         //! @see out()
         //!
         template <typename T>
-        std::ostream& operator<<(const T& expression) { return _duck.out() << expression; }
+        std::ostream& operator<<(const T& expression) { return out() << expression; }
 
         //!
         //! Output stream operator to use a TablesDisplay instance directly as an output stream.
@@ -104,7 +112,7 @@ namespace ts {
         // Implementation note: For some reason which is not identified, the template operator <<
         // above is not resolved on I/O manipulator parameters. So we need this explicit one.
         //
-        std::ostream& operator<<(std::ostream& (*manip)(std::ostream&)) { return _duck.out() << manip; }
+        std::ostream& operator<<(std::ostream& (*manip)(std::ostream&)) { return out() << manip; }
 
         //!
         //! Display a table on the output stream.
@@ -361,5 +369,10 @@ namespace ts {
         uint32_t        _raw_flags;       // Dump flags in raw mode.
         TLVSyntaxVector _tlv_syntax;      // TLV syntax to apply to unknown sections.
         size_t          _min_nested_tlv;  // Minimum size of a TLV record after which it is interpreted as a nested TLV (0=disabled).
+        bool            _use_cache;       // Use the table cache in displayTable().
+        std::ostream*   _out;             // Temporary output redirection, when not null.
+
+        // Display a table, without using the table cache.
+        void displayTableNoCache(const BinaryTable& table, const UString& margin, uint16_t cas);
     };
 }
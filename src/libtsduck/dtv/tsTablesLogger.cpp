@@ -30,6 +30,7 @@
 #include "tsTablesLogger.h"
 #include "tsTablesLoggerFilterRepository.h"
 #include "tsBinaryTable.h"
+#include "tsTableCache.h"
 #include "tsPAT.h"
 #include "tstlv.h"
 #include "tsTime.h"
@@ -102,6 +103,9 @@ ts::TablesLogger::TablesLogger(TablesDisplay& display) :
     _sectionsOnce(),
     _section_filters()
 {
+    // Tables which are repeatedly logged are formatted only once.
+    _display.setUseTableCache(true);
+
     // Create an instance of each registered section filter.
     TablesLoggerFilterRepository::Instance()->createFilters(_section_filters);
     _report.debug(u"TablesLogger has %s section filters", {_section_filters.size()});
@@ -889,8 +893,11 @@ bool ts::TablesLogger::createXML(const ts::UString& name)
 
 void ts::TablesLogger::saveXML(const ts::BinaryTable& table)
 {
-    // Convert the table into an XML structure.
-    xml::Element* elem = table.toXML(_duck, _xmlDoc.rootElement(), false);
+    // Convert the table into an XML structure. Reuse the deserialized table from the
+    // table cache when the same table was already processed. Unknown tables use a
+    // generic XML structure.
+    const TableCache::TablePtr tp(TableCache::Instance()->getTable(_duck, table));
+    xml::Element* elem = tp.isNull() ? table.toXML(_duck, _xmlDoc.rootElement(), false) : tp->toXML(_duck, _xmlDoc.rootElement());
     if (elem == nullptr) {
         // XML conversion error, message already displayed.
         return;
@@ -29,6 +29,7 @@
 
 #include "tsTimeShiftBuffer.h"
 #include "tsNullReport.h"
+#include "tsReportBuffer.h"
 #include "tsSysUtils.h"
 TSDUCK_SOURCE;
 
@@ -49,7 +50,9 @@ ts::TimeShiftBuffer::TimeShiftBuffer(size_t count) :
     _cur_packets(0),
     _total_packets(std::max(count, MIN_TOTAL_PACKETS)),
     _mem_packets(DEFAULT_MEMORY_PACKETS),
+    _use_mmap(true),
     _directory(),
+    _ring(),
     _file(),
     _next_read(0),
     _next_write(0),
@@ -95,6 +98,17 @@ bool ts::TimeShiftBuffer::setMemoryPackets(size_t count)
     }
 }
 
+bool ts::TimeShiftBuffer::setMemoryMapped(bool on)
+{
+    if (_is_open) {
+        return false;
+    }
+    else {
+        _use_mmap = on;
+        return true;
+    }
+}
+
 bool ts::TimeShiftBuffer::setBackupDirectory(const UString& directory)
 {
     if (_is_open) {
@@ -139,19 +153,36 @@ bool ts::TimeShiftBuffer::open(Report& report)
             }
         }
 
-        // Create the backup file. The flag temporary means that it will be deleted on close.
-        // Use TSDuck proprietary format to save the packet metadata.
-        if (!_file.open(filename, TSFile::READ | TSFile::WRITE | TSFile::TEMPORARY, report, TSPacketFormat::DUCK)) {
-            return false;
+        // Preferably map the backup file in memory. The memory quota is shared
+        // between the windows which are read ahead, written back and in use.
+        // A mapping failure is not an error since we fall back to plain file access.
+        ReportBuffer<NullMutex> map_errors(report.maxSeverity());
+        if (_use_mmap && !_ring.open(filename, _total_packets, _mem_packets / (MappedPacketRing::READ_AHEAD_WINDOWS + 2), map_errors)) {
+            report.verbose(u"cannot map time-shift file, using plain file access: %s", {map_errors.getMessages()});
+        }
+
+        if (_ring.isOpen()) {
+            // No memory cache.
+            _wcache.clear();
+            _wmdata.clear();
+            _rcache.clear();
+            _rmdata.clear();
         }
+        else {
+            // Create the backup file. The flag temporary means that it will be deleted on close.
+            // Use TSDuck proprietary format to save the packet metadata.
+            if (!_file.open(filename, TSFile::READ | TSFile::WRITE | TSFile::TEMPORARY, report, TSPacketFormat::DUCK)) {
+                return false;
+            }
 
-        // The read and write buffers use half of memory quota each.
-        // Since the size of the file is larger than the sum of the two,
-        // the read and write caches never overlap when the buffer is full.
-        _wcache.resize(_mem_packets / 2);
-        _wmdata.resize(_mem_packets / 2);
-        _rcache.resize(_mem_packets / 2);
-        _rmdata.resize(_mem_packets / 2);
+            // The read and write buffers use half of memory quota each.
+            // Since the size of the file is larger than the sum of the two,
+            // the read and write caches never overlap when the buffer is full.
+            _wcache.resize(_mem_packets / 2);
+            _wmdata.resize(_mem_packets / 2);
+            _rcache.resize(_mem_packets / 2);
+            _rmdata.resize(_mem_packets / 2);
+        }
     }
 
     _cur_packets = 0;
@@ -178,6 +209,9 @@ bool ts::TimeShiftBuffer::close(Report& report)
     _wmdata.clear();
     _rcache.clear();
     _rmdata.clear();
+    if (_ring.isOpen()) {
+        return _ring.close(report);
+    }
     return !_file.isOpen() || _file.close(report);
 }
 
@@ -218,6 +252,20 @@ bool ts::TimeShiftBuffer::shift(TSPacket& packet, TSPacketMetadata& mdata, Repor
         _wmdata[_next_write] = mdata;
         _next_write = (_next_write + 1) % _wcache.size();
     }
+    else if (_ring.isOpen()) {
+        // The buffer uses a memory-mapped file, accessed the same way as memory.
+        if (was_full) {
+            // Buffer full: return oldest packet.
+            _ring.read(_next_read, ret_packet, ret_mdata);
+            _next_read = (_next_read + 1) % _total_packets;
+        }
+        else {
+            // Buffer not full, increase the packet count.
+            _cur_packets++;
+        }
+        _ring.write(_next_write, packet, mdata);
+        _next_write = (_next_write + 1) % _total_packets;
+    }
     else {
         // The buffer uses a backup file.
         if (!was_full) {
@@ -36,6 +36,7 @@
 #include "tsUString.h"
 #include "tsTSFile.h"
 #include "tsTSPacketMetadata.h"
+#include "tsMappedPacketRing.h"
 #include "tsReport.h"
 
 namespace ts {
@@ -45,6 +46,8 @@ namespace ts {
     //!
     //! A TS packet buffer for time shift.
     //! The buffer is partly implemented in virtual memory and partly on disk.
+    //! The disk part is either a memory-mapped file, accessed with background
+    //! read-ahead and writeback, or a plain file with read and write caches.
     //! @ingroup mpeg
     //!
     class TSDUCKDLL TimeShiftBuffer
@@ -89,6 +92,8 @@ namespace ts {
 
         //!
         //! Set the maximum number of cached packets to be held in memory.
+        //! With a memory-mapped backup file, this is the approximate number of
+        //! packets in the windows which are read ahead and written back.
         //! Must be called before open().
         //! @param [in] count Max number of cached packets in memory.
         //! @return True on success, false if already open.
@@ -107,6 +112,16 @@ namespace ts {
         //!
         bool setBackupDirectory(const UString& directory);
 
+        //!
+        //! Use a memory-mapped backup file, when possible.
+        //! Must be called before open().
+        //! This is the default. When the file cannot be mapped (for instance when
+        //! the buffer is too large for the virtual address space), a plain file is used.
+        //! @param [in] on If false, always use a plain file.
+        //! @return True on success, false if already open.
+        //!
+        bool setMemoryMapped(bool on);
+
         //!
         //! Open the buffer.
         //! @param [in,out] report Where to report errors.
@@ -158,6 +173,12 @@ namespace ts {
         //!
         bool memoryResident() const { return _total_packets <= _mem_packets; }
 
+        //!
+        //! Check if the buffer is backed up by a memory-mapped file.
+        //! @return True when the buffer is open and backed up by a memory-mapped file.
+        //!
+        bool memoryMapped() const { return _ring.isOpen(); }
+
         //!
         //! Push a packet in the time-shift buffer and pull the oldest one.
         //!
@@ -180,8 +201,10 @@ namespace ts {
         size_t  _cur_packets;            // Current number of packets in the buffer.
         size_t  _total_packets;          // Total capacity of the buffer.
         size_t  _mem_packets;            // Max packets in memory.
+        bool    _use_mmap;               // Try to use a memory-mapped file.
         UString _directory;              // Where to store the backup file.
-        TSFile  _file;                   // Backup file on disk.
+        MappedPacketRing _ring;          // Memory-mapped backup file.
+        TSFile  _file;                   // Backup file on disk, when not memory-mapped.
         size_t  _next_read;              // Index in buffer of next packet to read.
         size_t  _next_write;             // Index in buffer of next packet to write.
         size_t  _wcache_next;            // Next index to write in _wcache (up to end of _wcache).
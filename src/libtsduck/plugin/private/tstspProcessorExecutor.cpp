@@ -124,9 +124,22 @@ void ts::tsp::ProcessorExecutor::main()
         // Now process the packets.
         size_t pkt_done = 0;
         size_t pkt_flush = 0;
+        size_t pkt_prepared = 0;
 
         while (pkt_done < pkt_cnt && !aborted) {
 
+            // Let the plugin prepare the next window of packets, up to the next periodic flush.
+            if (pkt_done == pkt_prepared) {
+                size_t window = pkt_cnt - pkt_done;
+                if (_options.max_flush_pkt > 0) {
+                    window = std::min(window, _options.max_flush_pkt);
+                }
+                if (!_suspended && only_labels.none()) {
+                    _processor->preparePackets(_buffer->base() + pkt_first + pkt_done, _metadata->base() + pkt_first + pkt_done, window);
+                }
+                pkt_prepared += window;
+            }
+
             TSPacket* const pkt = _buffer->base() + pkt_first + pkt_done;
             TSPacketMetadata* const pkt_data = _metadata->base() + pkt_first + pkt_done;
 
@@ -204,6 +217,16 @@ void ts::tsp::ProcessorExecutor::main()
             // too long before two output operations.
 
             if (pkt_data->getFlush() || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush % _options.max_flush_pkt == 0)) {
+                // Let the plugin complete the deferred processing on the packets to pass.
+                // It may end the processing on any of them, like with TSP_END.
+                const size_t pkt_first_flush = pkt_first + pkt_done - pkt_flush;
+                const size_t pkt_valid = _processor->completePackets(_buffer->base() + pkt_first_flush, _metadata->base() + pkt_first_flush, pkt_flush);
+                if (pkt_valid < pkt_flush) {
+                    input_end = aborted = true;
+                    pkt_done -= pkt_flush - pkt_valid;
+                    pkt_flush = pkt_valid;
+                    pkt_cnt = pkt_done;
+                }
                 aborted = !passPackets(pkt_flush, output_bitrate, pkt_done == pkt_cnt && input_end, aborted);
                 pkt_flush = 0;
             }
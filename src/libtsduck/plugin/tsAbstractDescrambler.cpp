@@ -28,13 +28,16 @@
 //----------------------------------------------------------------------------
 
 #include "tsAbstractDescrambler.h"
-#include "tsGuardCondition.h"
+#include "tsGuard.h"
 #include "tsNames.h"
 TSDUCK_SOURCE;
 
 // Stack usage required by this module in the ECM deciphering thread.
 #define ECM_THREAD_STACK_OVERHEAD (16  * 1024)
 
+// Maximum number of ECM's waiting to be deciphered.
+#define ECM_QUEUE_SIZE 32
+
 
 //----------------------------------------------------------------------------
 // Constructor
@@ -49,15 +52,15 @@ ts::AbstractDescrambler::AbstractDescrambler(TSP* tsp_, const UString& descripti
     _swap_cw(false),
     _scrambling(*tsp),
     _pids(),
+    _batch(),
     _service(duck, this),
     _stack_usage(stack_usage),
     _demux(duck, nullptr, this),
     _ecm_streams(),
     _scrambled_streams(),
     _mutex(),
-    _ecm_to_do(),
-    _ecm_thread(this),
-    _stop_thread(false)
+    _ecm_queue(ECM_QUEUE_SIZE),
+    _ecm_thread(this)
 {
     // We need to define character sets to specify service names.
     duck.defineArgsForCharset(*this);
@@ -152,14 +155,23 @@ ts::AbstractDescrambler::ECMStream::ECMStream(AbstractDescrambler* parent) :
     cw_valid(false),
     new_cw_even(false),
     new_cw_odd(false),
-    new_ecm(false),
-    ecm(),
     cw_even(),
     cw_odd()
 {
 }
 
 
+//----------------------------------------------------------------------------
+// An ECM to decipher in the ECM deciphering thread.
+//----------------------------------------------------------------------------
+
+ts::AbstractDescrambler::ECMRequest::ECMRequest(const ECMStreamPtr& stream_, const Section& section) :
+    stream(stream_),
+    ecm(section, ShareMode::COPY)
+{
+}
+
+
 //----------------------------------------------------------------------------
 // Get the ECM stream for a PID, create it if non existent
 //----------------------------------------------------------------------------
@@ -197,7 +209,7 @@ bool ts::AbstractDescrambler::start()
 
     // In asynchronous mode, create a thread for ECM processing
     if (_need_ecm && !_synchronous) {
-        _stop_thread = false;
+        _ecm_queue.clear();
         ThreadAttributes attr;
         _ecm_thread.getAttributes(attr);
         attr.setStackSize(ECM_THREAD_STACK_OVERHEAD + _stack_usage);
@@ -216,13 +228,9 @@ bool ts::AbstractDescrambler::start()
 bool ts::AbstractDescrambler::stop()
 {
     // In asynchronous mode, notify the ECM processing thread to terminate
-    // and wait for its actual termination.
+    // and wait for its actual termination. A null request terminates the thread.
     if (_need_ecm && !_synchronous) {
-        {
-            GuardCondition lock(_mutex, _ecm_to_do);
-            _stop_thread = true;
-            lock.signal();
-        }
+        _ecm_queue.forceEnqueue(static_cast<ECMRequest*>(nullptr));
         _ecm_thread.waitForTermination();
     }
 
@@ -362,49 +370,31 @@ void ts::AbstractDescrambler::handleSection(SectionDemux& demux, const Section&
     }
     tsp->debug(u"new ECM (TID 0x%X) on PID %d (0x%X)", {sect.tableId(), ecm_pid, ecm_pid});
 
-    // In asynchronous mode, the CW are accessed under mutex protection.
-    if (!_synchronous) {
-        _mutex.acquire();
-    }
-
-    // Copy the ECM into the PID context.
-    estream->ecm.copy(sect);
-    estream->new_ecm = true;
-
     // Decipher the ECM.
     if (_synchronous) {
         // Synchronous mode: directly decipher the ECM
-        processECM(*estream);
+        processECM(*estream, sect);
     }
-    else {
-        // Asynchronous mode: signal the ECM to the ECM processing thread.
-        _ecm_to_do.signal();
-        _mutex.release();
+    else if (!_ecm_queue.enqueue(new ECMRequest(estream, sect), 0)) {
+        // Asynchronous mode: pass a copy of the ECM to the ECM processing thread, never wait.
+        tsp->warning(u"too many pending ECM's, dropping ECM on PID %d (0x%X)", {ecm_pid, ecm_pid});
+        // Forget the dropped ECM, process its next repetition.
+        estream->last_tid = TID_NULL;
     }
 }
 
 
 //----------------------------------------------------------------------------
-// Process one ECM (the one in ECMStream::ecm).
-// In asynchronous mode, this method must be invoked with the mutex held.
-// Release the mutex while deciphering the ECM and relock it before exiting.
+// Process one ECM.
+// In asynchronous mode, this method is invoked in the ECM deciphering thread.
 //----------------------------------------------------------------------------
 
-void ts::AbstractDescrambler::processECM(ECMStream& estream)
+void ts::AbstractDescrambler::processECM(ECMStream& estream, const Section& ecm)
 {
-    // Copy the ECM out of the protected area into local data
-    Section ecm(estream.ecm, ShareMode::COPY);
-    estream.new_ecm = false;
-
     // Local data for deciphered CW's from ECM.
     CWData cw_even(estream.scrambling.scramblingType());
     CWData cw_odd(estream.scrambling.scramblingType());
 
-    // In asynchronous mode, release the mutex.
-    if (!_synchronous) {
-        _mutex.release();
-    }
-
     // Here, we have an ECM to decipher.
     const size_t dumpSize = std::min<size_t>(8, ecm.payloadSize());
     tsp->debug(u"packet %d, decipher ECM, %d bytes: %s%s", {
@@ -422,7 +412,7 @@ void ts::AbstractDescrambler::processECM(ECMStream& estream)
         tsp->debug(u"odd CW:  %s", {UString::Dump(cw_odd.cw, UString::SINGLE_LINE)});
     }
 
-    // In asynchronous mode, relock the mutex.
+    // In asynchronous mode, the CW are accessed under mutex protection.
     if (!_synchronous) {
         _mutex.acquire();
     }
@@ -444,6 +434,10 @@ void ts::AbstractDescrambler::processECM(ECMStream& estream)
         }
         estream.cw_valid = ok;
     }
+
+    if (!_synchronous) {
+        _mutex.release();
+    }
 }
 
 
@@ -455,59 +449,48 @@ void ts::AbstractDescrambler::ECMThread::main()
 {
     _parent->tsp->debug(u"ECM processing thread started");
 
-    // ECM processing loop.
-    // The loop executes with the mutex held. The mutex is released
-    // while deciphering an ECM and while waiting for the condition
-    // variable 'ecm_to_do'.
-    GuardCondition lock(_parent->_mutex, _parent->_ecm_to_do);
-
+    // ECM processing loop, until a null request is received.
     for (;;) {
-
-        // Look for an ECM to decipher. Loop as long as ECM's are
-        // found (or a terminate request is encountered). We loop
-        // again if at least an ECM was found since the mutex was
-        // released during the ECM processing and a new ECM may
-        // have been added at the beginning of the list.
-
-        bool got_ecm = false;
-        bool terminate = false;
-
-        do {
-            got_ecm = false;
-            terminate = _parent->_stop_thread;
-
-            // Decipher ECM's on all ECM PID's.
-            for (ECMStreamMap::iterator it = _parent->_ecm_streams.begin(); !terminate && it != _parent->_ecm_streams.end(); ++it) {
-                ECMStreamPtr& estream(it->second);
-                if (estream->new_ecm) {
-                    // Found an ECM, decipher it. Note that the mutex is
-                    // released while deciphering the ECM.
-                    got_ecm = true;
-                    _parent->processECM(*estream);
-
-                    // Look for termination request while deciphering
-                    terminate = _parent->_stop_thread;
-                }
-            }
-        } while (!terminate && got_ecm);
-
-        // Check if a terminate request is found
-        if (terminate) {
+        ECMQueue::MessagePtr request;
+        _parent->_ecm_queue.dequeue(request);
+        if (request.isNull()) {
             break;
         }
-
-        // We have accomplished a full scan of all ECM PID's and found no ECM.
-        // The mutex was consequently not released during the loop and we are
-        // now sure that there is nothing to do. The mutex is implicitely
-        // released and we wait for the condition 'ecm_to_do' and, once we
-        // get it, implicitely relock the mutex.
-        lock.waitCondition();
+        _parent->processECM(*request->stream, request->ecm);
     }
 
     _parent->tsp->debug(u"ECM processing thread terminated");
 }
 
 
+//----------------------------------------------------------------------------
+// Prepare a window of packets, descramble them in parallel when possible.
+//----------------------------------------------------------------------------
+
+void ts::AbstractDescrambler::preparePackets(TSPacket* pkts, TSPacketMetadata*, size_t count)
+{
+    // Only fixed control words can be applied in advance on a window of packets. With ECM's,
+    // the control words may change in the middle of the window. In a service without explicit
+    // scrambling type, the type may be changed by a PMT in the middle of the window.
+    if (_pids.any() || (!_need_ecm && _scrambling.explicitScramblingType())) {
+        _batch.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (pkts[i].b[0] == SYNC_BYTE && (_pids.none() || _pids.test(pkts[i].getPID()))) {
+                _batch.push_back(&pkts[i]);
+            }
+        }
+        // Descrambled packets are marked as clear, as soon as they are decrypted. In case of
+        // error, the packets which were not decrypted keep their scrambling control value.
+        // They are decrypted one by one in processPacket() where the error is reported
+        // and stops the processing, as without window of packets. The error is already
+        // logged by decryptBatch(), there is nothing else to do here.
+        if (!_scrambling.decryptBatch(_batch.data(), _batch.size())) {
+            tsp->debug(u"window descrambling failed, remaining packets are descrambled one by one");
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processing method
 //----------------------------------------------------------------------------
@@ -38,7 +38,7 @@
 #include "tsSection.h"
 #include "tsServiceDiscovery.h"
 #include "tsTSScrambling.h"
-#include "tsCondition.h"
+#include "tsLockFreeMessageQueue.h"
 #include "tsMutex.h"
 #include "tsThread.h"
 #include "tsMemory.h"
@@ -62,6 +62,7 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual void preparePackets(TSPacket*, TSPacketMetadata*, size_t) override;
 
     protected:
         //!
@@ -222,16 +223,30 @@ namespace ts {
             volatile bool new_cw_even;  // New CW available (even)
             volatile bool new_cw_odd;   // New CW available (odd)
             // -- start of protected area --
-            bool          new_ecm;      // New ECM available
-            Section       ecm;          // Last received ECM
             CWData        cw_even;      // Last valid CW (even)
             CWData        cw_odd;       // Last valid CW (odd)
             // -- end of protected area --
         };
 
-        typedef SafePtr<ECMStream, NullMutex> ECMStreamPtr;
+        // ECM streams are shared with the ECM deciphering thread.
+        typedef SafePtr<ECMStream, AtomicRefCount> ECMStreamPtr;
         typedef std::map<PID, ECMStreamPtr> ECMStreamMap;
 
+        // An ECM to decipher in the ECM deciphering thread.
+        class ECMRequest
+        {
+            TS_NOBUILD_NOCOPY(ECMRequest);
+        public:
+            // Constructor
+            ECMRequest(const ECMStreamPtr& stream, const Section& section);
+
+            ECMStreamPtr stream;  // ECM stream of the ECM.
+            Section      ecm;     // ECM to decipher.
+        };
+
+        // Queue of ECM's to decipher. A null request terminates the ECM deciphering thread.
+        typedef LockFreeMessageQueue<ECMRequest> ECMQueue;
+
         // ECM deciphering thread
         class ECMThread : public Thread
         {
@@ -251,10 +266,9 @@ namespace ts {
         // Get the ECM stream for a PID, create it if non existent
         ECMStreamPtr getOrCreateECMStream(PID);
 
-        // Process one ECM (the one in ECMStream::ecm).
-        // In asynchronous mode, this method must be invoked with the mutex held. The method
-        // releases the mutex while deciphering the ECM and relocks it before exiting.
-        void processECM(ECMStream&);
+        // Process one ECM. In asynchronous mode, this method is invoked in the ECM
+        // deciphering thread and the mutex is held only to store the new CW's.
+        void processECM(ECMStream&, const Section& ecm);
 
         // Analyze a list of descriptors from the PMT, looking for ECM PID's
         void analyzeDescriptors(const DescriptorList& dlist, std::set<PID>& ecm_pids, uint8_t& scrambling);
@@ -267,16 +281,14 @@ namespace ts {
         bool               _swap_cw;           // Swap even/odd CW from ECM.
         TSScrambling       _scrambling;        // Default descrambling (used with fixed control words).
         PIDSet             _pids;              // Explicit PID's to descramble.
+        std::vector<TSPacket*> _batch;         // Packets to descramble in a window (fixed control words only).
         ServiceDiscovery   _service;           // Service to descramble (by name, id or none).
         size_t             _stack_usage;       // Stack usage for ECM deciphering.
         SectionDemux       _demux;             // Section demux to extract ECM's.
         ECMStreamMap       _ecm_streams;       // ECM streams, indexed by PID.
         ScrambledStreamMap _scrambled_streams; // Scrambled streams, indexed by PID.
         Mutex              _mutex;             // Exclusive access to protected areas
-        Condition          _ecm_to_do;         // Notify thread to process ECM.
+        ECMQueue           _ecm_queue;         // ECM's to process in the ECM deciphering thread.
         ECMThread          _ecm_thread;        // Thread which deciphers ECM's.
-        // -- start of protected area --
-        bool               _stop_thread;       // Terminate ECM processing thread
-        // -- end of protected area --
     };
 }
@@ -56,6 +56,8 @@ ts::IPOutputPlugin::IPOutputPlugin(TSP* tsp_) :
     _tos(-1),
     _pkt_burst(DEF_PACKET_BURST),
     _enforce_burst(false),
+    _pacing(false),
+    _pacing_bitrate(0),
     _use_rtp(false),
     _rtp_pt(RTP_PT_MP2T),
     _rtp_fixed_sequence(false),
@@ -73,7 +75,8 @@ ts::IPOutputPlugin::IPOutputPlugin(TSP* tsp_) :
     _pkt_count(0),
     _sock(false, *tsp_),
     _out_count(0),
-    _out_buffer()
+    _out_buffer(),
+    _regulator(tsp_, Severity::Verbose)
 {
     option(u"", 0, STRING, 1, 1);
     help(u"",
@@ -82,6 +85,11 @@ ts::IPOutputPlugin::IPOutputPlugin(TSP* tsp_) :
          u"multicast. It can be also a host name that translates to an IP address. "
          u"The 'port' specifies the destination UDP port.");
 
+    option(u"bitrate", 'b', POSITIVE);
+    help(u"bitrate",
+         u"With --pacing, specify the bitrate in b/s which is used to pace the datagrams. "
+         u"By default, use the bitrate of the transport stream.");
+
     option(u"enforce-burst", 'e');
     help(u"enforce-burst",
          u"Enforce that the number of TS packets per UDP packet is exactly what is specified "
@@ -103,6 +111,14 @@ ts::IPOutputPlugin::IPOutputPlugin(TSP* tsp_) :
          u"Specifies the maximum number of TS packets per UDP packet. "
          u"The default is " TS_STRINGIFY(DEF_PACKET_BURST) u", the maximum is " TS_STRINGIFY(MAX_PACKET_BURST) u".");
 
+    option(u"pacing");
+    help(u"pacing",
+         u"Pace the output of UDP datagrams according to the bitrate. Each datagram is "
+         u"sent at its own due time, with a sub-millisecond accuracy. By default, the "
+         u"datagrams are sent as soon as the packets are received from the previous "
+         u"plugin, typically in bursts. Using --pacing is more precise than using the "
+         u"plugin \"regulate\" in front of this one but uses more CPU.");
+
     option(u"tos", 's', INTEGER, 0, 1, 1, 255);
     help(u"tos",
          u"Specifies the TOS (Type-Of-Service) socket option. Setting this value "
@@ -166,6 +182,8 @@ bool ts::IPOutputPlugin::getOptions()
     _tos = intValue<int>(u"tos", -1);
     _pkt_burst = intValue<size_t>(u"packet-burst", DEF_PACKET_BURST);
     _enforce_burst = present(u"enforce-burst");
+    _pacing = present(u"pacing");
+    _pacing_bitrate = intValue<BitRate>(u"bitrate", 0);
     _use_rtp = present(u"rtp");
     _rtp_pt = intValue<uint8_t>(u"payload-type", RTP_PT_MP2T);
     _rtp_fixed_sequence = present(u"start-sequence-number");
@@ -226,6 +244,14 @@ bool ts::IPOutputPlugin::start()
         }
     }
 
+    // Initialize datagram pacing, one burst per datagram.
+    if (_pacing) {
+        _regulator.setBurstPacketCount(_pkt_burst);
+        _regulator.setFixedBitRate(_pacing_bitrate);
+        _regulator.setPrecise(true);
+        _regulator.start();
+    }
+
     // Other states.
     _pcr_pid = _pcr_user_pid;
     _last_pcr = INVALID_PCR;
@@ -311,6 +337,15 @@ bool ts::IPOutputPlugin::sendDatagram(const TSPacket* pkt, size_t packet_count)
 {
     bool status = true;
 
+    // With --pacing, wait until the due time of the last packet in the datagram.
+    if (_pacing) {
+        bool flush = false;
+        bool bitrate_changed = false;
+        for (size_t i = 0; i < packet_count; ++i) {
+            _regulator.regulate(tsp->bitrate(), flush, bitrate_changed);
+        }
+    }
+
     if (_use_rtp) {
         // RTP datagram are relatively trivial to build, except the time stamp.
         // We cannot use the wall clock time because the plugin is likely to burst its output.
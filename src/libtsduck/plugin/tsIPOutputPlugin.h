@@ -35,6 +35,7 @@
 #pragma once
 #include "tsOutputPlugin.h"
 #include "tsUDPSocket.h"
+#include "tsBitRateRegulator.h"
 
 namespace ts {
     //!
@@ -71,6 +72,8 @@ namespace ts {
         int            _tos;                // Type of service option.
         size_t         _pkt_burst;          // Number of TS packets per UDP message
         bool           _enforce_burst;      // Option --enforce-burst
+        bool           _pacing;             // Option --pacing
+        BitRate        _pacing_bitrate;     // Option --bitrate, zero means use TS bitrate
         bool           _use_rtp;            // Use real-time transport protocol
         uint8_t        _rtp_pt;             // RTP payload type.
         bool           _rtp_fixed_sequence; // RTP sequence number starts with a fixed value
@@ -89,6 +92,7 @@ namespace ts {
         UDPSocket      _sock;               // Outgoing socket
         size_t         _out_count;          // Number of packets in _out_buffer
         TSPacketVector _out_buffer;         // Buffered packets for output with --enforce-burst
+        BitRateRegulator _regulator;        // Datagram pacing with --pacing
 
         // Send contiguous packets in one single datagram.
         bool sendDatagram(const TSPacket* pkt, size_t packet_count);
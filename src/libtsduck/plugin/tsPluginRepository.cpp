@@ -32,6 +32,8 @@
 #include "tsAlgorithm.h"
 #include "tsCerrReport.h"
 #include "tsSysUtils.h"
+#include "tsVersionInfo.h"
+#include "tsTime.h"
 TSDUCK_SOURCE;
 
 TS_DEFINE_SINGLETON(ts::PluginRepository);
@@ -204,6 +206,162 @@ void ts::PluginRepository::loadAllPlugins(Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Index of plugin shared libraries.
+//----------------------------------------------------------------------------
+
+ts::PluginRepository::IndexedPlugin::IndexedPlugin(int t, const UString& n, const UString& d) :
+    type(t),
+    name(n),
+    description(d)
+{
+}
+
+ts::PluginRepository::IndexedLibrary::IndexedLibrary() :
+    mtime(0),
+    plugins()
+{
+}
+
+// Index file, at the same place as the TSDuck configuration file.
+ts::UString ts::PluginRepository::PluginIndexFileName()
+{
+#if defined(TS_WINDOWS)
+    return GetEnvironment(u"APPDATA") + u"\\tsduck\\tsduck.plugins";
+#else
+    return UserHomeDirectory() + u"/.tsduck.plugins";
+#endif
+}
+
+// The first line of the index file identifies the TSDuck version which built it.
+ts::UString ts::PluginRepository::PluginIndexHeader()
+{
+    return UString::Format(u"# TSDuck %s plugin index", {VersionInfo::GetVersion()});
+}
+
+// Each other line of the index file describes one plugin: "file, mtime, type, name, description", with tab separators.
+bool ts::PluginRepository::LoadPluginIndex(PluginIndex& index, const UString& filename)
+{
+    index.clear();
+    UStringList lines;
+    if (!UString::Load(lines, filename) || lines.empty() || lines.front() != PluginIndexHeader()) {
+        // No index or built by another version of TSDuck.
+        return false;
+    }
+    for (auto it = ++lines.begin(); it != lines.end(); ++it) {
+        UStringVector fields;
+        it->split(fields, u'\t', false);
+        MilliSecond mtime = 0;
+        int type = 0;
+        if (fields.size() == 5 && fields[1].toInteger(mtime) && fields[2].toInteger(type)) {
+            IndexedLibrary& lib(index[fields[0]]);
+            lib.mtime = mtime;
+            lib.plugins.push_back(IndexedPlugin(type, fields[3], fields[4]));
+        }
+    }
+    return true;
+}
+
+namespace {
+    // Tabs and new lines are field and line separators in the index file.
+    ts::UString IndexField(const ts::UString& value)
+    {
+        ts::UString field(value);
+        field.substitute(u"\t", u" ");
+        field.substitute(u"\r", u" ");
+        field.substitute(u"\n", u" ");
+        return field;
+    }
+
+    // Atomically replace a file with another one.
+    bool ReplaceFile(const ts::UString& old_path, const ts::UString& new_path)
+    {
+#if defined(TS_WINDOWS)
+        // MoveFileW (ts::RenameFile) fails when the target file exists.
+        return ::MoveFileExW(old_path.wc_str(), new_path.wc_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return ts::RenameFile(old_path, new_path) == ts::SYS_SUCCESS;
+#endif
+    }
+}
+
+bool ts::PluginRepository::SavePluginIndex(const PluginIndex& index, const UString& filename)
+{
+    UStringList lines;
+    lines.push_back(PluginIndexHeader());
+    for (auto lib = index.begin(); lib != index.end(); ++lib) {
+        // Drop libraries which were removed since they were indexed.
+        // A file name with a separator cannot be indexed, the library will be loaded each time.
+        if (FileExists(lib->first) && IndexField(lib->first) == lib->first) {
+            for (auto pl = lib->second.plugins.begin(); pl != lib->second.plugins.end(); ++pl) {
+                lines.push_back(UString::Format(u"%s\t%d\t%d\t%s\t%s", {lib->first, lib->second.mtime, pl->type, IndexField(pl->name), IndexField(pl->description)}));
+            }
+        }
+    }
+
+    // Several processes may update the index at the same time.
+    // Write a private temporary file and atomically replace the index.
+    const UString tmpname(UString::Format(u"%s.%d.tmp", {filename, CurrentProcessId()}));
+    CreateDirectory(DirectoryName(filename), true);
+    if (!UString::Save(lines, tmpname) || !ReplaceFile(tmpname, filename)) {
+        CERR.debug(u"error saving plugin index %s", {filename});
+        DeleteFile(tmpname);
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Load a plugin shared library and describe the plugins it registers.
+//----------------------------------------------------------------------------
+
+template<typename FACTORY>
+void ts::PluginRepository::AddNewPlugins(IndexedLibrary& lib, int type, const std::map<UString,FACTORY>& plugin_map, const UStringList& old_names)
+{
+    for (auto it = plugin_map.begin(); it != plugin_map.end(); ++it) {
+        if (std::find(old_names.begin(), old_names.end(), it->first) == old_names.end()) {
+            Plugin* p = it->second(nullptr);
+            lib.plugins.push_back(IndexedPlugin(type, it->first, p->getDescription()));
+            delete p;
+        }
+    }
+}
+
+void ts::PluginRepository::indexSharedLibrary(const UString& file, IndexedLibrary& lib, Report& report)
+{
+    // Names of plugins which were registered before loading the library.
+    const UStringList inputs(inputNames());
+    const UStringList processors(processorNames());
+    const UStringList outputs(outputNames());
+
+    // Permanent load, let the library register its plugins.
+    SharedLibrary shlib(file, SharedLibraryFlags::PERMANENT, report);
+    CERR.debug(u"loaded plugin file \"%s\", status: %s", {file, shlib.isLoaded()});
+
+    // Describe the new plugins.
+    lib.plugins.clear();
+    AddNewPlugins(lib, LIST_INPUT, _inputPlugins, inputs);
+    AddNewPlugins(lib, LIST_PACKET, _processorPlugins, processors);
+    AddNewPlugins(lib, LIST_OUTPUT, _outputPlugins, outputs);
+}
+
+
+//----------------------------------------------------------------------------
+// Get the descriptions of registered plugins.
+//----------------------------------------------------------------------------
+
+template<typename FACTORY>
+void ts::PluginRepository::GetDescriptions(DescriptionMap& descs, const std::map<UString,FACTORY>& plugin_map)
+{
+    for (auto it = plugin_map.begin(); it != plugin_map.end(); ++it) {
+        Plugin* p = it->second(nullptr);
+        descs[it->first] = p->getDescription();
+        delete p;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // List all tsp processors.
 //----------------------------------------------------------------------------
@@ -214,26 +372,77 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
     UString out;
     out.reserve(5000);
 
-    // Load all shareable plugins first.
-    if (loadAll) {
-        loadAllPlugins(report);
+    // Descriptions of all plugins, starting with registered ones.
+    DescriptionMap inputs;
+    DescriptionMap processors;
+    DescriptionMap outputs;
+    GetDescriptions(inputs, _inputPlugins);
+    GetDescriptions(processors, _processorPlugins);
+    GetDescriptions(outputs, _outputPlugins);
+
+    // Add plugins from shared libraries, using the index when possible.
+    if (loadAll && _sharedLibraryAllowed) {
+        const bool useIndex = GetEnvironment(u"TSDUCK_NO_PLUGIN_INDEX").empty();
+        PluginIndex index;
+        bool modified = false;
+        if (useIndex) {
+            LoadPluginIndex(index);
+        }
+
+        // Get list of shared library files
+        UStringVector files;
+        ApplicationSharedLibrary::GetPluginList(files, u"tsplugin_", TS_PLUGINS_PATH);
+
+        for (size_t i = 0; i < files.size(); ++i) {
+            const MilliSecond mtime = GetFileModificationTimeUTC(files[i]) - Time::Epoch;
+            const PluginIndex::iterator it = index.find(files[i]);
+            IndexedLibrary lib;
+            if (it != index.end() && it->second.mtime == mtime) {
+                // Unmodified since indexed, do not load the library.
+                lib = it->second;
+            }
+            else {
+                // New or modified library, load it to get its plugins.
+                lib.mtime = mtime;
+                indexSharedLibrary(files[i], lib, report);
+                // A library which registers no new plugin is not indexed, its plugins
+                // may have been registered by another copy or it may be invalid.
+                if (!lib.plugins.empty()) {
+                    index[files[i]] = lib;
+                    modified = true;
+                }
+                else if (it != index.end()) {
+                    index.erase(it);
+                    modified = true;
+                }
+            }
+            for (auto pl = lib.plugins.begin(); pl != lib.plugins.end(); ++pl) {
+                // Plugins which are already registered take precedence.
+                DescriptionMap& descs(pl->type == LIST_INPUT ? inputs : (pl->type == LIST_OUTPUT ? outputs : processors));
+                descs.insert(std::make_pair(pl->name, pl->description));
+            }
+        }
+
+        if (useIndex && modified) {
+            SavePluginIndex(index);
+        }
     }
 
     // Compute max name width of all plugins.
     size_t name_width = 0;
     if ((flags & LIST_COMPACT) == 0) {
         if ((flags & LIST_INPUT) != 0) {
-            for (InputMap::const_iterator it = _inputPlugins.begin(); it != _inputPlugins.end(); ++it) {
+            for (auto it = inputs.begin(); it != inputs.end(); ++it) {
                 name_width = std::max(name_width, it->first.width());
             }
         }
         if ((flags & LIST_PACKET) != 0) {
-            for (ProcessorMap::const_iterator it = _processorPlugins.begin(); it != _processorPlugins.end(); ++it) {
+            for (auto it = processors.begin(); it != processors.end(); ++it) {
                 name_width = std::max(name_width, it->first.width());
             }
         }
         if ((flags & LIST_OUTPUT) != 0) {
-            for (OutputMap::const_iterator it = _outputPlugins.begin(); it != _outputPlugins.end(); ++it) {
+            for (auto it = outputs.begin(); it != outputs.end(); ++it) {
                 name_width = std::max(name_width, it->first.width());
             }
         }
@@ -241,36 +450,13 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
 
     // List capabilities.
     if ((flags & LIST_INPUT) != 0) {
-        if ((flags & LIST_COMPACT) == 0) {
-            out += u"\nList of tsp input plugins:\n\n";
-        }
-        for (InputMap::const_iterator it = _inputPlugins.begin(); it != _inputPlugins.end(); ++it) {
-            Plugin* p = it->second(nullptr);
-            ListOnePlugin(out, it->first, p, name_width, flags);
-            delete p;
-        }
+        ListPlugins(out, u"\nList of tsp input plugins:\n\n", inputs, name_width, flags);
     }
-
     if ((flags & LIST_OUTPUT) != 0) {
-        if ((flags & LIST_COMPACT) == 0) {
-            out += u"\nList of tsp output plugins:\n\n";
-        }
-        for (OutputMap::const_iterator it = _outputPlugins.begin(); it != _outputPlugins.end(); ++it) {
-            Plugin* p = it->second(nullptr);
-            ListOnePlugin(out, it->first, p, name_width, flags);
-            delete p;
-        }
+        ListPlugins(out, u"\nList of tsp output plugins:\n\n", outputs, name_width, flags);
     }
-
     if ((flags & LIST_PACKET) != 0) {
-        if ((flags & LIST_COMPACT) == 0) {
-            out += u"\nList of tsp packet processor plugins:\n\n";
-        }
-        for (ProcessorMap::const_iterator it = _processorPlugins.begin(); it != _processorPlugins.end(); ++it) {
-            Plugin* p = it->second(nullptr);
-            ListOnePlugin(out, it->first, p, name_width, flags);
-            delete p;
-        }
+        ListPlugins(out, u"\nList of tsp packet processor plugins:\n\n", processors, name_width, flags);
     }
 
     return out;
@@ -278,22 +464,27 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
 
 
 //----------------------------------------------------------------------------
-// List one plugin.
+// List plugins of one type.
 //----------------------------------------------------------------------------
 
-void ts::PluginRepository::ListOnePlugin(UString& out, const UString& name, Plugin* plugin, size_t name_width, int flags)
+void ts::PluginRepository::ListPlugins(UString& out, const UString& title, const DescriptionMap& descs, size_t name_width, int flags)
 {
-    if ((flags & LIST_COMPACT) != 0) {
-        out += name;
-        out += u":";
-        out += plugin->getDescription();
-        out += u"\n";
+    if ((flags & LIST_COMPACT) == 0) {
+        out += title;
     }
-    else {
-        out += u"  ";
-        out += name.toJustifiedLeft(name_width + 1, u'.', false, 1);
-        out += u" ";
-        out += plugin->getDescription();
-        out += u"\n";
+    for (auto it = descs.begin(); it != descs.end(); ++it) {
+        if ((flags & LIST_COMPACT) != 0) {
+            out += it->first;
+            out += u":";
+            out += it->second;
+            out += u"\n";
+        }
+        else {
+            out += u"  ";
+            out += it->first.toJustifiedLeft(name_width + 1, u'.', false, 1);
+            out += u" ";
+            out += it->second;
+            out += u"\n";
+        }
     }
 }
@@ -190,14 +190,85 @@ namespace ts {
         //!
         //! List all tsp processors.
         //! This function is typically used to implement the <code>tsp -\-list-processors</code> option.
-        //! @param [in] loadAll When true, all available plugins are loaded first.
-        //! Ignored when dynamic loading of plugins is disabled.
+        //!
+        //! The names and descriptions of the plugins from shared libraries are kept in a persistent
+        //! index file in the user's configuration area. Only the shared libraries which are new or
+        //! were modified since the index was last built are loaded. The index is not used when
+        //! the environment variable @c TSDUCK_NO_PLUGIN_INDEX is not empty.
+        //!
+        //! @param [in] loadAll When true, all available plugins are listed, including plugins
+        //! from shared libraries which are not yet loaded. Ignored when dynamic loading of plugins is disabled.
         //! @param [in,out] report Where to report errors.
         //! @param [in] flags List options, an or'ed mask of ListFlags values.
         //! @return The text to display.
         //!
         UString listPlugins(bool loadAll, Report& report, int flags = LIST_ALL);
 
+        //!
+        //! Description of a plugin in the index of plugin shared libraries.
+        //!
+        class TSDUCKDLL IndexedPlugin
+        {
+        public:
+            int     type;         //!< One of LIST_INPUT, LIST_PACKET, LIST_OUTPUT.
+            UString name;         //!< Plugin name.
+            UString description;  //!< Plugin description.
+
+            //!
+            //! Constructor.
+            //! @param [in] t Plugin type, one of LIST_INPUT, LIST_PACKET, LIST_OUTPUT.
+            //! @param [in] n Plugin name.
+            //! @param [in] d Plugin description.
+            //!
+            IndexedPlugin(int t = 0, const UString& n = UString(), const UString& d = UString());
+        };
+
+        //!
+        //! Description of a plugin shared library in the index.
+        //!
+        class TSDUCKDLL IndexedLibrary
+        {
+        public:
+            MilliSecond              mtime;    //!< Modification time of the file, in milliseconds since the Epoch.
+            std::list<IndexedPlugin> plugins;  //!< Plugins which are registered by the shared library.
+
+            //!
+            //! Constructor.
+            //!
+            IndexedLibrary();
+        };
+
+        //!
+        //! Index of plugin shared libraries, indexed by file name.
+        //!
+        typedef std::map<UString, IndexedLibrary> PluginIndex;
+
+        //!
+        //! Get the default file name of the persistent index of plugin shared libraries.
+        //! @return The file name of the index in the user's configuration area.
+        //!
+        static UString PluginIndexFileName();
+
+        //!
+        //! Load a persistent index of plugin shared libraries.
+        //! @param [out] index The loaded index. Empty if the file does not exist
+        //! or was built by another version of TSDuck.
+        //! @param [in] filename Name of the index file.
+        //! @return True if a valid index file was loaded, false otherwise.
+        //!
+        static bool LoadPluginIndex(PluginIndex& index, const UString& filename = PluginIndexFileName());
+
+        //!
+        //! Save a persistent index of plugin shared libraries.
+        //! The shared libraries which no longer exist are not saved. Tabs and new lines
+        //! in plugin names and descriptions are replaced with spaces. The file is atomically
+        //! replaced, several processes may update the index at the same time.
+        //! @param [in] index The index to save.
+        //! @param [in] filename Name of the index file.
+        //! @return True on success, false on error.
+        //!
+        static bool SavePluginIndex(const PluginIndex& index, const UString& filename = PluginIndexFileName());
+
         //!
         //! A class to register plugins.
         //!
@@ -243,8 +314,23 @@ namespace ts {
         template<typename FACTORY>
         FACTORY getFactory(const UString& name, const UString& type, const std::map<UString,FACTORY>&, Report&);
 
-        // List one plugin.
-        static void ListOnePlugin(UString& out, const UString& name, Plugin* plugin, size_t name_width, int flags);
+        // Map of plugin descriptions, indexed by plugin name.
+        typedef std::map<UString, UString> DescriptionMap;
+
+        // First line of the persistent index of plugin shared libraries.
+        static UString PluginIndexHeader();
+
+        // Load a plugin shared library and describe the plugins it registers.
+        void indexSharedLibrary(const UString& file, IndexedLibrary& lib, Report& report);
+
+        // Get the descriptions of registered plugins.
+        template<typename FACTORY>
+        static void GetDescriptions(DescriptionMap& descs, const std::map<UString,FACTORY>& plugin_map);
+        template<typename FACTORY>
+        static void AddNewPlugins(IndexedLibrary& lib, int type, const std::map<UString,FACTORY>& plugin_map, const UStringList& old_names);
+
+        // List plugins of one type.
+        static void ListPlugins(UString& out, const UString& title, const DescriptionMap& descs, size_t name_width, int flags);
     };
 }
 
@@ -68,3 +68,12 @@ ts::PluginType ts::ProcessorPlugin::type() const
 {
     return PluginType::PROCESSOR;
 }
+
+void ts::ProcessorPlugin::preparePackets(TSPacket*, TSPacketMetadata*, size_t)
+{
+}
+
+size_t ts::ProcessorPlugin::completePackets(TSPacket*, TSPacketMetadata*, size_t count)
+{
+    return count;
+}
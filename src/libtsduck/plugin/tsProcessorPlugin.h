@@ -83,6 +83,47 @@ namespace ts {
         //!
         virtual Status processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data) = 0;
 
+        //!
+        //! Packet window preparation interface.
+        //!
+        //! The main application invokes preparePackets() on a window of contiguous
+        //! TS packets before invoking processPacket() on each of them. A plugin may
+        //! use it to process several packets at once, in place, for instance to
+        //! descramble them in parallel. The window may contain packets which were
+        //! dropped by a previous plugin (a zero sync byte), they must be ignored.
+        //!
+        //! This method is invoked only when all packets of the window will be
+        //! passed to processPacket(), i.e. when the plugin is not suspended and
+        //! no --only-label option is specified. The default implementation does nothing.
+        //!
+        //! @param [in,out] pkts Address of the first TS packet in the window.
+        //! @param [in,out] pkt_data Address of the metadata of the first TS packet.
+        //! @param [in] count Number of packets in the window.
+        //!
+        virtual void preparePackets(TSPacket* pkts, TSPacketMetadata* pkt_data, size_t count);
+
+        //!
+        //! Packet window completion interface.
+        //!
+        //! The main application invokes completePackets() after processPacket() was invoked
+        //! on a group of packets and before these packets are passed to the next plugin.
+        //! A plugin which deferred some processing in processPacket(), for instance to
+        //! scramble several packets at once, must complete it here. The packets which were
+        //! previously passed to processPacket() remain valid until then.
+        //!
+        //! If the deferred processing fails on some packet, the plugin may end the processing
+        //! at this packet, exactly as if processPacket() had returned TSP_END on it. This packet
+        //! and all subsequent packets in the group are not passed to the next plugin.
+        //! The default implementation does nothing and accepts all packets.
+        //!
+        //! @param [in,out] pkts Address of the first TS packet in the group.
+        //! @param [in,out] pkt_data Address of the metadata of the first TS packet.
+        //! @param [in] count Number of packets in the group.
+        //! @return The number of packets to pass to the next plugin, from the start of the group.
+        //! When lower than @a count, the packet processing ends at the packet at this index.
+        //!
+        virtual size_t completePackets(TSPacket* pkts, TSPacketMetadata* pkt_data, size_t count);
+
         //!
         //! Get the content of the --only-label options.
         //! The value of the option is fetched each time this method is called.
@@ -54,6 +54,7 @@
 #include "tsAbstractSignalization.h"
 #include "tsAbstractTable.h"
 #include "tsAbstractTablePlugin.h"
+#include "tsAbstractTableView.h"
 #include "tsAbstractTransportListTable.h"
 #include "tsAbstractWriteStreamInterface.h"
 #include "tsAC3Attributes.h"
@@ -82,6 +83,7 @@
 #include "tsAssociationTagDescriptor.h"
 #include "tsAsyncReport.h"
 #include "tsAsyncReportArgs.h"
+#include "tsAtomicRefCount.h"
 #include "tsATSCAC3AudioStreamDescriptor.h"
 #include "tsATSCEAC3AudioDescriptor.h"
 #include "tsATSCEIT.h"
@@ -187,6 +189,7 @@
 #include "tsDES.h"
 #include "tsDescriptor.h"
 #include "tsDescriptorList.h"
+#include "tsDescriptorListView.h"
 #include "tsDigitalCopyControlDescriptor.h"
 #include "tsDIILocationDescriptor.h"
 #include "tsDiscontinuityInformationTable.h"
@@ -333,6 +336,8 @@
 #include "tsjsonNull.h"
 #include "tsjsonNumber.h"
 #include "tsjsonObject.h"
+#include "tsjsonStreamReader.h"
+#include "tsjsonStreamWriter.h"
 #include "tsjsonString.h"
 #include "tsjsonTrue.h"
 #include "tsjsonValue.h"
@@ -342,9 +347,11 @@
 #include "tsLIT.h"
 #include "tsLNB.h"
 #include "tsLocalTimeOffsetDescriptor.h"
+#include "tsLockFreeMessageQueue.h"
 #include "tsLogoTransmissionDescriptor.h"
 #include "tsMACAddress.h"
 #include "tsMain.h"
+#include "tsMappedPacketRing.h"
 #include "tsMaximumBitrateDescriptor.h"
 #include "tsMD5.h"
 #include "tsMemory.h"
@@ -374,6 +381,7 @@
 #include "tsMultilingualComponentDescriptor.h"
 #include "tsMultilingualNetworkNameDescriptor.h"
 #include "tsMultilingualServiceNameDescriptor.h"
+#include "tsMultiPatternMatcher.h"
 #include "tsMultiplexBufferDescriptor.h"
 #include "tsMultiplexBufferUtilizationDescriptor.h"
 #include "tsMutex.h"
@@ -401,12 +409,14 @@
 #include "tsOutputRedirector.h"
 #include "tsPacketDecapsulation.h"
 #include "tsPacketEncapsulation.h"
+#include "tsPacketFilter.h"
 #include "tsPacketizer.h"
 #include "tsPagerArgs.h"
 #include "tsParentalRatingDescriptor.h"
 #include "tsPartialReceptionDescriptor.h"
 #include "tsPartialTransportStreamDescriptor.h"
 #include "tsPAT.h"
+#include "tsPATView.h"
 #include "tsPCAT.h"
 #include "tsPCR.h"
 #include "tsPCRAnalyzer.h"
@@ -430,6 +440,7 @@
 #include "tsPluginRepository.h"
 #include "tsPluginThread.h"
 #include "tsPMT.h"
+#include "tsPMTView.h"
 #include "tsPolledFile.h"
 #include "tsPollFiles.h"
 #include "tsPollFilesListener.h"
@@ -463,16 +474,19 @@
 #include "tsS2XSatelliteDeliverySystemDescriptor.h"
 #include "tsSafePtr.h"
 #include "tsSatelliteDeliverySystemDescriptor.h"
+#include "tsScatteredPESPacket.h"
 #include "tsSchedulingDescriptor.h"
 #include "tsScramblingDescriptor.h"
 #include "tsSCTE35.h"
 #include "tsSCTE52.h"
 #include "tsSDT.h"
+#include "tsSDTView.h"
 #include "tsSection.h"
 #include "tsSectionDemux.h"
 #include "tsSectionFile.h"
 #include "tsSectionFileArgs.h"
 #include "tsSectionHandlerInterface.h"
+#include "tsSectionPool.h"
 #include "tsSectionProviderInterface.h"
 #include "tsSelectionInformationTable.h"
 #include "tsSeriesDescriptor.h"
@@ -554,6 +568,7 @@
 #include "tsT2MIDescriptor.h"
 #include "tsT2MIHandlerInterface.h"
 #include "tsT2MIPacket.h"
+#include "tsTableCache.h"
 #include "tsTableHandlerInterface.h"
 #include "tsTables.h"
 #include "tsTablesDisplay.h"
@@ -675,6 +690,7 @@
 #include "tsxmlDocument.h"
 #include "tsxmlElement.h"
 #include "tsxmlNode.h"
+#include "tsxmlStreamReader.h"
 #include "tsxmlText.h"
 #include "tsxmlTweaks.h"
 #include "tsxmlUnknown.h"
@@ -35,6 +35,7 @@
 #include "tsPluginRepository.h"
 #include "tsTSAnalyzerReport.h"
 #include "tsTSSpeedMetrics.h"
+#include "tsUDPSocket.h"
 #include "tsSysUtils.h"
 TSDUCK_SOURCE;
 
@@ -60,23 +61,36 @@ namespace ts {
         UString           _output_name;
         NanoSecond        _output_interval;
         bool              _multiple_output;
+        bool              _delta;
+        UString           _udp_destination;
+        UString           _udp_local;
+        int               _udp_ttl;
         TSAnalyzerOptions _analyzer_options;
 
         // Working data:
         std::ofstream     _output_stream;
         std::ostream*     _output;
+        UDPSocket         _sock;
         TSSpeedMetrics    _metrics;
         NanoSecond        _next_report;
         TSAnalyzerReport  _analyzer;
 
+        // Maximum size of a delta report in a UDP datagram.
+        static constexpr size_t MAX_DELTA_DATAGRAM = 65535 - IPv4_MIN_HEADER_SIZE - UDP_HEADER_SIZE;
+
         bool openOutput();
         void closeOutput();
         bool produceReport();
+        bool produceDelta();
     };
 }
 
 TS_REGISTER_PROCESSOR_PLUGIN(u"analyze", ts::AnalyzePlugin);
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::AnalyzePlugin::MAX_DELTA_DATAGRAM;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructor
@@ -87,9 +101,14 @@ ts::AnalyzePlugin::AnalyzePlugin(TSP* tsp_) :
     _output_name(),
     _output_interval(0),
     _multiple_output(false),
+    _delta(false),
+    _udp_destination(),
+    _udp_local(),
+    _udp_ttl(0),
     _analyzer_options(),
     _output_stream(),
     _output(),
+    _sock(false, *tsp_),
     _metrics(),
     _next_report(0),
     _analyzer(duck)
@@ -99,6 +118,15 @@ ts::AnalyzePlugin::AnalyzePlugin(TSP* tsp_) :
     duck.defineArgsForCharset(*this);
     _analyzer_options.defineArgs(*this);
 
+    option(u"delta", 'd');
+    help(u"delta",
+         u"With --interval, produce a delta report at each interval instead of a full report. "
+         u"A delta report is one compact JSON line containing only the values which changed "
+         u"since the previous interval (bitrates, new services and PID's, descriptions, "
+         u"scrambling state, error counters, table versions). With --delta, the analysis "
+         u"context is not reset at each interval and all lines are written in the same "
+         u"output file, or sent over UDP with --udp. This is useful for continuous monitoring.");
+
     option(u"interval", 'i', POSITIVE);
     help(u"interval",
          u"Produce a new output file at regular intervals. "
@@ -117,6 +145,26 @@ ts::AnalyzePlugin::AnalyzePlugin(TSP* tsp_) :
     help(u"output-file", u"filename",
          u"Specify the output text file for the analysis result. "
          u"By default, use the standard output.");
+
+    option(u"udp", 'u', STRING);
+    help(u"udp", u"address:port",
+         u"With --delta, send each delta report as one UDP datagram to the specified destination "
+         u"instead of an output file. The 'address' specifies an IP address which can be either "
+         u"unicast or multicast. It can be also a host name that translates to an IP address. "
+         u"The 'port' specifies the destination UDP port.");
+
+    option(u"local-udp", 0, STRING);
+    help(u"local-udp", u"address",
+         u"With --udp, when the destination is a multicast address, specify the IP address "
+         u"of the outgoing local interface. It can be also a host name that translates to "
+         u"a local address.");
+
+    option(u"ttl", 0, POSITIVE);
+    help(u"ttl",
+         u"With --udp, specifies the TTL (Time-To-Live) socket option. "
+         u"The actual option is either \"Unicast TTL\" or \"Multicast TTL\", "
+         u"depending on the destination address. Remember that the default "
+         u"Multicast TTL is 1 on most systems.");
 }
 
 
@@ -131,6 +179,23 @@ bool ts::AnalyzePlugin::getOptions()
     _output_name = value(u"output-file");
     _output_interval = NanoSecPerSec * intValue<Second>(u"interval", 0);
     _multiple_output = present(u"multiple-files");
+    _delta = present(u"delta");
+    _udp_destination = value(u"udp");
+    _udp_local = value(u"local-udp");
+    _udp_ttl = intValue<int>(u"ttl", 0);
+
+    if (_delta && _output_interval == 0) {
+        tsp->error(u"--delta can be used with --interval only");
+        return false;
+    }
+    if (!_udp_destination.empty() && !_delta) {
+        tsp->error(u"--udp can be used with --delta only");
+        return false;
+    }
+    if (!_udp_destination.empty() && !_output_name.empty()) {
+        tsp->error(u"--udp and --output-file are mutually exclusive");
+        return false;
+    }
     return true;
 }
 
@@ -148,10 +213,24 @@ bool ts::AnalyzePlugin::start()
     _metrics.start();
     _next_report = _output_interval;
 
+    // With --delta --udp, create the UDP socket.
+    if (!_udp_destination.empty()) {
+        if (!_sock.open(*tsp) ||
+            !_sock.setDefaultDestination(_udp_destination, *tsp) ||
+            (!_udp_local.empty() && !_sock.setOutgoingMulticast(_udp_local, *tsp)) ||
+            (_udp_ttl > 0 && !_sock.setTTL(_udp_ttl, *tsp)))
+        {
+            _sock.close(*tsp);
+            return false;
+        }
+        return true;
+    }
+
     // Create the output file. Note that this file is used only in the stop
     // method and could be created there. However, if the file cannot be
     // created, we do not want to wait all along the analysis and finally fail.
-    if (_output_interval == 0 && !openOutput()) {
+    // With --delta, the same file is used all along the analysis.
+    if ((_output_interval == 0 || _delta) && !openOutput()) {
         return false;
     }
 
@@ -225,13 +304,58 @@ bool ts::AnalyzePlugin::produceReport()
 }
 
 
+//----------------------------------------------------------------------------
+// Produce a delta report. Return false on output file error only.
+//----------------------------------------------------------------------------
+
+bool ts::AnalyzePlugin::produceDelta()
+{
+    // Set last known input bitrate as hint
+    _analyzer.setBitrateHint(tsp->bitrate());
+
+    if (_sock.isOpen()) {
+        // One datagram per JSON line, without the trailing end of line.
+        // Large delta reports are split in several JSON lines which fit in a UDP datagram.
+        std::ostringstream lines;
+        if (_analyzer.reportDelta(_analyzer_options, lines, *tsp, MAX_DELTA_DATAGRAM)) {
+            const std::string text(lines.str());
+            size_t start = 0;
+            for (size_t eol = text.find('\n'); eol != std::string::npos; start = eol + 1, eol = text.find('\n', start)) {
+                if (eol - start > MAX_DELTA_DATAGRAM) {
+                    tsp->error(u"delta report entry too large (%'d bytes), dropped", {eol - start});
+                }
+                else {
+                    // A send error is reported but does not stop the processing, a monitoring datagram may be lost.
+                    _sock.send(text.data() + start, eol - start, *tsp);
+                }
+            }
+        }
+        return true;
+    }
+    else {
+        _analyzer.reportDelta(_analyzer_options, *_output, *tsp);
+        _output->flush();
+        return !_output->fail();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Stop method
 //----------------------------------------------------------------------------
 
 bool ts::AnalyzePlugin::stop()
 {
-    produceReport();
+    if (_delta) {
+        produceDelta();
+        closeOutput();
+        if (_sock.isOpen()) {
+            _sock.close(*tsp);
+        }
+    }
+    else {
+        produceReport();
+    }
     return true;
 }
 
@@ -248,11 +372,19 @@ ts::ProcessorPlugin::Status ts::AnalyzePlugin::processPacket(TSPacket& pkt, TSPa
     // With --interval, check if it is time to produce a report
     if (_output_interval > 0 && _metrics.processedPacket() && _metrics.sessionNanoSeconds() >= _next_report) {
         // Time to produce a report.
-        if (!produceReport()) {
+        if (_delta) {
+            // Delta report, keep the analysis context.
+            if (!produceDelta()) {
+                return TSP_END;
+            }
+        }
+        else if (!produceReport()) {
             return TSP_END;
         }
-        // Reset analysis context.
-        _analyzer.reset();
+        else {
+            // Reset analysis context.
+            _analyzer.reset();
+        }
         // Compute next report time.
         _next_report += _output_interval;
     }
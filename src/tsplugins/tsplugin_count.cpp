@@ -33,6 +33,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsPluginRepository.h"
+#include "tsPacketFilter.h"
 #include "tsTime.h"
 #include "tsMemory.h"
 TSDUCK_SOURCE;
@@ -68,8 +69,7 @@ namespace ts {
 
         // Command  line options:
         UString        _tag;                // Message tag
-        bool           _negate;             // Negate filter (exclude selected packets)
-        PIDSet         _pids;               // PID values to filter
+        PacketFilter   _filter;             // Packet selection (PID values and negation)
         bool           _brief_report;       // Display biref report, values but not comments
         bool           _report_all;         // Report packet index and PID of each packet
         bool           _report_summary;     // Report summary
@@ -96,8 +96,7 @@ TS_REGISTER_PROCESSOR_PLUGIN(u"count", ts::CountPlugin);
 ts::CountPlugin::CountPlugin(TSP* tsp_) :
     ProcessorPlugin(tsp_, u"Count TS packets per PID", u"[options]"),
     _tag(),
-    _negate(false),
-    _pids(),
+    _filter(),
     _brief_report(false),
     _report_all(false),
     _report_summary(false),
@@ -163,17 +162,18 @@ bool ts::CountPlugin::getOptions()
     _report_total = present(u"total");
     _report_summary = (!_report_all && !_report_total) || present(u"summary");
     _brief_report = present(u"brief");
-    _negate = present(u"negate");
     getIntValue(_report_interval, u"interval");
-    getIntValues(_pids, u"pid");
     _tag = value(u"tag");
     if (!_tag.empty()) {
         _tag += u": ";
     }
 
-    // By default, all PIDs are selected
+    // Packet selection criteria. By default, all PIDs are selected.
+    _filter.clear();
+    _filter.negate = present(u"negate");
+    getIntValues(_filter.pids, u"pid");
     if (!present(u"pid")) {
-        _pids.set();
+        _filter.pids.set();
     }
     return true;
 }
@@ -198,6 +198,7 @@ bool ts::CountPlugin::start()
 
     // Reset state
     TS_ZERO(_counters);
+    _filter.reset();
 
     return true;
 }
@@ -267,10 +268,7 @@ ts::ProcessorPlugin::Status ts::CountPlugin::processPacket(TSPacket& pkt, TSPack
 {
     // Check if the packet must be counted
     const PID pid = pkt.getPID();
-    bool ok = _pids[pid];
-    if (_negate) {
-        ok = !ok;
-    }
+    const bool ok = _filter.match(pkt, pkt_data, tsp->pluginPackets());
 
     // Process reporting intervals.
     if (_report_interval > 0) {
@@ -38,6 +38,7 @@
 TSDUCK_SOURCE;
 
 #define DEF_PACKET_BURST 16
+#define DEF_PRECISE_PACKET_BURST 7  // One UDP datagram.
 
 
 //----------------------------------------------------------------------------
@@ -85,13 +86,23 @@ ts::RegulatePlugin::RegulatePlugin(TSP* tsp_) :
     help(u"packet-burst",
          u"Number of packets to burst at a time. Does not modify the average "
          u"output bitrate but influence smoothing and CPU load. The default "
-         u"is " TS_STRINGIFY(DEF_PACKET_BURST) u" packets.");
+         u"is " TS_STRINGIFY(DEF_PACKET_BURST) u" packets, " TS_STRINGIFY(DEF_PRECISE_PACKET_BURST) u" packets with --precise.");
 
     option(u"pcr-synchronous");
     help(u"pcr-synchronous",
          u"Regulate the flow based on the Program Clock Reference from the transport "
          u"stream. By default, use a bitrate, not PCR's.");
 
+    option(u"precise");
+    help(u"precise",
+         u"Use precise pacing. By default, the packets are released in bursts of "
+         u"at least 2 milliseconds, depending on the precision of the system timers. "
+         u"With --precise, each burst of packets is released at its own due time, "
+         u"computed from the bitrate or interpolated between PCR's. The plugin sleeps "
+         u"until shortly before the due time and then actively waits, which uses more "
+         u"CPU but gives a sub-millisecond accuracy. With --pcr-synchronous, --wait-min "
+         u"is ignored.");
+
     option(u"pid-pcr", 0, PIDVAL);
     help(u"pid-pcr",
          u"With --pcr-synchronous, specify the reference PID for PCR's. By default, "
@@ -115,7 +126,8 @@ bool ts::RegulatePlugin::start()
     const BitRate bitrate = intValue<BitRate>(u"bitrate", 0);
     const bool has_pid = present(u"pid-pcr");
     const PID pid = intValue<PID>(u"pid-pcr", PID_NULL);
-    const PacketCounter burst = intValue<PacketCounter>(u"packet-burst", DEF_PACKET_BURST);
+    const bool precise = present(u"precise");
+    const PacketCounter burst = intValue<PacketCounter>(u"packet-burst", precise ? DEF_PRECISE_PACKET_BURST : DEF_PACKET_BURST);
     const MilliSecond wait_min = intValue<MilliSecond>(u"wait-min", PCRRegulator::DEFAULT_MIN_WAIT_NS / NanoSecPerMilliSec);
 
     if (has_bitrate && _pcr_synchronous) {
@@ -133,10 +145,12 @@ bool ts::RegulatePlugin::start()
         _pcr_regulator.setBurstPacketCount(burst);
         _pcr_regulator.setReferencePID(pid);
         _pcr_regulator.setMinimimWait(wait_min * NanoSecPerMilliSec);
+        _pcr_regulator.setPrecise(precise);
     }
     else {
         _bitrate_regulator.setBurstPacketCount(burst);
         _bitrate_regulator.setFixedBitRate(bitrate);
+        _bitrate_regulator.setPrecise(precise);
         _bitrate_regulator.start();
     }
     return true;
@@ -104,6 +104,7 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t completePackets(TSPacket*, TSPacketMetadata*, size_t) override;
 
     private:
         // Description of a crypto-period.
@@ -195,6 +196,8 @@ namespace ts {
         size_t            _current_ecm;         // Index to current ECM (ECM being broadcast)
         TSScrambling      _scrambling;          // Scrambler
         CyclingPacketizer _pzer_pmt;            // Packetizer for modified PMT
+        std::vector<TSPacket*> _batch;          // Packets to scramble at once, with the current CW.
+        TSPacket*         _end_packet;          // First packet which could not be scrambled, end processing there.
 
         // Return current/next CryptoPeriod for CW or ECM
         CryptoPeriod& currentCW()  { return _cp[_current_cw]; }
@@ -202,6 +205,9 @@ namespace ts {
         CryptoPeriod& currentECM() { return _cp[_current_ecm]; }
         CryptoPeriod& nextECM()    { return _cp[(_current_ecm + 1) & 0x01]; }
 
+        // Scramble all packets in _batch.
+        bool scrambleBatch();
+
         // Perform CW and ECM transition
         bool changeCW();
         void changeECM();
@@ -264,7 +270,9 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
     _current_cw(0),
     _current_ecm(0),
     _scrambling(*tsp),
-    _pzer_pmt(duck)
+    _pzer_pmt(duck),
+    _batch(),
+    _end_packet(nullptr)
 {
     // We need to define character sets to specify service names.
     duck.defineArgsForCharset(*this);
@@ -420,6 +428,8 @@ bool ts::ScramblerPlugin::start()
     _scrambled_count = 0;
     _ecm_cc = 0;
     _abort = false;
+    _batch.clear();
+    _end_packet = nullptr;
     _degraded_mode = false;
     _ts_bitrate = 0;
     _pkt_insert_ecm = 0;
@@ -683,6 +693,11 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
 
 bool ts::ScramblerPlugin::changeCW()
 {
+    // The pending packets must be scrambled with the previous CW.
+    if (!scrambleBatch()) {
+        return false;
+    }
+
     if (_scrambling.hasFixedCW()) {
         // A list of fixed CW was loaded from a file.
 
@@ -848,16 +863,48 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
         _partial_clear = _partial_scrambling - 1;
     }
 
-    // Scramble the packet payload.
-    if (!_scrambling.encrypt(pkt)) {
-        return TSP_END;
-    }
+    // Scramble the packet payload, later, with the other packets of the same group.
+    _batch.push_back(&pkt);
     _scrambled_count++;
 
     return TSP_OK;
 }
 
 
+//----------------------------------------------------------------------------
+// Scramble all pending packets, before they are passed to the next plugin.
+//----------------------------------------------------------------------------
+
+size_t ts::ScramblerPlugin::completePackets(TSPacket* pkts, TSPacketMetadata*, size_t count)
+{
+    scrambleBatch();
+
+    // End the processing at the first packet which could not be scrambled, if in this group.
+    return _end_packet != nullptr && _end_packet >= pkts && _end_packet < pkts + count ? size_t(_end_packet - pkts) : count;
+}
+
+bool ts::ScramblerPlugin::scrambleBatch()
+{
+    // The packets in the batch were already accepted by processPacket().
+    const bool ok = _batch.empty() || _scrambling.encryptBatch(_batch.data(), _batch.size(), false);
+    if (!ok) {
+        // The packets are encrypted in order. Processing ends at the first one
+        // which was not encrypted. Never pass the others in clear, just in case.
+        for (auto it = _batch.begin(); it != _batch.end(); ++it) {
+            if (!(*it)->isScrambled()) {
+                if (_end_packet == nullptr) {
+                    _end_packet = *it;
+                }
+                **it = NullPacket;
+            }
+        }
+        _abort = true;
+    }
+    _batch.clear();
+    return ok;
+}
+
+
 //----------------------------------------------------------------------------
 // CryptoPeriod default constructor.
 //----------------------------------------------------------------------------
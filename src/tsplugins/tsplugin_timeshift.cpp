@@ -94,6 +94,8 @@ ts::TimeShiftPlugin::TimeShiftPlugin (TSP* tsp_) :
     help(u"memory-packets",
          u"Specify the number of packets which are cached in memory. "
          u"Having a larger memory cache improves the performances. "
+         u"When the buffer file is mapped in memory (the default when possible), this is the approximate "
+         u"number of packets which are loaded in advance and written back by a background thread. "
          u"By default, the size of the memory cache is " +
          UString::Decimal(TimeShiftBuffer::DEFAULT_MEMORY_PACKETS) + u" packets.");
 
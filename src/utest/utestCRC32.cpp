@@ -0,0 +1,211 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::CRC32
+//
+//----------------------------------------------------------------------------
+
+#include "tsCRC32.h"
+#include "tsByteBlock.h"
+#include "tsTime.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class CRC32Test: public tsunit::Test
+{
+public:
+    CRC32Test();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testKnownValues();
+    void testAlgorithms();
+    void testIncremental();
+    void testCombine();
+    void testBenchmark();
+
+    TSUNIT_TEST_BEGIN(CRC32Test);
+    TSUNIT_TEST(testKnownValues);
+    TSUNIT_TEST(testAlgorithms);
+    TSUNIT_TEST(testIncremental);
+    TSUNIT_TEST(testCombine);
+    TSUNIT_TEST(testBenchmark);
+    TSUNIT_TEST_END();
+
+private:
+    ts::ByteBlock _data;
+};
+
+TSUNIT_REGISTER(CRC32Test);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+CRC32Test::CRC32Test() :
+    _data(8192)
+{
+    // Deterministic pseudo-random data.
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < _data.size(); ++i) {
+        seed = seed * 1103515245 + 12345;
+        _data[i] = uint8_t(seed >> 16);
+    }
+}
+
+// Test suite initialization method.
+void CRC32Test::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void CRC32Test::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void CRC32Test::testKnownValues()
+{
+    // Standard check value of CRC-32/MPEG-2.
+    TSUNIT_EQUAL(0x0376E6E7, ts::CRC32("123456789", 9).value());
+    TSUNIT_EQUAL(0xFFFFFFFF, ts::CRC32("", 0).value());
+
+    // CRC32 of a complete section, including its CRC32, is zero.
+    static const uint8_t pat[] = {
+        0x00, 0xB0, 0x11, 0x00, 0x01, 0xC1, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x10,
+        0x00, 0x01, 0xE1, 0x00,
+    };
+    ts::ByteBlock sect(pat, sizeof(pat));
+    sect.appendUInt32(ts::CRC32(pat, sizeof(pat)).value());
+    for (int algo = ts::CRC32::DEFAULT; algo <= ts::CRC32::ACCELERATED; ++algo) {
+        ts::CRC32 crc;
+        crc.add(sect.data(), sect.size(), ts::CRC32::Algorithm(algo));
+        TSUNIT_EQUAL(0, crc.value());
+    }
+}
+
+void CRC32Test::testAlgorithms()
+{
+    debug() << "CRC32Test: accelerated algorithm available: " << ts::UString::YesNo(ts::CRC32::IsAvailable(ts::CRC32::ACCELERATED)) << std::endl;
+    TSUNIT_ASSERT(ts::CRC32::IsAvailable(ts::CRC32::DEFAULT));
+    TSUNIT_ASSERT(ts::CRC32::IsAvailable(ts::CRC32::BYTEWISE));
+    TSUNIT_ASSERT(ts::CRC32::IsAvailable(ts::CRC32::SLICE8));
+    TSUNIT_ASSERT(ts::CRC32::IsAvailable(ts::CRC32::SLICE16));
+
+    // All algorithms must be bit-exact with the bytewise one, for all sizes and alignments.
+    for (size_t offset = 0; offset < 16; ++offset) {
+        for (size_t size = 0; offset + size <= _data.size(); size += (size < 300 ? 1 : 97)) {
+            ts::CRC32 ref;
+            ref.add(_data.data() + offset, size, ts::CRC32::BYTEWISE);
+            for (int algo = ts::CRC32::DEFAULT; algo <= ts::CRC32::ACCELERATED; ++algo) {
+                ts::CRC32 crc;
+                crc.add(_data.data() + offset, size, ts::CRC32::Algorithm(algo));
+                TSUNIT_EQUAL(ref.value(), crc.value());
+            }
+        }
+    }
+}
+
+void CRC32Test::testIncremental()
+{
+    const ts::CRC32 ref(_data.data(), _data.size());
+    for (size_t split = 0; split <= _data.size(); split += 61) {
+        ts::CRC32 crc;
+        crc.add(_data.data(), split);
+        crc.add(_data.data() + split, _data.size() - split);
+        TSUNIT_EQUAL(ref.value(), crc.value());
+    }
+}
+
+void CRC32Test::testCombine()
+{
+    for (size_t size = 0; size <= 1000; size += 7) {
+        const ts::CRC32 ref(_data.data(), size);
+        for (size_t split = 0; split <= size; split += 13) {
+            ts::CRC32 crc1(_data.data(), split);
+            const ts::CRC32 crc2(_data.data() + split, size - split);
+            TSUNIT_EQUAL(ref.value(), ts::CRC32::Combine(crc1.value(), crc2.value(), size - split));
+            crc1.combine(crc2, size - split);
+            TSUNIT_EQUAL(ref.value(), crc1.value());
+        }
+    }
+
+    // Second areas with sizes using several bytes.
+    for (size_t split = 0; split < 1000; split += 111) {
+        const ts::CRC32 ref(_data.data(), _data.size());
+        const ts::CRC32 crc1(_data.data(), split);
+        const ts::CRC32 crc2(_data.data() + split, _data.size() - split);
+        TSUNIT_EQUAL(ref.value(), ts::CRC32::Combine(crc1.value(), crc2.value(), _data.size() - split));
+    }
+
+    // Combining is associative, check with large sizes.
+    const size_t n1 = size_t(0x12345678);
+    const size_t n2 = size_t(0x0FEDCBA9);
+    const uint32_t a = 0x01234567, b = 0x89ABCDEF, c = 0xDEADBEEF;
+    TSUNIT_EQUAL(ts::CRC32::Combine(ts::CRC32::Combine(a, b, n1), c, n2), ts::CRC32::Combine(a, ts::CRC32::Combine(b, c, n2), n1 + n2));
+}
+
+void CRC32Test::testBenchmark()
+{
+    // Micro-benchmark, run in debug mode only.
+    if (!debugMode()) {
+        return;
+    }
+    static const char* const names[] = {"default", "bytewise", "slice-by-8", "slice-by-16", "accelerated"};
+    static const size_t sizes[] = {184, 1024, 4096};
+    const size_t total = 16 * 1024 * 1024;
+
+    for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        const size_t size = sizes[si];
+        for (int algo = ts::CRC32::DEFAULT; algo <= ts::CRC32::ACCELERATED; ++algo) {
+            if (!ts::CRC32::IsAvailable(ts::CRC32::Algorithm(algo))) {
+                continue;
+            }
+            ts::CRC32 crc;
+            const ts::Time start(ts::Time::CurrentUTC());
+            for (size_t done = 0; done < total; done += size) {
+                crc.add(_data.data(), size, ts::CRC32::Algorithm(algo));
+            }
+            const ts::MilliSecond duration = std::max<ts::MilliSecond>(1, ts::Time::CurrentUTC() - start);
+            debug() << ts::UString::Format(u"CRC32Test: %-12s %4d-byte blocks: %6d MB/s", {names[algo], size, (total * 1000) / (duration * 1024 * 1024)}) << std::endl;
+        }
+    }
+}
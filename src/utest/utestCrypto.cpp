@@ -88,6 +88,7 @@ public:
     void testAES_CTS3();
     void testAES_CTS4();
     void testAES_DVS042();
+    void testAES_Blocks();
     void testDES();
     void testTDES();
     void testTDES_CBC();
@@ -111,6 +112,7 @@ public:
     TSUNIT_TEST(testAES_CTS3);
     TSUNIT_TEST(testAES_CTS4);
     TSUNIT_TEST(testAES_DVS042);
+    TSUNIT_TEST(testAES_Blocks);
     TSUNIT_TEST(testDES);
     TSUNIT_TEST(testTDES);
     TSUNIT_TEST(testTDES_CBC);
@@ -417,6 +419,87 @@ void CryptoTest::testAES_DVS042()
     testChainingSizes(dvs042_aes, 16, 17, 23, 31, 32, 33, 45, 64, 67, 184, 12345, 0);
 }
 
+void CryptoTest::testAES_Blocks()
+{
+    // Multi-block processing and chaining modes on more blocks than processed in parallel,
+    // checked against a block-by-block computation.
+    constexpr size_t bsize = ts::AES::BLOCK_SIZE;
+    constexpr size_t count = 37;
+    constexpr size_t residue = 5;
+
+    ts::SystemRandomGenerator prng;
+    ts::ByteBlock plain(count * bsize + residue);
+    ts::ByteBlock iv(bsize);
+    TSUNIT_ASSERT(prng.read(plain.data(), plain.size()));
+    TSUNIT_ASSERT(prng.read(iv.data(), iv.size()));
+
+    for (size_t key_size = 16; key_size <= 32; key_size += 8) {
+        ts::ByteBlock key(key_size);
+        TSUNIT_ASSERT(prng.read(key.data(), key.size()));
+
+        ts::AES aes;
+        TSUNIT_ASSERT(aes.setKey(key.data(), key.size()));
+
+        // Reference ECB, block by block.
+        ts::ByteBlock ecb(count * bsize);
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(aes.encrypt(&plain[i * bsize], bsize, &ecb[i * bsize], bsize));
+        }
+
+        // ECB, multi-blocks, including in place.
+        ts::ByteBlock tmp(count * bsize);
+        TSUNIT_ASSERT(aes.encryptBlocks(plain.data(), tmp.data(), count));
+        TSUNIT_ASSERT(tmp == ecb);
+        TSUNIT_ASSERT(aes.decryptBlocks(tmp.data(), tmp.data(), count));
+        TSUNIT_ASSERT(::memcmp(tmp.data(), plain.data(), count * bsize) == 0);
+        TSUNIT_EQUAL(2 * count, aes.encryptionCount());
+        TSUNIT_EQUAL(count, aes.decryptionCount());
+
+        // Reference CBC, block by block.
+        ts::ByteBlock cbc(count * bsize);
+        const uint8_t* previous = iv.data();
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t block[bsize];
+            for (size_t j = 0; j < bsize; ++j) {
+                block[j] = plain[i * bsize + j] ^ previous[j];
+            }
+            TSUNIT_ASSERT(aes.encrypt(block, bsize, &cbc[i * bsize], bsize));
+            previous = &cbc[i * bsize];
+        }
+
+        ts::CBC<ts::AES> cbc_aes;
+        TSUNIT_ASSERT(cbc_aes.setKey(key.data(), key.size()));
+        TSUNIT_ASSERT(cbc_aes.setIV(iv.data(), iv.size()));
+        TSUNIT_ASSERT(cbc_aes.encrypt(plain.data(), count * bsize, tmp.data(), tmp.size()));
+        TSUNIT_ASSERT(tmp == cbc);
+        TSUNIT_ASSERT(cbc_aes.decryptInPlace(tmp.data(), tmp.size()));
+        TSUNIT_ASSERT(::memcmp(tmp.data(), plain.data(), count * bsize) == 0);
+
+        // Reference CTR, block by block, with a 64-bit counter which wraps in the first blocks.
+        ts::ByteBlock counter(iv);
+        ts::PutUInt64(&counter[8], TS_UCONST64(0xFFFFFFFFFFFFFFFD));
+        ts::ByteBlock ctr(plain.size());
+        ts::ByteBlock current(counter);
+        for (size_t i = 0; i * bsize < plain.size(); ++i) {
+            uint8_t mask[bsize];
+            TSUNIT_ASSERT(aes.encrypt(current.data(), bsize, mask, bsize));
+            for (size_t j = 0; j < bsize && i * bsize + j < plain.size(); ++j) {
+                ctr[i * bsize + j] = plain[i * bsize + j] ^ mask[j];
+            }
+            ts::PutUInt64(&current[8], ts::GetUInt64(&current[8]) + 1);
+        }
+
+        ts::CTR<ts::AES> ctr_aes;
+        ts::ByteBlock tmp2(plain.size());
+        TSUNIT_ASSERT(ctr_aes.setKey(key.data(), key.size()));
+        TSUNIT_ASSERT(ctr_aes.setIV(counter.data(), counter.size()));
+        TSUNIT_ASSERT(ctr_aes.encrypt(plain.data(), plain.size(), tmp2.data(), tmp2.size()));
+        TSUNIT_ASSERT(tmp2 == ctr);
+        TSUNIT_ASSERT(ctr_aes.decryptInPlace(tmp2.data(), tmp2.size()));
+        TSUNIT_ASSERT(tmp2 == plain);
+    }
+}
+
 void CryptoTest::testDES()
 {
     ts::DES des;
@@ -93,6 +93,8 @@ public:
     void testTDT();
     void testTOT();
     void testHEVC();
+    void testTransientSections();
+    void testPooledTableRepetition();
 
     TSUNIT_TEST_BEGIN(DemuxTest);
     TSUNIT_TEST(testPAT);
@@ -106,6 +108,8 @@ public:
     TSUNIT_TEST(testTDT);
     TSUNIT_TEST(testTOT);
     TSUNIT_TEST(testHEVC);
+    TSUNIT_TEST(testTransientSections);
+    TSUNIT_TEST(testPooledTableRepetition);
     TSUNIT_TEST_END();
 
 private:
@@ -490,3 +494,82 @@ void DemuxTest::testHEVC()
 {
     TEST_TABLE("PMT with HEVC descriptor", pmt_hevc);
 }
+
+namespace {
+    // A section handler which collects copies of all sections.
+    class SectionCollector: public ts::SectionHandlerInterface
+    {
+    public:
+        ts::BinaryTable table;
+        SectionCollector() : table() {}
+        virtual void handleSection(ts::SectionDemux& demux, const ts::Section& section) override
+        {
+            table.addSection(new ts::Section(section, ts::ShareMode::SHARE));
+        }
+    };
+}
+
+void DemuxTest::testTransientSections()
+{
+    ts::DuckContext duck;
+    const ts::TSPacket* ref_pkt = reinterpret_cast<const ts::TSPacket*>(psi_bat_tvnum_packets);
+    const size_t ref_count = sizeof(psi_bat_tvnum_packets) / ts::PKT_SIZE;
+
+    // Transient sections, all shared sections shall remain intact.
+    SectionCollector collector1;
+    ts::SectionDemux demux1(duck, nullptr, &collector1, ts::AllPIDs);
+    demux1.setTransientSections(true);
+    for (size_t pi = 0; pi < ref_count; ++pi) {
+        demux1.feedPacket(ref_pkt[pi]);
+    }
+    TSUNIT_ASSERT(collector1.table.isValid());
+    TSUNIT_ASSERT(checkSections("transient sections", "BAT", collector1.table, psi_bat_tvnum_sections, sizeof(psi_bat_tvnum_sections)));
+
+    // Pool of one section, sections are retained by the collector.
+    SectionCollector collector2;
+    ts::SectionDemux demux2(duck, nullptr, &collector2, ts::AllPIDs);
+    demux2.setSectionPoolSize(1);
+    for (size_t pi = 0; pi < ref_count; ++pi) {
+        demux2.feedPacket(ref_pkt[pi]);
+    }
+    TSUNIT_ASSERT(collector2.table.isValid());
+    TSUNIT_ASSERT(checkSections("pooled sections", "BAT", collector2.table, psi_bat_tvnum_sections, sizeof(psi_bat_tvnum_sections)));
+}
+
+namespace {
+    // A table handler which counts and keeps the last table.
+    class TableCollector: public ts::TableHandlerInterface
+    {
+    public:
+        size_t count;
+        ts::BinaryTable table;
+        TableCollector() : count(0), table() {}
+        virtual void handleTable(ts::SectionDemux& demux, const ts::BinaryTable& tab) override
+        {
+            count++;
+            table = tab;
+        }
+    };
+}
+
+void DemuxTest::testPooledTableRepetition()
+{
+    ts::DuckContext duck;
+    const ts::TSPacket* ref_pkt = reinterpret_cast<const ts::TSPacket*>(psi_tdt_tnt_packets);
+    const size_t ref_count = sizeof(psi_tdt_tnt_packets) / ts::PKT_SIZE;
+
+    // Repeated short sections reuse their table context while pooled sections are recycled.
+    TableCollector collector;
+    ts::SectionDemux demux(duck, &collector, nullptr, ts::AllPIDs);
+    for (size_t rep = 0; rep < 5; ++rep) {
+        for (size_t pi = 0; pi < ref_count; ++pi) {
+            ts::TSPacket pkt(ref_pkt[pi]);
+            pkt.setCC(uint8_t((rep * ref_count + pi) & 0x0F));
+            demux.feedPacket(pkt);
+        }
+    }
+    debug() << "DemuxTest::testPooledTableRepetition: " << collector.count << " tables" << std::endl;
+    TSUNIT_EQUAL(5, collector.count);
+    TSUNIT_ASSERT(collector.table.isValid());
+    TSUNIT_ASSERT(checkSections("repeated tables", "TDT", collector.table, psi_tdt_tnt_sections, sizeof(psi_tdt_tnt_sections)));
+}
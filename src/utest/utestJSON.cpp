@@ -40,6 +40,9 @@
 #include "tsjsonString.h"
 #include "tsjsonObject.h"
 #include "tsjsonArray.h"
+#include "tsjsonStreamReader.h"
+#include "tsjsonStreamWriter.h"
+#include "tsTextFormatter.h"
 #include "tsCerrReport.h"
 #include "tsNullReport.h"
 #include "tsunit.h"
@@ -60,12 +63,16 @@ public:
     void testGitHub();
     void testFactory();
     void testQuery();
+    void testStreamWriter();
+    void testStreamReader();
 
     TSUNIT_TEST_BEGIN(JsonTest);
     TSUNIT_TEST(testSimple);
     TSUNIT_TEST(testGitHub);
     TSUNIT_TEST(testFactory);
     TSUNIT_TEST(testQuery);
+    TSUNIT_TEST(testStreamWriter);
+    TSUNIT_TEST(testStreamReader);
     TSUNIT_TEST_END();
 };
 
@@ -696,3 +703,100 @@ void JsonTest::testQuery()
 
     debug() << "JsonTest::testQuery:" << std::endl << root.printed() << std::endl;
 }
+
+void JsonTest::testStreamWriter()
+{
+    // Reference document, built in memory.
+    ts::json::Object ref;
+    ref.add(u"a", ts::json::ValuePtr(new ts::json::Number(12)));
+    ref.query(u"b[]", true).add(u"x", u"foo");
+    ref.query(u"b[]", true).add(u"y", ts::json::ValuePtr(new ts::json::True));
+    ref.query(u"c", true, ts::json::TypeArray).set(ts::json::ValuePtr(new ts::json::Number(1)));
+    ref.query(u"c", true, ts::json::TypeArray).set(ts::json::ValuePtr(new ts::json::String(u"two")));
+    ref.add(u"d", ts::json::ValuePtr(new ts::json::Object));
+
+    // Same document, streamed.
+    ts::TextFormatter text(CERR);
+    text.setString();
+    {
+        ts::json::StreamWriter out(text);
+        out.beginObject();
+        out.add(u"a", 12);
+        out.beginArray(u"b");
+        ts::json::Object elem;
+        elem.add(u"x", u"foo");
+        out.set(elem);
+        out.beginObject();
+        out.add(u"y", ts::json::True());
+        out.end();
+        out.end();
+        out.beginArray(u"c");
+        out.set(1);
+        out.set(u"two");
+        TSUNIT_EQUAL(2, out.depth());
+        out.end();
+        out.beginObject(u"d");
+        // Remaining levels are closed by the destructor.
+    }
+    ts::UString str;
+    text.getString(str);
+
+    debug() << "JsonTest::testStreamWriter: " << std::endl << str << std::endl;
+    TSUNIT_EQUAL(ref.printed(), str);
+}
+
+void JsonTest::testStreamReader()
+{
+    ts::json::StreamReader in(CERR);
+    TSUNIT_ASSERT(in.openText(
+        u"{\n"
+        u"  \"title\": \"foo\",\n"
+        u"  \"items\": [\n"
+        u"    {\"id\": 1, \"tags\": [\"a\", \"b\"]},\n"
+        u"    {\"id\": 2, \"tags\": []}\n"
+        u"  ],\n"
+        u"  \"count\": 2\n"
+        u"}\n"));
+
+    TSUNIT_EQUAL(ts::json::StreamReader::EventBeginObject, in.next());
+    TSUNIT_EQUAL(1, in.depth());
+    TSUNIT_EQUAL(ts::json::StreamReader::EventValue, in.next());
+    TSUNIT_EQUAL(u"title", in.name());
+    TSUNIT_ASSERT(in.value()->isString());
+    TSUNIT_EQUAL(u"foo", in.value()->toString());
+    TSUNIT_EQUAL(ts::json::StreamReader::EventBeginArray, in.next());
+    TSUNIT_EQUAL(u"items", in.name());
+    TSUNIT_EQUAL(2, in.depth());
+
+    // Read array elements one at a time.
+    ts::json::ValuePtr jv;
+    TSUNIT_EQUAL(ts::json::StreamReader::EventValue, in.readValue(jv));
+    TSUNIT_ASSERT(!jv.isNull());
+    TSUNIT_ASSERT(jv->isObject());
+    TSUNIT_EQUAL(1, jv->value(u"id").toInteger());
+    TSUNIT_EQUAL(2, jv->value(u"tags").size());
+    TSUNIT_EQUAL(u"b", jv->value(u"tags").at(1).toString());
+    TSUNIT_EQUAL(4, in.lineNumber());
+    TSUNIT_EQUAL(ts::json::StreamReader::EventValue, in.readValue(jv));
+    TSUNIT_ASSERT(!jv.isNull());
+    TSUNIT_EQUAL(2, jv->value(u"id").toInteger());
+    TSUNIT_EQUAL(0, jv->value(u"tags").size());
+    TSUNIT_EQUAL(ts::json::StreamReader::EventEndArray, in.readValue(jv));
+    TSUNIT_ASSERT(jv.isNull());
+
+    TSUNIT_EQUAL(ts::json::StreamReader::EventValue, in.next());
+    TSUNIT_EQUAL(u"count", in.name());
+    TSUNIT_EQUAL(2, in.value()->toInteger());
+    TSUNIT_EQUAL(ts::json::StreamReader::EventEndObject, in.next());
+    TSUNIT_EQUAL(0, in.depth());
+    TSUNIT_EQUAL(ts::json::StreamReader::EventEnd, in.next());
+
+    // Syntax errors.
+    ts::json::StreamReader bad;
+    TSUNIT_ASSERT(bad.openText(u"[1, 2,, 3]"));
+    TSUNIT_EQUAL(ts::json::StreamReader::EventBeginArray, bad.next());
+    TSUNIT_EQUAL(ts::json::StreamReader::EventValue, bad.next());
+    TSUNIT_EQUAL(ts::json::StreamReader::EventValue, bad.next());
+    TSUNIT_EQUAL(ts::json::StreamReader::EventError, bad.next());
+    TSUNIT_EQUAL(ts::json::StreamReader::EventError, bad.next());
+}
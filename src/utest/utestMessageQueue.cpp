@@ -27,12 +27,13 @@
 //
 //----------------------------------------------------------------------------
 //
-//  TSUnit test suite for class ts::MessageQueue
+//  TSUnit test suite for class ts::MessageQueue and its variants
 //
 //----------------------------------------------------------------------------
 
 #include "tsMessageQueue.h"
 #include "tsMessagePriorityQueue.h"
+#include "tsLockFreeMessageQueue.h"
 #include "tsMonotonic.h"
 #include "tsSysUtils.h"
 #include "tsunit.h"
@@ -55,11 +56,15 @@ public:
     void testConstructor();
     void testQueue();
     void testPriorityQueue();
+    void testLockFreeQueue();
+    void testLockFreeThreads();
 
     TSUNIT_TEST_BEGIN(MessageQueueTest);
     TSUNIT_TEST(testConstructor);
     TSUNIT_TEST(testQueue);
     TSUNIT_TEST(testPriorityQueue);
+    TSUNIT_TEST(testLockFreeQueue);
+    TSUNIT_TEST(testLockFreeThreads);
     TSUNIT_TEST_END();
 private:
     ts::NanoSecond  _nsPrecision;
@@ -272,3 +277,121 @@ void MessageQueueTest::testPriorityQueue()
 
     TSUNIT_ASSERT(!queue.dequeue(msg, 0));
 }
+
+typedef ts::LockFreeMessageQueue<int> LockFreeQueue;
+
+void MessageQueueTest::testLockFreeQueue()
+{
+    LockFreeQueue queue(4);
+    LockFreeQueue::MessagePtr msg;
+
+    TSUNIT_EQUAL(4, queue.getMaxMessages());
+    TSUNIT_EQUAL(LockFreeQueue::DEFAULT_MAX_MESSAGES, LockFreeQueue(0).getMaxMessages());
+
+    TSUNIT_ASSERT(!queue.dequeue(msg, 0));
+    TSUNIT_ASSERT(queue.peek().isNull());
+
+    // Fill the queue, next message is rejected, except forced ones.
+    for (int i = 0; i < 4; ++i) {
+        TSUNIT_ASSERT(queue.enqueue(new int(i), 0));
+    }
+    TSUNIT_ASSERT(!queue.enqueue(new int(100), 0));
+    TSUNIT_ASSERT(!queue.enqueue(new int(100), 20));
+
+    msg = new int(4);
+    queue.forceEnqueue(msg);
+    TSUNIT_ASSERT(msg.isNull());
+
+    msg = queue.peek();
+    TSUNIT_ASSERT(!msg.isNull());
+    TSUNIT_EQUAL(0, *msg);
+
+    // Messages are received in order.
+    for (int i = 0; i < 5; ++i) {
+        TSUNIT_ASSERT(queue.dequeue(msg, 0));
+        TSUNIT_ASSERT(!msg.isNull());
+        TSUNIT_EQUAL(i, *msg);
+    }
+    TSUNIT_ASSERT(!queue.dequeue(msg, 20));
+
+    // Use the ring several times.
+    for (int i = 0; i < 100; ++i) {
+        TSUNIT_ASSERT(queue.enqueue(new int(i), 0));
+        TSUNIT_ASSERT(queue.enqueue(new int(-i), 0));
+        TSUNIT_ASSERT(queue.dequeue(msg, 0));
+        TSUNIT_EQUAL(i, *msg);
+        TSUNIT_ASSERT(queue.dequeue(msg, 0));
+        TSUNIT_EQUAL(-i, *msg);
+    }
+
+    TSUNIT_ASSERT(queue.enqueue(new int(1), 0));
+    queue.clear();
+    TSUNIT_ASSERT(!queue.dequeue(msg, 0));
+}
+
+// Producer thread for testLockFreeThreads()
+namespace {
+    class LockFreeProducerThread: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(LockFreeProducerThread);
+    private:
+        LockFreeQueue& _queue;
+        int _first;
+        int _count;
+    public:
+        LockFreeProducerThread(LockFreeQueue& queue, int first, int count) :
+            utest::TSUnitThread(),
+            _queue(queue),
+            _first(first),
+            _count(count)
+        {
+        }
+
+        ~LockFreeProducerThread()
+        {
+            waitForTermination();
+        }
+
+        virtual void test() override
+        {
+            for (int i = 0; i < _count; ++i) {
+                TSUNIT_ASSERT(_queue.enqueue(new int(_first + i), 10000));
+            }
+        }
+    };
+}
+
+void MessageQueueTest::testLockFreeThreads()
+{
+    static const int THREADS = 4;
+    static const int COUNT = 20000;
+
+    // Small queue, producers frequently wait for free space.
+    LockFreeQueue queue(16);
+    std::vector<int> last(THREADS, -1);
+    {
+        std::vector<ts::SafePtr<LockFreeProducerThread>> threads;
+        for (int i = 0; i < THREADS; ++i) {
+            threads.push_back(new LockFreeProducerThread(queue, i * COUNT, COUNT));
+            TSUNIT_ASSERT(threads.back()->start());
+        }
+
+        // Messages from one producer are received in order.
+        // With one consumer, a peeked message is the next dequeued one.
+        LockFreeQueue::MessagePtr msg;
+        for (int n = 0; n < THREADS * COUNT; ++n) {
+            const LockFreeQueue::MessagePtr next(queue.peek());
+            TSUNIT_ASSERT(queue.dequeue(msg, 10000));
+            TSUNIT_ASSERT(!msg.isNull());
+            TSUNIT_ASSERT(next.isNull() || next.pointer() == msg.pointer());
+            const int producer = *msg / COUNT;
+            TSUNIT_ASSERT(producer >= 0 && producer < THREADS);
+            TSUNIT_ASSERT(*msg % COUNT == last[producer] + 1);
+            last[producer] = *msg % COUNT;
+        }
+        TSUNIT_ASSERT(!queue.dequeue(msg, 0));
+    }
+    for (int i = 0; i < THREADS; ++i) {
+        TSUNIT_EQUAL(COUNT - 1, last[i]);
+    }
+}
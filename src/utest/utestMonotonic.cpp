@@ -53,11 +53,13 @@ public:
     void testArithmetic();
     void testSysWait();
     void testWait();
+    void testPreciseWait();
 
     TSUNIT_TEST_BEGIN(MonotonicTest);
     TSUNIT_TEST(testArithmetic);
     TSUNIT_TEST(testSysWait);
     TSUNIT_TEST(testWait);
+    TSUNIT_TEST(testPreciseWait);
     TSUNIT_TEST_END();
 private:
     ts::NanoSecond  _nsPrecision;
@@ -153,3 +155,26 @@ void MonotonicTest::testWait()
     TSUNIT_ASSERT(end >= start + 100 - _msPrecision);
     TSUNIT_ASSUME(end < start + 150);
 }
+
+void MonotonicTest::testPreciseWait()
+{
+    // Pace 200 periods of 150 micro-seconds, as a 10 Mb/s stream with one packet per period.
+    constexpr ts::NanoSecond period = 150 * ts::NanoSecPerMicroSec;
+    std::vector<ts::NanoSecond> late;
+
+    ts::Monotonic due(true);
+    ts::Monotonic now;
+    for (int i = 0; i < 200; ++i) {
+        due += period;
+        due.preciseWait();
+        now.getSystemTime();
+        TSUNIT_ASSERT(now >= due);
+        late.push_back(now - due);
+    }
+
+    // Use the median value, the maximum depends on the system load.
+    std::sort(late.begin(), late.end());
+    debug() << "MonotonicTest::testPreciseWait: late wake-up: median " << ts::UString::Decimal(late[late.size() / 2])
+            << " ns, max " << ts::UString::Decimal(late.back()) << " ns" << std::endl;
+    TSUNIT_ASSUME(late[late.size() / 2] < 100 * ts::NanoSecPerMicroSec);
+}
@@ -0,0 +1,212 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for MultiPatternMatcher class.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMultiPatternMatcher.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class MultiPatternMatcherTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testEmpty();
+    void testSearch();
+    void testBoundaries();
+    void testMatchAt();
+    void testRandom();
+
+    TSUNIT_TEST_BEGIN(MultiPatternMatcherTest);
+    TSUNIT_TEST(testEmpty);
+    TSUNIT_TEST(testSearch);
+    TSUNIT_TEST(testBoundaries);
+    TSUNIT_TEST(testMatchAt);
+    TSUNIT_TEST(testRandom);
+    TSUNIT_TEST_END();
+
+private:
+    // Check a string against a matcher.
+    static bool Search(const ts::MultiPatternMatcher& matcher, const char* str) { return matcher.search(str, ::strlen(str)); }
+    static bool MatchAt(const ts::MultiPatternMatcher& matcher, const char* str) { return matcher.matchAt(str, ::strlen(str)); }
+};
+
+TSUNIT_REGISTER(MultiPatternMatcherTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void MultiPatternMatcherTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void MultiPatternMatcherTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+void MultiPatternMatcherTest::testEmpty()
+{
+    ts::MultiPatternMatcher matcher;
+    matcher.addPattern("", 0);
+    matcher.compile();
+
+    TSUNIT_ASSERT(matcher.empty());
+    TSUNIT_EQUAL(0, matcher.patternCount());
+    TSUNIT_ASSERT(!Search(matcher, "abcdef"));
+    TSUNIT_ASSERT(!MatchAt(matcher, "abcdef"));
+}
+
+void MultiPatternMatcherTest::testSearch()
+{
+    ts::MultiPatternMatcher matcher;
+    matcher.addPattern("abcd", 4);
+    matcher.addPattern("bce", 3);
+    matcher.addPattern("xyz", 3);
+    matcher.compile();
+
+    TSUNIT_EQUAL(3, matcher.patternCount());
+    TSUNIT_EQUAL(4, matcher.maxPatternSize());
+
+    TSUNIT_ASSERT(Search(matcher, "abcd"));
+    TSUNIT_ASSERT(Search(matcher, "--abcd--"));
+    TSUNIT_ASSERT(Search(matcher, "--abce--"));  // found through a failure transition
+    TSUNIT_ASSERT(Search(matcher, "abababcd"));
+    TSUNIT_ASSERT(Search(matcher, "xxxyz"));
+    TSUNIT_ASSERT(!Search(matcher, ""));
+    TSUNIT_ASSERT(!Search(matcher, "abc"));
+    TSUNIT_ASSERT(!Search(matcher, "abcx-bc-xy"));
+    TSUNIT_ASSERT(!Search(matcher, "ABCD"));
+
+    // Patterns are inside other patterns.
+    matcher.clear();
+    matcher.addPattern("abcdef", 6);
+    matcher.addPattern("cd", 2);
+    matcher.compile();
+    TSUNIT_ASSERT(Search(matcher, "-abcdx"));
+    TSUNIT_ASSERT(!Search(matcher, "-abc-def"));
+}
+
+void MultiPatternMatcherTest::testBoundaries()
+{
+    // One start byte (memchr), a few start bytes (SIMD) and many start bytes (portable).
+    for (size_t count = 1; count <= 12; count += 5) {
+        ts::MultiPatternMatcher matcher;
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t pattern[3] = {uint8_t(0x40 + i), 0x55, uint8_t(0x60 + i)};
+            matcher.addPattern(pattern, sizeof(pattern));
+        }
+        matcher.compile();
+
+        // Last pattern at all positions around the blocks of 16 bytes.
+        for (size_t pos = 0; pos + 3 <= 48; ++pos) {
+            uint8_t buffer[48];
+            ::memset(buffer, 0x55, sizeof(buffer));
+            buffer[pos] = uint8_t(0x40 + count - 1);
+            buffer[pos + 2] = uint8_t(0x60 + count - 1);
+            TSUNIT_ASSERT(matcher.search(buffer, sizeof(buffer)));
+            TSUNIT_ASSERT(!matcher.search(buffer, pos + 2));
+        }
+    }
+}
+
+void MultiPatternMatcherTest::testMatchAt()
+{
+    ts::MultiPatternMatcher matcher;
+    matcher.addPattern("abx", 3);
+    matcher.addPattern("bc", 2);
+    matcher.addPattern("xy", 2);
+    matcher.compile();
+
+    TSUNIT_ASSERT(MatchAt(matcher, "abx"));
+    TSUNIT_ASSERT(MatchAt(matcher, "abxy"));
+    TSUNIT_ASSERT(MatchAt(matcher, "bcd"));
+    TSUNIT_ASSERT(MatchAt(matcher, "xy"));
+    TSUNIT_ASSERT(!MatchAt(matcher, "abc"));  // "bc" is present but not at start
+    TSUNIT_ASSERT(!MatchAt(matcher, "ab"));
+    TSUNIT_ASSERT(!MatchAt(matcher, "-xy"));
+    TSUNIT_ASSERT(!MatchAt(matcher, ""));
+}
+
+void MultiPatternMatcherTest::testRandom()
+{
+    // Simple deterministic pseudo-random generator.
+    uint32_t seed = 12345;
+    auto rand = [&seed](uint32_t max) -> uint32_t { seed = seed * 1103515245 + 12345; return (seed >> 16) % max; };
+
+    // Hundreds of patterns on a small alphabet, compare with a simple search of each pattern.
+    ts::MultiPatternMatcher matcher;
+    std::vector<ts::ByteBlock> patterns;
+    for (size_t i = 0; i < 300; ++i) {
+        ts::ByteBlock pattern(2 + rand(6));
+        for (size_t k = 0; k < pattern.size(); ++k) {
+            pattern[k] = uint8_t(rand(24));
+        }
+        patterns.push_back(pattern);
+        matcher.addPattern(pattern);
+    }
+    matcher.compile();
+
+    size_t found = 0;
+    for (size_t i = 0; i < 500; ++i) {
+        uint8_t buffer[188];
+        for (size_t k = 0; k < sizeof(buffer); ++k) {
+            buffer[k] = uint8_t(rand(64));
+        }
+        bool expected = false;
+        bool expected_at = false;
+        for (auto it = patterns.begin(); it != patterns.end(); ++it) {
+            expected = expected || ts::LocatePattern(buffer, sizeof(buffer), it->data(), it->size()) != nullptr;
+            expected_at = expected_at || ::memcmp(buffer, it->data(), it->size()) == 0;
+        }
+        TSUNIT_EQUAL(expected, matcher.search(buffer, sizeof(buffer)));
+        TSUNIT_EQUAL(expected_at, matcher.matchAt(buffer, sizeof(buffer)));
+        if (expected) {
+            found++;
+        }
+    }
+    debug() << "MultiPatternMatcherTest::testRandom: " << found << " / 500 buffers with patterns" << std::endl;
+}
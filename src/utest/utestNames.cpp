@@ -50,6 +50,7 @@ public:
     virtual void afterTest() override;
 
     void testConfigFile();
+    void testSectionId();
     void testTID();
     void testSharedTID();
     void testDID();
@@ -88,6 +89,7 @@ public:
 
     TSUNIT_TEST_BEGIN(NamesTest);
     TSUNIT_TEST(testConfigFile);
+    TSUNIT_TEST(testSectionId);
     TSUNIT_TEST(testTID);
     TSUNIT_TEST(testSharedTID);
     TSUNIT_TEST(testDID);
@@ -162,6 +164,24 @@ void NamesTest::testConfigFile()
     TSUNIT_EQUAL(0, ts::NamesOUI::Instance()->errorCount());
 }
 
+void NamesTest::testSectionId()
+{
+    const ts::Names* const repo = ts::NamesMain::Instance();
+    const ts::Names::SectionId st = repo->sectionId(u"StreamType");
+
+    TSUNIT_ASSERT(st != ts::Names::NO_SECTION);
+    TSUNIT_EQUAL(st, repo->sectionId(u"streamtype"));
+    TSUNIT_EQUAL(st, repo->sectionId(u" STREAMTYPE "));
+    TSUNIT_ASSERT(st != repo->sectionId(u"TableId"));
+    TSUNIT_EQUAL(ts::Names::NO_SECTION, repo->sectionId(u"NonExistentSection"));
+
+    TSUNIT_ASSERT(repo->nameExists(st, 0x1B));
+    TSUNIT_ASSERT(!repo->nameExists(ts::Names::NO_SECTION, 0x1B));
+    TSUNIT_EQUAL(repo->nameFromSection(u"StreamType", 0x1B, ts::names::VALUE), repo->nameFromSection(st, 0x1B, ts::names::VALUE));
+    TSUNIT_EQUAL(u"unknown (0x1B)", repo->nameFromSection(ts::Names::NO_SECTION, 0x1B, ts::names::VALUE, 8));
+    TSUNIT_EQUAL(repo->nameFromSection(st, 0x1B), repo->nameFromSectionWithFallback(st, 0xFFFF1B, 0x1B));
+}
+
 void NamesTest::testTID()
 {
     ts::DuckContext duck;
@@ -0,0 +1,124 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::PCRAnalyzer
+//
+//----------------------------------------------------------------------------
+
+#include "tsPCRAnalyzer.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class PCRAnalyzerTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testWrap();
+
+    TSUNIT_TEST_BEGIN(PCRAnalyzerTest);
+    TSUNIT_TEST(testWrap);
+    TSUNIT_TEST_END();
+
+private:
+    static bool near(ts::BitRate value, ts::BitRate expected);
+};
+
+TSUNIT_REGISTER(PCRAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+void PCRAnalyzerTest::beforeTest()
+{
+}
+
+void PCRAnalyzerTest::afterTest()
+{
+}
+
+// Check that a bitrate is within 0.1% of the expected value.
+bool PCRAnalyzerTest::near(ts::BitRate value, ts::BitRate expected)
+{
+    return value >= expected - expected / 1000 && value <= expected + expected / 1000;
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+// Constant bitrate stream at 2 Mb/s with a PCR wrap up after 5 seconds.
+// PID 100 (1/5 of the stream) carries the PCR, PID 200 (1/5) has no PCR,
+// PID 300 (3/5) has no PCR.
+void PCRAnalyzerTest::testWrap()
+{
+    const ts::BitRate bitrate = 2000000;
+    const uint64_t start = ts::PCR_SCALE - 5 * ts::SYSTEM_CLOCK_FREQ;
+    uint8_t cc[3] = {0, 0, 0};
+
+    ts::PCRAnalyzer zer(1, 16);
+    TSUNIT_ASSERT(!zer.bitrateIsValid());
+    TSUNIT_EQUAL(0, zer.instantaneousBitrate188(100));
+
+    for (uint64_t n = 0; n < 20000; ++n) {
+        const size_t k = n % 5 == 0 ? 0 : (n % 5 == 1 ? 1 : 2);
+        ts::TSPacket pkt(ts::NullPacket);
+        pkt.setPID(ts::PID(100 * (k + 1)));
+        pkt.setCC(cc[k]++ & 0x0F);
+        if (k == 0 && n % 20 == 0) {
+            pkt.setPCR((start + (n * ts::PKT_SIZE * 8 * ts::SYSTEM_CLOCK_FREQ) / bitrate) % ts::PCR_SCALE, true);
+        }
+        zer.feedPacket(pkt);
+
+        // Check values after 2 seconds, including around the wrap up.
+        if (n >= 2700 && n % 500 == 0) {
+            TSUNIT_ASSERT(zer.bitrateIsValid());
+            TSUNIT_ASSERT(near(zer.bitrate188(), bitrate));
+            TSUNIT_ASSERT(near(zer.instantaneousBitrate188(), bitrate));
+            TSUNIT_ASSERT(near(zer.instantaneousBitrate204(), (bitrate * ts::PKT_RS_SIZE) / ts::PKT_SIZE));
+            TSUNIT_ASSERT(near(zer.instantaneousBitrate188(100), bitrate / 5));
+            TSUNIT_ASSERT(near(zer.instantaneousBitrate188(200), bitrate / 5));
+            TSUNIT_ASSERT(near(zer.instantaneousBitrate188(300), (bitrate * 3) / 5));
+            TSUNIT_ASSERT(near(zer.instantaneousBitrate204(300), (bitrate * 3 * ts::PKT_RS_SIZE) / (5 * ts::PKT_SIZE)));
+            TSUNIT_EQUAL(0, zer.instantaneousBitrate188(400));
+        }
+    }
+
+    ts::PCRAnalyzer::Status status(zer);
+    TSUNIT_EQUAL(0, status.discontinuities);
+}
@@ -33,6 +33,7 @@
 
 #include "tsPESOneShotPacketizer.h"
 #include "tsPESDemux.h"
+#include "tsScatteredPESPacket.h"
 #include "tsDuckContext.h"
 #include "tsTSPacket.h"
 #include "tsCerrReport.h"
@@ -52,14 +53,20 @@ public:
     virtual void afterTest() override;
 
     void testPacketizer();
+    void testScatterGather();
+    void testScatteredSplitHeader();
 
     TSUNIT_TEST_BEGIN(PESPacketizerTest);
     TSUNIT_TEST(testPacketizer);
+    TSUNIT_TEST(testScatterGather);
+    TSUNIT_TEST(testScatteredSplitHeader);
     TSUNIT_TEST_END();
 
 private:
     size_t _pes_count;
+    ts::PESPacketPtrVector _pes_list;
     virtual void handlePESPacket(ts::PESDemux& demux, const ts::PESPacket& packet) override;
+    virtual void handleScatteredPESPacket(ts::PESDemux& demux, const ts::ScatteredPESPacket& packet) override;
 };
 
 TSUNIT_REGISTER(PESPacketizerTest);
@@ -71,7 +78,8 @@ TSUNIT_REGISTER(PESPacketizerTest);
 
 // Constructor.
 PESPacketizerTest::PESPacketizerTest() :
-    _pes_count(0)
+    _pes_count(0),
+    _pes_list()
 {
 }
 
@@ -79,6 +87,7 @@ PESPacketizerTest::PESPacketizerTest() :
 void PESPacketizerTest::beforeTest()
 {
     _pes_count = 0;
+    _pes_list.clear();
 }
 
 // Test suite cleanup method.
@@ -174,3 +183,107 @@ void PESPacketizerTest::handlePESPacket(ts::PESDemux& demux, const ts::PESPacket
             TSUNIT_FAIL("invalid PES packet count");
     }
 }
+
+void PESPacketizerTest::testScatterGather()
+{
+    // Build PES packets of various sizes, with a long header.
+    ts::DuckContext duck;
+    ts::PESOneShotPacketizer zer(duck, 200, &CERR);
+    ts::PESPacketPtrVector input;
+    for (size_t size = 20; size < 40000; size = 3 * size + 1) {
+        ts::ByteBlock data(size);
+        for (size_t i = 0; i < size; i++) {
+            data[i] = uint8_t(i + size);
+        }
+        data[0] = 0x00;
+        data[1] = 0x00;
+        data[2] = 0x01;
+        data[3] = 0xE0;  // video stream, long header
+        ts::PutUInt16(data.data() + 4, uint16_t(size - 6));
+        data[6] = 0x80;
+        data[7] = 0x00;
+        data[8] = 0x00;  // PES header data length
+        input.push_back(new ts::PESPacket(data));
+        zer.addPES(*input.back(), ts::ShareMode::SHARE);
+    }
+
+    ts::TSPacketVector packets;
+    zer.getPackets(packets);
+
+    // Demux in scatter-gather mode.
+    ts::PESDemux demux(duck, this);
+    demux.setScatterGather(true);
+    TSUNIT_ASSERT(demux.scatterGather());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        demux.feedPacket(packets[i]);
+    }
+
+    // All PES packets have an explicit size, they are returned without waiting for the next PUSI.
+    TSUNIT_EQUAL(0, _pes_count);
+    TSUNIT_EQUAL(input.size(), _pes_list.size());
+    for (size_t i = 0; i < input.size() && i < _pes_list.size(); ++i) {
+        TSUNIT_ASSERT(_pes_list[i]->isValid());
+        TSUNIT_EQUAL(200, _pes_list[i]->getSourcePID());
+        TSUNIT_ASSERT(*input[i] == *_pes_list[i]);
+    }
+}
+
+void PESPacketizerTest::handleScatteredPESPacket(ts::PESDemux& demux, const ts::ScatteredPESPacket& pes)
+{
+    TSUNIT_ASSERT(pes.isValid());
+    TSUNIT_EQUAL(200, pes.getSourcePID());
+    TSUNIT_EQUAL(9, pes.headerSize());
+    TSUNIT_EQUAL(0xE0, pes.getStreamId());
+    TSUNIT_ASSERT(pes.segmentCount() > 0);
+
+    // The sum of segments is the PES packet.
+    size_t total = 0;
+    for (size_t i = 0; i < pes.segmentCount(); ++i) {
+        TSUNIT_ASSERT(pes.segmentData(i) != nullptr);
+        total += pes.segmentSize(i);
+    }
+    TSUNIT_EQUAL(total, pes.size());
+
+    // Gather a part across segments.
+    uint8_t buf[300];
+    const size_t len = pes.read(100, buf, sizeof(buf));
+    TSUNIT_EQUAL(std::min<size_t>(sizeof(buf), pes.size() > 100 ? pes.size() - 100 : 0), len);
+    for (size_t i = 0; i < len; ++i) {
+        TSUNIT_EQUAL(uint8_t(100 + i + pes.size()), buf[i]);
+    }
+
+    // Flatten on demand, the flattened packet remains valid after the handler.
+    const ts::PESPacketPtr flat(pes.getPESPacket());
+    TSUNIT_ASSERT(flat == pes.getPESPacket());
+    TSUNIT_EQUAL(pes.size(), flat->size());
+    _pes_list.push_back(flat);
+}
+
+void PESPacketizerTest::testScatteredSplitHeader()
+{
+    // The PES header is split after 1 or 2 bytes in the first TS packet.
+    for (size_t first = 1; first <= 2; ++first) {
+        ts::TSPacket pkt1;
+        pkt1.init(200, 0, 0x00);
+        pkt1.setPUSI();
+        TSUNIT_ASSERT(pkt1.setPayloadSize(first));
+        TSUNIT_EQUAL(first, pkt1.getPayloadSize());
+
+        // Remaining part of the header: 00 00 01 E0 (size) 80 00 00, then payload.
+        static const uint8_t header[] = {0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x80, 0x00, 0x00};
+        ts::TSPacket pkt2;
+        pkt2.init(200, 1, 0x47);
+        ::memcpy(pkt2.getPayload(), header + first, sizeof(header) - first);
+        ts::PutUInt16(pkt2.getPayload() + 4 - first, uint16_t(first + ts::PKT_SIZE - 4 - 6));
+
+        ts::ScatteredPESPacket pes(200);
+        pes.append(pkt1);
+        pes.append(pkt2);
+        TSUNIT_ASSERT(pes.validate());
+        TSUNIT_ASSERT(pes.isValid());
+        TSUNIT_EQUAL(0xE0, pes.getStreamId());
+        TSUNIT_EQUAL(9, pes.headerSize());
+        TSUNIT_EQUAL(first + ts::PKT_SIZE - 4, pes.size());
+        TSUNIT_EQUAL(0xE0, pes.getPESPacket()->getStreamId());
+    }
+}
@@ -0,0 +1,286 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for PacketFilter class.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPacketFilter.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class PacketFilterTest: public tsunit::Test
+{
+public:
+    PacketFilterTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testEmpty();
+    void testPID();
+    void testHeader();
+    void testStreamId();
+    void testIndex();
+    void testMetadata();
+    void testPattern();
+
+    TSUNIT_TEST_BEGIN(PacketFilterTest);
+    TSUNIT_TEST(testEmpty);
+    TSUNIT_TEST(testPID);
+    TSUNIT_TEST(testHeader);
+    TSUNIT_TEST(testStreamId);
+    TSUNIT_TEST(testIndex);
+    TSUNIT_TEST(testMetadata);
+    TSUNIT_TEST(testPattern);
+    TSUNIT_TEST_END();
+
+private:
+    ts::TSPacketMetadata _mdata;
+};
+
+TSUNIT_REGISTER(PacketFilterTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+PacketFilterTest::PacketFilterTest() :
+    _mdata()
+{
+}
+
+// Test suite initialization method.
+void PacketFilterTest::beforeTest()
+{
+    _mdata.reset();
+}
+
+// Test suite cleanup method.
+void PacketFilterTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+void PacketFilterTest::testEmpty()
+{
+    ts::PacketFilter filter;
+    filter.reset();
+
+    ts::TSPacket pkt;
+    pkt.init(100);
+    TSUNIT_ASSERT(!filter.match(pkt, _mdata, 0));
+    TSUNIT_ASSERT(!filter.match(ts::NullPacket, _mdata, 1));
+
+    filter.negate = true;
+    filter.reset();
+    TSUNIT_ASSERT(filter.match(pkt, _mdata, 2));
+}
+
+void PacketFilterTest::testPID()
+{
+    ts::PacketFilter filter;
+    filter.pids.set(100);
+    filter.pids.set(ts::PID_NULL);
+    filter.reset();
+
+    ts::TSPacket pkt;
+    pkt.init(100);
+    TSUNIT_ASSERT(filter.match(pkt, _mdata, 0));
+    TSUNIT_ASSERT(filter.match(ts::NullPacket, _mdata, 1));
+    pkt.setPID(101);
+    TSUNIT_ASSERT(!filter.match(pkt, _mdata, 2));
+
+    filter.negate = true;
+    filter.reset();
+    TSUNIT_ASSERT(filter.match(pkt, _mdata, 3));
+    TSUNIT_ASSERT(!filter.match(ts::NullPacket, _mdata, 4));
+
+    filter.clear();
+    filter.reset();
+    TSUNIT_ASSERT(!filter.match(ts::NullPacket, _mdata, 5));
+}
+
+void PacketFilterTest::testHeader()
+{
+    ts::PacketFilter filter;
+    ts::TSPacket pkt;
+    pkt.init(100);
+
+    filter.unit_start = true;
+    filter.reset();
+    TSUNIT_ASSERT(!filter.match(pkt, _mdata, 0));
+    pkt.setPUSI();
+    TSUNIT_ASSERT(filter.match(pkt, _mdata, 1));
+
+    filter.clear();
+    filter.scrambling_control = 2;
+    filter.reset();
+    TSUNIT_ASSERT(!filter.match(pkt, _mdata, 0));
+    pkt.setScrambling(3);
+    TSUNIT_ASSERT(!filter.match(pkt, _mdata, 1));
+    pkt.setScrambling(2);
+    TSUNIT_ASSERT(filter.match(pkt, _mdata, 2));
+
+    filter.clear();
+    filter.scrambling_control = 0;
+    filter.reset();
+    TSUNIT_ASSERT(!filter.match(pkt, _mdata, 0));
+    TSUNIT_ASSERT(filter.match(ts::NullPacket, _mdata, 1));
+
+    filter.clear();
+    filter.valid = true;
+    filter.reset();
+    TSUNIT_ASSERT(filter.match(pkt, _mdata, 0));
+    pkt.setTEI();
+    TSUNIT_ASSERT(!filter.match(pkt, _mdata, 1));
+    pkt.setTEI(false);
+    pkt.b[0] = 0x48;
+    TSUNIT_ASSERT(!filter.match(pkt, _mdata, 2));
+
+    filter.clear();
+    filter.payload = true;
+    filter.reset();
+    TSUNIT_ASSERT(filter.match(ts::NullPacket, _mdata, 0));
+    filter.payload = false;
+    filter.adaptation_field = true;
+    filter.reset();
+    TSUNIT_ASSERT(!filter.match(ts::NullPacket, _mdata, 0));
+}
+
+void PacketFilterTest::testStreamId()
+{
+    ts::PacketFilter filter;
+    filter.stream_ids.insert(0xE0);
+    filter.reset();
+
+    // Start of a video PES packet on PID 100.
+    ts::TSPacket pes;
+    pes.init(100);
+    pes.setPUSI();
+    pes.b[4] = 0x00;
+    pes.b[5] = 0x00;
+    pes.b[6] = 0x01;
+    pes.b[7] = 0xE0;
+
+    ts::TSPacket next;
+    next.init(100);
+
+    TSUNIT_ASSERT(!filter.match(next, _mdata, 0));
+    TSUNIT_ASSERT(filter.match(pes, _mdata, 1));
+    TSUNIT_ASSERT(filter.match(next, _mdata, 2));
+
+    // Another stream id on the same PID deselects it.
+    pes.b[7] = 0xC0;
+    TSUNIT_ASSERT(!filter.match(pes, _mdata, 3));
+    TSUNIT_ASSERT(!filter.match(next, _mdata, 4));
+
+    // Explicit PID's are never deselected.
+    filter.pids.set(100);
+    filter.reset();
+    TSUNIT_ASSERT(filter.match(pes, _mdata, 5));
+    TSUNIT_ASSERT(filter.match(next, _mdata, 6));
+}
+
+void PacketFilterTest::testIndex()
+{
+    ts::PacketFilter filter;
+    filter.after_packets = 10;
+    filter.every_packets = 5;
+    filter.intervals.push_back(std::make_pair(12, 13));
+    filter.reset();
+
+    ts::UString selected;
+    for (ts::PacketCounter i = 0; i < 30; ++i) {
+        if (filter.match(ts::NullPacket, _mdata, i)) {
+            selected += ts::UString::Format(u" %d", {i});
+        }
+    }
+    TSUNIT_EQUAL(u" 10 12 13 15 20 25", selected);
+
+    // Initial packets are never selected, even with negation.
+    filter.negate = true;
+    filter.reset();
+    TSUNIT_ASSERT(!filter.match(ts::NullPacket, _mdata, 0));
+    TSUNIT_ASSERT(!filter.match(ts::NullPacket, _mdata, 10));
+    TSUNIT_ASSERT(filter.match(ts::NullPacket, _mdata, 11));
+}
+
+void PacketFilterTest::testMetadata()
+{
+    ts::PacketFilter filter;
+    filter.labels.set(3);
+    filter.nullified = true;
+    filter.reset();
+
+    TSUNIT_ASSERT(!filter.match(ts::NullPacket, _mdata, 0));
+    _mdata.setLabel(2);
+    TSUNIT_ASSERT(!filter.match(ts::NullPacket, _mdata, 1));
+    _mdata.setLabel(3);
+    TSUNIT_ASSERT(filter.match(ts::NullPacket, _mdata, 2));
+    _mdata.reset();
+    _mdata.setNullified(true);
+    TSUNIT_ASSERT(filter.match(ts::NullPacket, _mdata, 3));
+}
+
+void PacketFilterTest::testPattern()
+{
+    ts::PacketFilter filter;
+    filter.patterns.push_back(ts::ByteBlock({0x12, 0x34, 0x56}));
+    filter.patterns.push_back(ts::ByteBlock({0xAB, 0xCD}));
+    filter.reset();
+
+    ts::TSPacket pkt;
+    pkt.init(100, 0, 0x00);
+    TSUNIT_ASSERT(!filter.match(pkt, _mdata, 0));
+    pkt.b[100] = 0xAB;
+    pkt.b[101] = 0xCD;
+    TSUNIT_ASSERT(filter.match(pkt, _mdata, 1));
+
+    // Search at a fixed offset in the payload.
+    filter.search_payload = true;
+    filter.use_search_offset = true;
+    filter.search_offset = 96;
+    filter.reset();
+    TSUNIT_ASSERT(filter.match(pkt, _mdata, 2));
+    filter.search_offset = 95;
+    filter.reset();
+    TSUNIT_ASSERT(!filter.match(pkt, _mdata, 3));
+}
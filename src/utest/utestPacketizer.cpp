@@ -40,6 +40,7 @@
 #include "tsPMT.h"
 #include "tsSDT.h"
 #include "tsNames.h"
+#include "tsTime.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
 
@@ -59,14 +60,25 @@ public:
     virtual void afterTest() override;
 
     void testPacketizer();
+    void testCache();
+    void testScheduling();
+    void testBenchmark();
 
     TSUNIT_TEST_BEGIN(PacketizerTest);
     TSUNIT_TEST(testPacketizer);
+    TSUNIT_TEST(testCache);
+    TSUNIT_TEST(testScheduling);
+    TSUNIT_TEST(testBenchmark);
     TSUNIT_TEST_END();
 
 private:
     // Demux one table from a list of packets
     static void DemuxTable(ts::BinaryTablePtr& binTable, const char* name, const uint8_t* packets, size_t packets_size);
+
+    // Packet indexes where each section starts, indexed by section number in the carousel.
+    typedef std::map<size_t, std::vector<ts::PacketCounter>> SectionSchedule;
+    static void AddSchedSections(ts::CyclingPacketizer& pzer, size_t count, ts::MilliSecond repetition);
+    static void GetSchedule(SectionSchedule& sched, ts::CyclingPacketizer& pzer, size_t packets);
 };
 
 TSUNIT_REGISTER(PacketizerTest);
@@ -178,3 +190,194 @@ void PacketizerTest::testPacketizer()
     TSUNIT_ASSERT(pmt_count == 4);
     TSUNIT_ASSERT(sdt_count >= 15 && sdt_count <= 18);
 }
+
+void PacketizerTest::testCache()
+{
+    // Build sections of various sizes, including sizes which end exactly at a packet boundary.
+    ts::DuckContext duck;
+    ts::SectionPtrVector sections;
+    const size_t sizes[] = {10, 170, 179, 180, 183, 360, 367, 1000, 4000};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        ts::ByteBlock payload(sizes[i]);
+        for (size_t j = 0; j < payload.size(); ++j) {
+            payload[j] = uint8_t(i + j);
+        }
+        if (i % 2 == 0) {
+            // Short section, 3-byte header.
+            sections.push_back(new ts::Section(ts::TID(0x80 + i), true, payload.data(), payload.size() - 3));
+        }
+        else {
+            // Long section, 8-byte header + 4-byte CRC32.
+            sections.push_back(new ts::Section(ts::TID(0x80 + i), true, uint16_t(i), 0, true, 0, 0, payload.data(), payload.size() - 12));
+        }
+        TSUNIT_ASSERT(sections.back()->isValid());
+        TSUNIT_EQUAL(sizes[i], sections.back()->size());
+    }
+
+    const ts::BitRate bitrate = ts::PKT_SIZE * 8 * 100; // 100 packets per second
+    const ts::CyclingPacketizer::StuffingPolicy policies[] = {ts::CyclingPacketizer::NEVER, ts::CyclingPacketizer::AT_END, ts::CyclingPacketizer::ALWAYS};
+
+    for (size_t pol = 0; pol < 3; ++pol) {
+        for (int split = 0; split < 2; ++split) {
+
+            // Packetizers with default cache, small cache and without cache must generate the same packets.
+            ts::CyclingPacketizer pz1(duck, 100, policies[pol], bitrate);
+            ts::CyclingPacketizer pz2(duck, 100, policies[pol], bitrate);
+            ts::CyclingPacketizer pz3(duck, 100, policies[pol], bitrate);
+            ts::CyclingPacketizer* const pzers[] = {&pz1, &pz2, &pz3};
+            pz2.setCacheSize(3);
+            pz3.setCacheSize(0);
+            TSUNIT_EQUAL(ts::Packetizer::DEFAULT_CACHE_SIZE, pz1.cacheSize());
+            TSUNIT_EQUAL(3, pz2.cacheSize());
+            TSUNIT_EQUAL(0, pz3.cacheSize());
+
+            for (size_t i = 0; i < 3; ++i) {
+                pzers[i]->allowHeaderSplit(split != 0);
+                for (size_t j = 0; j < sections.size(); ++j) {
+                    pzers[i]->addSection(sections[j], j % 3 == 0 ? 0 : 50 * j);
+                }
+            }
+
+            for (size_t pi = 0; pi < 2000; ++pi) {
+                if (pi == 700) {
+                    // Replace one section with another one with identical content and one with distinct content.
+                    ts::SectionPtr same(new ts::Section(*sections[1], ts::ShareMode::COPY));
+                    ts::SectionPtr other(new ts::Section(*sections[3], ts::ShareMode::COPY));
+                    other->setVersion(1);
+                    for (size_t i = 0; i < 3; ++i) {
+                        pzers[i]->removeSections(sections[1]->tableId());
+                        pzers[i]->removeSections(sections[3]->tableId());
+                        pzers[i]->addSection(same, 100);
+                        pzers[i]->addSection(other);
+                    }
+                }
+                ts::TSPacket pkt1, pkt2, pkt3;
+                pz1.getNextPacket(pkt1);
+                pz2.getNextPacket(pkt2);
+                pz3.getNextPacket(pkt3);
+                TSUNIT_ASSERT(pkt1 == pkt3);
+                TSUNIT_ASSERT(pkt2 == pkt3);
+                TSUNIT_EQUAL(pz1.atCycleBoundary(), pz3.atCycleBoundary());
+            }
+            TSUNIT_EQUAL(pz1.sectionCount(), pz3.sectionCount());
+            TSUNIT_EQUAL(pz2.sectionCount(), pz3.sectionCount());
+            TSUNIT_EQUAL(pz1.nextContinuityCounter(), pz3.nextContinuityCounter());
+        }
+    }
+}
+
+// Add schedule-like sections in a packetizer. Each section fits in one packet.
+void PacketizerTest::AddSchedSections(ts::CyclingPacketizer& pzer, size_t count, ts::MilliSecond repetition)
+{
+    const ts::ByteBlock payload(150, 0x5A);
+    for (size_t i = 0; i < count; ++i) {
+        pzer.addSection(new ts::Section(ts::TID_EIT_S_ACT_MIN + ts::TID(i % 16), false, uint16_t(i / 16), 0, true, 0, 0, payload.data(), payload.size()), repetition);
+    }
+}
+
+// Get the packet indexes where each section starts, the section number is rebuilt from the table id and extension.
+void PacketizerTest::GetSchedule(SectionSchedule& sched, ts::CyclingPacketizer& pzer, size_t packets)
+{
+    sched.clear();
+    ts::TSPacket pkt;
+    for (size_t pi = 0; pi < packets; ++pi) {
+        if (pzer.getNextPacket(pkt)) {
+            TSUNIT_ASSERT(pkt.getPUSI());
+            const uint8_t* sect = pkt.b + 5 + pkt.b[4];
+            sched[16 * ts::GetUInt16(sect + 3) + (sect[0] - ts::TID_EIT_S_ACT_MIN)].push_back(pi);
+        }
+    }
+}
+
+void PacketizerTest::testScheduling()
+{
+    ts::DuckContext duck;
+    SectionSchedule sched;
+
+    // Three sections with distinct repetition rates. At 1,880,000 b/s, 100 ms is 125 packets.
+    // Each section is sent exactly at its repetition rate, starting at the first packets.
+    {
+        ts::CyclingPacketizer pzer(duck, ts::PID_EIT, ts::CyclingPacketizer::ALWAYS, 1880000);
+        const ts::ByteBlock payload(150, 0x5A);
+        const ts::MilliSecond reps[] = {100, 200, 500};
+        const ts::PacketCounter dist[] = {125, 250, 625};
+        for (size_t i = 0; i < 3; ++i) {
+            pzer.addSection(new ts::Section(ts::TID(ts::TID_EIT_S_ACT_MIN + i), false, 0, 0, true, 0, 0, payload.data(), payload.size()), reps[i]);
+        }
+
+        const size_t packets = 12500;
+        GetSchedule(sched, pzer, packets);
+        TSUNIT_EQUAL(3, sched.size());
+        ts::PacketCounter total = 0;
+        for (size_t i = 0; i < 3; ++i) {
+            const std::vector<ts::PacketCounter>& pkts(sched[i]);
+            TSUNIT_ASSERT(!pkts.empty());
+            TSUNIT_ASSERT(pkts.front() < 3);
+            TSUNIT_EQUAL(1 + (packets - 1 - pkts.front()) / dist[i], pkts.size());
+            for (size_t n = 1; n < pkts.size(); ++n) {
+                TSUNIT_EQUAL(dist[i], pkts[n] - pkts[n-1]);
+            }
+            total += pkts.size();
+        }
+        TSUNIT_EQUAL(100 + 50 + 20, total);
+        TSUNIT_EQUAL(total, pzer.sectionCount());
+    }
+
+    // Large carousel: 10,000 sections with a 1 second repetition rate, 20,000 packets per second.
+    // All sections are sent once per second, in the same order.
+    {
+        const size_t count = 10000;
+        const ts::BitRate bitrate = 20000 * 8 * ts::PKT_SIZE;
+        ts::CyclingPacketizer pzer(duck, ts::PID_EIT, ts::CyclingPacketizer::ALWAYS, bitrate);
+        AddSchedSections(pzer, count, 1000);
+        TSUNIT_EQUAL(count, pzer.storedSectionCount());
+
+        GetSchedule(sched, pzer, 40000);
+        TSUNIT_EQUAL(count, sched.size());
+        TSUNIT_EQUAL(2 * count, pzer.sectionCount());
+        std::vector<size_t> order1(count);
+        std::vector<size_t> order2(count);
+        for (auto it = sched.begin(); it != sched.end(); ++it) {
+            TSUNIT_EQUAL(2, it->second.size());
+            TSUNIT_ASSERT(it->second[0] < count);
+            TSUNIT_EQUAL(20000, it->second[1] - it->second[0]);
+            order1[it->second[0]] = it->first;
+            order2[it->second[1] - 20000] = it->first;
+        }
+        TSUNIT_ASSERT(order1 == order2);
+    }
+}
+
+void PacketizerTest::testBenchmark()
+{
+    // Micro-benchmark of large carousels of scheduled sections, run in debug mode only.
+    // The cost per provided section shall not significantly depend on the number of sections.
+    if (!debugMode()) {
+        return;
+    }
+    ts::DuckContext duck;
+    const size_t counts[] = {10, 100, 1000, 10000, 100000};
+    const size_t packets = 200000;
+    const ts::BitRate bitrate = 20000000;
+    ts::ByteBlock payload(150, 0x5A);
+
+    for (size_t ci = 0; ci < sizeof(counts) / sizeof(counts[0]); ++ci) {
+        const size_t count = counts[ci];
+        ts::CyclingPacketizer pzer(duck, ts::PID_EIT, ts::CyclingPacketizer::ALWAYS, bitrate);
+        for (size_t i = 0; i < count; ++i) {
+            // Schedule-like sections with mixed repetition rates, from 100 ms to 10 seconds.
+            pzer.addSection(new ts::Section(ts::TID_EIT_S_ACT_MIN + ts::TID(i % 16), false, uint16_t(i / 16), 0, true, 0, 0, payload.data(), payload.size()),
+                            100 * ts::MilliSecond(1 + i % 100));
+        }
+        TSUNIT_EQUAL(count, pzer.storedSectionCount());
+
+        ts::TSPacket pkt;
+        const ts::Time start(ts::Time::CurrentUTC());
+        for (size_t pi = 0; pi < packets; ++pi) {
+            pzer.getNextPacket(pkt);
+        }
+        const ts::MilliSecond duration = std::max<ts::MilliSecond>(1, ts::Time::CurrentUTC() - start);
+        TSUNIT_ASSERT(pzer.sectionCount() > 0);
+        debug() << ts::UString::Format(u"PacketizerTest: %6d scheduled sections: %4d ns/packet, %'d sections provided", {count, (duration * 1000000) / packets, pzer.sectionCount()}) << std::endl;
+    }
+}
@@ -121,6 +121,7 @@ public:
     void testGetIntVarLE();
     void testPutIntVarBE();
     void testPutIntVarLE();
+    void testLocateZeroZero();
 
     TSUNIT_TEST_BEGIN(PlatformTest);
     TSUNIT_TEST(testIntegerTypes);
@@ -195,6 +196,7 @@ public:
     TSUNIT_TEST(testGetIntVarLE);
     TSUNIT_TEST(testPutIntVarBE);
     TSUNIT_TEST(testPutIntVarLE);
+    TSUNIT_TEST(testLocateZeroZero);
     TSUNIT_TEST_END();
 };
 
@@ -877,3 +879,36 @@ void PlatformTest::testPutIntVarLE()
     ts::PutIntVarLE(out, 8, TS_UCONST64(0x908F8E8D8C8B8A89));
     TSUNIT_EQUAL(0, ::memcmp(out, _bytes + 0x89, 8));
 }
+
+void PlatformTest::testLocateZeroZero()
+{
+    // Pseudo-random data with many zeroes, compared with the generic LocatePattern().
+    uint8_t data[1000];
+    uint32_t seed = 0x87654321;
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (seed >> 16) % 5 == 0 ? uint8_t(seed >> 24) : ((seed >> 16) % 5 == 1 ? 0x01 : 0x00);
+    }
+    static const uint8_t sc1[] = {0x00, 0x00, 0x01};
+    static const uint8_t sc0[] = {0x00, 0x00, 0x00};
+
+    for (size_t start = 0; start < 40; ++start) {
+        for (size_t size = 0; start + size <= sizeof(data); size += 1 + size / 8) {
+            TSUNIT_ASSERT(ts::LocateZeroZero(data + start, size, 0x01) == ts::LocatePattern(data + start, size, sc1, sizeof(sc1)));
+            TSUNIT_ASSERT(ts::LocateZeroZero(data + start, size, 0x00) == ts::LocatePattern(data + start, size, sc0, sizeof(sc0)));
+        }
+    }
+
+    // Pattern at the very end of a large area, after all vector iterations.
+    uint8_t large[4099];
+    ::memset(large, 0xFF, sizeof(large));
+    TSUNIT_ASSERT(ts::LocateZeroZero(large, sizeof(large), 0x01) == nullptr);
+    large[sizeof(large) - 3] = large[sizeof(large) - 2] = 0x00;
+    large[sizeof(large) - 1] = 0x01;
+    TSUNIT_ASSERT(ts::LocateZeroZero(large, sizeof(large), 0x01) == large + sizeof(large) - 3);
+    TSUNIT_ASSERT(ts::LocateZeroZero(large, sizeof(large) - 1, 0x01) == nullptr);
+    large[100] = large[101] = large[102] = 0x00;
+    TSUNIT_ASSERT(ts::LocateZeroZero(large, sizeof(large), 0x01) == large + sizeof(large) - 3);
+    TSUNIT_ASSERT(ts::LocateZeroZero(large, sizeof(large), 0x00) == large + 100);
+    TSUNIT_ASSERT(ts::LocateZeroZero(nullptr, 10, 0x00) == nullptr);
+}
@@ -34,6 +34,7 @@
 #include "tsPluginRepository.h"
 #include "tsNullReport.h"
 #include "tsCerrReport.h"
+#include "tsSysUtils.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
 
@@ -51,11 +52,13 @@ public:
     void testRegistrations();
     void testEmbedded();
     void testLoaded();
+    void testIndex();
 
     TSUNIT_TEST_BEGIN(PluginRepositoryTest);
     TSUNIT_TEST(testRegistrations);
     TSUNIT_TEST(testEmbedded);
     TSUNIT_TEST(testLoaded);
+    TSUNIT_TEST(testIndex);
     TSUNIT_TEST_END();
 };
 
@@ -133,3 +136,60 @@ void PluginRepositoryTest::testLoaded()
     TSUNIT_ASSERT(repo->getOutput(u"skip", report) == nullptr);
     TSUNIT_ASSERT(repo->getProcessor(u"skip", report) != nullptr);
 }
+
+void PluginRepositoryTest::testIndex()
+{
+    typedef ts::PluginRepository PR;
+
+    const ts::UString index_file(ts::TempFile(u".plugins"));
+    const ts::UString lib_file(ts::TempFile(u".so"));
+    const ts::UString missing_file(ts::TempFile(u".so"));
+    debug() << "PluginRepositoryTest::testIndex: index: " << index_file << ", library: " << lib_file << std::endl;
+
+    // Only the existence of the library file is checked when saving the index.
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringList(), lib_file));
+    TSUNIT_ASSERT(ts::FileExists(lib_file));
+    TSUNIT_ASSERT(!ts::FileExists(missing_file));
+
+    PR::PluginIndex index;
+    index[lib_file].mtime = 123456789;
+    index[lib_file].plugins.push_back(PR::IndexedPlugin(PR::LIST_INPUT, u"foo", u"Foo input"));
+    index[lib_file].plugins.push_back(PR::IndexedPlugin(PR::LIST_PACKET, u"bar\tbaz", u"Bar\tdescription\non\r\nlines"));
+    index[missing_file].mtime = 987654321;
+    index[missing_file].plugins.push_back(PR::IndexedPlugin(PR::LIST_OUTPUT, u"gone", u"Removed library"));
+
+    // Save twice, the second save replaces an existing index.
+    TSUNIT_ASSERT(PR::SavePluginIndex(index, index_file));
+    TSUNIT_ASSERT(PR::SavePluginIndex(index, index_file));
+    TSUNIT_ASSERT(ts::FileExists(index_file));
+
+    PR::PluginIndex loaded;
+    TSUNIT_ASSERT(PR::LoadPluginIndex(loaded, index_file));
+    TSUNIT_EQUAL(1, loaded.size());
+    TSUNIT_ASSERT(loaded.find(missing_file) == loaded.end());
+    TSUNIT_ASSERT(loaded.find(lib_file) != loaded.end());
+
+    const PR::IndexedLibrary& lib(loaded[lib_file]);
+    TSUNIT_EQUAL(123456789, lib.mtime);
+    TSUNIT_EQUAL(2, lib.plugins.size());
+    TSUNIT_EQUAL(PR::LIST_INPUT, lib.plugins.front().type);
+    TSUNIT_EQUAL(u"foo", lib.plugins.front().name);
+    TSUNIT_EQUAL(u"Foo input", lib.plugins.front().description);
+    TSUNIT_EQUAL(PR::LIST_PACKET, lib.plugins.back().type);
+    TSUNIT_EQUAL(u"bar baz", lib.plugins.back().name);
+    TSUNIT_EQUAL(u"Bar description on  lines", lib.plugins.back().description);
+
+    // The library was removed: dropped from the index at next save.
+    TSUNIT_EQUAL(ts::SYS_SUCCESS, ts::DeleteFile(lib_file));
+    TSUNIT_ASSERT(PR::SavePluginIndex(loaded, index_file));
+    TSUNIT_ASSERT(PR::LoadPluginIndex(loaded, index_file));
+    TSUNIT_ASSERT(loaded.empty());
+
+    // An index from another version is ignored, as well as a missing index.
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringList({u"# TSDuck 1.0 plugin index", lib_file + u"\t1\t1\tfoo\tFoo"}), index_file));
+    TSUNIT_ASSERT(!PR::LoadPluginIndex(loaded, index_file));
+    TSUNIT_ASSERT(loaded.empty());
+    TSUNIT_EQUAL(ts::SYS_SUCCESS, ts::DeleteFile(index_file));
+    TSUNIT_ASSERT(!PR::LoadPluginIndex(loaded, index_file));
+    TSUNIT_ASSERT(loaded.empty());
+}
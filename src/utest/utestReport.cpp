@@ -31,6 +31,7 @@
 //
 //----------------------------------------------------------------------------
 
+#include "tsAsyncReport.h"
 #include "tsReportBuffer.h"
 #include "tsReportFile.h"
 #include "tsSysUtils.h"
@@ -55,6 +56,8 @@ public:
     void testPrintf();
     void testByName();
     void testByStream();
+    void testAsyncSynchronous();
+    void testAsyncRate();
 
     TSUNIT_TEST_BEGIN(ReportTest);
     TSUNIT_TEST(testSeverity);
@@ -62,6 +65,8 @@ public:
     TSUNIT_TEST(testPrintf);
     TSUNIT_TEST(testByName);
     TSUNIT_TEST(testByStream);
+    TSUNIT_TEST(testAsyncSynchronous);
+    TSUNIT_TEST(testAsyncRate);
     TSUNIT_TEST_END();
 
 private:
@@ -325,3 +330,86 @@ void ReportTest::testByStream()
     ts::UString::Load(value, _fileName);
     TSUNIT_ASSERT(value == ref);
 }
+
+// A report handler which collects messages from an asynchronous report.
+namespace {
+    class AsyncCollector: public ts::ReportHandler
+    {
+    public:
+        std::vector<std::pair<int, ts::UString>> messages;
+        AsyncCollector() : messages() {}
+        virtual void handleMessage(int severity, const ts::UString& msg) override
+        {
+            messages.push_back(std::make_pair(severity, msg));
+        }
+    };
+}
+
+// Test case: asynchronous report in synchronous mode, no message is lost.
+void ReportTest::testAsyncSynchronous()
+{
+    AsyncCollector collector;
+    ts::AsyncReportArgs args;
+    args.sync_log = true;
+    args.log_msg_count = 8;
+    {
+        ts::AsyncReport log(ts::Severity::Info, args);
+        log.setMessageHandler(&collector);
+        for (int i = 0; i < 1000; ++i) {
+            log.info(u"message %d", {i});
+        }
+        log.terminate();
+        TSUNIT_EQUAL(0, log.droppedMessages());
+    }
+    TSUNIT_EQUAL(1000, collector.messages.size());
+    for (size_t i = 0; i < collector.messages.size(); ++i) {
+        TSUNIT_EQUAL(ts::Severity::Info, collector.messages[i].first);
+        TSUNIT_EQUAL(ts::UString::Format(u"message %d", {i}), collector.messages[i].second);
+    }
+}
+
+// Test case: asynchronous report with rate limitation.
+void ReportTest::testAsyncRate()
+{
+    AsyncCollector collector;
+    ts::AsyncReportArgs args;
+    args.log_msg_count = 1000;
+    args.log_msg_rate = 10;
+    uint64_t dropped = 0;
+    {
+        ts::AsyncReport log(ts::Severity::Info, args);
+        log.setMessageHandler(&collector);
+        for (int i = 0; i < 100; ++i) {
+            log.warning(u"warning %d", {i});
+        }
+        for (int i = 0; i < 5; ++i) {
+            log.error(u"error %d", {i});
+        }
+        log.terminate();
+        dropped = log.droppedMessages();
+    }
+
+    size_t warnings = 0;
+    size_t errors = 0;
+    size_t drop_reports = 0;
+    for (size_t i = 0; i < collector.messages.size(); ++i) {
+        const ts::UString& msg(collector.messages[i].second);
+        if (msg.endWith(u"log messages dropped")) {
+            drop_reports++;
+        }
+        else if (msg.startWith(u"warning")) {
+            warnings++;
+        }
+        else if (msg.startWith(u"error")) {
+            errors++;
+        }
+    }
+    debug() << "ReportTest::testAsyncRate: warnings: " << warnings << ", errors: " << errors << ", dropped: " << dropped << std::endl;
+
+    // The test may span two one-second windows on a very slow system.
+    TSUNIT_ASSERT(warnings >= 10);
+    TSUNIT_ASSERT(warnings <= 20);
+    TSUNIT_EQUAL(5, errors);
+    TSUNIT_EQUAL(100, warnings + dropped);
+    TSUNIT_ASSERT(drop_reports > 0);
+}
@@ -33,7 +33,9 @@
 
 #include "tsSafePtr.h"
 #include "tsMutex.h"
+#include "tsAtomicRefCount.h"
 #include "tsunit.h"
+#include "utestTSUnitThread.h"
 TSDUCK_SOURCE;
 
 
@@ -51,12 +53,16 @@ public:
     void testDowncast();
     void testUpcast();
     void testChangeMutex();
+    void testAtomic();
+    void testAtomicDowncast();
 
     TSUNIT_TEST_BEGIN(SafePtrTest);
     TSUNIT_TEST(testSafePtr);
     TSUNIT_TEST(testDowncast);
     TSUNIT_TEST(testUpcast);
     TSUNIT_TEST(testChangeMutex);
+    TSUNIT_TEST(testAtomic);
+    TSUNIT_TEST(testAtomicDowncast);
     TSUNIT_TEST_END();
 };
 
@@ -387,3 +393,175 @@ void SafePtrTest::testChangeMutex()
     pt.clear();
     TSUNIT_ASSERT(TestData::InstanceCount() == 0);
 }
+
+// Thread for testAtomic(): repeatedly copy and drop a shared safe pointer.
+namespace {
+    class AtomicData
+    {
+    public:
+        static std::atomic<int> instanceCount;
+        AtomicData() { instanceCount++; }
+        virtual ~AtomicData() { instanceCount--; }
+    };
+
+    class AtomicSubData: public AtomicData
+    {
+    public:
+        AtomicSubData() : AtomicData() {}
+        virtual ~AtomicSubData() override {}
+    };
+
+    std::atomic<int> AtomicData::instanceCount(0);
+
+    typedef ts::SafePtr<AtomicData, ts::AtomicRefCount> AtomicDataPtr;
+
+    class AtomicThread: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(AtomicThread);
+    private:
+        const AtomicDataPtr& _ptr;
+    public:
+        explicit AtomicThread(const AtomicDataPtr& ptr) :
+            utest::TSUnitThread(),
+            _ptr(ptr)
+        {
+        }
+
+        ~AtomicThread()
+        {
+            waitForTermination();
+        }
+
+        virtual void test() override
+        {
+            std::vector<AtomicDataPtr> copies;
+            for (int i = 0; i < 100000; ++i) {
+                copies.push_back(_ptr);
+                if (copies.size() >= 10) {
+                    copies.clear();
+                }
+                TSUNIT_ASSERT(!_ptr.isNull());
+            }
+        }
+    };
+}
+
+// Test case: lock-free reference counting
+void SafePtrTest::testAtomic()
+{
+    TSUNIT_ASSERT(TestData::InstanceCount() == 0);
+    ts::SafePtr<TestData> pn(new TestData(999));
+    ts::SafePtr<TestData, ts::AtomicRefCount> pa(pn.changeMutex<ts::AtomicRefCount>());
+    TSUNIT_ASSERT(pn.isNull());
+    TSUNIT_ASSERT(!pa.isNull());
+    TSUNIT_EQUAL(1, pa.count());
+    TSUNIT_EQUAL(999, pa->value());
+    {
+        ts::SafePtr<TestData, ts::AtomicRefCount> pa2(pa);
+        TSUNIT_EQUAL(2, pa.count());
+        TSUNIT_ASSERT(pa2.pointer() == pa.pointer());
+        pa2.reset(new TestData(1000));
+        TSUNIT_EQUAL(1, TestData::InstanceCount());
+        TSUNIT_EQUAL(1000, pa->value());
+    }
+    TSUNIT_EQUAL(1, pa.count());
+    TestData* raw = pa.release();
+    TSUNIT_ASSERT(pa.isNull());
+    TSUNIT_EQUAL(1, TestData::InstanceCount());
+    delete raw;
+    TSUNIT_EQUAL(0, TestData::InstanceCount());
+
+    // Concurrent copies from several threads.
+    AtomicDataPtr shared(new AtomicData);
+    {
+        AtomicThread t1(shared);
+        AtomicThread t2(shared);
+        AtomicThread t3(shared);
+        AtomicThread t4(shared);
+        TSUNIT_ASSERT(t1.start());
+        TSUNIT_ASSERT(t2.start());
+        TSUNIT_ASSERT(t3.start());
+        TSUNIT_ASSERT(t4.start());
+    }
+    TSUNIT_EQUAL(1, shared.count());
+    TSUNIT_EQUAL(1, AtomicData::instanceCount.load());
+    shared.clear();
+    TSUNIT_EQUAL(0, AtomicData::instanceCount.load());
+}
+
+
+//----------------------------------------------------------------------------
+// Thread for testAtomicDowncast(): downcast all shared safe pointers.
+namespace {
+    typedef ts::SafePtr<AtomicSubData, ts::AtomicRefCount> AtomicSubDataPtr;
+
+    class DowncastThread: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(DowncastThread);
+    private:
+        const std::vector<AtomicDataPtr>& _ptrs;
+        const std::atomic<bool>& _go;
+    public:
+        std::vector<AtomicSubDataPtr> results;
+
+        DowncastThread(const std::vector<AtomicDataPtr>& ptrs, const std::atomic<bool>& go) :
+            utest::TSUnitThread(),
+            _ptrs(ptrs),
+            _go(go),
+            results()
+        {
+        }
+
+        ~DowncastThread()
+        {
+            waitForTermination();
+        }
+
+        virtual void test() override
+        {
+            while (!_go) {
+            }
+            for (size_t i = 0; i < _ptrs.size(); ++i) {
+                AtomicDataPtr copy(_ptrs[i]);
+                AtomicSubDataPtr sub(copy.downcast<AtomicSubData>());
+                if (!sub.isNull()) {
+                    results.push_back(sub);
+                }
+            }
+        }
+    };
+}
+
+// Test case: concurrent downcasts of the same lock-free safe pointers.
+void SafePtrTest::testAtomicDowncast()
+{
+    TSUNIT_EQUAL(0, AtomicData::instanceCount.load());
+    {
+        std::vector<AtomicDataPtr> ptrs;
+        for (size_t i = 0; i < 20000; ++i) {
+            ptrs.push_back(AtomicDataPtr(new AtomicSubData));
+        }
+        std::atomic<bool> go(false);
+        DowncastThread t1(ptrs, go);
+        DowncastThread t2(ptrs, go);
+        DowncastThread t3(ptrs, go);
+        DowncastThread t4(ptrs, go);
+        TSUNIT_ASSERT(t1.start());
+        TSUNIT_ASSERT(t2.start());
+        TSUNIT_ASSERT(t3.start());
+        TSUNIT_ASSERT(t4.start());
+        go = true;
+        t1.waitForTermination();
+        t2.waitForTermination();
+        t3.waitForTermination();
+        t4.waitForTermination();
+
+        // Each object is owned by exactly one downcast pointer.
+        TSUNIT_EQUAL(ptrs.size(), t1.results.size() + t2.results.size() + t3.results.size() + t4.results.size());
+        for (auto it = ptrs.begin(); it != ptrs.end(); ++it) {
+            TSUNIT_ASSERT(it->isNull());
+        }
+        TSUNIT_EQUAL(int(ptrs.size()), AtomicData::instanceCount.load());
+    }
+    TSUNIT_EQUAL(0, AtomicData::instanceCount.load());
+}
@@ -32,7 +32,9 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCSA2.h"
+#include "tsTSScrambling.h"
 #include "tsTSPacket.h"
+#include "tsNullReport.h"
 #include "tsNames.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
@@ -49,9 +51,21 @@ public:
     virtual void afterTest() override;
 
     void testScrambling();
+    void testBatchVectors();
+    void testBatchRandom();
+    void testTSScramblingBatch();
+    void testTSScramblingBatchAES();
+    void testTSScramblingBatchError();
+    void testTSScramblingDecryptBatchError();
 
     TSUNIT_TEST_BEGIN(ScramblingTest);
     TSUNIT_TEST(testScrambling);
+    TSUNIT_TEST(testBatchVectors);
+    TSUNIT_TEST(testBatchRandom);
+    TSUNIT_TEST(testTSScramblingBatch);
+    TSUNIT_TEST(testTSScramblingBatchAES);
+    TSUNIT_TEST(testTSScramblingBatchError);
+    TSUNIT_TEST(testTSScramblingDecryptBatchError);
     TSUNIT_TEST_END();
 };
 
@@ -211,3 +225,266 @@ void ScramblingTest::testScrambling()
         TSUNIT_ASSERT(::memcmp(pkt.b + header_size, vec->cipher.b + header_size, payload_size) == 0);
     }
 }
+
+void ScramblingTest::testBatchVectors()
+{
+    // Enough copies of each test vector to use all bitsliced engines and the scalar tail.
+    const size_t copies = 300;
+    ts::TSPacketVector pkts(copies);
+    std::vector<uint8_t*> data(copies);
+    std::vector<size_t> sizes(copies);
+    ts::DVBCSA2 scrambler;
+
+    for (const ScramblingTestVector* vec = scrambling_test_vectors; vec < scrambling_test_vectors + sizeof(scrambling_test_vectors) / sizeof(ScramblingTestVector); ++vec) {
+
+        const size_t header_size = vec->plain.getHeaderSize();
+        const size_t payload_size = vec->plain.getPayloadSize();
+        const uint8_t scv = vec->cipher.getScrambling();
+        TSUNIT_ASSERT(scrambler.setKey(scv == ts::SC_EVEN_KEY ? vec->cw_even : vec->cw_odd, sizeof(vec->cw_even)));
+
+        for (size_t i = 0; i < copies; ++i) {
+            pkts[i] = vec->cipher;
+            data[i] = pkts[i].b + header_size;
+            sizes[i] = payload_size;
+        }
+        TSUNIT_ASSERT(scrambler.decryptBatch(data.data(), sizes.data(), copies));
+        for (size_t i = 0; i < copies; ++i) {
+            TSUNIT_EQUAL(0, ::memcmp(pkts[i].b + header_size, vec->plain.b + header_size, payload_size));
+        }
+
+        for (size_t i = 0; i < copies; ++i) {
+            pkts[i] = vec->plain;
+        }
+        TSUNIT_ASSERT(scrambler.encryptBatch(data.data(), sizes.data(), copies));
+        for (size_t i = 0; i < copies; ++i) {
+            TSUNIT_EQUAL(0, ::memcmp(pkts[i].b + header_size, vec->cipher.b + header_size, payload_size));
+        }
+    }
+}
+
+void ScramblingTest::testBatchRandom()
+{
+    // Pseudo-random payloads of all sizes, batch operations compared with one by one.
+    const size_t max_count = 600;
+    uint8_t ref[max_count][ts::PKT_SIZE];
+    uint8_t buf[max_count][ts::PKT_SIZE];
+    uint8_t* data[max_count];
+    size_t sizes[max_count];
+    uint8_t cw[ts::DVBCSA2::KEY_SIZE];
+    ts::DVBCSA2 scrambler(ts::DVBCSA2::FULL_CW);
+
+    uint32_t seed = 0x13579BDF;
+    for (size_t i = 0; i < sizeof(cw); ++i) {
+        seed = seed * 1103515245 + 12345;
+        cw[i] = uint8_t(seed >> 16);
+    }
+    TSUNIT_ASSERT(scrambler.setKey(cw, sizeof(cw)));
+
+    static const size_t counts[] = {1, 15, 16, 17, 63, 64, 100, 128, 200, 256, 257, 600};
+    for (size_t ci = 0; ci < sizeof(counts) / sizeof(counts[0]); ++ci) {
+        const size_t count = counts[ci];
+        for (size_t i = 0; i < count; ++i) {
+            seed = seed * 1103515245 + 12345;
+            sizes[i] = (seed >> 16) % 185;
+            for (size_t j = 0; j < sizes[i]; ++j) {
+                seed = seed * 1103515245 + 12345;
+                ref[i][j] = buf[i][j] = uint8_t(seed >> 16);
+            }
+            data[i] = buf[i];
+        }
+
+        TSUNIT_ASSERT(scrambler.encryptBatch(data, sizes, count));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(scrambler.encryptInPlace(ref[i], sizes[i]));
+            TSUNIT_EQUAL(0, ::memcmp(ref[i], buf[i], sizes[i]));
+        }
+
+        TSUNIT_ASSERT(scrambler.decryptBatch(data, sizes, count));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(scrambler.decryptInPlace(ref[i], sizes[i]));
+            TSUNIT_EQUAL(0, ::memcmp(ref[i], buf[i], sizes[i]));
+        }
+    }
+}
+
+void ScramblingTest::testTSScramblingBatch()
+{
+    // Test vectors with both parities, interleaved with clear packets.
+    const ScramblingTestVector& vec(scrambling_test_vectors[0]);
+    ts::TSScrambling batch(NULLREP);
+    ts::TSScrambling single(NULLREP);
+    TSUNIT_ASSERT(batch.setCW(ts::ByteBlock(vec.cw_even, sizeof(vec.cw_even)), ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(batch.setCW(ts::ByteBlock(vec.cw_odd, sizeof(vec.cw_odd)), ts::SC_ODD_KEY));
+    TSUNIT_ASSERT(single.setCW(ts::ByteBlock(vec.cw_even, sizeof(vec.cw_even)), ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(single.setCW(ts::ByteBlock(vec.cw_odd, sizeof(vec.cw_odd)), ts::SC_ODD_KEY));
+
+    const size_t count = 200;
+    ts::TSPacketVector pkts(count);
+    ts::TSPacketVector ref(count);
+    std::vector<ts::TSPacket*> ptrs(count);
+    for (size_t i = 0; i < count; ++i) {
+        pkts[i] = i % 10 == 9 ? ts::NullPacket : vec.cipher;
+        pkts[i].setScrambling(i % 10 == 9 ? ts::SC_CLEAR : (i < 120 ? ts::SC_EVEN_KEY : ts::SC_ODD_KEY));
+        ref[i] = pkts[i];
+        ptrs[i] = &pkts[i];
+    }
+
+    TSUNIT_ASSERT(batch.decryptBatch(ptrs.data(), count));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(single.decrypt(ref[i]));
+        TSUNIT_ASSERT(pkts[i] == ref[i]);
+        TSUNIT_ASSERT(pkts[i].getScrambling() == ts::SC_CLEAR);
+    }
+    TSUNIT_ASSERT(pkts[0] == vec.plain);
+
+    TSUNIT_ASSERT(batch.setEncryptParity(ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(single.setEncryptParity(ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(batch.encryptBatch(ptrs.data(), count));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(single.encrypt(ref[i]));
+        TSUNIT_ASSERT(pkts[i] == ref[i]);
+    }
+    TSUNIT_ASSERT(pkts[0] == vec.cipher);
+
+    // Encrypting a scrambled packet is an error.
+    TSUNIT_ASSERT(!batch.encryptBatch(ptrs.data(), count));
+}
+
+void ScramblingTest::testTSScramblingBatchAES()
+{
+    // AES-based algorithms, with a parity change in the batch and various payload sizes.
+    const uint8_t types[] = {ts::SCRAMBLING_DVB_CISSA1, ts::SCRAMBLING_ATIS_IIF_IDSA};
+    const ts::ByteBlock cw_even(16, 0x5A);
+    const ts::ByteBlock cw_odd(16, 0xA5);
+
+    for (size_t ti = 0; ti < sizeof(types); ++ti) {
+        ts::TSScrambling batch(NULLREP, types[ti]);
+        ts::TSScrambling single(NULLREP, types[ti]);
+        TSUNIT_ASSERT(batch.setCW(cw_even, ts::SC_EVEN_KEY));
+        TSUNIT_ASSERT(batch.setCW(cw_odd, ts::SC_ODD_KEY));
+        TSUNIT_ASSERT(single.setCW(cw_even, ts::SC_EVEN_KEY));
+        TSUNIT_ASSERT(single.setCW(cw_odd, ts::SC_ODD_KEY));
+
+        // Packets with an adaptation field of increasing size, up to an empty payload.
+        const size_t count = 190;
+        ts::TSPacketVector plain(count);
+        ts::TSPacketVector pkts(count);
+        ts::TSPacketVector ref(count);
+        std::vector<ts::TSPacket*> ptrs(count);
+        for (size_t i = 0; i < count; ++i) {
+            ts::TSPacket& pkt(plain[i]);
+            pkt.b[0] = ts::SYNC_BYTE;
+            pkt.b[1] = 0x01;
+            pkt.b[2] = 0x00;
+            const size_t af_size = i % 185;
+            if (af_size == 0) {
+                pkt.b[3] = 0x10 | uint8_t(i & 0x0F);
+            }
+            else {
+                pkt.b[3] = 0x30 | uint8_t(i & 0x0F);
+                pkt.b[4] = uint8_t(af_size - 1);
+                if (af_size > 1) {
+                    pkt.b[5] = 0x00;
+                    ::memset(pkt.b + 6, 0xFF, af_size - 2);
+                }
+            }
+            for (size_t j = 4 + af_size; j < ts::PKT_SIZE; ++j) {
+                pkt.b[j] = uint8_t(i + j);
+            }
+            pkts[i] = ref[i] = pkt;
+            ptrs[i] = &pkts[i];
+        }
+
+        // Encrypt first half with even key, second half with odd key.
+        const size_t half = count / 2;
+        TSUNIT_ASSERT(batch.setEncryptParity(ts::SC_EVEN_KEY));
+        TSUNIT_ASSERT(single.setEncryptParity(ts::SC_EVEN_KEY));
+        TSUNIT_ASSERT(batch.encryptBatch(ptrs.data(), half));
+        TSUNIT_ASSERT(batch.setEncryptParity(ts::SC_ODD_KEY));
+        TSUNIT_ASSERT(batch.encryptBatch(ptrs.data() + half, count - half));
+        for (size_t i = 0; i < count; ++i) {
+            if (i == half) {
+                TSUNIT_ASSERT(single.setEncryptParity(ts::SC_ODD_KEY));
+            }
+            TSUNIT_ASSERT(single.encrypt(ref[i]));
+            TSUNIT_ASSERT(pkts[i] == ref[i]);
+        }
+
+        // Decrypt all packets at once, the key switch occurs in the middle of the batch.
+        TSUNIT_ASSERT(batch.decryptBatch(ptrs.data(), count));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(pkts[i] == plain[i]);
+        }
+    }
+}
+
+void ScramblingTest::testTSScramblingBatchError()
+{
+    const ScramblingTestVector& vec(scrambling_test_vectors[0]);
+    const size_t count = 20;
+    ts::TSPacketVector pkts(count);
+    std::vector<ts::TSPacket*> ptrs(count);
+    for (size_t i = 0; i < count; ++i) {
+        ptrs[i] = &pkts[i];
+    }
+
+    // An already scrambled packet in the middle does not leave the next ones in clear.
+    ts::TSScrambling scrambler(NULLREP);
+    TSUNIT_ASSERT(scrambler.setCW(ts::ByteBlock(vec.cw_even, sizeof(vec.cw_even)), ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(scrambler.setEncryptParity(ts::SC_EVEN_KEY));
+    for (size_t i = 0; i < count; ++i) {
+        pkts[i] = vec.plain;
+    }
+    pkts[5] = vec.cipher;
+    TSUNIT_ASSERT(!scrambler.encryptBatch(ptrs.data(), count, true));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(pkts[i] == vec.cipher);
+    }
+
+    // Encryption failure (no control word): no clear payload is left.
+    ts::TSScrambling nokey(NULLREP);
+    for (size_t i = 0; i < count; ++i) {
+        pkts[i] = i % 4 == 3 ? ts::NullPacket : vec.plain;
+    }
+    TSUNIT_ASSERT(!nokey.encryptBatch(ptrs.data(), count, false));
+    TSUNIT_ASSERT(pkts[0] == vec.plain);
+    TSUNIT_ASSERT(!nokey.encryptBatch(ptrs.data(), count, true));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_EQUAL(ts::PID_NULL, pkts[i].getPID());
+        TSUNIT_ASSERT(pkts[i] == ts::NullPacket);
+    }
+}
+
+void ScramblingTest::testTSScramblingDecryptBatchError()
+{
+    const ScramblingTestVector& vec(scrambling_test_vectors[0]);
+    const size_t count = 20;
+    ts::TSPacketVector pkts(count);
+    std::vector<ts::TSPacket*> ptrs(count);
+    for (size_t i = 0; i < count; ++i) {
+        ptrs[i] = &pkts[i];
+    }
+
+    // Only the even key is known: the even packets are decrypted, the odd ones fail.
+    ts::TSScrambling descrambler(NULLREP);
+    TSUNIT_ASSERT(descrambler.setCW(ts::ByteBlock(vec.cw_even, sizeof(vec.cw_even)), ts::SC_EVEN_KEY));
+    for (size_t i = 0; i < count; ++i) {
+        pkts[i] = vec.cipher;
+        if (i >= count / 2) {
+            pkts[i].setScrambling(ts::SC_ODD_KEY);
+        }
+    }
+    TSUNIT_ASSERT(!descrambler.decryptBatch(ptrs.data(), count));
+    for (size_t i = 0; i < count / 2; ++i) {
+        TSUNIT_ASSERT(pkts[i] == vec.plain);
+    }
+    for (size_t i = count / 2; i < count; ++i) {
+        TSUNIT_EQUAL(ts::SC_ODD_KEY, pkts[i].getScrambling());
+    }
+
+    // The decrypted packets are marked as clear and are never decrypted twice.
+    TSUNIT_ASSERT(!descrambler.decryptBatch(ptrs.data(), count));
+    for (size_t i = 0; i < count / 2; ++i) {
+        TSUNIT_ASSERT(pkts[i] == vec.plain);
+    }
+}
@@ -32,6 +32,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsSection.h"
+#include "tsSectionPool.h"
 #include "tsBinaryTable.h"
 #include "tsNames.h"
 #include "tsunit.h"
@@ -59,6 +60,7 @@ public:
     void testAssign();
     void testPackSections();
     void testSize();
+    void testPool();
 
     TSUNIT_TEST_BEGIN(SectionTest);
     TSUNIT_TEST(testTOT);
@@ -68,6 +70,7 @@ public:
     TSUNIT_TEST(testAssign);
     TSUNIT_TEST(testPackSections);
     TSUNIT_TEST(testSize);
+    TSUNIT_TEST(testPool);
     TSUNIT_TEST_END();
 
 private:
@@ -292,3 +295,66 @@ void SectionTest::testSize()
     TSUNIT_EQUAL(366, table.totalSize());
     TSUNIT_EQUAL(2, table.packetCount());
 }
+
+void SectionTest::testPool()
+{
+    ts::SectionPool pool(2);
+    TSUNIT_EQUAL(2, pool.maxSize());
+    TSUNIT_EQUAL(0, pool.size());
+
+    ts::SectionPtr s1(pool.get(psi_tot_tnt_sections, sizeof(psi_tot_tnt_sections), ts::PID_TOT, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(!s1.isNull());
+    TSUNIT_ASSERT(s1->isValid());
+    TSUNIT_EQUAL(ts::TID_TOT, s1->tableId());
+    TSUNIT_EQUAL(1, pool.size());
+    TSUNIT_EQUAL(1, pool.allocatedCount());
+    TSUNIT_EQUAL(0, pool.recycledCount());
+
+    // Section still referenced, a new one is allocated.
+    ts::SectionPtr s2(pool.get(psi_nit_tntv23_sections, sizeof(psi_nit_tntv23_sections), ts::PID_NIT, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(s2->isValid());
+    TSUNIT_EQUAL(ts::TID_NIT_ACT, s2->tableId());
+    TSUNIT_ASSERT(s1 != s2);
+    TSUNIT_EQUAL(2, pool.size());
+    TSUNIT_EQUAL(2, pool.allocatedCount());
+
+    // Release first section, it is recycled.
+    const ts::Section* addr = s1.pointer();
+    s1.clear();
+    ts::SectionPtr s3(pool.get(psi_bat_tvnum_sections, sizeof(psi_bat_tvnum_sections), ts::PID_BAT, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(s3->isValid());
+    TSUNIT_EQUAL(addr, s3.pointer());
+    TSUNIT_EQUAL(ts::TID_BAT, s3->tableId());
+    TSUNIT_EQUAL(ts::PID_BAT, s3->sourcePID());
+    TSUNIT_EQUAL(sizeof(psi_bat_tvnum_sections), s3->size());
+    TSUNIT_EQUAL(0, ::memcmp(psi_bat_tvnum_sections, s3->content(), s3->size()));
+    TSUNIT_EQUAL(1, pool.recycledCount());
+
+    // A shared section content is not overwritten by a recycled section.
+    ts::Section shared(*s3, ts::ShareMode::SHARE);
+    s3.clear();
+    ts::SectionPtr s4(pool.get(psi_tot_tnt_sections, sizeof(psi_tot_tnt_sections), ts::PID_TOT, ts::CRC32::CHECK));
+    TSUNIT_EQUAL(addr, s4.pointer());
+    TSUNIT_EQUAL(ts::TID_TOT, s4->tableId());
+    TSUNIT_EQUAL(ts::TID_BAT, shared.tableId());
+    TSUNIT_EQUAL(0, ::memcmp(psi_bat_tvnum_sections, shared.content(), shared.size()));
+
+    // Pool full of retained sections, the new section is still valid.
+    ts::SectionPtr s5(pool.get(psi_nit_tntv23_sections, sizeof(psi_nit_tntv23_sections), ts::PID_NIT, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(s5->isValid());
+    TSUNIT_EQUAL(2, pool.size());
+    TSUNIT_EQUAL(3, pool.allocatedCount());
+
+    // A pooled section which is deallocated using reset() instead of clear() is replaced.
+    ts::SectionPtr s6(s5);
+    s5.reset();
+    TSUNIT_ASSERT(s6.isNull());
+    for (int i = 0; i < 4; ++i) {
+        ts::SectionPtr s7(pool.get(psi_bat_tvnum_sections, sizeof(psi_bat_tvnum_sections), ts::PID_BAT, ts::CRC32::CHECK));
+        TSUNIT_ASSERT(!s7.isNull());
+        TSUNIT_ASSERT(s7->isValid());
+        TSUNIT_EQUAL(ts::TID_BAT, s7->tableId());
+    }
+    TSUNIT_ASSERT(s6.isNull());
+    TSUNIT_EQUAL(2, pool.size());
+}
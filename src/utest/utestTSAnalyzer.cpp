@@ -0,0 +1,335 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TSAnalyzer
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSAnalyzerReport.h"
+#include "tsTSAnalyzerOptions.h"
+#include "tsOneShotPacketizer.h"
+#include "tsDuckContext.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsjsonValue.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSAnalyzerTest: public tsunit::Test
+{
+public:
+    TSAnalyzerTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testThreads();
+    void testSetThreads();
+    void testDelta();
+    void testDeltaSplit();
+
+    TSUNIT_TEST_BEGIN(TSAnalyzerTest);
+    TSUNIT_TEST(testThreads);
+    TSUNIT_TEST(testSetThreads);
+    TSUNIT_TEST(testDelta);
+    TSUNIT_TEST(testDeltaSplit);
+    TSUNIT_TEST_END();
+
+private:
+    ts::TSPacketVector _stream;
+    static void BuildStream(ts::TSPacketVector& stream);
+};
+
+TSUNIT_REGISTER(TSAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+TSAnalyzerTest::TSAnalyzerTest() :
+    _stream()
+{
+}
+
+// Test suite initialization method.
+void TSAnalyzerTest::beforeTest()
+{
+    if (_stream.empty()) {
+        BuildStream(_stream);
+    }
+}
+
+// Test suite cleanup method.
+void TSAnalyzerTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Build a synthetic transport stream with two services.
+//----------------------------------------------------------------------------
+
+void TSAnalyzerTest::BuildStream(ts::TSPacketVector& stream)
+{
+    ts::DuckContext duck;
+
+    // PSI packets.
+    ts::PAT pat(0, true, 10);
+    pat.pmts[1] = 0x100;
+    pat.pmts[2] = 0x200;
+
+    ts::PMT pmt1(0, true, 1, 0x101);
+    pmt1.streams[0x101].stream_type = ts::ST_MPEG2_VIDEO;
+    pmt1.streams[0x102].stream_type = ts::ST_MPEG1_AUDIO;
+
+    ts::PMT pmt2(0, true, 2, 0x201);
+    pmt2.streams[0x201].stream_type = ts::ST_MPEG2_VIDEO;
+    pmt2.streams[0x202].stream_type = ts::ST_MPEG2_AUDIO;
+
+    ts::TSPacketVector psi;
+    ts::TSPacketVector pkts;
+    ts::OneShotPacketizer pzer(duck, ts::PID_PAT);
+    pzer.addTable(duck, pat);
+    pzer.getPackets(psi);
+    pzer.removeAll();
+    pzer.setPID(0x100);
+    pzer.addTable(duck, pmt1);
+    pzer.getPackets(pkts);
+    psi.insert(psi.end(), pkts.begin(), pkts.end());
+    pzer.removeAll();
+    pzer.setPID(0x200);
+    pzer.addTable(duck, pmt2);
+    pzer.getPackets(pkts);
+    psi.insert(psi.end(), pkts.begin(), pkts.end());
+
+    // Payload of PES packets: MPEG-2 video sequence header and MPEG-1 audio frame header.
+    static const uint8_t video[] = {0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x01, 0xB3, 0x2D, 0x01, 0xE0, 0x24, 0xFF, 0xFF, 0xE0, 0x18};
+    static const uint8_t audio[] = {0x00, 0x00, 0x01, 0xC0, 0x00, 0xB2, 0x80, 0x00, 0x00, 0xFF, 0xFD, 0xA0, 0x04};
+    static const ts::PID pids[] = {0x101, 0x101, 0x102, 0x201, 0x201, 0x202, 0x300};
+
+    std::map<ts::PID, uint8_t> cc;
+    std::map<ts::PID, size_t> count;
+    stream.clear();
+
+    for (size_t index = 0; index < 40000; ++index) {
+        if (index % 700 == 0) {
+            for (auto it = psi.begin(); it != psi.end(); ++it) {
+                stream.push_back(*it);
+                stream.back().setCC(cc[it->getPID()]++ & 0x0F);
+            }
+            continue;
+        }
+        const ts::PID pid = pids[index % 7];
+        const size_t n = count[pid]++;
+        ts::TSPacket pkt;
+        pkt.init(pid, cc[pid]++ & 0x0F, 0xA5);
+        if (n % 12 == 0) {
+            const bool is_video = (pid & 0x0F) == 1;
+            pkt.setPUSI();
+            ::memcpy(pkt.getPayload(), is_video ? video : audio, is_video ? sizeof(video) : sizeof(audio));
+        }
+        if ((pid & 0x0F) == 1 && n % 20 == 0) {
+            pkt.setPCR(uint64_t(index) * 4060 + (pid == 0x201 ? 100 : 0), true);
+        }
+        if (pid == 0x202) {
+            pkt.setScrambling((n / 1000) % 2 == 0 ? ts::SC_EVEN_KEY : ts::SC_ODD_KEY);
+        }
+        if (pid == 0x102 && n % 997 == 0) {
+            cc[pid]++;
+        }
+        stream.push_back(pkt);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    ts::TSAnalyzerOptions Options()
+    {
+        ts::TSAnalyzerOptions opt;
+        opt.ts_analysis = opt.service_analysis = opt.pid_analysis = opt.table_analysis = opt.error_analysis = true;
+        opt.normalized = opt.deterministic = true;
+        return opt;
+    }
+
+    ts::UString Analyze(const ts::TSPacketVector& stream, size_t threads, size_t split, ts::UString* partial)
+    {
+        ts::DuckContext duck;
+        const ts::TSAnalyzerOptions opt(Options());
+        ts::TSAnalyzerReport analyzer(duck);
+        analyzer.setThreads(threads);
+        for (size_t i = 0; i < stream.size(); ++i) {
+            if (i == split && partial != nullptr) {
+                *partial = analyzer.reportToString(opt);
+            }
+            analyzer.feedPacket(stream[i]);
+        }
+        return analyzer.reportToString(opt);
+    }
+}
+
+void TSAnalyzerTest::testThreads()
+{
+    ts::UString partial1;
+    ts::UString partial4;
+    const ts::UString report1(Analyze(_stream, 1, _stream.size() / 3, &partial1));
+    const ts::UString report4(Analyze(_stream, 4, _stream.size() / 3, &partial4));
+
+    debug() << "TSAnalyzerTest::testThreads: report: " << std::endl << report1 << std::endl;
+
+    TSUNIT_ASSERT(!report1.empty());
+    TSUNIT_ASSERT(report1.find(u"Audio layer II") != ts::NPOS);
+    TSUNIT_EQUAL(report1, report4);
+    TSUNIT_EQUAL(partial1, partial4);
+    TSUNIT_EQUAL(report1, Analyze(_stream, 2, 0, nullptr));
+    TSUNIT_EQUAL(report1, Analyze(_stream, 7, 0, nullptr));
+}
+
+void TSAnalyzerTest::testSetThreads()
+{
+    ts::DuckContext duck;
+
+    // Change the number of threads in the middle of the analysis.
+    ts::TSAnalyzerReport analyzer(duck);
+    for (size_t i = 0; i < _stream.size(); ++i) {
+        if (i == _stream.size() / 4) {
+            analyzer.setThreads(3);
+        }
+        else if (i == _stream.size() / 2) {
+            analyzer.setThreads(1);
+        }
+        else if (i == 3 * _stream.size() / 4) {
+            analyzer.setThreads(2);
+        }
+        analyzer.feedPacket(_stream[i]);
+    }
+    TSUNIT_EQUAL(Analyze(_stream, 1, 0, nullptr), analyzer.reportToString(Options()));
+}
+
+void TSAnalyzerTest::testDelta()
+{
+    ts::DuckContext duck;
+    const ts::TSAnalyzerOptions opt(Options());
+    ts::TSAnalyzerReport analyzer(duck);
+
+    // First half of the stream: everything is new.
+    for (size_t i = 0; i < _stream.size() / 2; ++i) {
+        analyzer.feedPacket(_stream[i]);
+    }
+    std::ostringstream line1;
+    TSUNIT_ASSERT(analyzer.reportDelta(opt, line1));
+    debug() << "TSAnalyzerTest::testDelta: line 1: " << line1.str();
+
+    const ts::UString delta1(ts::UString::FromUTF8(line1.str()));
+    TSUNIT_ASSERT(delta1.startWith(u"{"));
+    TSUNIT_ASSERT(delta1.endWith(u"}\n"));
+    TSUNIT_EQUAL(1, std::count(delta1.begin(), delta1.end(), u'\n'));
+    TSUNIT_ASSERT(delta1.find(u"\"pids\":") != ts::NPOS);
+    TSUNIT_ASSERT(delta1.find(u"\"services\":") != ts::NPOS);
+    TSUNIT_ASSERT(delta1.find(u"\"tables\":") != ts::NPOS);
+
+    // No new packet, nothing changed.
+    std::ostringstream line2;
+    TSUNIT_ASSERT(!analyzer.reportDelta(opt, line2));
+    TSUNIT_ASSERT(line2.str().empty());
+
+    // Second half of the stream: only some values change, no new service, no new table version.
+    for (size_t i = _stream.size() / 2; i < _stream.size(); ++i) {
+        analyzer.feedPacket(_stream[i]);
+    }
+    std::ostringstream line3;
+    analyzer.reportDelta(opt, line3);
+    debug() << "TSAnalyzerTest::testDelta: line 3: " << line3.str();
+
+    const ts::UString delta3(ts::UString::FromUTF8(line3.str()));
+    TSUNIT_ASSERT(delta3.size() < delta1.size());
+    TSUNIT_ASSERT(delta3.find(u"\"tables\":") == ts::NPOS);
+}
+
+void TSAnalyzerTest::testDeltaSplit()
+{
+    ts::DuckContext duck;
+    const ts::TSAnalyzerOptions opt(Options());
+
+    // Reference: the same delta report without size limit.
+    ts::TSAnalyzerReport ref(duck);
+    ts::TSAnalyzerReport analyzer(duck);
+    for (size_t i = 0; i < _stream.size(); ++i) {
+        ref.feedPacket(_stream[i]);
+        analyzer.feedPacket(_stream[i]);
+    }
+    std::ostringstream full;
+    TSUNIT_ASSERT(ref.reportDelta(opt, full));
+
+    // Split the same report in small lines.
+    const size_t max_size = 300;
+    std::ostringstream split;
+    TSUNIT_ASSERT(analyzer.reportDelta(opt, split, NULLREP, max_size));
+    debug() << "TSAnalyzerTest::testDeltaSplit: full: " << full.str() << "split:" << std::endl << split.str();
+
+    ts::json::ValuePtr jfull;
+    TSUNIT_ASSERT(ts::json::Parse(jfull, ts::UString::FromUTF8(full.str())));
+    TSUNIT_ASSERT(!jfull.isNull());
+
+    ts::UStringList lines;
+    ts::UString::FromUTF8(split.str()).split(lines, u'\n', true, true);
+    TSUNIT_ASSERT(lines.size() > 1);
+
+    // Each line is a valid JSON object with the transport stream fields, the entries are dispatched over the lines.
+    size_t services = 0;
+    size_t pids = 0;
+    size_t tables = 0;
+    for (auto it = lines.begin(); it != lines.end(); ++it) {
+        TSUNIT_ASSERT(it->toUTF8().size() <= max_size);
+        ts::json::ValuePtr jline;
+        TSUNIT_ASSERT(ts::json::Parse(jline, *it));
+        TSUNIT_ASSERT(!jline.isNull());
+        TSUNIT_ASSERT(jline->isObject());
+        TSUNIT_EQUAL(jfull->value(u"ts").value(u"packets").toInteger(), jline->value(u"ts").value(u"packets").toInteger());
+        services += jline->value(u"services").size();
+        pids += jline->value(u"pids").size();
+        tables += jline->value(u"tables").size();
+    }
+    TSUNIT_ASSERT(services > 0);
+    TSUNIT_ASSERT(pids > 0);
+    TSUNIT_ASSERT(tables > 0);
+    TSUNIT_EQUAL(jfull->value(u"services").size(), services);
+    TSUNIT_EQUAL(jfull->value(u"pids").size(), pids);
+    TSUNIT_EQUAL(jfull->value(u"tables").size(), tables);
+}
@@ -47,6 +47,12 @@
 #include "tsEacemPreferredNameIdentifierDescriptor.h"
 #include "tsEacemLogicalChannelNumberDescriptor.h"
 #include "tsEutelsatChannelNumberDescriptor.h"
+#include "tsPATView.h"
+#include "tsPMTView.h"
+#include "tsSDTView.h"
+#include "tsDescriptorListView.h"
+#include "tsServiceDescriptor.h"
+#include "tsBinaryTable.h"
 #include "tsDuckContext.h"
 #include "tsTSPacket.h"
 #include "tsunit.h"
@@ -74,6 +80,10 @@ public:
     void testTOT();
     void testTSDT();
     void testCleanupPrivateDescriptors();
+    void testDescriptorListView();
+    void testPATView();
+    void testPMTView();
+    void testSDTView();
 
     TSUNIT_TEST_BEGIN(TableTest);
     TSUNIT_TEST(testAssignPMT);
@@ -87,6 +97,10 @@ public:
     TSUNIT_TEST(testTOT);
     TSUNIT_TEST(testTSDT);
     TSUNIT_TEST(testCleanupPrivateDescriptors);
+    TSUNIT_TEST(testDescriptorListView);
+    TSUNIT_TEST(testPATView);
+    TSUNIT_TEST(testPMTView);
+    TSUNIT_TEST(testSDTView);
     TSUNIT_TEST_END();
 };
 
@@ -369,3 +383,174 @@ void TableTest::testCleanupPrivateDescriptors()
     TSUNIT_EQUAL(1, dlist.count());
     TSUNIT_EQUAL(ts::DID_SERVICE, dlist[0]->tag());
 }
+
+void TableTest::testDescriptorListView()
+{
+    static const uint8_t data[] = {
+        0x48, 0x03, 0x01, 0x00, 0x00,   // service_descriptor
+        0x09, 0x04, 0x01, 0x00, 0xE1, 0x00,  // CA_descriptor
+        0x52, 0x01, 0x07,               // stream_identifier_descriptor
+        0x09, 0x05, 0x02,               // truncated CA_descriptor
+    };
+
+    const ts::DescriptorListView dlist(data, sizeof(data));
+    TSUNIT_ASSERT(!dlist.empty());
+    TSUNIT_ASSERT(!dlist.isValid());
+    TSUNIT_EQUAL(3, dlist.count());
+
+    ts::DescriptorListView::const_iterator it(dlist.begin());
+    TSUNIT_ASSERT(it != dlist.end());
+    TSUNIT_EQUAL(ts::DID_SERVICE, it->tag());
+    TSUNIT_EQUAL(5, it->size());
+    TSUNIT_EQUAL(3, it->payloadSize());
+    TSUNIT_ASSERT(it->content() == data);
+    ++it;
+    TSUNIT_EQUAL(ts::DID_CA, it->tag());
+    TSUNIT_ASSERT(it->payload() == data + 7);
+    ++it;
+    TSUNIT_EQUAL(ts::DID_STREAM_ID, it->tag());
+    ++it;
+    TSUNIT_ASSERT(it == dlist.end());
+
+    TSUNIT_ASSERT(dlist.search(ts::DID_CA) != dlist.end());
+    TSUNIT_ASSERT(dlist.search(ts::DID_CA)->content() == data + 5);
+    TSUNIT_ASSERT(dlist.search(ts::DID_CA, ++dlist.search(ts::DID_CA)) == dlist.end());
+
+    const ts::DescriptorListView valid(data, 14);
+    TSUNIT_ASSERT(valid.isValid());
+    TSUNIT_EQUAL(3, valid.count());
+
+    const ts::DescriptorListView empty;
+    TSUNIT_ASSERT(empty.empty());
+    TSUNIT_ASSERT(empty.isValid());
+    TSUNIT_EQUAL(0, empty.count());
+}
+
+void TableTest::testPATView()
+{
+    ts::DuckContext duck;
+    ts::PAT pat(3, true, 0x1234, 0x0010);
+    for (uint16_t id = 400; id > 0; --id) {
+        pat.pmts[id] = 0x1000 + id;
+    }
+
+    ts::BinaryTable bin;
+    pat.serialize(duck, bin);
+    TSUNIT_ASSERT(bin.isValid());
+    TSUNIT_ASSERT(bin.sectionCount() > 1);
+
+    const ts::PATView view(bin);
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_EQUAL(0x1234, view.tsId());
+    TSUNIT_EQUAL(0x0010, view.nitPID());
+    TSUNIT_EQUAL(1, view.firstServiceId());
+    TSUNIT_EQUAL(0x1000 + 150, view.pmtPID(150));
+    TSUNIT_EQUAL(ts::PID_NULL, view.pmtPID(401));
+
+    size_t count = 0;
+    for (ts::PATView::const_iterator it = view.begin(); it != view.end(); ++it) {
+        if (it->programNumber() != 0) {
+            TSUNIT_ASSERT(pat.pmts.find(it->programNumber()) != pat.pmts.end());
+            TSUNIT_EQUAL(pat.pmts[it->programNumber()], it->pid());
+            count++;
+        }
+    }
+    TSUNIT_EQUAL(pat.pmts.size(), count);
+
+    // A view of another table is invalid.
+    ts::SDT sdt;
+    sdt.serialize(duck, bin);
+    const ts::PATView bad(bin);
+    TSUNIT_ASSERT(!bad.isValid());
+    TSUNIT_ASSERT(bad.begin() == bad.end());
+    TSUNIT_EQUAL(ts::PID_NULL, bad.nitPID());
+}
+
+void TableTest::testPMTView()
+{
+    ts::DuckContext duck;
+    ts::PMT pmt(1, true, 27, 1001);
+    pmt.descs.add(duck, ts::CADescriptor(0x1234, 2002));
+    pmt.streams[3003].stream_type = 0x1B;
+    pmt.streams[3003].descs.add(duck, ts::AVCVideoDescriptor());
+    pmt.streams[4004].stream_type = 0x06;
+    pmt.streams[4004].descs.add(duck, ts::DVBAC3Descriptor());
+    pmt.streams[4004].descs.add(duck, ts::CADescriptor());
+    pmt.streams[5005].stream_type = 0x86;
+
+    ts::BinaryTable bin;
+    pmt.serialize(duck, bin);
+    TSUNIT_ASSERT(bin.isValid());
+
+    const ts::PMTView view(bin);
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_EQUAL(27, view.serviceId());
+    TSUNIT_EQUAL(1001, view.pcrPID());
+    TSUNIT_EQUAL(1, view.descriptors().count());
+    TSUNIT_EQUAL(ts::DID_CA, view.descriptors().begin()->tag());
+
+    ts::PMTView::const_iterator it(view.begin());
+    TSUNIT_ASSERT(it != view.end());
+    TSUNIT_EQUAL(3003, it->pid());
+    TSUNIT_EQUAL(0x1B, it->streamType());
+    TSUNIT_EQUAL(1, it->descriptors().count());
+    TSUNIT_EQUAL(ts::DID_AVC_VIDEO, it->descriptors().begin()->tag());
+    ++it;
+    TSUNIT_ASSERT(it != view.end());
+    TSUNIT_EQUAL(4004, it->pid());
+    TSUNIT_EQUAL(0x06, it->streamType());
+    TSUNIT_EQUAL(2, it->descriptors().count());
+    TSUNIT_ASSERT(it->descriptors().search(ts::DID_CA) != it->descriptors().end());
+    ++it;
+    TSUNIT_ASSERT(it != view.end());
+    TSUNIT_EQUAL(5005, it->pid());
+    TSUNIT_ASSERT(it->descriptors().empty());
+    ++it;
+    TSUNIT_ASSERT(it == view.end());
+}
+
+void TableTest::testSDTView()
+{
+    ts::DuckContext duck;
+    ts::SDT sdt(true, 2, true, 0x0102, 0x0304);
+    for (uint16_t id = 1; id <= 300; ++id) {
+        ts::SDT::Service& srv(sdt.services[id]);
+        srv.EITs_present = (id % 2) == 0;
+        srv.EITpf_present = (id % 3) == 0;
+        srv.running_status = uint8_t(id % 8);
+        srv.CA_controlled = (id % 5) == 0;
+        srv.descs.add(duck, ts::ServiceDescriptor(uint8_t(id), ts::UString::Format(u"Provider %d", {id}), ts::UString::Format(u"Service %d", {id})));
+    }
+
+    ts::BinaryTable bin;
+    sdt.serialize(duck, bin);
+    TSUNIT_ASSERT(bin.isValid());
+    TSUNIT_ASSERT(bin.sectionCount() > 1);
+
+    const ts::SDTView view(bin);
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_EQUAL(0x0102, view.tsId());
+    TSUNIT_EQUAL(0x0304, view.onetwId());
+
+    size_t count = 0;
+    for (ts::SDTView::const_iterator it = view.begin(); it != view.end(); ++it) {
+        const auto ref(sdt.services.find(it->serviceId()));
+        TSUNIT_ASSERT(ref != sdt.services.end());
+        TSUNIT_EQUAL(ref->second.EITs_present, it->EITsPresent());
+        TSUNIT_EQUAL(ref->second.EITpf_present, it->EITpfPresent());
+        TSUNIT_EQUAL(ref->second.running_status, it->runningStatus());
+        TSUNIT_EQUAL(ref->second.CA_controlled, it->CAControlled());
+        TSUNIT_EQUAL(ref->second.serviceType(duck), it->serviceType());
+        TSUNIT_EQUAL(ref->second.serviceName(duck), it->serviceName(duck));
+        TSUNIT_EQUAL(ref->second.providerName(duck), it->providerName(duck));
+        count++;
+    }
+    TSUNIT_EQUAL(sdt.services.size(), count);
+
+    TSUNIT_ASSERT(view.findService(301) == view.end());
+    TSUNIT_ASSERT(view.findService(57) != view.end());
+    TSUNIT_EQUAL(u"Service 57", view.findService(57)->serviceName(duck));
+    TSUNIT_ASSERT(view.findService(duck, u"service 83") != view.end());
+    TSUNIT_EQUAL(83, view.findService(duck, u"service 83")->serviceId());
+    TSUNIT_ASSERT(view.findService(duck, u"service 83", true) == view.end());
+}
@@ -0,0 +1,269 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TableCache
+//
+//----------------------------------------------------------------------------
+
+#include "tsTableCache.h"
+#include "tsTablesDisplay.h"
+#include "tsDuckContext.h"
+#include "tsBinaryTable.h"
+#include "tsPAT.h"
+#include "tsSDT.h"
+#include "tsETT.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TableCacheTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testDeserialized();
+    void testTypedAccess();
+    void testEviction();
+    void testRendering();
+    void testRenderingMultipleString();
+
+    TSUNIT_TEST_BEGIN(TableCacheTest);
+    TSUNIT_TEST(testDeserialized);
+    TSUNIT_TEST(testTypedAccess);
+    TSUNIT_TEST(testEviction);
+    TSUNIT_TEST(testRendering);
+    TSUNIT_TEST(testRenderingMultipleString);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(TableCacheTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void TableCacheTest::beforeTest()
+{
+    ts::TableCache::Instance()->clear();
+    ts::TableCache::Instance()->setMaxEntries(ts::TableCache::DEFAULT_MAX_ENTRIES);
+}
+
+// Test suite cleanup method.
+void TableCacheTest::afterTest()
+{
+    ts::TableCache::Instance()->clear();
+    ts::TableCache::Instance()->setMaxEntries(ts::TableCache::DEFAULT_MAX_ENTRIES);
+}
+
+namespace {
+    // Build a binary PAT.
+    void BuildPAT(ts::DuckContext& duck, ts::BinaryTable& bin, uint8_t version, uint16_t ts_id, ts::PID pid = ts::PID_PAT)
+    {
+        ts::PAT pat(version, true, ts_id);
+        pat.pmts[1] = 100;
+        pat.pmts[2] = 200;
+        pat.serialize(duck, bin);
+        bin.setSourcePID(pid);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void TableCacheTest::testDeserialized()
+{
+    ts::DuckContext duck;
+    ts::TableCache* cache = ts::TableCache::Instance();
+
+    ts::BinaryTable bin1, bin2, bin3;
+    BuildPAT(duck, bin1, 1, 10);
+    BuildPAT(duck, bin2, 1, 10);
+    BuildPAT(duck, bin3, 2, 10);
+
+    const ts::TableCache::TablePtr t1(cache->getTable(duck, bin1));
+    TSUNIT_ASSERT(!t1.isNull());
+    TSUNIT_EQUAL(ts::TID_PAT, t1->tableId());
+    TSUNIT_EQUAL(1, cache->size());
+    TSUNIT_EQUAL(0, cache->hitCount());
+    TSUNIT_EQUAL(1, cache->missCount());
+
+    // Same binary content in another BinaryTable: same deserialized object.
+    const ts::TableCache::TablePtr t2(cache->getTable(duck, bin2));
+    TSUNIT_ASSERT(t1.pointer() == t2.pointer());
+    TSUNIT_EQUAL(1, cache->size());
+    TSUNIT_EQUAL(1, cache->hitCount());
+
+    // New version: another object.
+    const ts::TableCache::TablePtr t3(cache->getTable(duck, bin3));
+    TSUNIT_ASSERT(!t3.isNull());
+    TSUNIT_ASSERT(t1.pointer() != t3.pointer());
+    TSUNIT_EQUAL(2, cache->size());
+    TSUNIT_EQUAL(2, cache->missCount());
+
+    // Invalid table.
+    ts::BinaryTable invalid;
+    TSUNIT_ASSERT(cache->getTable(duck, invalid).isNull());
+
+    // The cache is disabled with zero entries.
+    cache->setMaxEntries(0);
+    TSUNIT_EQUAL(0, cache->size());
+    const ts::TableCache::TablePtr t4(cache->getTable(duck, bin1));
+    TSUNIT_ASSERT(!t4.isNull());
+    TSUNIT_ASSERT(t1.pointer() != t4.pointer());
+    TSUNIT_EQUAL(0, cache->size());
+}
+
+void TableCacheTest::testTypedAccess()
+{
+    ts::DuckContext duck;
+    ts::TableCache* cache = ts::TableCache::Instance();
+
+    ts::BinaryTable bin;
+    BuildPAT(duck, bin, 3, 20);
+
+    ts::TableCache::TablePtr holder1;
+    const ts::PAT* pat1 = cache->getTable<ts::PAT>(duck, bin, holder1);
+    TSUNIT_ASSERT(pat1 != nullptr);
+    TSUNIT_EQUAL(20, pat1->ts_id);
+    TSUNIT_EQUAL(2, pat1->pmts.size());
+
+    ts::TableCache::TablePtr holder2;
+    const ts::PAT* pat2 = cache->getTable<ts::PAT>(duck, bin, holder2);
+    TSUNIT_ASSERT(pat1 == pat2);
+
+    // Request another class for the same table: local deserialization, which fails.
+    ts::TableCache::TablePtr holder3;
+    const ts::SDT* sdt = cache->getTable<ts::SDT>(duck, bin, holder3);
+    TSUNIT_ASSERT(sdt == nullptr);
+}
+
+void TableCacheTest::testEviction()
+{
+    ts::DuckContext duck;
+    ts::TableCache* cache = ts::TableCache::Instance();
+    cache->setMaxEntries(4);
+
+    ts::BinaryTable bin[6];
+    for (uint16_t i = 0; i < 6; ++i) {
+        BuildPAT(duck, bin[i], 0, i);
+    }
+
+    const ts::TableCache::TablePtr first(cache->getTable(duck, bin[0]));
+    for (size_t i = 1; i < 4; ++i) {
+        cache->getTable(duck, bin[i]);
+    }
+    TSUNIT_EQUAL(4, cache->size());
+
+    // Use table 0 again, it becomes the most recently used one.
+    TSUNIT_ASSERT(cache->getTable(duck, bin[0]).pointer() == first.pointer());
+
+    // Add two tables, tables 1 and 2 are evicted.
+    cache->getTable(duck, bin[4]);
+    cache->getTable(duck, bin[5]);
+    TSUNIT_EQUAL(4, cache->size());
+    TSUNIT_ASSERT(cache->getTable(duck, bin[0]).pointer() == first.pointer());
+
+    const uint64_t misses = cache->missCount();
+    cache->getTable(duck, bin[1]);
+    TSUNIT_EQUAL(misses + 1, cache->missCount());
+}
+
+void TableCacheTest::testRendering()
+{
+    ts::DuckContext duck;
+    ts::TableCache* cache = ts::TableCache::Instance();
+
+    ts::BinaryTable bin;
+    BuildPAT(duck, bin, 4, 30);
+
+    ts::UString text;
+    TSUNIT_ASSERT(!cache->getRendering(bin, u"foo", text));
+    cache->setRendering(bin, u"foo", u"rendering of foo");
+    TSUNIT_ASSERT(cache->getRendering(bin, u"foo", text));
+    TSUNIT_EQUAL(u"rendering of foo", text);
+    TSUNIT_ASSERT(!cache->getRendering(bin, u"bar", text));
+
+    // Cached and non-cached displays must be identical.
+    std::ostringstream out1, out2, out3;
+    duck.setOutput(&out1);
+    ts::TablesDisplay display(duck);
+    display.displayTable(bin);
+    display.setUseTableCache(true);
+    duck.setOutput(&out2);
+    display.displayTable(bin);
+    const uint64_t hits = cache->hitCount();
+    duck.setOutput(&out3);
+    display.displayTable(bin);
+    TSUNIT_EQUAL(hits + 1, cache->hitCount());
+    duck.setOutput(nullptr);
+
+    debug() << "TableCacheTest::testRendering: " << std::endl << out1.str();
+    TSUNIT_ASSERT(!out1.str().empty());
+    TSUNIT_EQUAL(out1.str(), out2.str());
+    TSUNIT_EQUAL(out1.str(), out3.str());
+}
+
+void TableCacheTest::testRenderingMultipleString()
+{
+    // The display of a multiple_string_structure shall be captured in the cached rendering.
+    ts::DuckContext duck;
+    duck.addStandards(ts::Standards::ATSC);
+
+    ts::ETT ett(3);
+    ett.ETM_id = 0x12345678;
+    ett.extended_text_message.add(u"eng", u"Cached text message");
+    ts::BinaryTable bin;
+    ett.serialize(duck, bin);
+    TSUNIT_ASSERT(bin.isValid());
+
+    std::ostringstream out1, out2, out3;
+    duck.setOutput(&out1);
+    ts::TablesDisplay display(duck);
+    display.displayTable(bin);
+    display.setUseTableCache(true);
+    duck.setOutput(&out2);
+    display.displayTable(bin);
+    duck.setOutput(&out3);
+    display.displayTable(bin);
+    duck.setOutput(nullptr);
+
+    debug() << "TableCacheTest::testRenderingMultipleString: " << std::endl << out1.str();
+    TSUNIT_ASSERT(ts::UString::FromUTF8(out1.str()).contain(u"Cached text message"));
+    TSUNIT_EQUAL(out1.str(), out2.str());
+    TSUNIT_EQUAL(out1.str(), out3.str());
+}
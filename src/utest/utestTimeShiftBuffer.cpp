@@ -50,15 +50,19 @@ public:
     void testMinimum();
     void testMemory();
     void testFile();
+    void testMapped();
+    void testMappedWindows();
 
     TSUNIT_TEST_BEGIN(TimeShiftBufferTest);
     TSUNIT_TEST(testMinimum);
     TSUNIT_TEST(testMemory);
     TSUNIT_TEST(testFile);
+    TSUNIT_TEST(testMapped);
+    TSUNIT_TEST(testMappedWindows);
     TSUNIT_TEST_END();
 
 private:
-    void testCommon(uint8_t total, uint8_t memory);
+    void testCommon(uint8_t total, uint8_t memory, bool mapped);
 };
 
 TSUNIT_REGISTER(TimeShiftBufferTest);
@@ -83,10 +87,11 @@ void TimeShiftBufferTest::afterTest()
 // Unitary tests.
 //----------------------------------------------------------------------------
 
-void TimeShiftBufferTest::testCommon(uint8_t total, uint8_t memory)
+void TimeShiftBufferTest::testCommon(uint8_t total, uint8_t memory, bool mapped)
 {
     ts::TimeShiftBuffer buf(total);
     TSUNIT_ASSERT(buf.setMemoryPackets(memory));
+    TSUNIT_ASSERT(buf.setMemoryMapped(mapped));
     TSUNIT_ASSERT(!buf.isOpen());
     TSUNIT_ASSERT(buf.open(CERR));
     TSUNIT_ASSERT(buf.isOpen());
@@ -95,6 +100,7 @@ void TimeShiftBufferTest::testCommon(uint8_t total, uint8_t memory)
     TSUNIT_ASSERT(buf.empty());
     TSUNIT_ASSERT(!buf.full());
     TSUNIT_EQUAL(memory >= total, buf.memoryResident());
+    TSUNIT_EQUAL(mapped && memory < total, buf.memoryMapped());
 
     ts::TSPacket pkt;
     ts::TSPacketMetadata mdata;
@@ -155,15 +161,58 @@ void TimeShiftBufferTest::testCommon(uint8_t total, uint8_t memory)
 
 void TimeShiftBufferTest::testMinimum()
 {
-    testCommon(2, 2);
+    testCommon(2, 2, false);
 }
 
 void TimeShiftBufferTest::testMemory()
 {
-    testCommon(10, 16);
+    testCommon(10, 16, false);
 }
 
 void TimeShiftBufferTest::testFile()
 {
-    testCommon(20, 4);
+    testCommon(20, 4, false);
+}
+
+void TimeShiftBufferTest::testMapped()
+{
+    testCommon(20, 4, true);
+}
+
+// Large enough buffer to use read-ahead and writeback windows.
+void TimeShiftBufferTest::testMappedWindows()
+{
+    const size_t total = 10 * ts::MappedPacketRing::MIN_WINDOW_PACKETS + 7;
+    ts::TimeShiftBuffer buf(total);
+    TSUNIT_ASSERT(buf.setMemoryPackets(4 * ts::MappedPacketRing::MIN_WINDOW_PACKETS));
+    TSUNIT_ASSERT(buf.open(CERR));
+    TSUNIT_ASSERT(buf.memoryMapped());
+    TSUNIT_EQUAL(total, buf.size());
+
+    ts::TSPacket pkt;
+    ts::TSPacketMetadata mdata;
+
+    for (uint32_t i = 0; i < 3 * total; i++) {
+        pkt.init(ts::PID(i % ts::PID_NULL));
+        ts::PutUInt32(pkt.getPayload(), i);
+        mdata.reset();
+        mdata.setLabel(i % ts::TSPacketMetadata::LABEL_COUNT);
+
+        TSUNIT_ASSERT(buf.shift(pkt, mdata, CERR));
+
+        if (i < total) {
+            TSUNIT_EQUAL(ts::PID_NULL, pkt.getPID());
+            TSUNIT_ASSERT(mdata.getInputStuffing());
+        }
+        else {
+            const uint32_t j = uint32_t(i - total);
+            TSUNIT_EQUAL(j % ts::PID_NULL, pkt.getPID());
+            TSUNIT_EQUAL(j, ts::GetUInt32(pkt.getPayload()));
+            TSUNIT_ASSERT(!mdata.getInputStuffing());
+            TSUNIT_ASSERT(mdata.hasLabel(j % ts::TSPacketMetadata::LABEL_COUNT));
+        }
+    }
+
+    TSUNIT_ASSERT(buf.close(CERR));
+    TSUNIT_ASSERT(!buf.memoryMapped());
 }
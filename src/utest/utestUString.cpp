@@ -52,6 +52,7 @@ public:
 
     void testIsSpace();
     void testUTF();
+    void testUTFBlocks();
     void testDiacritical();
     void testSurrogate();
     void testFromWChar();
@@ -107,6 +108,7 @@ public:
     TSUNIT_TEST_BEGIN(UStringTest);
     TSUNIT_TEST(testIsSpace);
     TSUNIT_TEST(testUTF);
+    TSUNIT_TEST(testUTFBlocks);
     TSUNIT_TEST(testDiacritical);
     TSUNIT_TEST(testSurrogate);
     TSUNIT_TEST(testFromWChar);
@@ -321,6 +323,39 @@ void UStringTest::testUTF()
     TSUNIT_EQUAL(s1, s4);
 }
 
+void UStringTest::testUTFBlocks()
+{
+    // Non-ASCII characters at all positions around the blocks of the ASCII fast paths.
+    // Each non-ASCII character uses 2, 3 or 4 bytes in UTF-8.
+    const ts::UString nonascii16[] = {
+        ts::UString(1, ts::LATIN_SMALL_LETTER_E_WITH_ACUTE),
+        ts::UString(1, ts::EURO_SIGN),
+        ts::UString({ts::UChar(0xD835), ts::UChar(0xDC00)}),  // U+1D400
+    };
+    const std::string nonascii8[] = {"\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9D\x90\x80"};
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t len = 0; len < 40; ++len) {
+            for (size_t pos = 0; pos <= len; ++pos) {
+                ts::UString ref16;
+                std::string ref8;
+                for (size_t i = 0; i <= len; ++i) {
+                    if (i == pos) {
+                        ref16.append(nonascii16[k]);
+                        ref8.append(nonascii8[k]);
+                    }
+                    if (i < len) {
+                        ref16.push_back(ts::UChar('a' + i % 26));
+                        ref8.push_back(char('a' + i % 26));
+                    }
+                }
+                TSUNIT_EQUAL(ref8, ref16.toUTF8());
+                TSUNIT_EQUAL(ref16, ts::UString::FromUTF8(ref8));
+            }
+        }
+    }
+}
+
 void UStringTest::testDiacritical()
 {
     TSUNIT_ASSERT(!ts::IsCombiningDiacritical(ts::UChar('a')));
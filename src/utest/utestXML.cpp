@@ -33,6 +33,7 @@
 
 #include "tsxmlDocument.h"
 #include "tsxmlElement.h"
+#include "tsxmlStreamReader.h"
 #include "tsSectionFile.h"
 #include "tsTextFormatter.h"
 #include "tsCerrReport.h"
@@ -63,6 +64,7 @@ public:
     void testEscape();
     void testTweaks();
     void testChannels();
+    void testStreamReader();
 
     TSUNIT_TEST_BEGIN(XMLTest);
     TSUNIT_TEST(testDocument);
@@ -74,6 +76,7 @@ public:
     TSUNIT_TEST(testEscape);
     TSUNIT_TEST(testTweaks);
     TSUNIT_TEST(testChannels);
+    TSUNIT_TEST(testStreamReader);
     TSUNIT_TEST_END();
 
 private:
@@ -485,3 +488,74 @@ void XMLTest::testChannels()
     ts::xml::Document model(report());
     TSUNIT_ASSERT(model.load(TS_XML_TABLES_MODEL));
 }
+
+void XMLTest::testStreamReader()
+{
+    static const ts::UChar* const document =
+        u"<?xml version='1.0' encoding='UTF-8'?>\n"
+        u"<!-- leading comment -->\n"
+        u"<root attr1='val1'\n"
+        u"      attr2='val2'>  <node1 a1='v>1'>Text in node1</node1>\n"
+        u"  <!-- <node0/> -->\n"
+        u"  <node2\n"
+        u"     b1=\"x/>1\">\n"
+        u"    <sub1><![CDATA[</node2>]]></sub1>\n"
+        u"    <sub2/>\n"
+        u"  </node2><node3/>\n"
+        u"</root>\n"
+        u"<!-- trailing comment -->\n";
+
+    ts::xml::StreamReader reader(report());
+    TSUNIT_ASSERT(reader.openText(document));
+    TSUNIT_ASSERT(!reader.error());
+
+    const ts::xml::Element* elem = reader.document().rootElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"root", elem->name());
+    TSUNIT_EQUAL(u"val1", elem->attribute(u"attr1").value());
+    TSUNIT_EQUAL(u"val2", elem->attribute(u"attr2").value());
+    TSUNIT_ASSERT(!elem->hasChildren());
+
+    elem = reader.next();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"node1", elem->name());
+    TSUNIT_EQUAL(4, elem->lineNumber());
+    TSUNIT_EQUAL(u"v>1", elem->attribute(u"a1").value());
+    TSUNIT_EQUAL(u"Text in node1", elem->text());
+    TSUNIT_ASSERT(elem->nextSiblingElement() == nullptr);
+    TSUNIT_ASSERT(!reader.document().rootElement()->hasAttribute(u"attr1"));
+
+    elem = reader.next();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"node2", elem->name());
+    TSUNIT_EQUAL(6, elem->lineNumber());
+    TSUNIT_EQUAL(u"x/>1", elem->attribute(u"b1").value());
+    TSUNIT_EQUAL(2, elem->childrenCount());
+    const ts::xml::Element* sub = elem->firstChildElement();
+    TSUNIT_ASSERT(sub != nullptr);
+    TSUNIT_EQUAL(u"sub1", sub->name());
+    TSUNIT_EQUAL(8, sub->lineNumber());
+    TSUNIT_EQUAL(u"</node2>", sub->text());
+    sub = sub->nextSiblingElement();
+    TSUNIT_ASSERT(sub != nullptr);
+    TSUNIT_EQUAL(u"sub2", sub->name());
+    TSUNIT_EQUAL(9, sub->lineNumber());
+
+    elem = reader.next();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"node3", elem->name());
+    TSUNIT_EQUAL(10, elem->lineNumber());
+
+    TSUNIT_ASSERT(reader.next() == nullptr);
+    TSUNIT_ASSERT(!reader.error());
+    TSUNIT_ASSERT(reader.next() == nullptr);
+
+    // Truncated document.
+    ts::ReportBuffer<> rep;
+    ts::xml::StreamReader reader2(rep);
+    TSUNIT_ASSERT(reader2.openText(u"<root>\n  <node1/>\n  <node2>\n"));
+    TSUNIT_ASSERT(reader2.next() != nullptr);
+    TSUNIT_ASSERT(reader2.next() == nullptr);
+    TSUNIT_ASSERT(reader2.error());
+    TSUNIT_EQUAL(u"Error: line 4: unexpected end of XML document, unterminated element at line 3", rep.getMessages());
+}